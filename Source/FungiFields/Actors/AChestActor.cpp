@@ -1,6 +1,7 @@
 #include "AChestActor.h"
 #include "../Components/ChestInventoryComponent.h"
 #include "../Widgets/UChestWidget.h"
+#include "../Subsystems/UFarmWidgetPoolSubsystem.h"
 #include "../Characters/FungiFieldsCharacter.h"
 #include "GameFramework/PlayerController.h"
 #include "Kismet/GameplayStatics.h"
@@ -8,6 +9,9 @@
 AChestActor::AChestActor()
 {
 	ChestInventoryComponent = CreateDefaultSubobject<UChestInventoryComponent>(TEXT("ChestInventoryComponent"));
+
+	bReplicates = true;
+	bReplicateUsingRegisteredSubObjectList = true;
 }
 
 void AChestActor::BeginPlay()
@@ -65,30 +69,49 @@ void AChestActor::OpenChestWidgetForPlayer(AActor* Interactor)
 		return;
 	}
 
+	APlayerController* PC = Cast<APlayerController>(PlayerCharacter->GetController());
+
 	if (!ChestWidgetInstance)
 	{
-		ChestWidgetInstance = CreateWidget<UChestWidget>(World, ChestWidgetClass);
+		if (UFarmWidgetPoolSubsystem* WidgetPool = UFarmWidgetPoolSubsystem::Get(this))
+		{
+			ChestWidgetInstance = WidgetPool->Acquire<UChestWidget>(ChestWidgetClass, PC);
+		}
 	}
 
 	if (ChestWidgetInstance)
 	{
 		ChestWidgetInstance->SetupInventories(PlayerCharacter->InventoryComponent, ChestInventoryComponent);
-		ChestWidgetInstance->OnChestWidgetClosed.AddDynamic(this, &AChestActor::OnChestWidgetClosed);
+		ChestWidgetInstance->OnChestWidgetClosed.AddUniqueDynamic(this, &AChestActor::OnChestWidgetClosed);
 		ChestWidgetInstance->AddToViewport();
 
-		if (APlayerController* PC = Cast<APlayerController>(PlayerCharacter->GetController()))
+		if (PC)
 		{
 			FInputModeUIOnly InputMode;
 			InputMode.SetWidgetToFocus(ChestWidgetInstance->TakeWidget());
 			PC->SetInputMode(InputMode);
 			PC->bShowMouseCursor = true;
+
+			CurrentViewer = PC;
+			ChestInventoryComponent->AddViewer(PC);
 		}
 	}
 }
 
 void AChestActor::OnChestWidgetClosed()
 {
+	// The widget and its slots go back to the pool for the next chest that opens
+	if (UFarmWidgetPoolSubsystem* WidgetPool = UFarmWidgetPoolSubsystem::Get(this))
+	{
+		WidgetPool->Release(ChestWidgetInstance);
+	}
 	ChestWidgetInstance = nullptr;
+
+	if (ChestInventoryComponent)
+	{
+		ChestInventoryComponent->RemoveViewer(CurrentViewer.Get());
+	}
+	CurrentViewer.Reset();
 	
 	if (UWorld* World = GetWorld())
 	{
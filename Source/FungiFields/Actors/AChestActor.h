@@ -6,6 +6,7 @@
 
 class UChestInventoryComponent;
 class UChestWidget;
+class APlayerController;
 
 /**
  * Actor representing a chest that can be placed and interacted with.
@@ -46,6 +47,9 @@ private:
 	UPROPERTY()
 	TObjectPtr<UChestWidget> ChestWidgetInstance;
 
+	/** Player that currently has the chest open, tracked for inventory relevancy */
+	TWeakObjectPtr<APlayerController> CurrentViewer;
+
 	/** Open the chest widget for the interacting player */
 	void OpenChestWidgetForPlayer(AActor* Interactor);
 
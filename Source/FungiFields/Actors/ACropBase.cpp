@@ -1,4 +1,5 @@
 #include "ACropBase.h"
+#include "../FungiFieldsStats.h"
 #include "../Components/UCropGrowthComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "../Data/UCropDataAsset.h"
@@ -8,13 +9,20 @@
 #include "../Data/FHarvestResult.h"
 #include "../Data/UItemDataAsset.h"
 #include "../Actors/ItemPickup.h"
+#include "../Subsystems/FFarmAllocationCounter.h"
+#include "../Subsystems/FFarmAssetLoading.h"
+#include "../Subsystems/UCropManagerSubsystem.h"
+#include "../Subsystems/UCropVisualStreamingSubsystem.h"
+#include "../Subsystems/FFarmSimTimings.h"
 #include "Engine/World.h"
-#include "Kismet/KismetMathLibrary.h"
 #include "NiagaraFunctionLibrary.h"
 #include "Kismet/GameplayStatics.h"
+#include "FCropGrowthRules.h"
 
 ACropBase::ACropBase()
 {
+	LLM_SCOPE_BYTAG(Farm_Crops);
+
 	PrimaryActorTick.bCanEverTick = false;
 
 	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("RootComponent"));
@@ -32,6 +40,14 @@ void ACropBase::BeginPlay()
 	GrowthComponent->OnGrowthStageChanged.AddDynamic(this, &ACropBase::OnGrowthStageChanged);
 	GrowthComponent->OnCropFullyGrown.AddDynamic(this, &ACropBase::OnCropFullyGrown);
 	GrowthComponent->OnCropWithered.AddDynamic(this, &ACropBase::OnCropWithered);
+	GrowthComponent->OnVisualStageApproaching.AddDynamic(this, &ACropBase::OnVisualStageApproaching);
+}
+
+void ACropBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	ReleaseVisualStages();
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void ACropBase::Initialize(UCropDataAsset* InCropData, ASoilPlot* InParentSoil)
@@ -48,22 +64,33 @@ void ACropBase::Initialize(UCropDataAsset* InCropData, ASoilPlot* InParentSoil)
 		return;
 	}
 
+	// Stages held for a previous crop type must be released against that type
+	ReleaseVisualStages();
+
 	CropDataAsset = InCropData;
 	ParentSoil = InParentSoil;
 
 	GrowthComponent->OnGrowthStageChanged.Clear();
 	GrowthComponent->OnCropFullyGrown.Clear();
 	GrowthComponent->OnCropWithered.Clear();
+	GrowthComponent->OnVisualStageApproaching.Clear();
 
 	GrowthComponent->OnGrowthStageChanged.AddDynamic(this, &ACropBase::OnGrowthStageChanged);
 	GrowthComponent->OnCropFullyGrown.AddDynamic(this, &ACropBase::OnCropFullyGrown);
 	GrowthComponent->OnCropWithered.AddDynamic(this, &ACropBase::OnCropWithered);
+	GrowthComponent->OnVisualStageApproaching.AddDynamic(this, &ACropBase::OnVisualStageApproaching);
 
 	GrowthComponent->Initialize(InCropData, InParentSoil);
+
+	if (UCropManagerSubsystem* CropManager = GetWorld() ? GetWorld()->GetSubsystem<UCropManagerSubsystem>() : nullptr)
+	{
+		CropManager->PrefetchCropAssets(InCropData);
+	}
 }
 
 FHarvestResult ACropBase::Harvest_Implementation(AActor* Harvester, float ToolPower)
 {
+	FARM_HITCH_SCOPE(Harvest, this);
 	FHarvestResult Result;
 
 	if (!CanHarvest_Implementation())
@@ -88,21 +115,21 @@ FHarvestResult ACropBase::Harvest_Implementation(AActor* Harvester, float ToolPo
 			int32 BaseQuantity = CropDataAsset->BaseHarvestQuantity;
 			int32 FinalQuantity = BaseQuantity;
 
-			if (USoilComponent* SoilComp = ParentSoil->FindComponentByClass<USoilComponent>())
+			// The yield roll advances the plot's deterministic stream, so only the server makes it
+			USoilComponent* SoilComp = GetNetMode() != NM_Client ? ParentSoil->FindComponentByClass<USoilComponent>() : nullptr;
+			if (SoilComp)
 			{
 				if (USoilDataAsset* SoilData = SoilComp->GetSoilData())
 				{
-					float RandomValue = UKismetMathLibrary::RandomFloatInRange(0.0f, 1.0f);
-					if (RandomValue <= SoilData->YieldChance)
-					{
-						FinalQuantity *= 2;
-					}
+					const float RandomValue = ParentSoil->GetRandomStream().FRand();
+					FinalQuantity = FCropGrowthRules::GetHarvestQuantity(BaseQuantity, SoilData->YieldChance, RandomValue);
 				}
 			}
 
-			if (CropDataAsset->HarvestItem.IsValid())
+			if (!CropDataAsset->HarvestItem.IsNull())
 			{
-				UItemDataAsset* HarvestItem = CropDataAsset->HarvestItem.LoadSynchronous();
+				// Prefetched by the crop manager when the crop was planted
+				UItemDataAsset* HarvestItem = FFarmAssetLoading::Resolve(CropDataAsset->HarvestItem, this);
 				if (HarvestItem)
 				{
 					Result.HarvestItem = HarvestItem;
@@ -173,17 +200,22 @@ bool ACropBase::CanHarvest_Implementation() const
 
 FText ACropBase::GetHarvestText_Implementation() const
 {
+	// Built once; the tooltip trace asks for this every frame
+	static const FText NotReadyText = NSLOCTEXT("CropBase", "NotReady", "Not Ready");
+	static const FText RemoveWitheredText = NSLOCTEXT("CropBase", "RemoveWithered", "Remove Withered Crop");
+	static const FText HarvestText = NSLOCTEXT("CropBase", "Harvest", "Harvest");
+
 	if (!CanHarvest_Implementation())
 	{
-		return FText::FromString("Not Ready");
+		return NotReadyText;
 	}
 
 	if (GrowthComponent && GrowthComponent->IsWithered())
 	{
-		return FText::FromString("Remove Withered Crop");
+		return RemoveWitheredText;
 	}
 
-	return FText::FromString("Harvest");
+	return HarvestText;
 }
 
 FText ACropBase::GetTooltipText_Implementation() const
@@ -209,69 +241,132 @@ float ACropBase::GetInteractionRange_Implementation() const
 
 void ACropBase::OnGrowthStageChanged(AActor* Crop, float Progress)
 {
-	if (!CropDataAsset)
+	SetVisualStage(FCropGrowthRules::GetGrowthStage(Progress));
+}
+
+void ACropBase::OnCropFullyGrown(AActor* Crop)
+{
+}
+
+void ACropBase::OnCropWithered(AActor* Crop)
+{
+	SetVisualStage(FCropGrowthRules::WitheredStage);
+}
+
+void ACropBase::OnVisualStageApproaching(AActor* Crop, int32 Stage)
+{
+	if (!CropDataAsset || Stage == VisualStage || Stage == PrefetchedStage)
 	{
 		return;
 	}
 
-	int8 MeshIndex;
-	if (Progress >= 1.0f)
+	UCropVisualStreamingSubsystem* CropVisuals = UCropVisualStreamingSubsystem::Get(this);
+	if (!CropVisuals)
 	{
-		MeshIndex = 3;
+		return;
 	}
-	else if (Progress >= 0.5f)
+
+	// Acquire before releasing so a stage held by this crop alone is not unloaded and reloaded
+	CropVisuals->AcquireStage(CropDataAsset, Stage);
+	if (PrefetchedStage != INDEX_NONE)
 	{
-		MeshIndex = 2;
+		CropVisuals->ReleaseStage(CropDataAsset, PrefetchedStage);
 	}
-	else if (Progress >= 0.25f)
+	PrefetchedStage = Stage;
+}
+
+void ACropBase::OnStageMeshLoaded(int32 Stage)
+{
+	if (Stage == VisualStage)
 	{
-		MeshIndex = 1;
+		ApplyVisualStageMesh();
 	}
-	else
+}
+
+void ACropBase::SetVisualStage(int32 Stage)
+{
+	if (!CropDataAsset || Stage == VisualStage)
 	{
-		MeshIndex = 0;
+		return;
 	}
 
-	if (CropDataAsset->GrowthMeshes.IsValidIndex(MeshIndex) && CropDataAsset->GrowthMeshes[MeshIndex])
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmCropVisuals, "ACropBase::SetVisualStage");
+	// Material and mesh updates go through the renderer, which allocates
+	FARM_ALLOCATION_GUARD_EXEMPT();
+	FScopedFarmSimTiming VisualTiming(&FFarmSimTimings::VisualCycles, &FFarmSimTimings::VisualCount);
+
+	const int32 PreviousStage = VisualStage;
+	VisualStage = Stage;
+
+	if (UCropVisualStreamingSubsystem* CropVisuals = UCropVisualStreamingSubsystem::Get(this))
 	{
-		MeshComponent->SetStaticMesh(CropDataAsset->GrowthMeshes[MeshIndex]);
+		CropVisuals->AcquireStage(CropDataAsset, Stage, this);
+		if (PreviousStage != INDEX_NONE)
+		{
+			CropVisuals->ReleaseStage(CropDataAsset, PreviousStage);
+		}
+		if (PrefetchedStage == Stage)
+		{
+			CropVisuals->ReleaseStage(CropDataAsset, PrefetchedStage);
+			PrefetchedStage = INDEX_NONE;
+		}
 	}
-}
 
-void ACropBase::OnCropFullyGrown(AActor* Crop)
-{
+	ApplyVisualStageMesh();
 }
 
-void ACropBase::OnCropWithered(AActor* Crop)
+void ACropBase::ApplyVisualStageMesh()
 {
-	if (!CropDataAsset)
+	// Keep showing the previous stage until the new one has loaded
+	if (UStaticMesh* StageMesh = UCropVisualStreamingSubsystem::GetStageMesh(CropDataAsset, VisualStage))
 	{
-		return;
+		MeshComponent->SetStaticMesh(StageMesh);
 	}
+}
 
-	if (CropDataAsset->WitheredMesh)
+void ACropBase::ReleaseVisualStages()
+{
+	UCropVisualStreamingSubsystem* CropVisuals = UCropVisualStreamingSubsystem::Get(this);
+	if (CropVisuals && CropDataAsset)
 	{
-		MeshComponent->SetStaticMesh(CropDataAsset->WitheredMesh);
+		if (VisualStage != INDEX_NONE)
+		{
+			CropVisuals->ReleaseStage(CropDataAsset, VisualStage);
+		}
+		if (PrefetchedStage != INDEX_NONE)
+		{
+			CropVisuals->ReleaseStage(CropDataAsset, PrefetchedStage);
+		}
 	}
+
+	VisualStage = INDEX_NONE;
+	PrefetchedStage = INDEX_NONE;
 }
 
 void ACropBase::SpawnHarvestItems(UItemDataAsset* ItemData, int32 Quantity)
 {
-	if (!ItemData || !GetWorld() || Quantity <= 0)
+	if (!ItemData || !GetWorld() || !ParentSoil || Quantity <= 0)
+	{
+		return;
+	}
+
+	// Pickups replicate from the server; a harvest predicted on a client only removes the crop
+	if (GetNetMode() == NM_Client)
 	{
 		return;
 	}
 
+	FRandomStream& RandomStream = ParentSoil->GetRandomStream();
+
 	for (int32 i = 0; i < Quantity; ++i)
 	{
 		FVector SpawnLocation = GetActorLocation();
 		SpawnLocation.Z += 50.0f;
 		
-		FVector RandomOffset = FVector(
-			UKismetMathLibrary::RandomFloatInRange(-30.0f, 30.0f),
-			UKismetMathLibrary::RandomFloatInRange(-30.0f, 30.0f),
-			0.0f
-		);
+		// Drawn one at a time so the order does not depend on argument evaluation order
+		const float OffsetX = RandomStream.FRandRange(-30.0f, 30.0f);
+		const float OffsetY = RandomStream.FRandRange(-30.0f, 30.0f);
+		FVector RandomOffset = FVector(OffsetX, OffsetY, 0.0f);
 		SpawnLocation += RandomOffset;
 
 		TSubclassOf<AActor> SpawnClass = ItemPickupClass;
@@ -280,6 +375,9 @@ void ACropBase::SpawnHarvestItems(UItemDataAsset* ItemData, int32 Quantity)
 			SpawnClass = AItemPickup::StaticClass();
 		}
 
+		LLM_SCOPE_BYTAG(Farm_Pickups);
+		FARM_INC_COUNTER(STAT_FarmActorsSpawned, ActorSpawnCount);
+		FARM_HITCH_SCOPE(Spawn, SpawnClass);
 		AActor* SpawnedActor = GetWorld()->SpawnActor<AActor>(SpawnClass, SpawnLocation, FRotator::ZeroRotator);
 		if (AItemPickup* ItemPickup = Cast<AItemPickup>(SpawnedActor))
 		{
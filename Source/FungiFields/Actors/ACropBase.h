@@ -25,6 +25,7 @@ public:
 	ACropBase();
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	// IHarvestableInterface implementation
 	virtual FHarvestResult Harvest_Implementation(AActor* Harvester, float ToolPower) override;
@@ -58,6 +59,20 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Crop")
 	UCropDataAsset* GetCropData() const { return CropDataAsset; }
 
+	/**
+	 * Get the soil plot this crop is planted on.
+	 * @return The parent soil plot
+	 */
+	UFUNCTION(BlueprintPure, Category = "Crop")
+	ASoilPlot* GetParentSoil() const { return ParentSoil; }
+
+	/**
+	 * Show a visual stage's mesh once it has streamed in.
+	 * Called by the crop visual streaming subsystem when a mesh this crop was waiting on finishes loading.
+	 * @param Stage The stage whose mesh loaded
+	 */
+	void OnStageMeshLoaded(int32 Stage);
+
 protected:
 	/**
 	 * Update the crop mesh based on growth stage.
@@ -78,6 +93,25 @@ protected:
 	UFUNCTION()
 	void OnCropWithered(AActor* Crop);
 
+	/**
+	 * Start streaming the mesh of a visual stage the crop is about to reach.
+	 * Called by growth component ahead of a stage change.
+	 */
+	UFUNCTION()
+	void OnVisualStageApproaching(AActor* Crop, int32 Stage);
+
+	/**
+	 * Switch the crop to a visual stage, holding its mesh and releasing the previous stage's.
+	 * @param Stage A growth stage, or FCropGrowthRules::WitheredStage
+	 */
+	void SetVisualStage(int32 Stage);
+
+	/** Set the mesh of the current visual stage if it has loaded */
+	void ApplyVisualStageMesh();
+
+	/** Release the visual stages this crop holds */
+	void ReleaseVisualStages();
+
 	/**
 	 * Spawn harvest items at crop location.
 	 * @param ItemData The item data asset to spawn
@@ -107,4 +141,11 @@ protected:
 
 	UPROPERTY(EditAnywhere, Category = "Crop")
 	float HarvestProgress = 0;
+
+private:
+	/** Visual stage currently held and shown */
+	int32 VisualStage = INDEX_NONE;
+
+	/** Upcoming visual stage held ahead of time */
+	int32 PrefetchedStage = INDEX_NONE;
 };
\ No newline at end of file
@@ -0,0 +1,177 @@
+#include "AFarmChunk.h"
+#include "ASoilPlot.h"
+#include "../Subsystems/UFarmReplicationSubsystem.h"
+#include "Engine/World.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+
+AFarmChunk::AFarmChunk()
+	: PlotList(this)
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("RootComponent"));
+
+	bReplicates = true;
+	NetDormancy = DORM_DormantAll;
+	NetUpdateFrequency = 10.0f;
+
+	// Relevancy is measured from the chunk centre, so reach past the chunk edge by a view distance
+	NetCullDistanceSquared = FMath::Square(6000.0f);
+}
+
+void AFarmChunk::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AFarmChunk, PlotList, Params);
+
+	Params.Condition = COND_InitialOnly;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AFarmChunk, ChunkCoord, Params);
+}
+
+void AFarmChunk::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	PlotList.OwnerChunk = this;
+}
+
+void AFarmChunk::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (GetLocalRole() != ROLE_Authority)
+	{
+		if (UFarmReplicationSubsystem* FarmReplication = UFarmReplicationSubsystem::Get(this))
+		{
+			FarmReplication->ReleaseClientChunk(this);
+		}
+	}
+
+	ClientPlots.Empty();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AFarmChunk::SetChunkCoord(const FIntPoint& InChunkCoord)
+{
+	ChunkCoord = InChunkCoord;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AFarmChunk, ChunkCoord, this);
+}
+
+uint16 AFarmChunk::AddPlotRecord(FFarmPlotRecord Record)
+{
+	while (FindPlotRecord(NextPlotKey))
+	{
+		++NextPlotKey;
+	}
+
+	Record.PlotKey = NextPlotKey++;
+	FFarmPlotRecord& NewRecord = PlotList.Records.Add_GetRef(Record);
+	PlotList.MarkItemDirty(NewRecord);
+	MarkRecordsDirty();
+
+	return Record.PlotKey;
+}
+
+bool AFarmChunk::UpdatePlotRecord(const FFarmPlotRecord& Sampled, uint8 WaterResyncStep)
+{
+	// Chunks hold at most a few hundred plots, so a linear scan is cheaper than maintaining an index
+	for (FFarmPlotRecord& Record : PlotList.Records)
+	{
+		if (Record.PlotKey != Sampled.PlotKey)
+		{
+			continue;
+		}
+
+		if (!FFarmPlotRecord::NeedsResync(Record, Sampled, WaterResyncStep))
+		{
+			return false;
+		}
+
+		const int32 ReplicationID = Record.ReplicationID;
+		const int32 ReplicationKey = Record.ReplicationKey;
+		Record = Sampled;
+		Record.ReplicationID = ReplicationID;
+		Record.ReplicationKey = ReplicationKey;
+
+		PlotList.MarkItemDirty(Record);
+		MarkRecordsDirty();
+		return true;
+	}
+
+	return false;
+}
+
+void AFarmChunk::RemovePlotRecord(uint16 PlotKey)
+{
+	const int32 RemovedCount = PlotList.Records.RemoveAllSwap([PlotKey](const FFarmPlotRecord& Record)
+	{
+		return Record.PlotKey == PlotKey;
+	});
+
+	if (RemovedCount > 0)
+	{
+		PlotList.MarkArrayDirty();
+		MarkRecordsDirty();
+	}
+}
+
+const FFarmPlotRecord* AFarmChunk::FindPlotRecord(uint16 PlotKey) const
+{
+	return PlotList.Records.FindByPredicate([PlotKey](const FFarmPlotRecord& Record)
+	{
+		return Record.PlotKey == PlotKey;
+	});
+}
+
+void AFarmChunk::SetClientPlot(uint16 PlotKey, ASoilPlot* Plot)
+{
+	if (Plot)
+	{
+		ClientPlots.Add(PlotKey, Plot);
+	}
+	else
+	{
+		ClientPlots.Remove(PlotKey);
+	}
+}
+
+ASoilPlot* AFarmChunk::GetClientPlot(uint16 PlotKey) const
+{
+	const TWeakObjectPtr<ASoilPlot>* Plot = ClientPlots.Find(PlotKey);
+	return Plot ? Plot->Get() : nullptr;
+}
+
+void AFarmChunk::HandleRecordReplicated(const FFarmPlotRecord& Record)
+{
+	if (UFarmReplicationSubsystem* FarmReplication = UFarmReplicationSubsystem::Get(this))
+	{
+		FarmReplication->ApplyClientRecord(this, Record);
+	}
+}
+
+void AFarmChunk::HandleRecordRemoved(const FFarmPlotRecord& Record)
+{
+	if (UFarmReplicationSubsystem* FarmReplication = UFarmReplicationSubsystem::Get(this))
+	{
+		FarmReplication->RemoveClientRecord(this, Record);
+	}
+}
+
+void AFarmChunk::HandleRecordsReceived()
+{
+	if (UFarmReplicationSubsystem* FarmReplication = UFarmReplicationSubsystem::Get(this))
+	{
+		FarmReplication->ResolveOrphanedPlots(this);
+	}
+}
+
+void AFarmChunk::MarkRecordsDirty()
+{
+	MARK_PROPERTY_DIRTY_FROM_NAME(AFarmChunk, PlotList, this);
+
+	// Replicate this change once, then fall back to dormant
+	FlushNetDormancy();
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "../Data/FFarmPlotRecord.h"
+#include "AFarmChunk.generated.h"
+
+class ASoilPlot;
+
+/**
+ * Replicated container for the plot records of one square chunk of the farm grid.
+ * Spawned on demand by UFarmReplicationSubsystem on the server and kept dormant;
+ * a change to any record wakes the chunk for a single update, so idle chunks cost no bandwidth.
+ * Chunks are spatially relevant: a client only holds the chunks near its view and keeps its last known
+ * plot state for chunks that go out of range.
+ */
+UCLASS(NotBlueprintable)
+class FUNGIFIELDS_API AFarmChunk : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AFarmChunk();
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void PostInitializeComponents() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/**
+	 * Server: set the grid coordinate of this chunk. Must be called before the chunk first replicates.
+	 * @param InChunkCoord Chunk coordinate in the farm grid
+	 */
+	void SetChunkCoord(const FIntPoint& InChunkCoord);
+
+	/**
+	 * Get the grid coordinate of this chunk.
+	 * @return Chunk coordinate in the farm grid
+	 */
+	const FIntPoint& GetChunkCoord() const { return ChunkCoord; }
+
+	/**
+	 * Server: add a record for a newly registered plot.
+	 * @param Record The initial plot state; PlotKey is assigned here
+	 * @return The key assigned to the plot
+	 */
+	uint16 AddPlotRecord(FFarmPlotRecord Record);
+
+	/**
+	 * Server: replace the record of a plot if the change is visible to clients.
+	 * @param Sampled Freshly sampled plot state with PlotKey set
+	 * @param WaterResyncStep Quantized water difference that forces a resend
+	 * @return True if the record was replaced and will replicate
+	 */
+	bool UpdatePlotRecord(const FFarmPlotRecord& Sampled, uint8 WaterResyncStep);
+
+	/**
+	 * Server: remove the record of a plot.
+	 * @param PlotKey Key of the plot to remove
+	 */
+	void RemovePlotRecord(uint16 PlotKey);
+
+	/**
+	 * Find a record by key.
+	 * @param PlotKey Key of the plot
+	 * @return The record, or nullptr if not found
+	 */
+	const FFarmPlotRecord* FindPlotRecord(uint16 PlotKey) const;
+
+	/**
+	 * Get the number of records in this chunk.
+	 * @return Record count
+	 */
+	int32 GetNumRecords() const { return PlotList.Records.Num(); }
+
+	/** Client: bind a replicated record to the local plot actor that represents it */
+	void SetClientPlot(uint16 PlotKey, ASoilPlot* Plot);
+
+	/** Client: get the local plot actor bound to a record */
+	ASoilPlot* GetClientPlot(uint16 PlotKey) const;
+
+private:
+	friend struct FFarmPlotRecord;
+	friend struct FFarmPlotRecordList;
+
+	/** Client: a record was added or changed */
+	void HandleRecordReplicated(const FFarmPlotRecord& Record);
+
+	/** Client: a record is about to be removed */
+	void HandleRecordRemoved(const FFarmPlotRecord& Record);
+
+	/** Client: a batch of record changes has been applied */
+	void HandleRecordsReceived();
+
+	/** Wake the chunk for one update after its records changed */
+	void MarkRecordsDirty();
+
+	/** Grid coordinate of this chunk. Declared before PlotList so it arrives before the first records */
+	UPROPERTY(Replicated)
+	FIntPoint ChunkCoord = FIntPoint::ZeroValue;
+
+	/** Plot records of this chunk */
+	UPROPERTY(Replicated)
+	FFarmPlotRecordList PlotList;
+
+	/** Next key to hand out to a registered plot */
+	uint16 NextPlotKey = 0;
+
+	/** Client-side plot actors bound to records, by key */
+	TMap<uint16, TWeakObjectPtr<ASoilPlot>> ClientPlots;
+
+public:
+	/** Client: get all plot actors currently bound to records */
+	const TMap<uint16, TWeakObjectPtr<ASoilPlot>>& GetClientPlots() const { return ClientPlots; }
+};
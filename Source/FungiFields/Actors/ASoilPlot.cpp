@@ -1,4 +1,5 @@
 #include "ASoilPlot.h"
+#include "../FungiFieldsStats.h"
 #include "../Components/USoilComponent.h"
 #include "../Components/InventoryComponent.h"
 #include "../Inventory/FInventorySlot.h"
@@ -15,6 +16,14 @@
 #include "../Data/UToolDataAsset.h"
 #include "../ENUM/ESoilState.h"
 #include "../Data/UItemDataAsset.h"
+#include "../Data/FFarmPlotRecord.h"
+#include "../Data/FFarmSaveData.h"
+#include "../Components/UCropGrowthComponent.h"
+#include "../Subsystems/FFarmAllocationCounter.h"
+#include "../Subsystems/FFarmSimTimings.h"
+#include "../Subsystems/UFarmReplicationSubsystem.h"
+#include "../Subsystems/UFarmSaveSubsystem.h"
+#include "../Subsystems/UFarmSimulationSubsystem.h"
 #include "Engine/World.h"
 #include "NiagaraFunctionLibrary.h"
 #include "Particles/ParticleSystem.h"
@@ -24,6 +33,8 @@
 
 ASoilPlot::ASoilPlot()
 {
+	LLM_SCOPE_BYTAG(Farm_Plots);
+
 	PrimaryActorTick.bCanEverTick = false;
 
 	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("RootComponent"));
@@ -55,6 +66,31 @@ void ASoilPlot::BeginPlay()
 	{
 		Initialize(SoilDataAsset);
 	}
+
+	if (UFarmReplicationSubsystem* FarmReplication = UFarmReplicationSubsystem::Get(this))
+	{
+		FarmReplication->RegisterLocalPlot(this);
+	}
+
+	if (UFarmSaveSubsystem* FarmSave = UFarmSaveSubsystem::Get(this))
+	{
+		FarmSave->RegisterPlot(this);
+	}
+}
+
+void ASoilPlot::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UFarmReplicationSubsystem* FarmReplication = UFarmReplicationSubsystem::Get(this))
+	{
+		FarmReplication->UnregisterPlot(this, EndPlayReason);
+	}
+
+	if (UFarmSaveSubsystem* FarmSave = UFarmSaveSubsystem::Get(this))
+	{
+		FarmSave->UnregisterPlot(this, EndPlayReason);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void ASoilPlot::Initialize(USoilContainerDataAsset* InContainerData, USoilDataAsset* InSoilData)
@@ -100,6 +136,7 @@ void ASoilPlot::InitializeSoil(USoilDataAsset* InSoilData)
 	{
 		if (InSoilData->SoilMaterial && SoilMeshComponent)
 		{
+			LLM_SCOPE_BYTAG(Farm_Materials);
 			DynamicSoilMaterial = UMaterialInstanceDynamic::Create(InSoilData->SoilMaterial, this);
 			if (DynamicSoilMaterial)
 			{
@@ -123,6 +160,8 @@ void ASoilPlot::InitializeSoil(USoilDataAsset* InSoilData)
 	}
 
 	UpdateVisuals();
+	MarkFarmStateDirty();
+	JournalFarmState();
 }
 
 bool ASoilPlot::InteractTool_Implementation(EToolType ToolType, AActor* Interactor, float ToolPower)
@@ -158,6 +197,7 @@ bool ASoilPlot::InteractTool_Implementation(EToolType ToolType, AActor* Interact
 		if (SoilComponent->HasSoil() && SoilComponent->IsTilled())
 		{
 			SoilComponent->AddWater(ToolPower);
+			JournalFarmState();
 			bSuccess = true;
 		}
 		else
@@ -266,27 +306,34 @@ bool ASoilPlot::PlantSeed_Implementation(UCropDataAsset* CropToPlant, AActor* Pl
 
 FText ASoilPlot::GetInteractionText_Implementation() const
 {
+	// Built once; tooltips and prompts ask for this every frame
+	static const FText SoilText = NSLOCTEXT("SoilPlot", "Soil", "Soil");
+	static const FText EmptyPlotText = NSLOCTEXT("SoilPlot", "EmptyPlot", "Empty Plot");
+	static const FText TillSoilText = NSLOCTEXT("SoilPlot", "TillSoil", "Till Soil");
+	static const FText RemoveCropText = NSLOCTEXT("SoilPlot", "RemoveCrop", "Remove Crop");
+	static const FText PlantSeedText = NSLOCTEXT("SoilPlot", "PlantSeed", "Plant Seed");
+
 	if (!SoilComponent)
 	{
-		return FText::FromString("Soil");
+		return SoilText;
 	}
 
 	if (!SoilComponent->HasSoil())
 	{
-		return FText::FromString("Empty Plot");
+		return EmptyPlotText;
 	}
 
 	if (!SoilComponent->IsTilled())
 	{
-		return FText::FromString("Till Soil");
+		return TillSoilText;
 	}
 
 	if (SoilComponent->GetCrop())
 	{
-		return FText::FromString("Remove Crop");
+		return RemoveCropText;
 	}
 
-	return FText::FromString("Plant Seed");
+	return PlantSeedText;
 }
 
 bool ASoilPlot::CanInteractWithTool_Implementation(EToolType ToolType, AActor* Interactor) const
@@ -350,6 +397,9 @@ ACropBase* ASoilPlot::SpawnCrop(UCropDataAsset* CropData)
 	FVector SpawnLocation = CropSpawnPoint->GetComponentLocation();
 	FRotator SpawnRotation = CropSpawnPoint->GetComponentRotation();
 
+	LLM_SCOPE_BYTAG(Farm_Crops);
+	FARM_INC_COUNTER(STAT_FarmActorsSpawned, ActorSpawnCount);
+	FARM_HITCH_SCOPE(Spawn, CropActorClass);
 	ACropBase* NewCrop = GetWorld()->SpawnActor<ACropBase>(CropActorClass, SpawnLocation, SpawnRotation);
 	if (NewCrop)
 	{
@@ -366,6 +416,11 @@ void ASoilPlot::UpdateVisuals()
 		return;
 	}
 
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmPlotVisuals, "ASoilPlot::UpdateVisuals");
+	// Material and mesh updates go through the renderer, which allocates
+	FARM_ALLOCATION_GUARD_EXEMPT();
+	FScopedFarmSimTiming VisualTiming(&FFarmSimTimings::VisualCycles, &FFarmSimTimings::VisualCount);
+
 	if (!SoilComponent->HasSoil())
 	{
 		SoilMeshComponent->SetVisibility(false);
@@ -402,26 +457,292 @@ void ASoilPlot::UpdateVisuals()
 void ASoilPlot::OnSoilTilled(AActor* Soil)
 {
 	UpdateVisuals();
+	MarkFarmStateDirty();
+	JournalFarmState();
 }
 
 void ASoilPlot::OnCropPlanted(AActor* Soil, ACropBase* Crop)
 {
+	if (Crop && Crop->GetGrowthComponent())
+	{
+		UCropGrowthComponent* GrowthComp = Crop->GetGrowthComponent();
+		GrowthComp->OnCropWithered.AddUniqueDynamic(this, &ASoilPlot::OnCropGrowthStateChanged);
+		GrowthComp->OnCropFullyGrown.AddUniqueDynamic(this, &ASoilPlot::OnCropGrowthStateChanged);
+	}
+
 	UpdateVisuals();
+	MarkFarmStateDirty();
+	JournalFarmState();
 }
 
 void ASoilPlot::OnCropRemoved(AActor* Soil)
 {
 	UpdateVisuals();
+	MarkFarmStateDirty();
+	JournalFarmState();
 }
 
 void ASoilPlot::OnWaterLevelChanged(AActor* Soil, float NewWaterLevel)
 {
 	UpdateVisuals();
+
+	// Evaporation reports every small step; only a change clients would see is queued
+	if (GetQuantizedWaterLevel() != MarkedWaterLevel)
+	{
+		MarkFarmStateDirty();
+	}
 }
 
 void ASoilPlot::OnSoilStateChanged(AActor* Soil, ESoilState NewState)
 {
 	UpdateVisuals();
+	MarkFarmStateDirty();
+}
+
+void ASoilPlot::OnCropGrowthStateChanged(AActor* Crop)
+{
+	MarkFarmStateDirty();
+	JournalFarmState();
+}
+
+void ASoilPlot::MarkFarmStateDirty()
+{
+	MarkedWaterLevel = GetQuantizedWaterLevel();
+
+	// Level plots start out identical on every machine, so only changes after BeginPlay are replicated
+	if (!bReplicateFarmState || !HasActorBegunPlay())
+	{
+		return;
+	}
+
+	if (UFarmReplicationSubsystem* FarmReplication = UFarmReplicationSubsystem::Get(this))
+	{
+		FarmReplication->MarkPlotDirty(this);
+	}
+}
+
+uint8 ASoilPlot::GetQuantizedWaterLevel() const
+{
+	const USoilDataAsset* SoilData = SoilComponent ? SoilComponent->GetSoilData() : nullptr;
+	if (!SoilData || SoilData->MaxWaterLevel <= 0.0f)
+	{
+		return 0;
+	}
+
+	return FFarmPlotRecord::QuantizeUnit(SoilComponent->GetWaterLevel() / SoilData->MaxWaterLevel);
+}
+
+void ASoilPlot::JournalFarmState()
+{
+	if (!bReplicateFarmState || !HasActorBegunPlay())
+	{
+		return;
+	}
+
+	if (UFarmSaveSubsystem* FarmSave = UFarmSaveSubsystem::Get(this))
+	{
+		FarmSave->JournalPlot(this);
+	}
+}
+
+FRandomStream& ASoilPlot::GetRandomStream()
+{
+	if (!bRandomStreamSeeded)
+	{
+		const UFarmSimulationSubsystem* Simulation = UFarmSimulationSubsystem::Get(this);
+		RandomStream.Initialize(Simulation ? Simulation->GetPlotSeed(GetActorLocation()) : FMath::Rand());
+		bRandomStreamSeeded = true;
+	}
+
+	return RandomStream;
+}
+
+FFarmPlotRecord ASoilPlot::BuildReplicationRecord(float ServerTime) const
+{
+	FFarmPlotRecord Record;
+	Record.Location = GetActorLocation();
+	Record.Yaw = FRotator::CompressAxisToByte(GetActorRotation().Yaw);
+	Record.PlotClass = GetClass();
+	Record.ContainerData = ContainerDataAsset;
+	Record.SampleServerTime = ServerTime;
+
+	if (!SoilComponent)
+	{
+		return Record;
+	}
+
+	Record.SoilData = SoilComponent->GetSoilData();
+	Record.SetFlag(EFarmPlotFlags::HasSoil, SoilComponent->HasSoil());
+	Record.SetFlag(EFarmPlotFlags::Tilled, SoilComponent->IsTilled());
+
+	Record.WaterLevel = GetQuantizedWaterLevel();
+
+	const ACropBase* Crop = SoilComponent->GetCrop();
+	const UCropGrowthComponent* GrowthComp = Crop ? Crop->GetGrowthComponent() : nullptr;
+	if (GrowthComp)
+	{
+		const float Progress = GrowthComp->GetGrowthProgress();
+		const float GrowthRate = GrowthComp->GetGrowthRate();
+		const bool bWithered = GrowthComp->IsWithered();
+
+		Record.CropData = Crop->GetCropData();
+		Record.GrowthProgress = FFarmPlotRecord::QuantizeUnit(Progress);
+		Record.SetFlag(EFarmPlotFlags::HasCrop, true);
+		Record.SetFlag(EFarmPlotFlags::Withered, bWithered);
+		Record.SetFlag(EFarmPlotFlags::Growing, !bWithered && Progress < 1.0f && SoilComponent->HasWater());
+
+		if (GrowthRate > 0.0f)
+		{
+			Record.FullGrowthSeconds = static_cast<uint16>(FMath::Clamp<int32>(FMath::RoundToInt(1.0f / GrowthRate), 1, MAX_uint16));
+		}
+	}
+
+	return Record;
+}
+
+void ASoilPlot::ApplyReplicationRecord(const FFarmPlotRecord& Record)
+{
+	if (!SoilComponent)
+	{
+		return;
+	}
+
+	if (Record.ContainerData != ContainerDataAsset || Record.SoilData != SoilComponent->GetSoilData())
+	{
+		// Re-initializing the soil forgets the crop, so the old crop actor has to go first
+		if (ACropBase* OldCrop = SoilComponent->GetCrop())
+		{
+			SoilComponent->RemoveCrop();
+			OldCrop->Destroy();
+		}
+		Initialize(Record.ContainerData, Record.SoilData);
+	}
+
+	const float MaxWaterLevel = SoilDataAsset ? SoilDataAsset->MaxWaterLevel : 0.0f;
+	SoilComponent->ApplyReplicatedState(Record.HasFlag(EFarmPlotFlags::Tilled), FFarmPlotRecord::DequantizeUnit(Record.WaterLevel) * MaxWaterLevel);
+
+	ACropBase* Crop = SoilComponent->GetCrop();
+	if (Crop && (!Record.HasFlag(EFarmPlotFlags::HasCrop) || Crop->GetCropData() != Record.CropData))
+	{
+		SoilComponent->RemoveCrop();
+		Crop->Destroy();
+		Crop = nullptr;
+	}
+
+	if (!Record.HasFlag(EFarmPlotFlags::HasCrop) || !Record.CropData)
+	{
+		return;
+	}
+
+	if (!Crop)
+	{
+		Crop = SpawnCrop(Record.CropData);
+		if (!Crop)
+		{
+			return;
+		}
+		SoilComponent->SetCrop(Crop);
+	}
+
+	if (UCropGrowthComponent* GrowthComp = Crop->GetGrowthComponent())
+	{
+		const float GrowthRate = Record.FullGrowthSeconds > 0 ? 1.0f / Record.FullGrowthSeconds : 0.0f;
+		GrowthComp->ApplyReplicatedState(
+			FFarmPlotRecord::DequantizeUnit(Record.GrowthProgress),
+			GrowthRate,
+			Record.SampleServerTime,
+			Record.HasFlag(EFarmPlotFlags::Growing),
+			Record.HasFlag(EFarmPlotFlags::Withered)
+		);
+	}
+}
+
+FFarmPlotSaveRecord ASoilPlot::BuildSaveRecord(TFunctionRef<uint16(const UObject*)> GetPaletteIndex) const
+{
+	FFarmPlotSaveRecord Record;
+	Record.Location = FVector3f(GetActorLocation());
+	Record.Yaw = GetActorRotation().Yaw;
+	Record.PlotClass = GetPaletteIndex(GetClass());
+	Record.ContainerData = GetPaletteIndex(ContainerDataAsset);
+
+	if (!SoilComponent)
+	{
+		return Record;
+	}
+
+	EFarmPlotFlags Flags = EFarmPlotFlags::None;
+	if (SoilComponent->HasSoil())
+	{
+		Flags |= EFarmPlotFlags::HasSoil;
+	}
+	if (SoilComponent->IsTilled())
+	{
+		Flags |= EFarmPlotFlags::Tilled;
+	}
+
+	Record.SoilData = GetPaletteIndex(SoilComponent->GetSoilData());
+	Record.WaterLevel = SoilComponent->GetWaterLevel();
+
+	const ACropBase* Crop = SoilComponent->GetCrop();
+	const UCropGrowthComponent* GrowthComp = Crop ? Crop->GetGrowthComponent() : nullptr;
+	if (GrowthComp)
+	{
+		Flags |= EFarmPlotFlags::HasCrop;
+		if (GrowthComp->IsWithered())
+		{
+			Flags |= EFarmPlotFlags::Withered;
+		}
+
+		Record.CropData = GetPaletteIndex(Crop->GetCropData());
+		Record.GrowthProgress = GrowthComp->GetGrowthProgress();
+		Record.TimeWithoutWater = GrowthComp->GetTimeWithoutWater();
+	}
+
+	Record.Flags = static_cast<uint8>(Flags);
+	return Record;
+}
+
+void ASoilPlot::ApplySaveRecord(const FFarmPlotSaveRecord& Record, const FFarmSaveSnapshot& Snapshot)
+{
+	if (!SoilComponent)
+	{
+		return;
+	}
+
+	const EFarmPlotFlags Flags = static_cast<EFarmPlotFlags>(Record.Flags);
+
+	// Re-initializing the soil forgets the crop, so the old crop actor has to go first
+	if (ACropBase* OldCrop = SoilComponent->GetCrop())
+	{
+		SoilComponent->RemoveCrop();
+		OldCrop->Destroy();
+	}
+
+	USoilContainerDataAsset* SavedContainer = Cast<USoilContainerDataAsset>(Snapshot.GetPaletteAsset(Record.ContainerData).ResolveObject());
+	USoilDataAsset* SavedSoil = Cast<USoilDataAsset>(Snapshot.GetPaletteAsset(Record.SoilData).ResolveObject());
+	Initialize(SavedContainer ? SavedContainer : ContainerDataAsset.Get(), SavedSoil);
+
+	SoilComponent->RestoreSavedState(EnumHasAnyFlags(Flags, EFarmPlotFlags::Tilled), Record.WaterLevel);
+
+	if (!EnumHasAnyFlags(Flags, EFarmPlotFlags::HasCrop))
+	{
+		return;
+	}
+
+	UCropDataAsset* SavedCrop = Cast<UCropDataAsset>(Snapshot.GetPaletteAsset(Record.CropData).ResolveObject());
+	ACropBase* Crop = SpawnCrop(SavedCrop);
+	if (!Crop)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ASoilPlot::ApplySaveRecord: Failed to restore crop '%s'"), *Snapshot.GetPaletteAsset(Record.CropData).ToString());
+		return;
+	}
+
+	SoilComponent->SetCrop(Crop);
+
+	if (UCropGrowthComponent* GrowthComp = Crop->GetGrowthComponent())
+	{
+		GrowthComp->RestoreSavedState(Record.GrowthProgress, EnumHasAnyFlags(Flags, EFarmPlotFlags::Withered), Record.TimeWithoutWater);
+	}
 }
 
 bool ASoilPlot::CanAcceptSoilBag_Implementation(UItemDataAsset* SoilBagItem) const
@@ -14,6 +14,9 @@ class USoilContainerDataAsset;
 class ACropBase;
 class UCropDataAsset;
 class UMaterialInstanceDynamic;
+struct FFarmPlotRecord;
+struct FFarmPlotSaveRecord;
+struct FFarmSaveSnapshot;
 
 /**
  * Actor representing a plot of soil that can be tilled, watered, and have crops planted on it.
@@ -28,6 +31,7 @@ public:
 	ASoilPlot();
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	// IFarmableInterface implementation
 	virtual bool InteractTool_Implementation(EToolType ToolType, AActor* Instigator, float ToolPower) override;
@@ -66,7 +70,76 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Soil Plot")
 	USoilComponent* GetSoilComponent() const { return SoilComponent; }
 
+	/**
+	 * Enable or disable network replication of this plot's farm state.
+	 * Disable before initializing plots that only exist locally, such as placement previews.
+	 * @param bEnabled Whether state changes should be replicated
+	 */
+	void SetReplicateFarmState(bool bEnabled) { bReplicateFarmState = bEnabled; }
+
+	/**
+	 * Check whether this plot's farm state is replicated.
+	 * @return True unless disabled with SetReplicateFarmState
+	 */
+	bool ShouldReplicateFarmState() const { return bReplicateFarmState; }
+
+	/**
+	 * Server: sample the current state of this plot as a quantized replication record.
+	 * @param ServerTime Server world time to stamp the growth sample with
+	 * @return The sampled record, without a plot key
+	 */
+	FFarmPlotRecord BuildReplicationRecord(float ServerTime) const;
+
+	/**
+	 * Client: bring this plot and its crop in line with a replicated record.
+	 * @param Record The replicated plot state
+	 */
+	void ApplyReplicationRecord(const FFarmPlotRecord& Record);
+
+	/**
+	 * Authority: capture the full simulated state of this plot for a save.
+	 * @param GetPaletteIndex Maps a referenced asset or class to its save palette index
+	 * @return The saved record
+	 */
+	FFarmPlotSaveRecord BuildSaveRecord(TFunctionRef<uint16(const UObject*)> GetPaletteIndex) const;
+
+	/**
+	 * Authority: restore this plot and its crop from a save, replacing any existing crop.
+	 * Assets referenced by the record must already be loaded.
+	 * @param Record The saved record
+	 * @param Snapshot The save the record belongs to, for resolving palette indices
+	 */
+	void ApplySaveRecord(const FFarmPlotSaveRecord& Record, const FFarmSaveSnapshot& Snapshot);
+
+	/**
+	 * Get the random stream for this plot's simulation, such as harvest yield rolls.
+	 * Seeded on first use from the simulation seed and the plot location, see UFarmSimulationSubsystem::GetPlotSeed.
+	 * @return The plot's random stream
+	 */
+	FRandomStream& GetRandomStream();
+
+	/** Reseed the random stream on its next use */
+	void ResetRandomStream() { bRandomStreamSeeded = false; }
+
 protected:
+	/** Queue this plot's state for replication after a change */
+	void MarkFarmStateDirty();
+
+	/**
+	 * Get the water level as FFarmPlotRecord sends it.
+	 * @return Water level as a fraction of the soil's capacity, 0-255 maps to 0-1
+	 */
+	uint8 GetQuantizedWaterLevel() const;
+
+	/** Record a player-driven change in the save journal */
+	void JournalFarmState();
+
+	/**
+	 * Handler for crop withered and fully grown delegates, which change whether the crop is growing.
+	 */
+	UFUNCTION()
+	void OnCropGrowthStateChanged(AActor* Crop);
+
 	/**
 	 * Update visual representation based on soil state.
 	 * Called when soil is tilled or water level changes.
@@ -160,4 +233,17 @@ protected:
 	/** Class of crop actor to spawn when planting */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Soil Plot")
 	TSubclassOf<ACropBase> CropActorClass;
+
+private:
+	/** Whether state changes are sent to clients through UFarmReplicationSubsystem */
+	bool bReplicateFarmState = true;
+
+	/** Quantized water level when the plot was last marked dirty; changes that round to it are not queued */
+	uint8 MarkedWaterLevel = 0;
+
+	/** Random stream for this plot's simulation */
+	FRandomStream RandomStream;
+
+	/** Whether RandomStream has been seeded since the last reset */
+	bool bRandomStreamSeeded = false;
 };
\ No newline at end of file
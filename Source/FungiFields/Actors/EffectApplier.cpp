@@ -8,7 +8,7 @@
 
 AEffectApplier::AEffectApplier()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bCanEverTick = false;
 }
 
 void AEffectApplier::BeginPlay()
@@ -1,13 +1,12 @@
 #include "InteractableActor.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/WidgetComponent.h"
+#include "../Subsystems/UInteractionPromptSubsystem.h"
 #include "../Widgets/InteractionWidget.h"
-#include "Kismet/GameplayStatics.h"
-#include "Camera/PlayerCameraManager.h"
 
 AInteractableActor::AInteractableActor()
 {
-    PrimaryActorTick.bCanEverTick = true;
+    PrimaryActorTick.bCanEverTick = false;
     SetRootComponent(RootComponent);
 
     Mesh = CreateDefaultSubobject<UStaticMeshComponent>("Mesh");
@@ -15,10 +14,7 @@ AInteractableActor::AInteractableActor()
     
     Widget = CreateDefaultSubobject<UWidgetComponent>("Widget");
     Widget->SetupAttachment(Mesh);
-    Widget->SetWidgetSpace(EWidgetSpace::World);
-    Widget->SetDrawAtDesiredSize(true);
-    Widget->SetPivot(FVector2D(0.5f, 0.5f));
-    Widget->SetTwoSided(true);
+    Widget->PrimaryComponentTick.bCanEverTick = false;
     Widget->SetVisibility(false);
 }
 
@@ -26,49 +22,20 @@ void AInteractableActor::BeginPlay()
 {
     Super::BeginPlay();
 
-    if (WidgetClass)
+    if (UInteractionPromptSubsystem* PromptSubsystem = UInteractionPromptSubsystem::Get(this))
     {
-        Widget->SetWidgetClass(WidgetClass);
+        PromptSubsystem->RegisterInteractable(this);
     }
-
-    UpdateWidgetTransform();
 }
 
-void AInteractableActor::Tick(float DeltaSeconds)
+void AInteractableActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    Super::Tick(DeltaSeconds);
-
-    UpdateWidgetTransform();
-
-    if (bFacePlayerCamera)
+    if (UInteractionPromptSubsystem* PromptSubsystem = UInteractionPromptSubsystem::Get(this))
     {
-        BillboardToCamera();
+        PromptSubsystem->UnregisterInteractable(this);
     }
-}
-
-void AInteractableActor::UpdateWidgetTransform() const
-{
-    const FVector BaseLoc = GetActorLocation();
-    Widget->SetWorldLocation(BaseLoc + FVector(0.f, 0.f, WidgetHeightOffset));
-}
 
-void AInteractableActor::BillboardToCamera()
-{
-    APlayerController* PC = UGameplayStatics::GetPlayerController(this, 0);
-    if (!PC) return;
-
-    APlayerCameraManager* PCM = PC->PlayerCameraManager;
-    if (!PCM) return;
-
-    const FVector CamLoc = PCM->GetCameraLocation();
-    const FVector WidgetLoc = Widget->GetComponentLocation();
-    const FRotator LookAtRot = (CamLoc - WidgetLoc).Rotation();
-    Widget->SetWorldRotation(FRotator(0.f, LookAtRot.Yaw + 180.f, 0.f));
-}
-
-UInteractionWidget* AInteractableActor::GetInteractionWidget() const
-{
-    return Cast<UInteractionWidget>(Widget->GetUserWidgetObject());
+    Super::EndPlay(EndPlayReason);
 }
 
 FText AInteractableActor::GetInteractionText_Implementation()
@@ -9,6 +9,10 @@ class UWidgetComponent;
 class UInteractionWidget;
 class UStaticMeshComponent;
 
+/**
+ * Actor the player can interact with. It does not tick: its prompt is drawn in screen space by
+ * UInteractionPromptSubsystem when it is in focus or near the interactable that is.
+ */
 UCLASS()
 class AInteractableActor : public AActor, public IInteractableInterface
 {
@@ -17,8 +21,6 @@ class AInteractableActor : public AActor, public IInteractableInterface
 public:
 	AInteractableActor();
 
-	virtual void Tick(float DeltaSeconds) override;
-
 	// Interaction interface
 	virtual void Interact_Implementation(AActor* Interactor) override;
 	virtual FText GetInteractionText_Implementation() override;
@@ -26,13 +28,21 @@ public:
 	// ITooltipProvider implementation
 	virtual FText GetTooltipText_Implementation() const override;
 
-protected:
-	virtual void BeginPlay() override;
+	/**
+	 * Get where the interaction prompt is anchored.
+	 * @return World location WidgetHeightOffset above the actor
+	 */
+	FVector GetPromptLocation() const { return GetActorLocation() + FVector(0.f, 0.f, WidgetHeightOffset); }
 
-	void UpdateWidgetTransform() const;
-	void BillboardToCamera();
+	/**
+	 * Get the prompt widget for this interactable.
+	 * @return WidgetClass, or nullptr to use the interacting player's default prompt
+	 */
+	TSubclassOf<UInteractionWidget> GetPromptClass() const { return WidgetClass; }
 
-	UInteractionWidget* GetInteractionWidget() const;
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 protected:
 	UPROPERTY(VisibleAnywhere)
@@ -41,15 +51,15 @@ protected:
 	UPROPERTY(VisibleAnywhere)
 	UStaticMeshComponent* Mesh;
 
+	/** No longer drawn or ticked; kept so Blueprint subclasses that reference it still load */
 	UPROPERTY(VisibleAnywhere)
 	UWidgetComponent* Widget;
 
+	/** Prompt widget shown by UInteractionPromptSubsystem */
 	UPROPERTY(EditAnywhere)
 	TSubclassOf<UInteractionWidget> WidgetClass;
 
+	/** Height above the actor at which the prompt is anchored */
 	UPROPERTY(EditAnywhere)
 	float WidgetHeightOffset = 100.f;
-
-	UPROPERTY(EditAnywhere)
-	bool bFacePlayerCamera = true;
 };
@@ -1,6 +1,7 @@
 #include "InteractableItemPickup.h"
 #include "../Data/UItemDataAsset.h"
 #include "../Components/InventoryComponent.h"
+#include "../Subsystems/UFarmSimulationSubsystem.h"
 #include "Components/WidgetComponent.h"
 
 AInteractableItemPickup::AInteractableItemPickup()
@@ -82,6 +83,10 @@ void AInteractableItemPickup::TryPickupItem(AActor* PickerUpper)
 
 	if (bSuccess)
 	{
+		if (UFarmSimulationSubsystem* Simulation = UFarmSimulationSubsystem::Get(this))
+		{
+			Simulation->RecordItemAdded(Inventory, ItemDataAsset, ItemAmount);
+		}
 		Destroy();
 	}
 }
@@ -1,11 +1,15 @@
 #include "ItemPickup.h"
+#include "../FungiFieldsStats.h"
 #include "../Data/UItemDataAsset.h"
 #include "../Components/InventoryComponent.h"
+#include "../Subsystems/UFarmSimulationSubsystem.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/SphereComponent.h"
 
 AItemPickup::AItemPickup()
 {
+	LLM_SCOPE_BYTAG(Farm_Pickups);
+
 	PrimaryActorTick.bCanEverTick = false;
 
 	MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("MeshComponent"));
@@ -32,6 +36,10 @@ AItemPickup::AItemPickup()
 	
 	PickupSphere->SetSimulatePhysics(false);
 	PickupSphere->SetEnableGravity(false);
+
+	bReplicates = true;
+	SetReplicatingMovement(true);
+	NetCullDistanceSquared = FMath::Square(3000.0f);
 }
 
 void AItemPickup::BeginPlay()
@@ -72,7 +80,7 @@ void AItemPickup::OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActo
 
 void AItemPickup::TryPickupItem(AActor* PickerUpper)
 {
-	if (!PickerUpper || !ItemDataAsset)
+	if (!PickerUpper || !ItemDataAsset || !HasAuthority())
 	{
 		return;
 	}
@@ -85,6 +93,10 @@ void AItemPickup::TryPickupItem(AActor* PickerUpper)
 	
 	if (Inventory->TryAddItem(ItemDataAsset, ItemAmount))
 	{
+		if (UFarmSimulationSubsystem* Simulation = UFarmSimulationSubsystem::Get(this))
+		{
+			Simulation->RecordItemAdded(Inventory, ItemDataAsset, ItemAmount);
+		}
 		Destroy();
 	}
 }
@@ -11,6 +11,7 @@ class USphereComponent;
 /**
  * Actor that is automatically picked up when a player walks over it.
  * Uses overlap detection to trigger pickup when player enters the pickup radius.
+ * Replicated as a short-lived spatial actor: only nearby connections receive it, and dropped pickups expire.
  */
 UCLASS()
 class FUNGIFIELDS_API AItemPickup : public AActor
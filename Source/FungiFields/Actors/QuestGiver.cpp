@@ -6,7 +6,7 @@
 
 AQuestGiver::AQuestGiver()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bCanEverTick = false;
 }
 
 void AQuestGiver::BeginPlay()
@@ -16,16 +16,17 @@
 #include "../Attributes/LevelAttributeSet.h"
 #include "../Widgets/PlayerHUDWidget.h"
 #include "../Widgets/UBackpackWidget.h"
+#include "../Widgets/UFarmPerfOverlayWidget.h"
 #include "Blueprint/UserWidget.h"
 #include "FungiFields/Components/LevelComponent.h"
 #include "FungiFields/Components/QuestComponent.h"
 #include "FungiFields/Components/UFarmingComponent.h"
 #include "FungiFields/Components/UPlacementComponent.h"
+#include "FungiFields/Components/UUIManagerComponent.h"
 #include "FungiFields/Data/USoilDataAsset.h"
 #include "FungiFields/Data/USoilContainerDataAsset.h"
 #include "FungiFields/Data/UItemDataAsset.h"
-#include "AssetRegistry/AssetRegistryModule.h"
-#include "Engine/AssetManager.h"
+#include "FungiFields/Subsystems/UItemCatalogSubsystem.h"
 #include "Misc/CoreMiscDefines.h"
 
 DEFINE_LOG_CATEGORY(LogTemplateCharacter);
@@ -59,11 +60,13 @@ AFungiFieldsCharacter::AFungiFieldsCharacter()
 
 	InteractionComponent = CreateDefaultSubobject<UInteractionComponent>(TEXT("InteractionComponent"));
 	InventoryComponent = CreateDefaultSubobject<UInventoryComponent>(TEXT("InventoryComponent"));
+	InventoryComponent->SetEnableReplication(true);
 	AbilitySystemComponent = CreateDefaultSubobject<UAbilitySystemComponent>(TEXT("AbilitySystemComponent"));
 	QuestComponent = CreateDefaultSubobject<UQuestComponent>(TEXT("QuestComponent"));
 	LevelComponent = CreateDefaultSubobject<ULevelComponent>(TEXT("LevelComponent"));
 	FarmingComponent = CreateDefaultSubobject<UFarmingComponent>(TEXT("FarmingComponent"));
 	PlacementComponent = CreateDefaultSubobject<UPlacementComponent>(TEXT("PlacementComponent"));
+	UIManagerComponent = CreateDefaultSubobject<UUIManagerComponent>(TEXT("UIManagerComponent"));
 
 	CharacterAttributeSet = CreateDefaultSubobject<UCharacterAttributeSet>(TEXT("CharacterAttributeSet"));
 	EconomyAttributeSet   = CreateDefaultSubobject<UEconomyAttributeSet>(TEXT("EconomyAttributeSet"));
@@ -125,43 +128,21 @@ void AFungiFieldsCharacter::BeginPlay()
 			}
 		}
 	}
-	if (APlayerController* PC = Cast<APlayerController>(GetController()))
+	if (IsLocallyControlled() && UIManagerComponent)
 	{
-		if (HUDWidgetClass && IsPlayerControlled())
-		{
-
-			HUDWidget = CreateWidget<UPlayerHUDWidget>(GetWorld(), HUDWidgetClass);
-			if (HUDWidget)
-			{
-				HUDWidget->SetOwningPlayer(PC);
-				HUDWidget->AddToViewport();
-			}
-		}
+		// The HUD is on screen from spawn; menus are built in idle frames or when first opened
+		HUDWidget = UIManagerComponent->CreateMenu<UPlayerHUDWidget>(HUDWidgetClass);
+		UIManagerComponent->ShowMenu(HUDWidget);
 
-		if (QuestMenuClass)
+		UIManagerComponent->QueuePrewarm([this]()
 		{
-
-			QuestMenuWidget = CreateWidget<UQuestMenu>(GetWorld(), QuestMenuClass);
-			if (QuestMenuWidget)
-			{
-				QuestMenuWidget->SetOwningPlayer(PC);
-				QuestMenuWidget->AddToViewport();
-				QuestMenuWidget->SetVisibility(ESlateVisibility::Hidden);
-				QuestMenuWidget->OnQuestMenuClosed.AddDynamic(this, &AFungiFieldsCharacter::OnQuestMenuClosed);
-			}
-		}
-
-		if (BackpackWidgetClass)
+			UIManagerComponent->ConstructMenu(GetQuestMenu());
+		});
+		UIManagerComponent->QueuePrewarm([this]()
 		{
-			BackpackWidget = CreateWidget<UBackpackWidget>(GetWorld(), BackpackWidgetClass);
-			if (BackpackWidget)
-			{
-				BackpackWidget->SetOwningPlayer(PC);
-				BackpackWidget->AddToViewport();
-				BackpackWidget->SetVisibility(ESlateVisibility::Hidden);
-				BackpackWidget->OnBackpackClosed.AddDynamic(this, &AFungiFieldsCharacter::OnBackpackClosed);
-			}
-		}
+			UIManagerComponent->ConstructMenu(GetBackpack());
+		});
+		UIManagerComponent->QueueWidgetPoolPrewarm();
 	}
 
 	if (FollowCamera)
@@ -198,6 +179,45 @@ UAbilitySystemComponent* AFungiFieldsCharacter::GetAbilitySystemComponent() cons
 	return AbilitySystemComponent;
 }
 
+void AFungiFieldsCharacter::SetPerfOverlayVisible(bool bVisible)
+{
+	if (!bVisible)
+	{
+		if (PerfOverlayWidget)
+		{
+			PerfOverlayWidget->RemoveFromParent();
+		}
+		return;
+	}
+
+	APlayerController* PC = Cast<APlayerController>(GetController());
+	if (!PC || !IsLocallyControlled())
+	{
+		return;
+	}
+
+	if (!PerfOverlayWidget)
+	{
+		TSubclassOf<UFarmPerfOverlayWidget> OverlayClass = PerfOverlayClass ? PerfOverlayClass : TSubclassOf<UFarmPerfOverlayWidget>(UFarmPerfOverlayWidget::StaticClass());
+		PerfOverlayWidget = CreateWidget<UFarmPerfOverlayWidget>(PC, OverlayClass);
+		if (!PerfOverlayWidget)
+		{
+			return;
+		}
+	}
+
+	if (!PerfOverlayWidget->IsInViewport())
+	{
+		// Above the HUD, which is added at the default z-order
+		PerfOverlayWidget->AddToViewport(10);
+	}
+}
+
+bool AFungiFieldsCharacter::IsPerfOverlayVisible() const
+{
+	return PerfOverlayWidget && PerfOverlayWidget->IsInViewport();
+}
+
 void AFungiFieldsCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 {
 	if (APlayerController* PlayerController = Cast<APlayerController>(GetController()))
@@ -305,7 +325,7 @@ void AFungiFieldsCharacter::Look(const FInputActionValue& Value)
 
 void AFungiFieldsCharacter::ToggleQuestMenu(const FInputActionValue& Value)
 {
-	if (!QuestMenuWidget) 
+	if (!GetQuestMenu())
 	{
 		UE_LOG(LogTemp, Warning, TEXT("QuestMenuWidget not set!"));
 		return;
@@ -319,7 +339,7 @@ void AFungiFieldsCharacter::ToggleQuestMenu(const FInputActionValue& Value)
 	{
 		this->GetCharacterMovement()->StopMovementImmediately();
 		QuestMenuWidget->RefreshQuests();
-		QuestMenuWidget->SetVisibility(ESlateVisibility::Visible);
+		UIManagerComponent->ShowMenu(QuestMenuWidget);
 		bQuestMenuVisible = true;
 
 		FInputModeUIOnly Mode;
@@ -329,7 +349,7 @@ void AFungiFieldsCharacter::ToggleQuestMenu(const FInputActionValue& Value)
 	}
 	else
 	{
-		QuestMenuWidget->SetVisibility(ESlateVisibility::Hidden);
+		UIManagerComponent->HideMenu(QuestMenuWidget);
 		bQuestMenuVisible = false;
 		FInputModeGameOnly Mode;
 		PC->SetInputMode(Mode);
@@ -378,7 +398,7 @@ void AFungiFieldsCharacter::OnQuestMenuClosed()
 	if (!PC)
 		return;
 
-	QuestMenuWidget->SetVisibility(ESlateVisibility::Hidden);
+	UIManagerComponent->HideMenu(QuestMenuWidget);
 	bQuestMenuVisible = false;
 
 	FInputModeGameOnly Mode;
@@ -388,7 +408,7 @@ void AFungiFieldsCharacter::OnQuestMenuClosed()
 
 void AFungiFieldsCharacter::ToggleBackpack(const FInputActionValue& Value)
 {
-	if (!BackpackWidget) 
+	if (!GetBackpack())
 	{
 		UE_LOG(LogTemp, Warning, TEXT("BackpackWidget not set!"));
 		return;
@@ -401,15 +421,9 @@ void AFungiFieldsCharacter::ToggleBackpack(const FInputActionValue& Value)
 	if (!bBackpackVisible)
 	{
 		this->GetCharacterMovement()->StopMovementImmediately();
-		
-		if (!BackpackWidget->IsInViewport())
-		{
-			BackpackWidget->AddToViewport();
-		}
-		
+
+		UIManagerComponent->ShowMenu(BackpackWidget);
 		BackpackWidget->RefreshInventory();
-		
-		BackpackWidget->SetVisibility(ESlateVisibility::Visible);
 		bBackpackVisible = true;
 
 		FInputModeUIOnly Mode;
@@ -432,7 +446,7 @@ void AFungiFieldsCharacter::OnBackpackClosed()
 	if (!PC)
 		return;
 
-	BackpackWidget->SetVisibility(ESlateVisibility::Hidden);
+	UIManagerComponent->HideMenu(BackpackWidget);
 	bBackpackVisible = false;
 	FInputModeGameOnly Mode;
 	PC->SetInputMode(Mode);
@@ -467,10 +481,26 @@ void AFungiFieldsCharacter::OnSoilPlotPickedUp(AActor* Picker, USoilDataAsset* S
 	}
 	else
 	{
-		UItemDataAsset* FoundItem = FindItemDataAssetBySoilData(SoilData);
-		if (FoundItem)
+		UItemCatalogSubsystem* Catalog = UItemCatalogSubsystem::Get(this);
+		if (Catalog && !Catalog->IsReverseIndexComplete())
+		{
+			// Assets saved without catalog tags are indexed in the background; pick up once they are
+			TWeakObjectPtr<AActor> WeakPicker(Picker);
+			TWeakObjectPtr<USoilDataAsset> WeakSoil(SoilData);
+			Catalog->CallWhenReverseIndexComplete(FSimpleDelegate::CreateWeakLambda(this, [this, WeakPicker, WeakSoil]()
+			{
+				if (USoilDataAsset* SoilAsset = WeakSoil.Get())
+				{
+					OnSoilPlotPickedUp(WeakPicker.Get(), SoilAsset);
+				}
+			}));
+			return;
+		}
+
+		const int32 ItemId = Catalog ? Catalog->FindPlaceableItemForSoil(SoilData) : INDEX_NONE;
+		if (ItemId != INDEX_NONE)
 		{
-			InventoryComponent->TryAddItem(FoundItem, 1);
+			Catalog->LoadItemAsync(ItemId, FOnCatalogItemLoaded::CreateUObject(this, &AFungiFieldsCharacter::AddPickedUpItem));
 		}
 		else
 		{
@@ -507,10 +537,26 @@ void AFungiFieldsCharacter::OnContainerPickedUp(AActor* Picker, USoilContainerDa
 	}
 	else
 	{
-		UItemDataAsset* FoundItem = FindItemDataAssetByContainerData(ContainerData);
-		if (FoundItem)
+		UItemCatalogSubsystem* Catalog = UItemCatalogSubsystem::Get(this);
+		if (Catalog && !Catalog->IsReverseIndexComplete())
+		{
+			// Assets saved without catalog tags are indexed in the background; pick up once they are
+			TWeakObjectPtr<AActor> WeakPicker(Picker);
+			TWeakObjectPtr<USoilContainerDataAsset> WeakContainer(ContainerData);
+			Catalog->CallWhenReverseIndexComplete(FSimpleDelegate::CreateWeakLambda(this, [this, WeakPicker, WeakContainer]()
+			{
+				if (USoilContainerDataAsset* ContainerAsset = WeakContainer.Get())
+				{
+					OnContainerPickedUp(WeakPicker.Get(), ContainerAsset);
+				}
+			}));
+			return;
+		}
+
+		const int32 ItemId = Catalog ? Catalog->FindItemForContainer(ContainerData) : INDEX_NONE;
+		if (ItemId != INDEX_NONE)
 		{
-			InventoryComponent->TryAddItem(FoundItem, 1);
+			Catalog->LoadItemAsync(ItemId, FOnCatalogItemLoaded::CreateUObject(this, &AFungiFieldsCharacter::AddPickedUpItem));
 		}
 		else
 		{
@@ -519,54 +565,46 @@ void AFungiFieldsCharacter::OnContainerPickedUp(AActor* Picker, USoilContainerDa
 	}
 }
 
-UItemDataAsset* AFungiFieldsCharacter::FindItemDataAssetByContainerData(USoilContainerDataAsset* ContainerData) const
+void AFungiFieldsCharacter::AddPickedUpItem(UItemDataAsset* Item)
 {
-	if (!ContainerData)
+	if (!Item)
 	{
-		return nullptr;
+		UE_LOG(LogTemp, Error, TEXT("AFungiFieldsCharacter::AddPickedUpItem: The picked up item failed to load and was not added to the inventory"));
+		return;
 	}
 
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
-	TArray<FAssetData> AssetDataList;
-	AssetRegistry.GetAssetsByClass(UItemDataAsset::StaticClass()->GetClassPathName(), AssetDataList, true);
-
-	for (const FAssetData& AssetData : AssetDataList)
+	if (!InventoryComponent)
 	{
-		if (UItemDataAsset* ItemAsset = Cast<UItemDataAsset>(AssetData.GetAsset()))
-		{
-			if (ItemAsset && ItemAsset->bIsPlaceable && ItemAsset->PlaceableContainerDataAsset == ContainerData)
-			{
-				return ItemAsset;
-			}
-		}
+		return;
 	}
 
-	return nullptr;
+	InventoryComponent->TryAddItem(Item, 1);
 }
 
-UItemDataAsset* AFungiFieldsCharacter::FindItemDataAssetBySoilData(USoilDataAsset* SoilData) const
+UQuestMenu* AFungiFieldsCharacter::GetQuestMenu()
 {
-	if (!SoilData)
+	if (!QuestMenuWidget && UIManagerComponent)
 	{
-		return nullptr;
+		QuestMenuWidget = UIManagerComponent->CreateMenu<UQuestMenu>(QuestMenuClass);
+		if (QuestMenuWidget)
+		{
+			QuestMenuWidget->OnQuestMenuClosed.AddDynamic(this, &AFungiFieldsCharacter::OnQuestMenuClosed);
+		}
 	}
 
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
-
-	TArray<FAssetData> AssetDataList;
-	AssetRegistry.GetAssetsByClass(UItemDataAsset::StaticClass()->GetClassPathName(), AssetDataList, true);
+	return QuestMenuWidget;
+}
 
-	for (const FAssetData& AssetData : AssetDataList)
+UBackpackWidget* AFungiFieldsCharacter::GetBackpack()
+{
+	if (!BackpackWidget && UIManagerComponent)
 	{
-		UItemDataAsset* ItemAsset = Cast<UItemDataAsset>(AssetData.GetAsset());
-		
-		if (ItemAsset && ItemAsset->bIsPlaceable && ItemAsset->PlaceableSoilDataAsset == SoilData)
+		BackpackWidget = UIManagerComponent->CreateMenu<UBackpackWidget>(BackpackWidgetClass);
+		if (BackpackWidget)
 		{
-			return ItemAsset;
+			BackpackWidget->OnBackpackClosed.AddDynamic(this, &AFungiFieldsCharacter::OnBackpackClosed);
 		}
 	}
 
-	return nullptr;
+	return BackpackWidget;
 }
@@ -17,11 +17,13 @@ class UAbilitySystemComponent;
 class UCharacterAttributeSet;
 class UEconomyAttributeSet;
 class UPlayerHUDWidget;
+class UFarmPerfOverlayWidget;
 class ULevelComponent;
 class UGameplayEffect;
 class UQuestComponent;
 class ULevelAttributeSet;
 class UFarmingComponent;
+class UUIManagerComponent;
 struct FInputActionValue;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogTemplateCharacter, Log, All);
@@ -62,6 +64,10 @@ public:
 	/** Placement component for handling placeable items */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Placement", meta = (AllowPrivateAccess = "true"))
 	class UPlacementComponent* PlacementComponent;
+
+	/** UI manager creating menus on demand and prewarming them in idle frames */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "UI", meta = (AllowPrivateAccess = "true"))
+	UUIManagerComponent* UIManagerComponent;
 	
 	/** Ability System Component. Required to use Gameplay Attributes and Gameplay Abilities. */
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Abilities", meta = (AllowPrivateAccess = "true"))
@@ -175,11 +181,19 @@ public:
 	UPROPERTY()
 	TObjectPtr<UPlayerHUDWidget> HUDWidget;
 
-	/** Instance of the Quest Menu widget */
+	/** Farm performance overlay class; the C++ overlay is used if unset */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "UI")
+	TSubclassOf<UFarmPerfOverlayWidget> PerfOverlayClass;
+
+	/** Instance of the performance overlay, created the first time it is shown */
+	UPROPERTY()
+	TObjectPtr<UFarmPerfOverlayWidget> PerfOverlayWidget;
+
+	/** Instance of the Quest Menu widget, created the first time it is needed */
 	UPROPERTY()
 	TObjectPtr<UQuestMenu> QuestMenuWidget;
 
-	/** Instance of the Backpack widget */
+	/** Instance of the Backpack widget, created the first time it is needed */
 	UPROPERTY()
 	TObjectPtr<class UBackpackWidget> BackpackWidget;
 
@@ -219,20 +233,22 @@ protected:
 
 private:
 	/**
-	 * Find an ItemDataAsset that matches the given SoilDataAsset.
-	 * Searches through asset registry for placeable items.
-	 * @param SoilData The soil data asset to match
-	 * @return Matching ItemDataAsset, or nullptr if not found
+	 * Add a picked up placeable back to the inventory once the catalog has resolved it.
+	 * @param Item The resolved item, or nullptr if the load failed
 	 */
-	class UItemDataAsset* FindItemDataAssetBySoilData(class USoilDataAsset* SoilData) const;
+	void AddPickedUpItem(class UItemDataAsset* Item);
 
 	/**
-	 * Find an ItemDataAsset that matches the given ContainerDataAsset.
-	 * Searches through asset registry for placeable items.
-	 * @param ContainerData The container data asset to match
-	 * @return Matching ItemDataAsset, or nullptr if not found
+	 * Get the quest menu, creating it on first use.
+	 * @return The quest menu, or nullptr if there is no class or local player
 	 */
-	class UItemDataAsset* FindItemDataAssetByContainerData(class USoilContainerDataAsset* ContainerData) const;
+	UQuestMenu* GetQuestMenu();
+
+	/**
+	 * Get the backpack, creating it on first use.
+	 * @return The backpack, or nullptr if there is no class or local player
+	 */
+	class UBackpackWidget* GetBackpack();
 
 	// APawn interface
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
@@ -243,6 +259,12 @@ private:
 public:
 	virtual UAbilitySystemComponent* GetAbilitySystemComponent() const override;
 
+	/** Show or hide the farm performance overlay next to the HUD */
+	void SetPerfOverlayVisible(bool bVisible);
+
+	/** Whether the farm performance overlay is on screen */
+	bool IsPerfOverlayVisible() const;
+
 	/** Returns CameraBoom subobject **/
 	FORCEINLINE class USpringArmComponent* GetCameraBoom() const { return CameraBoom; }
 	/** Returns FollowCamera subobject **/
@@ -0,0 +1,45 @@
+#include "FBenchmarkWorld.h"
+#include "../Subsystems/UFarmSaveSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+FBenchmarkWorld::FBenchmarkWorld(const FString& WorldName)
+{
+	World = UWorld::CreateWorld(EWorldType::Game, false, *WorldName);
+	if (!World)
+	{
+		return;
+	}
+
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	if (UFarmSaveSubsystem* FarmSave = World->GetSubsystem<UFarmSaveSubsystem>())
+	{
+		FarmSave->SetAutosaveSuspended(true);
+	}
+
+	const FURL URL;
+	World->SetGameMode(URL);
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+}
+
+FBenchmarkWorld::~FBenchmarkWorld()
+{
+	if (!World)
+	{
+		return;
+	}
+
+	World->BeginTearingDown();
+	for (FActorIterator ActorIt(World); ActorIt; ++ActorIt)
+	{
+		ActorIt->RouteEndPlay(EEndPlayReason::Quit);
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+
+/**
+ * An empty game world for benchmarks, begun play on construction and torn down on destruction.
+ * Autosaves are suspended before play begins, so the world never loads or overwrites the player's farm.
+ */
+class FBenchmarkWorld
+{
+public:
+	/**
+	 * Create the world and begin play.
+	 * @param WorldName Name of the world, for logs
+	 */
+	explicit FBenchmarkWorld(const FString& WorldName);
+	~FBenchmarkWorld();
+
+	FBenchmarkWorld(const FBenchmarkWorld&) = delete;
+	FBenchmarkWorld& operator=(const FBenchmarkWorld&) = delete;
+
+	/**
+	 * Get the world.
+	 * @return The world, or nullptr if it could not be created
+	 */
+	UWorld* Get() const { return World; }
+
+private:
+	UWorld* World = nullptr;
+};
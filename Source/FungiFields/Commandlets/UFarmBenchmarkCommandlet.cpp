@@ -0,0 +1,348 @@
+#include "UFarmBenchmarkCommandlet.h"
+#include "FBenchmarkWorld.h"
+#include "../Actors/ASoilPlot.h"
+#include "../Data/UCropDataAsset.h"
+#include "../Data/USoilContainerDataAsset.h"
+#include "../Data/USoilDataAsset.h"
+#include "../ENUM/EToolType.h"
+#include "../Interfaces/IFarmableInterface.h"
+#include "../Subsystems/FFarmAllocationCounter.h"
+#include "../Subsystems/FFarmSimTimings.h"
+#include "../Subsystems/UCropManagerSubsystem.h"
+#include "../Subsystems/UFarmMemorySubsystem.h"
+#include "../Subsystems/UFarmSimulationSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace FarmBenchmark
+{
+	static double CyclesToMs(uint64 Cycles)
+	{
+		return FPlatformTime::ToMilliseconds64(Cycles);
+	}
+
+	static double UsedMemoryMB()
+	{
+		return static_cast<double>(FPlatformMemory::GetStats().UsedPhysical) / (1024.0 * 1024.0);
+	}
+}
+
+UFarmBenchmarkCommandlet::UFarmBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = true;
+	IsEditor = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UFarmBenchmarkCommandlet::Main(const FString& Params)
+{
+	TArray<int32> RunPlotCounts = PlotCounts;
+
+	FString PlotsParam;
+	if (FParse::Value(*Params, TEXT("Plots="), PlotsParam, false))
+	{
+		TArray<FString> Counts;
+		PlotsParam.ParseIntoArray(Counts, TEXT(","));
+
+		RunPlotCounts.Reset();
+		for (const FString& Count : Counts)
+		{
+			RunPlotCounts.Add(FCString::Atoi(*Count));
+		}
+	}
+
+	FParse::Value(*Params, TEXT("Seconds="), SimSeconds);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	FParse::Value(*Params, TEXT("Label="), Label);
+
+	if (!FParse::Value(*Params, TEXT("Output="), OutputPath))
+	{
+		OutputPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / FString::Printf(TEXT("FarmBenchmark_%s.csv"), *FDateTime::Now().ToString());
+	}
+
+	if (RunPlotCounts.Num() == 0 || CropData.Num() == 0 || SoilData.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UFarmBenchmarkCommandlet::Main: Plot counts, crops and soils must be configured"));
+		return 1;
+	}
+
+	TArray<FFarmBenchmarkResult> Results;
+	bool bOverBudget = false;
+	for (int32 PlotCount : RunPlotCounts)
+	{
+		if (PlotCount <= 0)
+		{
+			continue;
+		}
+
+		FFarmBenchmarkResult& Result = Results.AddDefaulted_GetRef();
+		if (!RunBenchmark(PlotCount, Result))
+		{
+			UE_LOG(LogTemp, Error, TEXT("UFarmBenchmarkCommandlet::Main: Run with %d plots failed"), PlotCount);
+			return 1;
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("UFarmBenchmarkCommandlet::Main: %d plots, %d crops: %.3f ms/step avg, %.3f max (growth %.3f, evaporation %.3f, events %.3f, visuals %.3f), %.1f MB, GC %.2f ms"),
+			Result.PlotCount, Result.CropCount, Result.AvgStepMs, Result.MaxStepMs, Result.GrowthMsPerStep, Result.EvaporationMsPerStep,
+			Result.EventMsPerStep, Result.VisualMsPerStep, Result.MemoryMB, Result.GCMs);
+
+		if (Result.GuardedAllocsPerStep > MaxGuardedAllocsPerStep)
+		{
+			UE_LOG(LogTemp, Error, TEXT("UFarmBenchmarkCommandlet::Main: %d plots: %.1f allocations per step in steady-state scopes, budget is %.1f"),
+				Result.PlotCount, Result.GuardedAllocsPerStep, MaxGuardedAllocsPerStep);
+			bOverBudget = true;
+		}
+
+		if (!Result.bWithinMemoryBudget)
+		{
+			UE_LOG(LogTemp, Error, TEXT("UFarmBenchmarkCommandlet::Main: %d plots: %lld bytes per plot and %lld bytes per crop, over the farm memory budget"),
+				Result.PlotCount, Result.MeasuredBytesPerPlot, Result.MeasuredBytesPerCrop);
+			bOverBudget = true;
+		}
+	}
+
+	WriteResults(Results);
+	return bOverBudget ? 1 : 0;
+}
+
+bool UFarmBenchmarkCommandlet::RunBenchmark(int32 PlotCount, FFarmBenchmarkResult& OutResult)
+{
+	OutResult.PlotCount = PlotCount;
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	const double MemoryBefore = FarmBenchmark::UsedMemoryMB();
+	const double SetupStart = FPlatformTime::Seconds();
+
+	// Scoped so the world is torn down before the next plot count runs
+	FBenchmarkWorld BenchmarkWorld(FString::Printf(TEXT("FarmBenchmark_%d"), PlotCount));
+	UWorld* World = BenchmarkWorld.Get();
+	if (!World)
+	{
+		return false;
+	}
+
+	UFarmSimulationSubsystem* Simulation = World->GetSubsystem<UFarmSimulationSubsystem>();
+	if (Simulation)
+	{
+		Simulation->EnableDeterministicMode(Seed);
+	}
+
+	TArray<ASoilPlot*> Plots;
+	SpawnPlots(World, PlotCount, Plots);
+
+	if (UCropManagerSubsystem* CropManager = World->GetSubsystem<UCropManagerSubsystem>())
+	{
+		OutResult.CropCount = CropManager->GetRegisteredCropCount();
+	}
+
+	OutResult.SetupMs = (FPlatformTime::Seconds() - SetupStart) * 1000.0;
+
+	const float StepSeconds = Simulation ? Simulation->GetFixedStepSeconds() : 1.0f;
+	const int32 StepCount = FMath::Max(1, FMath::CeilToInt(SimSeconds / StepSeconds));
+	const int32 WateredPerStep = FMath::Max(1, FMath::CeilToInt(Plots.Num() * StepSeconds / FMath::Max(WaterInterval, StepSeconds)));
+	int32 NextWateredPlot = 0;
+	uint64 WaterCycles = 0;
+	double TotalStepMs = 0.0;
+
+	FFarmSimTimings::Reset();
+	FFarmSimTimings::AddEnableRef();
+
+	const int32 GuardedFirstStep = FMath::Min(WarmUpSteps, StepCount - 1);
+	FScopedFarmAllocationGuard::ResetAllocationCount();
+
+	for (int32 Step = 0; Step < StepCount && Plots.Num() > 0; ++Step)
+	{
+		if (Step == GuardedFirstStep)
+		{
+			FScopedFarmAllocationGuard::SetEnabled(true);
+		}
+
+		const uint64 WaterStart = FPlatformTime::Cycles64();
+		for (int32 Watered = 0; Watered < WateredPerStep; ++Watered)
+		{
+			ASoilPlot* Plot = Plots[NextWateredPlot];
+			NextWateredPlot = (NextWateredPlot + 1) % Plots.Num();
+
+			if (IsValid(Plot))
+			{
+				IFarmableInterface::Execute_InteractTool(Plot, EToolType::WateringCan, nullptr, WaterAmount);
+			}
+		}
+		WaterCycles += FPlatformTime::Cycles64() - WaterStart;
+
+		const double TickStart = FPlatformTime::Seconds();
+		World->Tick(LEVELTICK_All, StepSeconds);
+		const double StepMs = (FPlatformTime::Seconds() - TickStart) * 1000.0;
+
+		TotalStepMs += StepMs;
+		OutResult.MaxStepMs = FMath::Max(OutResult.MaxStepMs, StepMs);
+	}
+
+	FFarmSimTimings::ReleaseEnableRef();
+	FScopedFarmAllocationGuard::SetEnabled(false);
+	OutResult.GuardedAllocsPerStep = static_cast<double>(FScopedFarmAllocationGuard::GetAllocationCount()) / FMath::Max(StepCount - GuardedFirstStep, 1);
+
+	const FFarmSimTimings& Timings = FFarmSimTimings::Get();
+
+	OutResult.Steps = StepCount;
+	OutResult.AvgStepMs = TotalStepMs / StepCount;
+	OutResult.GrowthMsPerStep = FarmBenchmark::CyclesToMs(Timings.GrowthCycles) / StepCount;
+	OutResult.EvaporationMsPerStep = FarmBenchmark::CyclesToMs(Timings.EvaporationCycles) / StepCount;
+	OutResult.EventMsPerStep = FarmBenchmark::CyclesToMs(Timings.EventCycles) / StepCount;
+	OutResult.VisualMsPerStep = FarmBenchmark::CyclesToMs(Timings.VisualCycles) / StepCount;
+	OutResult.WaterMsPerStep = FarmBenchmark::CyclesToMs(WaterCycles) / StepCount;
+	OutResult.EventsPerStep = static_cast<double>(Timings.EventCount) / StepCount;
+	OutResult.VisualUpdatesPerStep = static_cast<double>(Timings.VisualCount) / StepCount;
+
+	OutResult.MemoryMB = FMath::Max(0.0, FarmBenchmark::UsedMemoryMB() - MemoryBefore);
+	OutResult.BytesPerPlot = OutResult.MemoryMB * 1024.0 * 1024.0 / PlotCount;
+
+	if (const UFarmMemorySubsystem* FarmMemory = World->GetSubsystem<UFarmMemorySubsystem>())
+	{
+		const FFarmMemoryReport Report = FarmMemory->Measure();
+		OutResult.MeasuredBytesPerPlot = Report.GetBytesPerPlot();
+		OutResult.MeasuredBytesPerCrop = Report.GetBytesPerCrop();
+		OutResult.bWithinMemoryBudget = FarmMemory->CheckBudgets(Report);
+	}
+
+	// Time a full collection while the farm is still alive; that is the pause players would see
+	const double GCStart = FPlatformTime::Seconds();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+	OutResult.GCMs = (FPlatformTime::Seconds() - GCStart) * 1000.0;
+
+	return true;
+}
+
+void UFarmBenchmarkCommandlet::SpawnPlots(UWorld* World, int32 PlotCount, TArray<ASoilPlot*>& OutPlots)
+{
+	UClass* SpawnClass = PlotClass.LoadSynchronous();
+	if (!SpawnClass)
+	{
+		SpawnClass = ASoilPlot::StaticClass();
+	}
+
+	USoilContainerDataAsset* Container = ContainerData.LoadSynchronous();
+
+	TArray<USoilDataAsset*> Soils;
+	for (const TSoftObjectPtr<USoilDataAsset>& Soil : SoilData)
+	{
+		if (USoilDataAsset* LoadedSoil = Soil.LoadSynchronous())
+		{
+			Soils.Add(LoadedSoil);
+		}
+	}
+
+	TArray<UCropDataAsset*> Crops;
+	for (const TSoftObjectPtr<UCropDataAsset>& Crop : CropData)
+	{
+		if (UCropDataAsset* LoadedCrop = Crop.LoadSynchronous())
+		{
+			Crops.Add(LoadedCrop);
+		}
+	}
+
+	if (Soils.Num() == 0 || Crops.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UFarmBenchmarkCommandlet::SpawnPlots: No soil or crop data could be loaded"));
+		return;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	const int32 GridSize = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(PlotCount)));
+	OutPlots.Reserve(PlotCount);
+
+	for (int32 Index = 0; Index < PlotCount; ++Index)
+	{
+		const FVector Location((Index % GridSize) * PlotSpacing, (Index / GridSize) * PlotSpacing, 0.0f);
+
+		ASoilPlot* Plot = World->SpawnActor<ASoilPlot>(SpawnClass, Location, FRotator::ZeroRotator, SpawnParams);
+		if (!Plot)
+		{
+			continue;
+		}
+
+		Plot->Initialize(Container, Soils[Index % Soils.Num()]);
+
+		// Soils with a till threshold need several passes
+		for (int32 Pass = 0; Pass < 16 && IFarmableInterface::Execute_CanInteractWithTool(Plot, EToolType::Hoe, nullptr); ++Pass)
+		{
+			IFarmableInterface::Execute_InteractTool(Plot, EToolType::Hoe, nullptr, 1.0f);
+		}
+
+		IFarmableInterface::Execute_PlantSeed(Plot, Crops[Index % Crops.Num()], nullptr);
+		OutPlots.Add(Plot);
+	}
+}
+
+void UFarmBenchmarkCommandlet::WriteResults(const TArray<FFarmBenchmarkResult>& Results) const
+{
+	FString Csv = TEXT("Label,Plots,Crops,Steps,SetupMs,AvgStepMs,MaxStepMs,GrowthMsPerStep,EvaporationMsPerStep,EventMsPerStep,VisualMsPerStep,WaterMsPerStep,EventsPerStep,VisualUpdatesPerStep,MemoryMB,BytesPerPlot,GCMs,GuardedAllocsPerStep,MeasuredBytesPerPlot,MeasuredBytesPerCrop,WithinMemoryBudget\n");
+
+	FString Json;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+	JsonWriter->WriteObjectStart();
+	JsonWriter->WriteValue(TEXT("label"), Label);
+	JsonWriter->WriteValue(TEXT("simSeconds"), SimSeconds);
+	JsonWriter->WriteValue(TEXT("waterInterval"), WaterInterval);
+	JsonWriter->WriteValue(TEXT("seed"), Seed);
+	JsonWriter->WriteArrayStart(TEXT("runs"));
+
+	for (const FFarmBenchmarkResult& Result : Results)
+	{
+		Csv += FString::Printf(TEXT("%s,%d,%d,%d,%.3f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.1f,%.1f,%.2f,%.1f,%.3f,%.2f,%lld,%lld,%d\n"),
+			*Label, Result.PlotCount, Result.CropCount, Result.Steps, Result.SetupMs, Result.AvgStepMs, Result.MaxStepMs,
+			Result.GrowthMsPerStep, Result.EvaporationMsPerStep, Result.EventMsPerStep, Result.VisualMsPerStep, Result.WaterMsPerStep,
+			Result.EventsPerStep, Result.VisualUpdatesPerStep, Result.MemoryMB, Result.BytesPerPlot, Result.GCMs, Result.GuardedAllocsPerStep,
+			Result.MeasuredBytesPerPlot, Result.MeasuredBytesPerCrop, Result.bWithinMemoryBudget ? 1 : 0);
+
+		JsonWriter->WriteObjectStart();
+		JsonWriter->WriteValue(TEXT("plots"), Result.PlotCount);
+		JsonWriter->WriteValue(TEXT("crops"), Result.CropCount);
+		JsonWriter->WriteValue(TEXT("steps"), Result.Steps);
+		JsonWriter->WriteValue(TEXT("setupMs"), Result.SetupMs);
+		JsonWriter->WriteValue(TEXT("avgStepMs"), Result.AvgStepMs);
+		JsonWriter->WriteValue(TEXT("maxStepMs"), Result.MaxStepMs);
+		JsonWriter->WriteValue(TEXT("growthMsPerStep"), Result.GrowthMsPerStep);
+		JsonWriter->WriteValue(TEXT("evaporationMsPerStep"), Result.EvaporationMsPerStep);
+		JsonWriter->WriteValue(TEXT("eventMsPerStep"), Result.EventMsPerStep);
+		JsonWriter->WriteValue(TEXT("visualMsPerStep"), Result.VisualMsPerStep);
+		JsonWriter->WriteValue(TEXT("waterMsPerStep"), Result.WaterMsPerStep);
+		JsonWriter->WriteValue(TEXT("eventsPerStep"), Result.EventsPerStep);
+		JsonWriter->WriteValue(TEXT("visualUpdatesPerStep"), Result.VisualUpdatesPerStep);
+		JsonWriter->WriteValue(TEXT("memoryMB"), Result.MemoryMB);
+		JsonWriter->WriteValue(TEXT("bytesPerPlot"), Result.BytesPerPlot);
+		JsonWriter->WriteValue(TEXT("gcMs"), Result.GCMs);
+		JsonWriter->WriteValue(TEXT("guardedAllocsPerStep"), Result.GuardedAllocsPerStep);
+		JsonWriter->WriteValue(TEXT("measuredBytesPerPlot"), Result.MeasuredBytesPerPlot);
+		JsonWriter->WriteValue(TEXT("measuredBytesPerCrop"), Result.MeasuredBytesPerCrop);
+		JsonWriter->WriteValue(TEXT("withinMemoryBudget"), Result.bWithinMemoryBudget);
+		JsonWriter->WriteObjectEnd();
+	}
+
+	JsonWriter->WriteArrayEnd();
+	JsonWriter->WriteObjectEnd();
+	JsonWriter->Close();
+
+	const FString JsonPath = FPaths::GetPath(OutputPath) / FPaths::GetBaseFilename(OutputPath) + TEXT(".json");
+
+	if (FFileHelper::SaveStringToFile(Csv, *OutputPath) && FFileHelper::SaveStringToFile(Json, *JsonPath))
+	{
+		UE_LOG(LogTemp, Display, TEXT("UFarmBenchmarkCommandlet::WriteResults: Wrote %s and %s"), *OutputPath, *JsonPath);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("UFarmBenchmarkCommandlet::WriteResults: Failed to write %s"), *OutputPath);
+	}
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "UFarmBenchmarkCommandlet.generated.h"
+
+class ASoilPlot;
+class UCropDataAsset;
+class USoilContainerDataAsset;
+class USoilDataAsset;
+
+/** Results of one benchmark run at a given plot count */
+struct FFarmBenchmarkResult
+{
+	int32 PlotCount = 0;
+	int32 CropCount = 0;
+	int32 Steps = 0;
+	double SetupMs = 0.0;
+	double AvgStepMs = 0.0;
+	double MaxStepMs = 0.0;
+	double GrowthMsPerStep = 0.0;
+	double EvaporationMsPerStep = 0.0;
+	double EventMsPerStep = 0.0;
+	double VisualMsPerStep = 0.0;
+	double WaterMsPerStep = 0.0;
+	double EventsPerStep = 0.0;
+	double VisualUpdatesPerStep = 0.0;
+	double MemoryMB = 0.0;
+	double BytesPerPlot = 0.0;
+	double GCMs = 0.0;
+
+	/** Bytes per plot and per crop measured from the farm objects by UFarmMemorySubsystem */
+	int64 MeasuredBytesPerPlot = 0;
+	int64 MeasuredBytesPerCrop = 0;
+
+	/** Whether the measured bytes per plot and per crop are within the UFarmMemorySubsystem budgets */
+	bool bWithinMemoryBudget = true;
+
+	/** Allocations inside guarded steady-state scopes per step, after the warm-up steps */
+	double GuardedAllocsPerStep = 0.0;
+};
+
+/**
+ * Headless farm scale benchmark. For each plot count it creates an empty game world, lays out a grid of
+ * soil plots, tills them, plants crops round-robin from CropData, then runs the deterministic simulation
+ * for SimSeconds while watering plots on a schedule. Per-step growth, evaporation, event and visual timings,
+ * memory growth and garbage collection time are written as CSV and JSON to Saved/Benchmarks.
+ * After WarmUpSteps the steady-state scopes are checked with FScopedFarmAllocationGuard, and the commandlet
+ * fails if they allocate more than MaxGuardedAllocsPerStep on average. The farm objects are then measured by
+ * UFarmMemorySubsystem, and the commandlet also fails if a plot or crop is over its memory budget.
+ * Usage: UnrealEditor-Cmd FungiFields.uproject -run=FarmBenchmark -nullrhi [-Plots=1000,10000,200000]
+ * [-Seconds=60] [-Label=Name] [-Output=Path]
+ * Defaults are read from the [/Script/FungiFields.FarmBenchmarkCommandlet] section of DefaultGame.ini.
+ */
+UCLASS(config=Game)
+class FUNGIFIELDS_API UFarmBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UFarmBenchmarkCommandlet();
+
+	// UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+
+protected:
+	/**
+	 * Run the benchmark at one plot count in a fresh world.
+	 * @param PlotCount Number of plots to lay out
+	 * @param OutResult Filled with the run's measurements
+	 * @return True if the world was created and the plots spawned
+	 */
+	bool RunBenchmark(int32 PlotCount, FFarmBenchmarkResult& OutResult);
+
+	/**
+	 * Spawn, till and plant a square grid of plots.
+	 * @param World World to spawn into
+	 * @param PlotCount Number of plots
+	 * @param OutPlots Spawned plots
+	 */
+	void SpawnPlots(UWorld* World, int32 PlotCount, TArray<ASoilPlot*>& OutPlots);
+
+	/** Write all results as CSV and JSON */
+	void WriteResults(const TArray<FFarmBenchmarkResult>& Results) const;
+
+	/** Plot actor to spawn */
+	UPROPERTY(Config)
+	TSoftClassPtr<ASoilPlot> PlotClass;
+
+	/** Container every plot is initialized with */
+	UPROPERTY(Config)
+	TSoftObjectPtr<USoilContainerDataAsset> ContainerData;
+
+	/** Soil types assigned round-robin across plots */
+	UPROPERTY(Config)
+	TArray<TSoftObjectPtr<USoilDataAsset>> SoilData;
+
+	/** Crops planted round-robin across plots */
+	UPROPERTY(Config)
+	TArray<TSoftObjectPtr<UCropDataAsset>> CropData;
+
+	/** Plot counts to run, smallest first */
+	UPROPERTY(Config)
+	TArray<int32> PlotCounts;
+
+	/** Simulated seconds per run */
+	UPROPERTY(Config)
+	float SimSeconds = 60.0f;
+
+	/** Simulated seconds between waterings of the same plot */
+	UPROPERTY(Config)
+	float WaterInterval = 20.0f;
+
+	/** Water added per watering */
+	UPROPERTY(Config)
+	float WaterAmount = 25.0f;
+
+	/** Distance between neighbouring plots */
+	UPROPERTY(Config)
+	float PlotSpacing = 200.0f;
+
+	/** Seed for the deterministic simulation */
+	UPROPERTY(Config)
+	int32 Seed = 1;
+
+	/** Steps run before allocations are checked, so scratch buffers reach their working size */
+	UPROPERTY(Config)
+	int32 WarmUpSteps = 2;
+
+	/** Average allocations per step allowed in guarded scopes; higher fails the run */
+	UPROPERTY(Config)
+	float MaxGuardedAllocsPerStep = 0.0f;
+
+	/** Name written to each result row, e.g. a branch or change being measured */
+	FString Label;
+
+	/** CSV file to write; the JSON file is written next to it */
+	FString OutputPath;
+};
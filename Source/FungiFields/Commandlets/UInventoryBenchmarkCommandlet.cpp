@@ -0,0 +1,497 @@
+#include "UInventoryBenchmarkCommandlet.h"
+#include "FBenchmarkWorld.h"
+#include "../Components/InventoryComponent.h"
+#include "../Components/QuestComponent.h"
+#include "../Components/UFarmingComponent.h"
+#include "../Data/Quest.h"
+#include "../Data/UCropDataAsset.h"
+#include "../Data/UItemDataAsset.h"
+#include "../Data/USeedDataAsset.h"
+#include "../ENUM/EQuestEventType.h"
+#include "../Inventory/FInventorySlot.h"
+#include "../Inventory/FPackedInventory.h"
+#include "../Subsystems/FFarmAllocationCounter.h"
+#include "Dom/JsonObject.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+
+namespace InventoryBenchmark
+{
+	/** Keeps benchmarked results from being optimized away */
+	static volatile int32 Sink = 0;
+
+	/** Stack size of the benchmark items */
+	static constexpr int32 MaxStackSize = 99;
+
+	/** Build packed contents with the first SlotCount slots holding one item each, cycling through the items */
+	static FPackedInventory MakeContents(const TArray<TObjectPtr<UItemDataAsset>>& Items, int32 ItemVariety, int32 InventorySize, int32 SlotCount)
+	{
+		TArray<FInventorySlot> Slots;
+		Slots.SetNum(InventorySize);
+		for (int32 SlotIndex = 0; SlotIndex < SlotCount; ++SlotIndex)
+		{
+			Slots[SlotIndex].SetContents(Items[SlotIndex % ItemVariety], 1);
+		}
+
+		FPackedInventory Packed;
+		Packed.Pack(Slots);
+		return Packed;
+	}
+}
+
+UInventoryBenchmarkCommandlet::UInventoryBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = true;
+	IsEditor = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UInventoryBenchmarkCommandlet::Main(const FString& Params)
+{
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	FParse::Value(*Params, TEXT("Filter="), Filter);
+
+	FString BaselinePath = GetBaselinePath();
+	FParse::Value(*Params, TEXT("Baseline="), BaselinePath);
+
+	if (!RunCases())
+	{
+		return 1;
+	}
+
+	const FString ResultsPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / FString::Printf(TEXT("InventoryBenchmark_%s.json"), *FDateTime::Now().ToString());
+	WriteResults(ResultsPath);
+
+	if (FParse::Param(*Params, TEXT("UpdateBaseline")))
+	{
+		WriteResults(BaselinePath);
+		UE_LOG(LogTemp, Display, TEXT("UInventoryBenchmarkCommandlet::Main: Baseline updated at %s"), *BaselinePath);
+		return 0;
+	}
+
+	return CompareWithBaseline(BaselinePath) ? 0 : 1;
+}
+
+bool UInventoryBenchmarkCommandlet::RunCases()
+{
+	Iterations = FMath::Max(1, Iterations);
+	Repetitions = FMath::Max(1, Repetitions);
+	Results.Reset();
+
+	int32 MaxVariety = 1;
+	for (int32 ItemVariety : ItemVarieties)
+	{
+		MaxVariety = FMath::Max(MaxVariety, ItemVariety);
+	}
+
+	for (int32 Index = Items.Num(); Index < MaxVariety; ++Index)
+	{
+		UItemDataAsset* Item = NewObject<UItemDataAsset>(GetTransientPackage(), MakeUniqueObjectName(GetTransientPackage(), UItemDataAsset::StaticClass(), *FString::Printf(TEXT("BenchmarkItem_%d"), Index)));
+		Item->MaxStackSize = InventoryBenchmark::MaxStackSize;
+		Items.Add(Item);
+
+		Crops.Add(NewObject<UCropDataAsset>(GetTransientPackage(), MakeUniqueObjectName(GetTransientPackage(), UCropDataAsset::StaticClass(), *FString::Printf(TEXT("BenchmarkCrop_%d"), Index))));
+
+		USeedDataAsset* Seed = NewObject<USeedDataAsset>(GetTransientPackage(), MakeUniqueObjectName(GetTransientPackage(), USeedDataAsset::StaticClass(), *FString::Printf(TEXT("BenchmarkSeed_%d"), Index)));
+		Seed->MaxStackSize = InventoryBenchmark::MaxStackSize;
+		Seeds.Add(Seed);
+	}
+
+	FBenchmarkWorld BenchmarkWorld(TEXT("InventoryBenchmark"));
+	UWorld* World = BenchmarkWorld.Get();
+	if (!World)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UInventoryBenchmarkCommandlet::RunCases: Failed to create a world"));
+		return false;
+	}
+
+	for (int32 InventorySize : InventorySizes)
+	{
+		for (int32 ItemVariety : ItemVarieties)
+		{
+			RunInventoryCases(World, InventorySize, ItemVariety);
+		}
+	}
+
+	for (int32 QuestCount : QuestCounts)
+	{
+		for (int32 ItemVariety : ItemVarieties)
+		{
+			RunQuestCases(World, QuestCount, ItemVariety);
+		}
+	}
+
+	for (int32 ItemVariety : ItemVarieties)
+	{
+		RunQuestMatchCases(ItemVariety);
+	}
+
+	return true;
+}
+
+FString UInventoryBenchmarkCommandlet::GetBaselinePath() const
+{
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectDir() / BaselineFile);
+}
+
+void UInventoryBenchmarkCommandlet::RunCase(const FString& Name, TFunctionRef<void()> Reset, TFunctionRef<bool(int32)> Operation)
+{
+	if (!Filter.IsEmpty() && !Name.Contains(Filter))
+	{
+		return;
+	}
+
+	FInventoryBenchmarkResult Result;
+	Result.Name = Name;
+	Result.NsPerOp = TNumericLimits<double>::Max();
+
+	for (int32 Repetition = 0; Repetition < Repetitions; ++Repetition)
+	{
+		int32 Done = 0;
+		uint64 Cycles = 0;
+		uint64 Allocations = 0;
+
+		while (Done < Iterations)
+		{
+			Reset();
+
+			const int32 BatchStart = Done;
+			FScopedFarmAllocationCounter AllocationCounter;
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+
+			while (Done < Iterations && Operation(Done))
+			{
+				++Done;
+			}
+
+			Cycles += FPlatformTime::Cycles64() - StartCycles;
+			Allocations += AllocationCounter.GetCount();
+
+			if (Done == BatchStart)
+			{
+				UE_LOG(LogTemp, Error, TEXT("UInventoryBenchmarkCommandlet::RunCase: %s makes no progress from its reset state"), *Name);
+				return;
+			}
+		}
+
+		const double NsPerOp = FPlatformTime::ToSeconds64(Cycles) * 1.0e9 / Done;
+		if (NsPerOp < Result.NsPerOp)
+		{
+			Result.NsPerOp = NsPerOp;
+			Result.AllocsPerOp = static_cast<double>(Allocations) / Done;
+			Result.Operations = Done;
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("%-48s %10.1f ns/op %8.3f allocs/op"), *Name, Result.NsPerOp, Result.AllocsPerOp);
+	Results.Add(MoveTemp(Result));
+}
+
+void UInventoryBenchmarkCommandlet::RunInventoryCases(UWorld* World, int32 InventorySize, int32 ItemVariety)
+{
+	if (InventorySize < 2 || ItemVariety < 1 || ItemVariety > Items.Num())
+	{
+		return;
+	}
+
+	UInventoryComponent* Inventory = SpawnInventory(World, InventorySize);
+	if (!Inventory)
+	{
+		return;
+	}
+
+	const FString Suffix = FString::Printf(TEXT("S%d.V%d"), InventorySize, ItemVariety);
+	const int32 StackVariety = FMath::Min(ItemVariety, InventorySize);
+
+	const FPackedInventory EmptyContents;
+	const FPackedInventory StackContents = InventoryBenchmark::MakeContents(Items, ItemVariety, InventorySize, StackVariety);
+	const FPackedInventory AllButLastContents = InventoryBenchmark::MakeContents(Items, ItemVariety, InventorySize, InventorySize - 1);
+	const FPackedInventory FullContents = InventoryBenchmark::MakeContents(Items, ItemVariety, InventorySize, InventorySize);
+
+	RunCase(TEXT("Inventory.TryAddItem.") + Suffix,
+		[&]() { Inventory->RestorePackedSlots(EmptyContents); },
+		[&](int32 Index) { return Inventory->TryAddItem(Items[Index % ItemVariety], 1); });
+
+	RunCase(TEXT("Inventory.TryStackItem.") + Suffix,
+		[&]() { Inventory->RestorePackedSlots(StackContents); },
+		[&](int32 Index)
+		{
+			int32 RemainingAmount = 1;
+			return Inventory->TryStackItem(Items[Index % StackVariety], RemainingAmount) && RemainingAmount == 0;
+		});
+
+	// One slot is kept empty and each move shifts its neighbour into it
+	int32 EmptySlot = InventorySize - 1;
+	RunCase(TEXT("Inventory.MoveItemToSlot.") + Suffix,
+		[&]()
+		{
+			Inventory->RestorePackedSlots(AllButLastContents);
+			EmptySlot = InventorySize - 1;
+		},
+		[&](int32 Index)
+		{
+			const int32 FromSlot = (EmptySlot + 1) % InventorySize;
+			const bool bMoved = Inventory->MoveItemToSlot(FromSlot, EmptySlot);
+			EmptySlot = FromSlot;
+			return bMoved;
+		});
+
+	RunCase(TEXT("Inventory.GetItemTotalCount.") + Suffix,
+		[&]() { Inventory->RestorePackedSlots(FullContents); },
+		[&](int32 Index)
+		{
+			InventoryBenchmark::Sink = InventoryBenchmark::Sink + Inventory->GetItemTotalCount(Items[Index % ItemVariety]);
+			return true;
+		});
+
+	Inventory->GetOwner()->Destroy();
+}
+
+void UInventoryBenchmarkCommandlet::RunQuestCases(UWorld* World, int32 QuestCount, int32 ItemVariety)
+{
+	if (QuestCount < 1 || ItemVariety < 1 || ItemVariety > Items.Num())
+	{
+		return;
+	}
+
+	UInventoryComponent* Inventory = SpawnInventory(World, 27);
+	if (!Inventory)
+	{
+		return;
+	}
+
+	AActor* Owner = Inventory->GetOwner();
+
+	UFarmingComponent* Farming = NewObject<UFarmingComponent>(Owner);
+	Farming->RegisterComponent();
+
+	// Registered last so it subscribes to the other components when it begins play
+	UQuestComponent* Quests = NewObject<UQuestComponent>(Owner);
+	Quests->RegisterComponent();
+
+	static const EQuestEventType EventTypes[] =
+	{
+		EQuestEventType::ItemAdded,
+		EQuestEventType::CropHarvested,
+		EQuestEventType::SeedPlanted,
+		EQuestEventType::SoilTilled,
+		EQuestEventType::SoilWatered
+	};
+
+	for (int32 QuestIndex = 0; QuestIndex < QuestCount; ++QuestIndex)
+	{
+		UQuest* Quest = NewObject<UQuest>(GetTransientPackage());
+		Quest->QuestID = FName(TEXT("BenchmarkQuest"), QuestIndex + 1);
+		Quest->QuestEventType = EventTypes[QuestIndex % UE_ARRAY_COUNT(EventTypes)];
+		Quest->RequiredProgress = MAX_int32;
+		Quest->RequiredItem = Items[QuestIndex % ItemVariety].Get();
+		Quest->RequiredCrop = Crops[QuestIndex % ItemVariety].Get();
+		Quest->RequiredSeed = Seeds[QuestIndex % ItemVariety].Get();
+		Quests->AddQuest(Quest);
+	}
+
+	const FString Suffix = FString::Printf(TEXT("Q%d.V%d"), QuestCount, ItemVariety);
+	auto NoReset = []() {};
+
+	RunCase(TEXT("Quest.OnItemAdded.") + Suffix, NoReset,
+		[&](int32 Index)
+		{
+			Inventory->OnItemAdded.Broadcast(Items[Index % ItemVariety], 1, 1);
+			return true;
+		});
+
+	RunCase(TEXT("Quest.OnCropHarvested.") + Suffix, NoReset,
+		[&](int32 Index)
+		{
+			Farming->OnCropHarvested.Broadcast(Owner, Crops[Index % ItemVariety], 1);
+			return true;
+		});
+
+	RunCase(TEXT("Quest.OnSeedPlanted.") + Suffix, NoReset,
+		[&](int32 Index)
+		{
+			Farming->OnSeedPlanted.Broadcast(Owner, Seeds[Index % ItemVariety]);
+			return true;
+		});
+
+	RunCase(TEXT("Quest.OnSoilTilled.") + Suffix, NoReset,
+		[&](int32 Index)
+		{
+			Farming->OnSoilTilled.Broadcast(Owner);
+			return true;
+		});
+
+	RunCase(TEXT("Quest.OnSoilWatered.") + Suffix, NoReset,
+		[&](int32 Index)
+		{
+			Farming->OnSoilWatered.Broadcast(Owner, nullptr);
+			return true;
+		});
+
+	Owner->Destroy();
+}
+
+void UInventoryBenchmarkCommandlet::RunQuestMatchCases(int32 ItemVariety)
+{
+	if (ItemVariety < 1 || ItemVariety > Items.Num())
+	{
+		return;
+	}
+
+	UQuest* Quest = NewObject<UQuest>(GetTransientPackage());
+	Quest->RequiredItem = Items[0].Get();
+	Quest->RequiredCrop = Crops[0].Get();
+	Quest->RequiredSeed = Seeds[0].Get();
+	Quest->StartQuest();
+
+	const FString Suffix = FString::Printf(TEXT("V%d"), ItemVariety);
+	auto NoReset = []() {};
+
+	Quest->QuestEventType = EQuestEventType::ItemAdded;
+	RunCase(TEXT("Quest.ShouldRespondToItemAdded.") + Suffix, NoReset,
+		[&](int32 Index)
+		{
+			InventoryBenchmark::Sink = InventoryBenchmark::Sink + Quest->ShouldRespondToItemAdded(Items[Index % ItemVariety], 1);
+			return true;
+		});
+
+	Quest->QuestEventType = EQuestEventType::CropHarvested;
+	RunCase(TEXT("Quest.ShouldRespondToCropHarvested.") + Suffix, NoReset,
+		[&](int32 Index)
+		{
+			InventoryBenchmark::Sink = InventoryBenchmark::Sink + Quest->ShouldRespondToCropHarvested(Crops[Index % ItemVariety], 1);
+			return true;
+		});
+
+	Quest->QuestEventType = EQuestEventType::SeedPlanted;
+	RunCase(TEXT("Quest.ShouldRespondToSeedPlanted.") + Suffix, NoReset,
+		[&](int32 Index)
+		{
+			InventoryBenchmark::Sink = InventoryBenchmark::Sink + Quest->ShouldRespondToSeedPlanted(Seeds[Index % ItemVariety]);
+			return true;
+		});
+}
+
+UInventoryComponent* UInventoryBenchmarkCommandlet::SpawnInventory(UWorld* World, int32 InventorySize) const
+{
+	AActor* Owner = World->SpawnActor<AActor>();
+	if (!Owner)
+	{
+		return nullptr;
+	}
+
+	UInventoryComponent* Inventory = NewObject<UInventoryComponent>(Owner);
+	Inventory->SetInitialSlotCount(InventorySize);
+	Inventory->SetSupportsEquipping(false);
+	Inventory->RegisterComponent();
+	return Inventory;
+}
+
+bool UInventoryBenchmarkCommandlet::CompareWithBaseline(const FString& BaselinePath)
+{
+	FString BaselineJson;
+	if (!FFileHelper::LoadFileToString(BaselineJson, *BaselinePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("UInventoryBenchmarkCommandlet::CompareWithBaseline: No baseline at %s; run with -UpdateBaseline to create one"), *BaselinePath);
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> Baseline;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(BaselineJson);
+	if (!FJsonSerializer::Deserialize(Reader, Baseline) || !Baseline.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("UInventoryBenchmarkCommandlet::CompareWithBaseline: %s is not valid JSON"), *BaselinePath);
+		return false;
+	}
+
+	// Hand-written baselines carry no "measured" flag; their timings are not from this machine
+	bBaselineMeasured = false;
+	Baseline->TryGetBoolField(TEXT("measured"), bBaselineMeasured);
+	if (!bBaselineMeasured)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UInventoryBenchmarkCommandlet::CompareWithBaseline: %s is not a measured baseline, skipping the timing comparison; run with -UpdateBaseline on the benchmark machine"), *BaselinePath);
+	}
+
+	TMap<FString, TSharedPtr<FJsonObject>> BaselineCases;
+	const TArray<TSharedPtr<FJsonValue>>* Cases = nullptr;
+	if (Baseline->TryGetArrayField(TEXT("cases"), Cases))
+	{
+		for (const TSharedPtr<FJsonValue>& Case : *Cases)
+		{
+			const TSharedPtr<FJsonObject> CaseObject = Case->AsObject();
+			if (CaseObject.IsValid())
+			{
+				BaselineCases.Add(CaseObject->GetStringField(TEXT("name")), CaseObject);
+			}
+		}
+	}
+
+	int32 Regressions = 0;
+	for (FInventoryBenchmarkResult& Result : Results)
+	{
+		const TSharedPtr<FJsonObject>* BaselineCase = BaselineCases.Find(Result.Name);
+		if (!BaselineCase)
+		{
+			continue;
+		}
+
+		Result.BaselineNsPerOp = (*BaselineCase)->GetNumberField(TEXT("nsPerOp"));
+		Result.BaselineAllocsPerOp = (*BaselineCase)->GetNumberField(TEXT("allocsPerOp"));
+
+		const double SlowdownNs = Result.NsPerOp - Result.BaselineNsPerOp;
+		const bool bSlower = bBaselineMeasured && SlowdownNs > MinRegressionNs && Result.NsPerOp > Result.BaselineNsPerOp * (1.0 + MaxRegressionPercent / 100.0);
+		const bool bMoreAllocations = Result.AllocsPerOp > Result.BaselineAllocsPerOp + MaxExtraAllocsPerOp;
+
+		if (bSlower || bMoreAllocations)
+		{
+			Result.bRegressed = true;
+			++Regressions;
+			UE_LOG(LogTemp, Error, TEXT("UInventoryBenchmarkCommandlet::CompareWithBaseline: %s regressed: %.1f ns/op (baseline %.1f), %.3f allocs/op (baseline %.3f)"),
+				*Result.Name, Result.NsPerOp, Result.BaselineNsPerOp, Result.AllocsPerOp, Result.BaselineAllocsPerOp);
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("UInventoryBenchmarkCommandlet::CompareWithBaseline: %d of %d cases regressed against %s"), Regressions, Results.Num(), *BaselinePath);
+	return Regressions == 0;
+}
+
+void UInventoryBenchmarkCommandlet::WriteResults(const FString& FilePath) const
+{
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("measured"), true);
+	Writer->WriteValue(TEXT("iterations"), Iterations);
+	Writer->WriteValue(TEXT("repetitions"), Repetitions);
+	Writer->WriteArrayStart(TEXT("cases"));
+
+	for (const FInventoryBenchmarkResult& Result : Results)
+	{
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("name"), Result.Name);
+		Writer->WriteValue(TEXT("operations"), Result.Operations);
+		Writer->WriteValue(TEXT("nsPerOp"), Result.NsPerOp);
+		Writer->WriteValue(TEXT("allocsPerOp"), Result.AllocsPerOp);
+		Writer->WriteObjectEnd();
+	}
+
+	Writer->WriteArrayEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	if (!FFileHelper::SaveStringToFile(Json, *FilePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("UInventoryBenchmarkCommandlet::WriteResults: Failed to write %s"), *FilePath);
+	}
+}
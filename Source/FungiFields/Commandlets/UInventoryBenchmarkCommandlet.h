@@ -0,0 +1,154 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "UInventoryBenchmarkCommandlet.generated.h"
+
+class UCropDataAsset;
+class UInventoryComponent;
+class UItemDataAsset;
+class USeedDataAsset;
+class UWorld;
+
+/** Measurement of one benchmark case */
+struct FInventoryBenchmarkResult
+{
+	FString Name;
+	int64 Operations = 0;
+	double NsPerOp = 0.0;
+	double AllocsPerOp = 0.0;
+
+	/** Baseline values, negative if the case is not in the baseline */
+	double BaselineNsPerOp = -1.0;
+	double BaselineAllocsPerOp = -1.0;
+
+	bool bRegressed = false;
+};
+
+/**
+ * Micro-benchmarks for the inventory and quest hot paths: TryAddItem, TryStackItem, MoveItemToSlot and
+ * GetItemTotalCount across inventory sizes and item variety, and the quest event handlers and
+ * UQuest::ShouldRespondTo* across quest counts. Reports ns/op and allocations/op per case, compares them
+ * with a stored baseline and returns 1 if any case regressed past the configured thresholds or there is no
+ * baseline. The same cases run as the FungiFields.Benchmarks.Inventory automation test.
+ * Usage: UnrealEditor-Cmd FungiFields.uproject -run=InventoryBenchmark -nullrhi [-Baseline=Path]
+ * [-UpdateBaseline] [-Iterations=N] [-Filter=Substring]
+ * Defaults are read from the [/Script/FungiFields.InventoryBenchmarkCommandlet] section of DefaultGame.ini.
+ */
+UCLASS(config=Game)
+class FUNGIFIELDS_API UInventoryBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UInventoryBenchmarkCommandlet();
+
+	// UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+
+	/**
+	 * Run every case in a benchmark world.
+	 * @return False if the world could not be created
+	 */
+	bool RunCases();
+
+	/**
+	 * Compare the results with the baseline and flag regressions. Timings are only compared against a baseline
+	 * written by -UpdateBaseline, which marks it "measured"; an unmeasured baseline only checks allocations.
+	 * @param BaselinePath Baseline file
+	 * @return True if no case regressed; false if any did or the baseline is missing or invalid
+	 */
+	bool CompareWithBaseline(const FString& BaselinePath);
+
+	/** Check whether the last baseline compared was measured, so its timings were checked */
+	bool IsBaselineMeasured() const { return bBaselineMeasured; }
+
+	/** Get the configured baseline file as an absolute path */
+	FString GetBaselinePath() const;
+
+	/** Get the results of the cases run so far */
+	const TArray<FInventoryBenchmarkResult>& GetResults() const { return Results; }
+
+protected:
+	/**
+	 * Time an operation. The operation runs until it returns false or the case's iterations are used up,
+	 * then Reset restores the starting state outside the timed region and the operation continues.
+	 * The best of Repetitions runs is kept.
+	 * @param Name Case name
+	 * @param Reset Restores the state the operation starts from
+	 * @param Operation Runs one operation given its index; returns false once the state needs resetting
+	 */
+	void RunCase(const FString& Name, TFunctionRef<void()> Reset, TFunctionRef<bool(int32)> Operation);
+
+	/** Inventory cases for one inventory size and item variety */
+	void RunInventoryCases(UWorld* World, int32 InventorySize, int32 ItemVariety);
+
+	/** Quest cases for one quest count and item variety */
+	void RunQuestCases(UWorld* World, int32 QuestCount, int32 ItemVariety);
+
+	/** UQuest::ShouldRespondTo* cases for one item variety, half of them matching */
+	void RunQuestMatchCases(int32 ItemVariety);
+
+	/** Spawn an actor owning an inventory of the given size */
+	UInventoryComponent* SpawnInventory(UWorld* World, int32 InventorySize) const;
+
+	/** Write the results as a baseline file */
+	void WriteResults(const FString& FilePath) const;
+
+	/** Inventory slot counts to run */
+	UPROPERTY(Config)
+	TArray<int32> InventorySizes;
+
+	/** Number of distinct items to run */
+	UPROPERTY(Config)
+	TArray<int32> ItemVarieties;
+
+	/** Number of active quests to run */
+	UPROPERTY(Config)
+	TArray<int32> QuestCounts;
+
+	/** Operations per repetition of each case */
+	UPROPERTY(Config)
+	int32 Iterations = 100000;
+
+	/** Repetitions of each case; the fastest is reported */
+	UPROPERTY(Config)
+	int32 Repetitions = 5;
+
+	/** Baseline file, relative to the project directory */
+	UPROPERTY(Config)
+	FString BaselineFile;
+
+	/** Whether the last baseline compared was measured */
+	bool bBaselineMeasured = false;
+
+	/** Slowdown over the baseline ns/op that fails the run, in percent */
+	UPROPERTY(Config)
+	float MaxRegressionPercent = 25.0f;
+
+	/** Slowdowns smaller than this many ns/op are treated as noise */
+	UPROPERTY(Config)
+	float MinRegressionNs = 5.0f;
+
+	/** Extra allocations per operation over the baseline that fail the run */
+	UPROPERTY(Config)
+	float MaxExtraAllocsPerOp = 0.01f;
+
+	/** Transient items used by the cases */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UItemDataAsset>> Items;
+
+	/** Transient crops used by the quest cases */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UCropDataAsset>> Crops;
+
+	/** Transient seeds used by the quest cases */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<USeedDataAsset>> Seeds;
+
+	/** Only cases whose name contains this run */
+	FString Filter;
+
+	/** Results of the cases run so far */
+	TArray<FInventoryBenchmarkResult> Results;
+};
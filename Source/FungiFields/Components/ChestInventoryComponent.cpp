@@ -1,4 +1,12 @@
+
+
 #include "ChestInventoryComponent.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Net/Core/Misc/NetConditionGroupManager.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
 
 UChestInventoryComponent::UChestInventoryComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -18,4 +26,156 @@ void UChestInventoryComponent::PostInitProperties()
 	Super::PostInitProperties();
 }
 
+void UChestInventoryComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	AActor* Owner = GetOwner();
+	if (!bEnableReplication || Relevancy != EInventoryRelevancy::OpenOrInRange || !Owner || !Owner->HasAuthority())
+	{
+		return;
+	}
+
+	ContentsNetGroup = FName(*FString::Printf(TEXT("ChestContents_%s"), *Owner->GetPathName()));
+	Owner->SetReplicatedComponentNetCondition(this, COND_NetGroup);
+	UE::Net::FNetConditionGroupManager::RegisterSubObjectInGroup(this, ContentsNetGroup);
+
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().SetTimer(
+			RelevancyTimerHandle,
+			this,
+			&UChestInventoryComponent::UpdateRelevantViewers,
+			RelevancyUpdateInterval,
+			true
+		);
+	}
+
+	UpdateRelevantViewers();
+}
+
+void UChestInventoryComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (!ContentsNetGroup.IsNone())
+	{
+		if (UWorld* World = GetWorld())
+		{
+			World->GetTimerManager().ClearTimer(RelevancyTimerHandle);
+
+			for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+			{
+				if (APlayerController* PC = It->Get())
+				{
+					PC->RemoveFromNetConditionGroup(ContentsNetGroup);
+				}
+			}
+		}
+
+		UE::Net::FNetConditionGroupManager::UnregisterSubObjectFromGroup(this, ContentsNetGroup);
+		ContentsNetGroup = NAME_None;
+	}
+
+	OpenViewers.Empty();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UChestInventoryComponent::AddViewer(APlayerController* Viewer)
+{
+	if (!Viewer)
+	{
+		return;
+	}
+
+	if (GetOwnerRole() != ROLE_Authority)
+	{
+		SendViewerToServer(Viewer, true);
+		return;
+	}
+
+	OpenViewers.AddUnique(Viewer);
+	SetViewerInGroup(Viewer, true);
+}
+
+void UChestInventoryComponent::RemoveViewer(APlayerController* Viewer)
+{
+	if (GetOwnerRole() != ROLE_Authority)
+	{
+		SendViewerToServer(Viewer, false);
+		return;
+	}
+
+	OpenViewers.RemoveAll([Viewer](const TWeakObjectPtr<APlayerController>& OpenViewer)
+	{
+		return !OpenViewer.IsValid() || OpenViewer.Get() == Viewer;
+	});
+
+	UpdateRelevantViewers();
+}
+
+void UChestInventoryComponent::SendViewerToServer(APlayerController* Viewer, bool bViewing)
+{
+	// The chest UI runs on the client, which does not own the chest; it tells the server through its own inventory
+	const APawn* ViewerPawn = Viewer && Viewer->IsLocalController() ? Viewer->GetPawn() : nullptr;
+	UInventoryComponent* ViewerInventory = ViewerPawn ? ViewerPawn->FindComponentByClass<UInventoryComponent>() : nullptr;
+	if (ViewerInventory && ViewerInventory->GetIsReplicated())
+	{
+		ViewerInventory->ServerSetViewingChest(this, bViewing);
+	}
+}
+
+void UChestInventoryComponent::UpdateRelevantViewers()
+{
+	UWorld* World = GetWorld();
+	const AActor* Owner = GetOwner();
+	if (!World || !Owner || ContentsNetGroup.IsNone())
+	{
+		return;
+	}
+
+	const FVector ChestLocation = Owner->GetActorLocation();
+	const float RangeSquared = FMath::Square(ContentsRelevancyRange);
+
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PC = It->Get();
+		if (!PC)
+		{
+			continue;
+		}
+
+		bool bRelevant = OpenViewers.Contains(PC);
+		if (!bRelevant)
+		{
+			if (const APawn* Pawn = PC->GetPawn())
+			{
+				bRelevant = FVector::DistSquared(Pawn->GetActorLocation(), ChestLocation) <= RangeSquared;
+			}
+		}
+
+		SetViewerInGroup(PC, bRelevant);
+	}
+}
+
+void UChestInventoryComponent::SetViewerInGroup(APlayerController* Viewer, bool bInGroup)
+{
+	if (!Viewer || ContentsNetGroup.IsNone() || Viewer->IsMemberOfNetConditionGroup(ContentsNetGroup) == bInGroup)
+	{
+		return;
+	}
+
+	if (bInGroup)
+	{
+		Viewer->IncludeInNetConditionGroup(ContentsNetGroup);
 
+		// Contents were withheld from this connection until now
+		if (AActor* Owner = GetOwner())
+		{
+			Owner->ForceNetUpdate();
+		}
+	}
+	else
+	{
+		Viewer->RemoveFromNetConditionGroup(ContentsNetGroup);
+	}
+}
@@ -2,11 +2,16 @@
 
 #include "CoreMinimal.h"
 #include "InventoryComponent.h"
+#include "../ENUM/EInventoryRelevancy.h"
 #include "ChestInventoryComponent.generated.h"
 
+class APlayerController;
+
 /**
  * Specialized inventory component for chests with replication enabled by default.
  * This ensures replication is set during construction via PostInitProperties.
+ * With OpenOrInRange relevancy, contents replicate only to players that have the chest open or stand nearby,
+ * using a per-chest net condition group; the chest actor itself stays relevant as normal.
  */
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class FUNGIFIELDS_API UChestInventoryComponent : public UInventoryComponent
@@ -16,8 +21,56 @@ class FUNGIFIELDS_API UChestInventoryComponent : public UInventoryComponent
 public:
 	UChestInventoryComponent(const FObjectInitializer& ObjectInitializer);
 
+	/**
+	 * Record that a player has opened this chest. On a client, the server is told through the player's inventory.
+	 * @param Viewer The player controller viewing the chest
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	void AddViewer(APlayerController* Viewer);
+
+	/**
+	 * Record that a player has closed this chest. On a client, the server is told through the player's inventory.
+	 * @param Viewer The player controller that was viewing the chest
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	void RemoveViewer(APlayerController* Viewer);
+
 protected:
 	virtual void PostInitProperties() override;
-};
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Which connections receive this chest's contents */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Inventory|Replication")
+	EInventoryRelevancy Relevancy = EInventoryRelevancy::OpenOrInRange;
+
+	/** Distance within which contents replicate even if the chest is closed */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Inventory|Replication", meta = (ClampMin = "0.0", EditCondition = "Relevancy == EInventoryRelevancy::OpenOrInRange"))
+	float ContentsRelevancyRange = 1500.0f;
 
+	/** How often player distances are re-evaluated (seconds) */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Inventory|Replication", meta = (ClampMin = "0.1", EditCondition = "Relevancy == EInventoryRelevancy::OpenOrInRange"))
+	float RelevancyUpdateInterval = 1.0f;
 
+private:
+	/**
+	 * Client: ask the server to add or remove a local player as a viewer.
+	 * @param Viewer The local player controller
+	 * @param bViewing True to add the player, false to remove it
+	 */
+	void SendViewerToServer(APlayerController* Viewer, bool bViewing);
+
+	/** Re-evaluate which players belong to the contents group */
+	void UpdateRelevantViewers();
+
+	/** Add or remove a player from the contents group, forcing a net update on change */
+	void SetViewerInGroup(APlayerController* Viewer, bool bInGroup);
+
+	/** Players that currently have the chest open */
+	TArray<TWeakObjectPtr<APlayerController>> OpenViewers;
+
+	/** Net condition group gating this component's replication */
+	FName ContentsNetGroup;
+
+	FTimerHandle RelevancyTimerHandle;
+};
@@ -1,9 +1,11 @@
 #include "InteractionComponent.h"
+#include "../FungiFieldsStats.h"
 #include "Camera/CameraComponent.h"
 #include "Engine/World.h"
 #include "../Interfaces/InteractableInterface.h"
+#include "../Subsystems/UInteractionPromptSubsystem.h"
 #include "../Widgets/InteractionWidget.h"
-#include "Blueprint/UserWidget.h"
+#include "GameFramework/PlayerController.h"
 #include "DrawDebugHelpers.h"
 #include "Engine/Engine.h"
 
@@ -52,6 +54,7 @@ void UInteractionComponent::Interact(const FInputActionValue& Value)
 	TraceParams.bReturnPhysicalMaterial = false;
 	TraceParams.bTraceComplex = true;
 
+	FARM_INC_COUNTER(STAT_FarmTraces, TraceCount);
 	bool bHit = World->LineTraceSingleByChannel(
 		HitResult,
 		Start,
@@ -76,6 +79,9 @@ void UInteractionComponent::Interact(const FInputActionValue& Value)
 
 void UInteractionComponent::TraceForInteractable()
 {
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmTraceForInteractable, "UInteractionComponent::TraceForInteractable");
+	FScopedFarmSimTiming TraceTiming(&FFarmSimTimings::TraceCycles);
+
 	if (!CameraComponent)
 	{
 		return;
@@ -93,6 +99,7 @@ void UInteractionComponent::TraceForInteractable()
 	FHitResult HitResult;
 	FCollisionQueryParams Params(FName(TEXT("InteractTrace")), true, GetOwner());
 
+	FARM_INC_COUNTER(STAT_FarmTraces, TraceCount);
 	World->LineTraceSingleByChannel(HitResult, Start, End, ECC_Visibility, Params);
 	
 	AActor* HitActor = HitResult.GetActor();
@@ -141,32 +148,32 @@ void UInteractionComponent::ClearInteractable()
 
 void UInteractionComponent::ShowInteractionWidget(AActor* Interactable, const FText& Prompt)
 {
-
-	UWorld* World = GetWorld();
-	if (!InteractionWidget && InteractionWidgetClass && World)
+	// The prompt subsystem reads the prompt text from the interactable itself
+	const APawn* OwnerPawn = Cast<APawn>(GetOwner());
+	APlayerController* PC = OwnerPawn ? Cast<APlayerController>(OwnerPawn->GetController()) : nullptr;
+	if (PC && PC->IsLocalController())
 	{
-		InteractionWidget = CreateWidget<UInteractionWidget>(World, InteractionWidgetClass);
-		if (InteractionWidget)
+		if (UInteractionPromptSubsystem* PromptSubsystem = UInteractionPromptSubsystem::Get(this))
 		{
-			InteractionWidget->AddToViewport();
+			PromptSubsystem->SetFocus(PC, Interactable, InteractionWidgetClass);
 		}
 	}
 
-	if (InteractionWidget)
-	{
-		InteractionWidget->SetPromptText(Prompt);
-		InteractionWidget->SetVisibility(ESlateVisibility::Visible);
-	}
-
 	LastInteractable = Interactable;
 }
 
 void UInteractionComponent::HideInteractionWidget()
 {
-	if (InteractionWidget)
+	// Pawns of other players trace too; only the local player's own pawn hides its prompts
+	const APawn* OwnerPawn = Cast<APawn>(GetOwner());
+	APlayerController* PC = OwnerPawn ? Cast<APlayerController>(OwnerPawn->GetController()) : nullptr;
+	if (PC && PC->IsLocalController())
 	{
-		InteractionWidget->HidePrompt();
+		if (UInteractionPromptSubsystem* PromptSubsystem = UInteractionPromptSubsystem::Get(this))
+		{
+			PromptSubsystem->SetFocus(PC, nullptr, nullptr);
+		}
 	}
+
 	LastInteractable = nullptr;
 }
-
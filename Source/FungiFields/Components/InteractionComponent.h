@@ -12,7 +12,7 @@ struct FInputActionValue;
 
 /**
  * Component responsible for handling player interaction with interactable actors.
- * Performs line traces, manages interaction widgets, and handles interaction input.
+ * Performs line traces, focuses interaction prompts, and handles interaction input.
  */
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class FUNGIFIELDS_API UInteractionComponent : public UActorComponent
@@ -55,21 +55,21 @@ protected:
 	void ClearInteractable();
 
 	/**
-	 * Shows the interaction widget with the specified prompt text.
+	 * Focuses the interaction prompt subsystem on an interactable, showing its prompt and those of its neighbours.
 	 * @param Interactable The actor that can be interacted with
 	 * @param Prompt The text to display in the interaction widget
 	 */
 	void ShowInteractionWidget(AActor* Interactable, const FText& Prompt);
 
 	/**
-	 * Hides the interaction widget.
+	 * Clears the prompt subsystem's focus, hiding every prompt.
 	 */
 	void HideInteractionWidget();
 
 protected:
-	/** Widget class to use for displaying interaction prompts */
+	/** Prompt widget for interactables that do not set their own */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Interaction")
-	TSubclassOf<UUserWidget> InteractionWidgetClass;
+	TSubclassOf<UInteractionWidget> InteractionWidgetClass;
 
 	/** Maximum distance for interaction line traces */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Interaction", meta = (ClampMin = "0.0"))
@@ -90,9 +90,5 @@ private:
 
 	/** Timer handle for clearing the widget after losing focus */
 	FTimerHandle InteractableResetTimer;
-
-	/** Instance of the interaction widget */
-	UPROPERTY()
-	UInteractionWidget* InteractionWidget = nullptr;
 };
 
@@ -1,9 +1,23 @@
 #include "InventoryComponent.h"
+#include "ChestInventoryComponent.h"
+#include "../FungiFieldsStats.h"
+#include "../Data/FFarmPrimaryAssets.h"
 #include "../Data/UItemDataAsset.h"
+#include "../Inventory/FPackedInventory.h"
+#include "../Subsystems/FFarmAssetLoading.h"
+#include "../Subsystems/UFarmAssetStartupSubsystem.h"
+#include "../Subsystems/UFarmSaveSubsystem.h"
+#include "../Subsystems/UFarmSimulationSubsystem.h"
+#include "../Subsystems/UItemCatalogSubsystem.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "GameFramework/Character.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "FItemStackRules.h"
 
 struct FInputActionValue;
 
@@ -11,6 +25,7 @@ UInventoryComponent::UInventoryComponent(const FObjectInitializer& ObjectInitial
 	: Super(ObjectInitializer)
 	, bEnableReplication(false)
 	, bSupportsEquipping(true)
+	, InventoryList(this)
 	, CurrentEquippedSlotIndex(INDEX_NONE)
 {
 	PrimaryComponentTick.bCanEverTick = false;
@@ -19,6 +34,9 @@ UInventoryComponent::UInventoryComponent(const FObjectInitializer& ObjectInitial
 void UInventoryComponent::PostInitProperties()
 {
 	Super::PostInitProperties();
+
+	// Instancing copies the list from the archetype, owner and all
+	InventoryList.OwnerComponent = this;
 	
 	if (bEnableReplication)
 	{
@@ -34,18 +52,32 @@ void UInventoryComponent::SetEnableReplication(bool bEnable)
 void UInventoryComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-	
-	if (bEnableReplication)
-	{
-		DOREPLIFETIME(UInventoryComponent, InventorySlots);
-	}
+
+	// Registered unconditionally: replicated properties are gathered once per class, not per instance,
+	// and instances without bEnableReplication never replicate anyway
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(UInventoryComponent, InventoryList, Params);
 }
 
 void UInventoryComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
-	InventorySlots.SetNum(InitialSlotCount);
+	// Replication enabled by the owner's constructor comes after PostInitProperties
+	if (bEnableReplication && !GetIsReplicated())
+	{
+		SetIsReplicated(true);
+	}
+
+	// Replicated slots are created by the server and arrive through the fast array
+	if (!bEnableReplication || GetOwnerRole() == ROLE_Authority)
+	{
+		LLM_SCOPE_BYTAG(Farm_Inventory);
+		InventoryList.Slots.SetNum(InitialSlotCount);
+		InventoryList.MarkArrayDirty();
+		MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryComponent, InventoryList, this);
+	}
 
 	if (bSupportsEquipping && GetOwner())
 	{
@@ -55,6 +87,9 @@ void UInventoryComponent::BeginPlay()
 
 bool UInventoryComponent::TryAddItem(UItemDataAsset* ItemToAdd, int32 Amount)
 {
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmInventoryMutation, "UInventoryComponent::TryAddItem");
+	FScopedFarmSimTiming InventoryTiming(&FFarmSimTimings::InventoryCycles, &FFarmSimTimings::InventoryOpCount);
+
 	if (!ItemToAdd || Amount <= 0)
 	{
 		return false;
@@ -104,16 +139,14 @@ bool UInventoryComponent::TryStackItem(UItemDataAsset* ItemToAdd, int32& Remaini
 
 	bool bStackedAny = false;
 
-	for (FInventorySlot& Slot : InventorySlots)
+	for (int32 SlotIndex = 0; SlotIndex < InventoryList.Slots.Num(); ++SlotIndex)
 	{
+		FInventorySlot& Slot = InventoryList.Slots[SlotIndex];
 		if (Slot.ItemDefinition == ItemToAdd && Slot.Count < ItemToAdd->MaxStackSize)
 		{
-			int32 SpaceAvailable = ItemToAdd->MaxStackSize - Slot.Count;
-			int32 AmountToAdd = FMath::Min(RemainingAmount, SpaceAvailable);
-
-			Slot.Count += AmountToAdd;
-			RemainingAmount -= AmountToAdd;
+			FItemStackRules::AddToStack(Slot.Count, ItemToAdd->MaxStackSize, RemainingAmount);
 			bStackedAny = true;
+			MarkSlotDirty(SlotIndex);
 
 			if (RemainingAmount <= 0)
 			{
@@ -132,13 +165,13 @@ bool UInventoryComponent::AddToNewSlot(UItemDataAsset* ItemToAdd, int32 Amount)
 		return false;
 	}
 
-	for (FInventorySlot& Slot : InventorySlots)
+	for (int32 SlotIndex = 0; SlotIndex < InventoryList.Slots.Num(); ++SlotIndex)
 	{
+		FInventorySlot& Slot = InventoryList.Slots[SlotIndex];
 		if (Slot.IsEmpty())
 		{
-			int32 AmountToAdd = FMath::Min(Amount, ItemToAdd->MaxStackSize);
-			Slot.ItemDefinition = ItemToAdd;
-			Slot.Count = AmountToAdd;
+			Slot.SetContents(ItemToAdd, FItemStackRules::GetNewStackCount(Amount, ItemToAdd->MaxStackSize));
+			MarkSlotDirty(SlotIndex);
 			return true;
 		}
 	}
@@ -152,12 +185,72 @@ void UInventoryComponent::BroadcastUpdate()
 	{
 		UpdateEquippedItemMesh();
 	}
+
+	if (PendingChangedSlots.Num() > 0)
+	{
+		// Icons of newly owned items start loading before a slot widget asks for them
+		if (GetNetMode() != NM_DedicatedServer)
+		{
+			if (UFarmAssetStartupSubsystem* AssetStartup = UFarmAssetStartupSubsystem::Get(this))
+			{
+				for (const int32 SlotIndex : PendingChangedSlots)
+				{
+					if (InventoryList.Slots.IsValidIndex(SlotIndex) && InventoryList.Slots[SlotIndex].HasItem())
+					{
+						AssetStartup->RequestItemBundle(InventoryList.Slots[SlotIndex].ItemDefinition, FFarmPrimaryAssets::UIBundle);
+					}
+				}
+			}
+		}
+
+		OnInventorySlotsChanged.Broadcast(PendingChangedSlots);
+		PendingChangedSlots.Reset();
+	}
+
 	OnInventoryChanged.Broadcast();
 }
 
-void UInventoryComponent::OnRep_InventorySlots()
+void UInventoryComponent::MarkSlotDirty(int32 SlotIndex)
 {
-	BroadcastUpdate();
+	if (!InventoryList.Slots.IsValidIndex(SlotIndex))
+	{
+		return;
+	}
+
+	PendingChangedSlots.AddUnique(SlotIndex);
+
+	// Client predictions change slots locally; only the server's changes replicate
+	if (bEnableReplication && GetOwnerRole() == ROLE_Authority)
+	{
+		InventoryList.MarkItemDirty(InventoryList.Slots[SlotIndex]);
+		MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryComponent, InventoryList, this);
+	}
+
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		if (UFarmSaveSubsystem* FarmSave = UFarmSaveSubsystem::Get(this))
+		{
+			FarmSave->JournalInventory(this);
+		}
+	}
+}
+
+void UInventoryComponent::NotifySlotsReplicated(const TArrayView<int32>& SlotIndices)
+{
+	for (const int32 SlotIndex : SlotIndices)
+	{
+		PendingChangedSlots.AddUnique(SlotIndex);
+	}
+}
+
+void UInventoryComponent::FlushChangedSlots()
+{
+	LoadPendingItems();
+
+	if (PendingChangedSlots.Num() > 0)
+	{
+		BroadcastUpdate();
+	}
 }
 
 void UInventoryComponent::UpdateEquippedItemMesh()
@@ -196,20 +289,31 @@ void UInventoryComponent::UpdateEquippedItemMesh()
 		return;
 	}
 
-	if (!InventorySlots.IsValidIndex(CurrentEquippedSlotIndex))
+	if (!InventoryList.Slots.IsValidIndex(CurrentEquippedSlotIndex))
 	{
 		return;
 	}
 
-	const FInventorySlot& EquippedSlot = InventorySlots[CurrentEquippedSlotIndex];
+	const FInventorySlot& EquippedSlot = InventoryList.Slots[CurrentEquippedSlotIndex];
 	if (EquippedSlot.IsEmpty() || !EquippedSlot.ItemDefinition)
 	{
 		return;
 	}
 
-	UStaticMesh* ItemMesh = EquippedSlot.ItemDefinition->ItemMesh;
+	const TSoftObjectPtr<UStaticMesh>& ItemMeshReference = EquippedSlot.ItemDefinition->ItemMesh;
+	UStaticMesh* ItemMesh = ItemMeshReference.Get();
 	if (!ItemMesh)
 	{
+		// Loaded the first time the item is equipped; attached when it arrives. A mesh that failed to load is not requested again
+		const FSoftObjectPath ItemMeshPath = ItemMeshReference.ToSoftObjectPath();
+		if (!ItemMeshPath.IsNull() && ItemMeshPath != RequestedItemMeshPath)
+		{
+			RequestedItemMeshPath = ItemMeshPath;
+			ItemMeshLoadHandle = FFarmAssetLoading::Prefetch({ ItemMeshPath }, FStreamableDelegate::CreateWeakLambda(this, [this]()
+			{
+				UpdateEquippedItemMesh();
+			}));
+		}
 		return;
 	}
 
@@ -243,7 +347,7 @@ void UInventoryComponent::EquipSlot(const FInputActionValue& Value, int32 SlotIn
 
 	const int32 HotbarSize = 9;
 	
-	if (SlotIndex < 0 || SlotIndex >= HotbarSize || SlotIndex >= InventorySlots.Num())
+	if (SlotIndex < 0 || SlotIndex >= HotbarSize || SlotIndex >= InventoryList.Slots.Num())
 	{
 		return;
 	}
@@ -251,9 +355,9 @@ void UInventoryComponent::EquipSlot(const FInputActionValue& Value, int32 SlotIn
 	CurrentEquippedSlotIndex = SlotIndex;
 	
 	UItemDataAsset* EquippedItem = nullptr;
-	if (InventorySlots.IsValidIndex(SlotIndex) && !InventorySlots[SlotIndex].IsEmpty())
+	if (InventoryList.Slots.IsValidIndex(SlotIndex) && !InventoryList.Slots[SlotIndex].IsEmpty())
 	{
-		EquippedItem = const_cast<UItemDataAsset*>(InventorySlots[SlotIndex].ItemDefinition.Get());
+		EquippedItem = const_cast<UItemDataAsset*>(InventoryList.Slots[SlotIndex].ItemDefinition.Get());
 	}
 	
 	UpdateEquippedItemMesh();
@@ -268,18 +372,21 @@ void UInventoryComponent::EquipSlot(const FInputActionValue& Value, int32 SlotIn
 
 bool UInventoryComponent::ConsumeFromSlot(int32 SlotIndex, int32 Amount)
 {
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmInventoryMutation, "UInventoryComponent::ConsumeFromSlot");
+	FScopedFarmSimTiming InventoryTiming(&FFarmSimTimings::InventoryCycles, &FFarmSimTimings::InventoryOpCount);
+
 	if (Amount <= 0)
 	{
 		return false;
 	}
 
-	if (!InventorySlots.IsValidIndex(SlotIndex))
+	if (!InventoryList.Slots.IsValidIndex(SlotIndex))
 	{
 		return false;
 	}
 
-	FInventorySlot& Slot = InventorySlots[SlotIndex];
-	if (Slot.IsEmpty())
+	FInventorySlot& Slot = InventoryList.Slots[SlotIndex];
+	if (!Slot.HasItem())
 	{
 		return false;
 	}
@@ -300,6 +407,8 @@ bool UInventoryComponent::ConsumeFromSlot(int32 SlotIndex, int32 Amount)
 		return false;
 	}
 
+	MarkSlotDirty(SlotIndex);
+
 	if (bSupportsEquipping && CurrentEquippedSlotIndex == SlotIndex)
 	{
 		UpdateEquippedItemMesh();
@@ -314,23 +423,36 @@ bool UInventoryComponent::ConsumeFromSlot(int32 SlotIndex, int32 Amount)
 
 bool UInventoryComponent::RemoveFromSlot(int32 SlotIndex, int32 Amount)
 {
-	if (bEnableReplication && GetOwnerRole() != ROLE_Authority)
+	if (ShouldQueueCommands())
 	{
-		return false;
+		return QueueCommand(EInventoryCommandType::Remove, SlotIndex, 0, nullptr, Amount);
 	}
 
+	const bool bRemoved = RemoveFromSlotInternal(SlotIndex, Amount);
+	if (bRemoved)
+	{
+		RecordCommand(MakeCommand(EInventoryCommandType::Remove, SlotIndex, 0, nullptr, Amount));
+	}
+	return bRemoved;
+}
+
+bool UInventoryComponent::RemoveFromSlotInternal(int32 SlotIndex, int32 Amount)
+{
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmInventoryMutation, "UInventoryComponent::RemoveFromSlot");
+	FScopedFarmSimTiming InventoryTiming(&FFarmSimTimings::InventoryCycles, &FFarmSimTimings::InventoryOpCount);
+
 	if (Amount <= 0)
 	{
 		return false;
 	}
 
-	if (!InventorySlots.IsValidIndex(SlotIndex))
+	if (!InventoryList.Slots.IsValidIndex(SlotIndex))
 	{
 		return false;
 	}
 
-	FInventorySlot& Slot = InventorySlots[SlotIndex];
-	if (Slot.IsEmpty())
+	FInventorySlot& Slot = InventoryList.Slots[SlotIndex];
+	if (!Slot.HasItem())
 	{
 		return false;
 	}
@@ -340,10 +462,11 @@ bool UInventoryComponent::RemoveFromSlot(int32 SlotIndex, int32 Amount)
 
 	if (Slot.Count <= 0)
 	{
-		Slot.ItemDefinition = nullptr;
-		Slot.Count = 0;
+		Slot.Clear();
 	}
 
+	MarkSlotDirty(SlotIndex);
+
 	if (bSupportsEquipping && CurrentEquippedSlotIndex == SlotIndex)
 	{
 		UpdateEquippedItemMesh();
@@ -361,7 +484,7 @@ int32 UInventoryComponent::GetItemTotalCount(UItemDataAsset* Item) const
 	}
 
 	int32 TotalCount = 0;
-	for (const FInventorySlot& Slot : InventorySlots)
+	for (const FInventorySlot& Slot : InventoryList.Slots)
 	{
 		if (Slot.ItemDefinition == Item)
 		{
@@ -374,12 +497,25 @@ int32 UInventoryComponent::GetItemTotalCount(UItemDataAsset* Item) const
 
 bool UInventoryComponent::MoveItemToSlot(int32 FromSlotIndex, int32 ToSlotIndex)
 {
-	if (bEnableReplication && GetOwnerRole() != ROLE_Authority)
+	if (ShouldQueueCommands())
 	{
-		return false;
+		return QueueCommand(EInventoryCommandType::Move, FromSlotIndex, ToSlotIndex, nullptr, 0);
+	}
+
+	const bool bMoved = MoveItemToSlotInternal(FromSlotIndex, ToSlotIndex);
+	if (bMoved)
+	{
+		RecordCommand(MakeCommand(EInventoryCommandType::Move, FromSlotIndex, ToSlotIndex, nullptr, 0));
 	}
+	return bMoved;
+}
+
+bool UInventoryComponent::MoveItemToSlotInternal(int32 FromSlotIndex, int32 ToSlotIndex)
+{
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmInventoryMutation, "UInventoryComponent::MoveItemToSlot");
+	FScopedFarmSimTiming InventoryTiming(&FFarmSimTimings::InventoryCycles, &FFarmSimTimings::InventoryOpCount);
 
-	if (!InventorySlots.IsValidIndex(FromSlotIndex) || !InventorySlots.IsValidIndex(ToSlotIndex))
+	if (!InventoryList.Slots.IsValidIndex(FromSlotIndex) || !InventoryList.Slots.IsValidIndex(ToSlotIndex))
 	{
 		return false;
 	}
@@ -389,8 +525,8 @@ bool UInventoryComponent::MoveItemToSlot(int32 FromSlotIndex, int32 ToSlotIndex)
 		return false;
 	}
 
-	FInventorySlot& FromSlot = InventorySlots[FromSlotIndex];
-	FInventorySlot& ToSlot = InventorySlots[ToSlotIndex];
+	FInventorySlot& FromSlot = InventoryList.Slots[FromSlotIndex];
+	FInventorySlot& ToSlot = InventoryList.Slots[ToSlotIndex];
 
 	if (FromSlot.IsEmpty())
 	{
@@ -399,9 +535,10 @@ bool UInventoryComponent::MoveItemToSlot(int32 FromSlotIndex, int32 ToSlotIndex)
 
 	if (ToSlot.IsEmpty())
 	{
-		ToSlot = FromSlot;
-		FromSlot.ItemDefinition = nullptr;
-		FromSlot.Count = 0;
+		ToSlot.CopyContents(FromSlot);
+		FromSlot.Clear();
+		MarkSlotDirty(FromSlotIndex);
+		MarkSlotDirty(ToSlotIndex);
 		
 		if (bSupportsEquipping)
 		{
@@ -419,21 +556,21 @@ bool UInventoryComponent::MoveItemToSlot(int32 FromSlotIndex, int32 ToSlotIndex)
 		return true;
 	}
 
-	if (FromSlot.ItemDefinition == ToSlot.ItemDefinition)
+	// Slots still waiting for their item only swap
+	if (FromSlot.HasItem() && FromSlot.ItemDefinition == ToSlot.ItemDefinition)
 	{
-		int32 SpaceAvailable = ToSlot.ItemDefinition->MaxStackSize - ToSlot.Count;
-		if (SpaceAvailable > 0)
+		if (FItemStackRules::GetSpace(ToSlot.Count, ToSlot.ItemDefinition->MaxStackSize) > 0)
 		{
-			int32 AmountToMove = FMath::Min(FromSlot.Count, SpaceAvailable);
-			ToSlot.Count += AmountToMove;
-			FromSlot.Count -= AmountToMove;
+			FItemStackRules::AddToStack(ToSlot.Count, ToSlot.ItemDefinition->MaxStackSize, FromSlot.Count);
 
 			if (FromSlot.Count <= 0)
 			{
-				FromSlot.ItemDefinition = nullptr;
-				FromSlot.Count = 0;
+				FromSlot.Clear();
 			}
 
+			MarkSlotDirty(FromSlotIndex);
+			MarkSlotDirty(ToSlotIndex);
+
 			if (bSupportsEquipping)
 			{
 				if (CurrentEquippedSlotIndex == FromSlotIndex && FromSlot.IsEmpty())
@@ -451,17 +588,30 @@ bool UInventoryComponent::MoveItemToSlot(int32 FromSlotIndex, int32 ToSlotIndex)
 		}
 	}
 
-	return SwapSlots(FromSlotIndex, ToSlotIndex);
+	return SwapSlotsInternal(FromSlotIndex, ToSlotIndex);
 }
 
 bool UInventoryComponent::SwapSlots(int32 SlotAIndex, int32 SlotBIndex)
 {
-	if (bEnableReplication && GetOwnerRole() != ROLE_Authority)
+	if (ShouldQueueCommands())
 	{
-		return false;
+		return QueueCommand(EInventoryCommandType::Swap, SlotAIndex, SlotBIndex, nullptr, 0);
 	}
 
-	if (!InventorySlots.IsValidIndex(SlotAIndex) || !InventorySlots.IsValidIndex(SlotBIndex))
+	const bool bSwapped = SwapSlotsInternal(SlotAIndex, SlotBIndex);
+	if (bSwapped)
+	{
+		RecordCommand(MakeCommand(EInventoryCommandType::Swap, SlotAIndex, SlotBIndex, nullptr, 0));
+	}
+	return bSwapped;
+}
+
+bool UInventoryComponent::SwapSlotsInternal(int32 SlotAIndex, int32 SlotBIndex)
+{
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmInventoryMutation, "UInventoryComponent::SwapSlots");
+	FScopedFarmSimTiming InventoryTiming(&FFarmSimTimings::InventoryCycles, &FFarmSimTimings::InventoryOpCount);
+
+	if (!InventoryList.Slots.IsValidIndex(SlotAIndex) || !InventoryList.Slots.IsValidIndex(SlotBIndex))
 	{
 		return false;
 	}
@@ -471,9 +621,9 @@ bool UInventoryComponent::SwapSlots(int32 SlotAIndex, int32 SlotBIndex)
 		return false;
 	}
 
-	FInventorySlot Temp = InventorySlots[SlotAIndex];
-	InventorySlots[SlotAIndex] = InventorySlots[SlotBIndex];
-	InventorySlots[SlotBIndex] = Temp;
+	InventoryList.Slots[SlotAIndex].SwapContents(InventoryList.Slots[SlotBIndex]);
+	MarkSlotDirty(SlotAIndex);
+	MarkSlotDirty(SlotBIndex);
 
 	if (bSupportsEquipping)
 	{
@@ -491,4 +641,517 @@ bool UInventoryComponent::SwapSlots(int32 SlotAIndex, int32 SlotBIndex)
 
 	BroadcastUpdate();
 	return true;
-}
\ No newline at end of file
+}
+
+bool UInventoryComponent::TransferSlotTo(int32 SlotIndex, UInventoryComponent* TargetInventory)
+{
+	if (!TargetInventory)
+	{
+		return false;
+	}
+
+	if (ShouldQueueCommands() || TargetInventory->ShouldQueueCommands())
+	{
+		return QueueCommand(EInventoryCommandType::Transfer, SlotIndex, 0, TargetInventory, 0);
+	}
+
+	const bool bTransferred = TransferSlotInternal(SlotIndex, TargetInventory);
+	if (bTransferred)
+	{
+		RecordCommand(MakeCommand(EInventoryCommandType::Transfer, SlotIndex, 0, TargetInventory, 0));
+	}
+	return bTransferred;
+}
+
+bool UInventoryComponent::TransferSlotInternal(int32 SlotIndex, UInventoryComponent* TargetInventory)
+{
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmInventoryMutation, "UInventoryComponent::TransferSlotTo");
+	FScopedFarmSimTiming InventoryTiming(&FFarmSimTimings::InventoryCycles, &FFarmSimTimings::InventoryOpCount);
+
+	if (!TargetInventory || TargetInventory == this || !InventoryList.Slots.IsValidIndex(SlotIndex))
+	{
+		return false;
+	}
+
+	const FInventorySlot& Slot = InventoryList.Slots[SlotIndex];
+	if (!Slot.HasItem())
+	{
+		return false;
+	}
+
+	UItemDataAsset* Item = const_cast<UItemDataAsset*>(Slot.ItemDefinition.Get());
+	const int32 Amount = Slot.Count;
+	int32 RemainingAmount = Amount;
+
+	TargetInventory->TryStackItem(Item, RemainingAmount);
+	if (RemainingAmount > 0 && TargetInventory->AddToNewSlot(Item, RemainingAmount))
+	{
+		RemainingAmount -= FItemStackRules::GetNewStackCount(RemainingAmount, Item->MaxStackSize);
+	}
+
+	const int32 MovedAmount = Amount - RemainingAmount;
+	if (MovedAmount <= 0)
+	{
+		return false;
+	}
+
+	TargetInventory->BroadcastUpdate();
+	TargetInventory->OnItemAdded.Broadcast(Item, MovedAmount, TargetInventory->GetItemTotalCount(Item));
+
+	return ConsumeFromSlot(SlotIndex, MovedAmount);
+}
+
+void UInventoryComponent::ForceSlotResync(int32 SlotIndex)
+{
+	if (!bEnableReplication || GetOwnerRole() != ROLE_Authority || !InventoryList.Slots.IsValidIndex(SlotIndex))
+	{
+		return;
+	}
+
+	InventoryList.MarkItemDirty(InventoryList.Slots[SlotIndex]);
+	MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryComponent, InventoryList, this);
+}
+
+void UInventoryComponent::RestorePackedSlots(const FPackedInventory& SavedSlots)
+{
+	if (GetOwnerRole() != ROLE_Authority)
+	{
+		return;
+	}
+
+	TArray<FInventorySlot> Slots;
+	SavedSlots.Unpack(Slots);
+	Slots.SetNum(InventoryList.Slots.Num());
+
+	RestoreSlots(Slots);
+}
+
+bool UInventoryComponent::ShouldQueueCommands() const
+{
+	return bEnableReplication && GetOwnerRole() != ROLE_Authority;
+}
+
+UInventoryComponent* UInventoryComponent::FindCommandIssuer() const
+{
+	if (GetOwnerRole() == ROLE_AutonomousProxy)
+	{
+		return const_cast<UInventoryComponent*>(this);
+	}
+
+	const UWorld* World = GetWorld();
+	const APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+	const APawn* Pawn = PC ? PC->GetPawn() : nullptr;
+	UInventoryComponent* Issuer = Pawn ? Pawn->FindComponentByClass<UInventoryComponent>() : nullptr;
+
+	if (!Issuer || Issuer->GetOwnerRole() != ROLE_AutonomousProxy || !Issuer->GetIsReplicated())
+	{
+		return nullptr;
+	}
+
+	return Issuer;
+}
+
+bool UInventoryComponent::QueueCommand(EInventoryCommandType Type, int32 SlotIndex, int32 OtherSlotIndex, UInventoryComponent* OtherInventory, int32 Amount)
+{
+	if (!InventoryList.Slots.IsValidIndex(SlotIndex) || SlotIndex > MAX_uint16 || OtherSlotIndex < 0 || OtherSlotIndex > MAX_uint16)
+	{
+		return false;
+	}
+
+	UInventoryComponent* Issuer = FindCommandIssuer();
+	if (!Issuer)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UInventoryComponent::QueueCommand: No replicated local player inventory to send commands through"));
+		return false;
+	}
+
+	return Issuer->SubmitCommand(MakeCommand(Type, SlotIndex, OtherSlotIndex, OtherInventory, Amount));
+}
+
+FInventoryCommand UInventoryComponent::MakeCommand(EInventoryCommandType Type, int32 SlotIndex, int32 OtherSlotIndex, UInventoryComponent* OtherInventory, int32 Amount)
+{
+	FInventoryCommand Command;
+	Command.Type = Type;
+	Command.Inventory = this;
+	Command.SlotIndex = static_cast<uint16>(SlotIndex);
+	Command.OtherSlotIndex = static_cast<uint16>(OtherSlotIndex);
+	Command.OtherInventory = OtherInventory;
+	Command.Amount = Amount;
+	return Command;
+}
+
+bool UInventoryComponent::SubmitCommand(FInventoryCommand Command)
+{
+	if (!Command.Inventory)
+	{
+		return false;
+	}
+
+	FPredictedInventoryCommand Prediction;
+	Prediction.Command = Command;
+
+	if (!PredictCommand(Prediction))
+	{
+		return false;
+	}
+
+	Command.Sequence = ++LastCommandSequence;
+	Prediction.Command.Sequence = Command.Sequence;
+
+	PendingCommands.Add(Command);
+	PredictedCommands.Add(MoveTemp(Prediction));
+
+	if (!bCommandFlushScheduled)
+	{
+		if (UWorld* World = GetWorld())
+		{
+			World->GetTimerManager().SetTimerForNextTick(this, &UInventoryComponent::FlushCommands);
+			bCommandFlushScheduled = true;
+		}
+	}
+
+	return true;
+}
+
+void UInventoryComponent::FlushCommands()
+{
+	bCommandFlushScheduled = false;
+
+	if (PendingCommands.Num() == 0)
+	{
+		return;
+	}
+
+	ServerExecuteCommands(PendingCommands);
+	PendingCommands.Reset();
+}
+
+bool UInventoryComponent::ApplyCommand(const FInventoryCommand& Command)
+{
+	UInventoryComponent* Inventory = Command.Inventory;
+	if (!Inventory)
+	{
+		return false;
+	}
+
+	switch (Command.Type)
+	{
+	case EInventoryCommandType::Move:
+		return Inventory->MoveItemToSlotInternal(Command.SlotIndex, Command.OtherSlotIndex);
+	case EInventoryCommandType::Swap:
+		return Inventory->SwapSlotsInternal(Command.SlotIndex, Command.OtherSlotIndex);
+	case EInventoryCommandType::Remove:
+		return Inventory->RemoveFromSlotInternal(Command.SlotIndex, Command.Amount);
+	case EInventoryCommandType::Transfer:
+		return Inventory->TransferSlotInternal(Command.SlotIndex, Command.OtherInventory);
+	default:
+		return false;
+	}
+}
+
+bool UInventoryComponent::PredictCommand(FPredictedInventoryCommand& Prediction)
+{
+	const FInventoryCommand& Command = Prediction.Command;
+	Prediction.ChangedSlots.Reset();
+
+	UInventoryComponent* Inventory = Command.Inventory;
+	if (!Inventory)
+	{
+		return false;
+	}
+
+	auto CaptureSlot = [&Prediction](UInventoryComponent* SlotInventory, int32 SlotIndex)
+	{
+		if (SlotInventory->InventoryList.Slots.IsValidIndex(SlotIndex))
+		{
+			Prediction.ChangedSlots.Add({ SlotInventory, SlotIndex, SlotInventory->InventoryList.Slots[SlotIndex] });
+		}
+	};
+
+	CaptureSlot(Inventory, Command.SlotIndex);
+	if (Command.Type == EInventoryCommandType::Move || Command.Type == EInventoryCommandType::Swap)
+	{
+		CaptureSlot(Inventory, Command.OtherSlotIndex);
+	}
+	else if (Command.Type == EInventoryCommandType::Transfer && Command.OtherInventory)
+	{
+		// A transfer may stack into any slot of the receiving inventory
+		for (int32 SlotIndex = 0; SlotIndex < Command.OtherInventory->InventoryList.Slots.Num(); ++SlotIndex)
+		{
+			if (Command.OtherInventory != Inventory || SlotIndex != Command.SlotIndex)
+			{
+				CaptureSlot(Command.OtherInventory, SlotIndex);
+			}
+		}
+	}
+
+	if (!ApplyCommand(Command))
+	{
+		Prediction.ChangedSlots.Reset();
+		return false;
+	}
+
+	// Keep only the slots the command actually changed
+	Prediction.ChangedSlots.RemoveAll([](const FInventorySlotSnapshot& Snapshot)
+	{
+		const FInventorySlot& Slot = Snapshot.Inventory->InventoryList.Slots[Snapshot.SlotIndex];
+		return Slot.HasSameContents(Snapshot.Contents);
+	});
+
+	return true;
+}
+
+void UInventoryComponent::RecordCommand(const FInventoryCommand& Command)
+{
+	if (UFarmSimulationSubsystem* Simulation = UFarmSimulationSubsystem::Get(Command.Inventory))
+	{
+		Simulation->RecordInventoryCommand(Command);
+	}
+}
+
+bool UInventoryComponent::CanCommandInventory(const UInventoryComponent* Inventory) const
+{
+	if (!Inventory)
+	{
+		return false;
+	}
+
+	if (Inventory == this)
+	{
+		return true;
+	}
+
+	const AActor* Owner = GetOwner();
+	const AActor* InventoryOwner = Inventory->GetOwner();
+	if (!Owner || !InventoryOwner || !Inventory->bEnableReplication || InventoryOwner->IsA<APawn>())
+	{
+		return false;
+	}
+
+	return FVector::DistSquared(Owner->GetActorLocation(), InventoryOwner->GetActorLocation()) <= FMath::Square(MaxRemoteInventoryDistance);
+}
+
+void UInventoryComponent::ServerSetViewingChest_Implementation(UChestInventoryComponent* Chest, bool bViewing)
+{
+	const APawn* OwnerPawn = Cast<APawn>(GetOwner());
+	APlayerController* Viewer = OwnerPawn ? Cast<APlayerController>(OwnerPawn->GetController()) : nullptr;
+	if (!Chest || !Viewer)
+	{
+		return;
+	}
+
+	if (!bViewing)
+	{
+		Chest->RemoveViewer(Viewer);
+		return;
+	}
+
+	// Opening a chest out of reach would stream its contents to a player who cannot use them
+	if (!CanCommandInventory(Chest))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UInventoryComponent::ServerSetViewingChest: %s is out of reach of %s"), *GetNameSafe(Chest->GetOwner()), *GetNameSafe(OwnerPawn));
+		return;
+	}
+
+	Chest->AddViewer(Viewer);
+}
+
+void UInventoryComponent::ServerExecuteCommands_Implementation(const TArray<FInventoryCommand>& Commands)
+{
+	if (Commands.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<uint16> RejectedSequences;
+
+	for (int32 Index = 0; Index < Commands.Num(); ++Index)
+	{
+		const FInventoryCommand& Command = Commands[Index];
+		const bool bTransfer = Command.Type == EInventoryCommandType::Transfer;
+		const bool bAllowed = Index < MaxCommandsPerBatch
+			&& CanCommandInventory(Command.Inventory)
+			&& (!bTransfer || CanCommandInventory(Command.OtherInventory));
+
+		if (bAllowed && ApplyCommand(Command))
+		{
+			RecordCommand(Command);
+			continue;
+		}
+
+		RejectedSequences.Add(Command.Sequence);
+
+		// The client already predicted this command; resend what it touched so its copy converges
+		if (UInventoryComponent* Inventory = Command.Inventory)
+		{
+			Inventory->ForceSlotResync(Command.SlotIndex);
+			if (Command.Type == EInventoryCommandType::Move || Command.Type == EInventoryCommandType::Swap)
+			{
+				Inventory->ForceSlotResync(Command.OtherSlotIndex);
+			}
+		}
+
+		if (bTransfer && Command.OtherInventory)
+		{
+			for (int32 SlotIndex = 0; SlotIndex < Command.OtherInventory->GetMaxSlots(); ++SlotIndex)
+			{
+				Command.OtherInventory->ForceSlotResync(SlotIndex);
+			}
+		}
+	}
+
+	ClientAckCommands(Commands.Last().Sequence, RejectedSequences);
+}
+
+void UInventoryComponent::ClientAckCommands_Implementation(uint16 LastSequence, const TArray<uint16>& RejectedSequences)
+{
+	const int32 FirstRejected = PredictedCommands.IndexOfByPredicate([&RejectedSequences](const FPredictedInventoryCommand& Predicted)
+	{
+		return RejectedSequences.Contains(Predicted.Command.Sequence);
+	});
+
+	if (FirstRejected != INDEX_NONE)
+	{
+		TArray<UInventoryComponent*, TInlineAllocator<2>> RestoredInventories;
+
+		// Undo newest first back to the oldest rejected command, so each slot ends as it was before that command
+		for (int32 Index = PredictedCommands.Num() - 1; Index >= FirstRejected; --Index)
+		{
+			const TArray<FInventorySlotSnapshot, TInlineAllocator<2>>& ChangedSlots = PredictedCommands[Index].ChangedSlots;
+			for (int32 SlotIndex = ChangedSlots.Num() - 1; SlotIndex >= 0; --SlotIndex)
+			{
+				const FInventorySlotSnapshot& Snapshot = ChangedSlots[SlotIndex];
+				if (UInventoryComponent* Inventory = Snapshot.Inventory.Get())
+				{
+					Inventory->RestoreSlot(Snapshot.SlotIndex, Snapshot.Contents);
+					RestoredInventories.AddUnique(Inventory);
+				}
+			}
+		}
+
+		// Predict the commands the server did not reject again on top; the server's state replaces them once it arrives
+		for (int32 Index = FirstRejected; Index < PredictedCommands.Num(); ++Index)
+		{
+			FPredictedInventoryCommand& Prediction = PredictedCommands[Index];
+			if (RejectedSequences.Contains(Prediction.Command.Sequence))
+			{
+				UE_LOG(LogTemp, Verbose, TEXT("UInventoryComponent::ClientAckCommands: Server rejected command %d, rolling back"), Prediction.Command.Sequence);
+				Prediction.ChangedSlots.Reset();
+				continue;
+			}
+
+			if (!PredictCommand(Prediction))
+			{
+				UE_LOG(LogTemp, Verbose, TEXT("UInventoryComponent::ClientAckCommands: Command %d no longer applies after rollback"), Prediction.Command.Sequence);
+			}
+		}
+
+		for (UInventoryComponent* Inventory : RestoredInventories)
+		{
+			if (Inventory->PendingChangedSlots.Num() > 0)
+			{
+				Inventory->BroadcastUpdate();
+			}
+		}
+	}
+
+	while (PredictedCommands.Num() > 0)
+	{
+		const bool bLastInBatch = PredictedCommands[0].Command.Sequence == LastSequence;
+		PredictedCommands.RemoveAt(0);
+		if (bLastInBatch)
+		{
+			break;
+		}
+	}
+}
+
+void UInventoryComponent::RestoreSlots(const TArray<FInventorySlot>& Snapshot)
+{
+	const int32 NumSlots = FMath::Min(Snapshot.Num(), InventoryList.Slots.Num());
+	for (int32 SlotIndex = 0; SlotIndex < NumSlots; ++SlotIndex)
+	{
+		FInventorySlot& Slot = InventoryList.Slots[SlotIndex];
+		const FInventorySlot& Saved = Snapshot[SlotIndex];
+		if (!Slot.HasSameContents(Saved))
+		{
+			Slot.CopyContents(Saved);
+			MarkSlotDirty(SlotIndex);
+		}
+	}
+
+	LoadPendingItems();
+
+	if (PendingChangedSlots.Num() > 0)
+	{
+		BroadcastUpdate();
+	}
+}
+
+void UInventoryComponent::RestoreSlot(int32 SlotIndex, const FInventorySlot& Saved)
+{
+	if (!InventoryList.Slots.IsValidIndex(SlotIndex))
+	{
+		return;
+	}
+
+	FInventorySlot& Slot = InventoryList.Slots[SlotIndex];
+	if (!Slot.HasSameContents(Saved))
+	{
+		Slot.CopyContents(Saved);
+		MarkSlotDirty(SlotIndex);
+	}
+}
+
+void UInventoryComponent::LoadPendingItems()
+{
+	UItemCatalogSubsystem* Catalog = UItemCatalogSubsystem::Get(this);
+	if (!Catalog)
+	{
+		return;
+	}
+
+	for (const FInventorySlot& Slot : InventoryList.Slots)
+	{
+		if (!Slot.IsPendingLoad() || LoadingItemIds.Contains(Slot.PendingItemId))
+		{
+			continue;
+		}
+
+		const int32 ItemId = Slot.PendingItemId;
+		LoadingItemIds.Add(ItemId);
+		Catalog->LoadItemAsync(ItemId, FOnCatalogItemLoaded::CreateWeakLambda(this, [this, ItemId](UItemDataAsset* Item)
+		{
+			OnPendingItemLoaded(ItemId, Item);
+		}));
+	}
+}
+
+void UInventoryComponent::OnPendingItemLoaded(int32 ItemId, UItemDataAsset* Item)
+{
+	LoadingItemIds.Remove(ItemId);
+
+	for (int32 SlotIndex = 0; SlotIndex < InventoryList.Slots.Num(); ++SlotIndex)
+	{
+		FInventorySlot& Slot = InventoryList.Slots[SlotIndex];
+		if (Slot.PendingItemId != ItemId)
+		{
+			continue;
+		}
+
+		if (Item)
+		{
+			Slot.SetContents(Item, Slot.Count);
+		}
+		else
+		{
+			Slot.Clear();
+		}
+		MarkSlotDirty(SlotIndex);
+	}
+
+	if (PendingChangedSlots.Num() > 0)
+	{
+		BroadcastUpdate();
+	}
+}
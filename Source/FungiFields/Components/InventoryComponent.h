@@ -3,13 +3,18 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "../Inventory/FInventorySlot.h"
+#include "../Inventory/FInventorySlotList.h"
+#include "../Inventory/FInventoryCommand.h"
 #include "InventoryComponent.generated.h"
 
 struct FInputActionValue;
+struct FPackedInventory;
+class UChestInventoryComponent;
 class UItemDataAsset;
 class UStaticMeshComponent;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnInventoryChanged);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnInventorySlotsChanged, const TArray<int32>&, ChangedSlots);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnItemAdded, UItemDataAsset*, Item, int32, Amount, int32, NewTotal);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnItemRemoved, UItemDataAsset*, Item, int32, Amount, int32, NewTotal);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnItemEquipped, UItemDataAsset*, Item, int32, SlotIndex);
@@ -18,6 +23,9 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnItemEquipped, UItemDataAsset*, I
  * Generic inventory component that can be used for players, chests, or any actor.
  * Handles item storage, stacking, and slot management.
  * Supports optional equipping (for characters) and optional replication (for multiplayer).
+ * Replicated inventories use a push-model fast array, so only dirtied slots are sent.
+ * On clients, slot operations on replicated inventories are predicted locally and queued as commands on the local
+ * player's inventory, which sends them to the server as one batched RPC per frame.
  */
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class FUNGIFIELDS_API UInventoryComponent : public UActorComponent
@@ -33,10 +41,10 @@ public:
 	bool TryAddItem(UItemDataAsset* ItemToAdd, int32 Amount = 1);
 
 	UFUNCTION(BlueprintPure, Category = "Inventory")
-	int32 GetMaxSlots() const { return InventorySlots.Num(); }
+	int32 GetMaxSlots() const { return InventoryList.Slots.Num(); }
 
 	UFUNCTION(BlueprintPure, Category = "Inventory")
-	const TArray<FInventorySlot>& GetInventorySlots() const { return InventorySlots; }
+	const TArray<FInventorySlot>& GetInventorySlots() const { return InventoryList.Slots; }
 
 	/**
 	 * Equip an item from a slot. Only works if bSupportsEquipping is true.
@@ -83,12 +91,39 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	bool RemoveFromSlot(int32 SlotIndex, int32 Amount);
 
+	/**
+	 * Move as much of a slot's contents as fits into another inventory, stacking first.
+	 * @param SlotIndex Index of the slot to move from
+	 * @param TargetInventory Inventory to move the items into
+	 * @return True if any items were moved
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	bool TransferSlotTo(int32 SlotIndex, UInventoryComponent* TargetInventory);
+
+	/**
+	 * Server: resend a slot to clients even though it has not changed, overwriting any client prediction.
+	 * @param SlotIndex Index of the slot to resend
+	 */
+	void ForceSlotResync(int32 SlotIndex);
+
+	/**
+	 * Authority: overwrite the inventory with saved contents. Slots beyond the saved count are emptied.
+	 * Saved items should already be prefetched; any that are not are loaded asynchronously and filled in when they
+	 * arrive. Unknown items leave their slot empty.
+	 * @param SavedSlots Packed saved contents
+	 */
+	void RestorePackedSlots(const FPackedInventory& SavedSlots);
+
 	UFUNCTION(BlueprintPure, Category = "Inventory")
 	int32 GetEquippedSlot() const { return CurrentEquippedSlotIndex; }
 
 	UPROPERTY(BlueprintAssignable, Category = "Inventory")
 	FOnInventoryChanged OnInventoryChanged;
 
+	/** Delegate broadcast alongside OnInventoryChanged with the exact slot indices that changed */
+	UPROPERTY(BlueprintAssignable, Category = "Inventory")
+	FOnInventorySlotsChanged OnInventorySlotsChanged;
+
 	/** Delegate broadcast when an item is added to inventory */
 	UPROPERTY(BlueprintAssignable, Category = "Inventory")
 	FOnItemAdded OnItemAdded;
@@ -105,7 +140,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	void SetInitialSlotCount(int32 SlotCount) { InitialSlotCount = SlotCount; }
 
-	/** Enable or disable replication (must be called in constructor, before component registration) */
+	/** Enable or disable replication (call in the owner's constructor) */
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	void SetEnableReplication(bool bEnable);
 
@@ -113,6 +148,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	void SetSupportsEquipping(bool bSupport) { bSupportsEquipping = bSupport; }
 
+	/**
+	 * Server: record that the player owning this inventory opened or closed a chest, so the chest's contents
+	 * replicate to them while it is open. Chests call this on the client's own inventory, which its connection owns.
+	 * @param Chest The chest
+	 * @param bViewing True when the chest was opened, false when it was closed
+	 */
+	UFUNCTION(Server, Reliable)
+	void ServerSetViewingChest(UChestInventoryComponent* Chest, bool bViewing);
+
 protected:
 	virtual void PostInitProperties() override;
 	virtual void BeginPlay() override;
@@ -122,9 +166,8 @@ protected:
 
 	/** Whether this inventory should support replication (for multiplayer) 
 	 *  Note: If set to true, replication will be enabled during component construction.
-	 *  This can be set via EditDefaultsOnly in Blueprint, or by directly setting this property
-	 *  immediately after CreateDefaultSubobject (before PostInitProperties runs).
-	 *  WARNING: SetEnableReplication() cannot enable replication if called after PostInitProperties.
+	 *  This can be set via EditDefaultsOnly in Blueprint, or with SetEnableReplication in the owner's constructor,
+	 *  in which case replication is switched on when play begins.
 	 */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Inventory", meta = (AllowPrivateAccess = "false"))
 	bool bEnableReplication = false;
@@ -133,16 +176,133 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Inventory")
 	bool bSupportsEquipping = true;
 
-	UPROPERTY(ReplicatedUsing = OnRep_InventorySlots, VisibleAnywhere, Category = "Inventory Data")
-	TArray<FInventorySlot> InventorySlots;
+	UPROPERTY(Replicated, VisibleAnywhere, Category = "Inventory Data")
+	FInventorySlotList InventoryList;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Inventory Data")
 	int32 CurrentEquippedSlotIndex = INDEX_NONE;
 
-	UFUNCTION()
-	void OnRep_InventorySlots();
+	/** Server: maximum distance between the owner and another actor's inventory it sends commands for */
+	UPROPERTY(EditDefaultsOnly, Category = "Inventory|Replication", meta = (ClampMin = "0.0"))
+	float MaxRemoteInventoryDistance = 1000.0f;
+
+	/** Server: commands beyond this count in a single batch are rejected */
+	UPROPERTY(EditDefaultsOnly, Category = "Inventory|Replication", meta = (ClampMin = "1"))
+	int32 MaxCommandsPerBatch = 32;
+
+	/** Server: perform a frame's batch of inventory commands and acknowledge them */
+	UFUNCTION(Server, Reliable)
+	void ServerExecuteCommands(const TArray<FInventoryCommand>& Commands);
+
+	/**
+	 * Client: acknowledge a command batch.
+	 * @param LastSequence Sequence number of the last command in the batch
+	 * @param RejectedSequences Commands in the batch the server refused; their predictions are rolled back
+	 */
+	UFUNCTION(Client, Reliable)
+	void ClientAckCommands(uint16 LastSequence, const TArray<uint16>& RejectedSequences);
 
 private:
+	friend struct FInventorySlotList;
+	friend class UInventoryBenchmarkCommandlet;
+
+	/** Record slots received from the server; broadcast once the whole update has been applied */
+	void NotifySlotsReplicated(const TArrayView<int32>& SlotIndices);
+
+	/** Broadcast slots recorded by NotifySlotsReplicated */
+	void FlushChangedSlots();
+
+	/** Start loading the items of slots that arrived before their item was loaded */
+	void LoadPendingItems();
+
+	/**
+	 * Fill in the slots waiting for an item once it has loaded.
+	 * @param ItemId Catalog ID of the item
+	 * @param Item The loaded item, or nullptr if it failed to load; its slots are emptied
+	 */
+	void OnPendingItemLoaded(int32 ItemId, UItemDataAsset* Item);
+
+	/** Mark a slot for replication and record it for the next change broadcast */
+	void MarkSlotDirty(int32 SlotIndex);
+
+	/** Contents of one slot before a predicted command changed it */
+	struct FInventorySlotSnapshot
+	{
+		TWeakObjectPtr<UInventoryComponent> Inventory;
+		int32 SlotIndex = 0;
+		FInventorySlot Contents;
+	};
+
+	/** A predicted command awaiting its ack, and the slots its prediction changed */
+	struct FPredictedInventoryCommand
+	{
+		FInventoryCommand Command;
+		TArray<FInventorySlotSnapshot, TInlineAllocator<2>> ChangedSlots;
+	};
+
+	/** Check whether slot operations on this inventory must go through the server */
+	bool ShouldQueueCommands() const;
+
+	/** Find the local player's inventory, which sends commands for every inventory on this client */
+	UInventoryComponent* FindCommandIssuer() const;
+
+	/**
+	 * Client: build a command for an operation on this inventory and hand it to the command issuer.
+	 * @return True if the operation was predicted and queued
+	 */
+	bool QueueCommand(EInventoryCommandType Type, int32 SlotIndex, int32 OtherSlotIndex, UInventoryComponent* OtherInventory, int32 Amount);
+
+	/**
+	 * Client: predict a command and queue it for the next batch. Called on the issuing inventory.
+	 * @param Command The command, without a sequence number
+	 * @return True if the prediction succeeded and the command was queued
+	 */
+	bool SubmitCommand(FInventoryCommand Command);
+
+	/** Client: send all commands queued this frame */
+	void FlushCommands();
+
+	/**
+	 * Server: check that the owner may send commands for an inventory.
+	 * @param Inventory The targeted inventory
+	 * @return True for this inventory and replicated inventories within MaxRemoteInventoryDistance
+	 */
+	bool CanCommandInventory(const UInventoryComponent* Inventory) const;
+
+	/** Build a command for an operation on this inventory */
+	FInventoryCommand MakeCommand(EInventoryCommandType Type, int32 SlotIndex, int32 OtherSlotIndex, UInventoryComponent* OtherInventory, int32 Amount);
+
+	/** Perform a command without any authority checks */
+	static bool ApplyCommand(const FInventoryCommand& Command);
+
+	/**
+	 * Client: perform a prediction's command, recording the slots it changes so only they are rolled back.
+	 * @param Prediction The prediction; its ChangedSlots are replaced
+	 * @return True if the command could be performed
+	 */
+	static bool PredictCommand(FPredictedInventoryCommand& Prediction);
+
+	/** Authority: record a performed command if the farm simulation is recording */
+	static void RecordCommand(const FInventoryCommand& Command);
+
+	/** Put back slot contents from a snapshot and broadcast the change */
+	void RestoreSlots(const TArray<FInventorySlot>& Snapshot);
+
+	/**
+	 * Put back the contents of one slot without broadcasting the change.
+	 * @param SlotIndex Index of the slot
+	 * @param Saved Contents to put back
+	 */
+	void RestoreSlot(int32 SlotIndex, const FInventorySlot& Saved);
+
+	bool MoveItemToSlotInternal(int32 FromSlotIndex, int32 ToSlotIndex);
+
+	bool SwapSlotsInternal(int32 SlotAIndex, int32 SlotBIndex);
+
+	bool RemoveFromSlotInternal(int32 SlotIndex, int32 Amount);
+
+	bool TransferSlotInternal(int32 SlotIndex, UInventoryComponent* TargetInventory);
+
 	bool TryStackItem(UItemDataAsset* ItemToAdd, int32& RemainingAmount);
 
 	bool AddToNewSlot(UItemDataAsset* ItemToAdd, int32 Amount);
@@ -163,5 +323,27 @@ private:
 
 	UPROPERTY()
 	TObjectPtr<UStaticMeshComponent> EquippedItemMeshComponent;
+
+	/** Equipped item mesh being loaded, and the handle keeping it loaded */
+	FSoftObjectPath RequestedItemMeshPath;
+	TSharedPtr<struct FStreamableHandle> ItemMeshLoadHandle;
+
+	/** Slots changed since the last broadcast */
+	TArray<int32> PendingChangedSlots;
+
+	/** Catalog IDs of pending slot items being loaded */
+	TSet<int32> LoadingItemIds;
+
+	/** Client: commands recorded this frame */
+	TArray<FInventoryCommand> PendingCommands;
+
+	/** Client: predicted commands not yet acknowledged, oldest first */
+	TArray<FPredictedInventoryCommand> PredictedCommands;
+
+	/** Client: sequence number of the last command issued */
+	uint16 LastCommandSequence = 0;
+
+	/** Client: whether a flush is already scheduled for next frame */
+	bool bCommandFlushScheduled = false;
 };
 
@@ -31,6 +31,7 @@ UQuest* UQuestComponent::AddQuest(UQuest* Quest)
 
 	ActiveQuests.Add(Quest->QuestID, Quest);
 
+	Quest->PrefetchRequirements();
 	Quest->StartQuest();
 
 	return Quest;
@@ -43,6 +44,19 @@ TArray<UQuest*> UQuestComponent::GetAllQuests() const
 	return Values;
 }
 
+UQuest* UQuestComponent::RestoreQuest(UQuest* Quest, int32 Progress, EQuestState SavedState)
+{
+	if (!Quest)
+		return nullptr;
+
+	ActiveQuests.Add(Quest->QuestID, Quest);
+
+	Quest->PrefetchRequirements();
+	Quest->RestoreProgress(Progress, SavedState);
+
+	return Quest;
+}
+
 bool UQuestComponent::RemoveQuest(FName QuestID)
 {
 	return ActiveQuests.Remove(QuestID) > 0;
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "../ENUM/QuestState.h"
 class UQuest;
 class UCropDataAsset;
 class USeedDataAsset;
@@ -33,6 +34,15 @@ public:
 	UFUNCTION(BlueprintCallable)
 	bool RemoveQuest(FName QuestID);
 
+	/**
+	 * Add a quest with saved progress instead of starting it fresh.
+	 * @param Quest The quest to add
+	 * @param Progress Saved progress
+	 * @param SavedState Saved quest state
+	 * @return The added quest, or nullptr if Quest is null
+	 */
+	UQuest* RestoreQuest(UQuest* Quest, int32 Progress, EQuestState SavedState);
+
 	/**
 	 * Subscribe to component events from owner's components.
 	 * Called automatically in BeginPlay.
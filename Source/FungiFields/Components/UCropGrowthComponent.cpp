@@ -1,9 +1,14 @@
 #include "UCropGrowthComponent.h"
+#include "../FungiFieldsStats.h"
 #include "../Data/UCropDataAsset.h"
 #include "../Actors/ASoilPlot.h"
 #include "../Components/USoilComponent.h"
+#include "../Subsystems/FFarmAllocationCounter.h"
+#include "../Subsystems/FFarmSimTimings.h"
 #include "../Subsystems/UCropManagerSubsystem.h"
+#include "../Subsystems/UFarmReplicationSubsystem.h"
 #include "Engine/World.h"
+#include "FCropGrowthRules.h"
 
 UCropGrowthComponent::UCropGrowthComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -66,19 +71,16 @@ void UCropGrowthComponent::Initialize(UCropDataAsset* InCropData, ASoilPlot* InP
 	bIsWithered = false;
 	TimeWithoutWater = 0.0f;
 	LastGrowthStageIndex = -1;
+	LastApproachingStage = -1;
 
 	WitherTimeWithoutWater = InCropData->WitherTimeWithoutWater;
 
+	float EffectiveFertility = 1.0f;
 	if (USoilComponent* SoilComp = ParentSoil->FindComponentByClass<USoilComponent>())
 	{
-		float EffectiveFertility = SoilComp->GetEffectiveFertility();
-		float AdjustedGrowthTime = CropData->GrowthTimeSeconds / EffectiveFertility;
-		GrowthIncrementPerSecond = 1.0f / AdjustedGrowthTime;
-	}
-	else
-	{
-		GrowthIncrementPerSecond = 1.0f / CropData->GrowthTimeSeconds;
+		EffectiveFertility = SoilComp->GetEffectiveFertility();
 	}
+	GrowthIncrementPerSecond = FCropGrowthRules::GetGrowthPerSecond(CropData->GrowthTimeSeconds, EffectiveFertility);
 	StartGrowth();
 }
 
@@ -119,46 +121,64 @@ void UCropGrowthComponent::PauseGrowth()
 
 void UCropGrowthComponent::UpdateGrowth(float DeltaTime)
 {
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmUpdateGrowth, "UCropGrowthComponent::UpdateGrowth");
+	FFarmSimTimings::Count(&FFarmSimTimings::CropUpdateCount);
+
 	if (!CropData || !ParentSoil || bIsWithered)
 	{
 		return;
 	}
 
+	if (bReplicatedProxy)
+	{
+		if (bReplicatedGrowing)
+		{
+			UpdateReplicatedGrowth();
+		}
+		return;
+	}
+
 	USoilComponent* SoilComp = ParentSoil->FindComponentByClass<USoilComponent>();
 	if (!SoilComp)
 	{
 		return;
 	}
 
-	bool bHasWater = SoilComp->HasWater();
+	FCropGrowthParams Params;
+	Params.GrowthPerSecond = GrowthIncrementPerSecond;
+	Params.WaterConsumptionRate = CropData->WaterConsumptionRate;
+	Params.WitherTimeWithoutWater = WitherTimeWithoutWater;
 
-	if (bHasWater)
-	{
-		TimeWithoutWater = 0.0f;
+	FCropGrowthState State;
+	State.Progress = CurrentGrowthProgress;
+	State.TimeWithoutWater = TimeWithoutWater;
 
-		float OldProgress = CurrentGrowthProgress;
-		CurrentGrowthProgress = FMath::Min(1.0f, CurrentGrowthProgress + GrowthIncrementPerSecond * DeltaTime);
+	const bool bHasWater = SoilComp->HasWater();
+	const FCropGrowthStepResult StepResult = FCropGrowthRules::Step(State, Params, bHasWater, DeltaTime);
+	TimeWithoutWater = State.TimeWithoutWater;
 
-		SoilComp->ConsumeWater(CropData->WaterConsumptionRate * DeltaTime);
+	if (bHasWater)
+	{
+		SetGrowthProgress(State.Progress);
 
-		if (CurrentGrowthProgress >= 1.0f && OldProgress < 1.0f)
-		{
-			OnCropFullyGrown.Broadcast(GetOwner());
-			UpdateMesh();
-		}
-		else if (CurrentGrowthProgress > OldProgress)
-		{
-			UpdateMesh();
-		}
+		SoilComp->ConsumeWater(StepResult.WaterToConsume);
 	}
 	else
 	{
-		TimeWithoutWater += DeltaTime;
+		if (!StepResult.bWitheredThisStep && WitherTimeWithoutWater - TimeWithoutWater <= StagePrefetchSeconds)
+		{
+			NotifyStageApproaching(FCropGrowthRules::WitheredStage);
+		}
 
-		if (TimeWithoutWater >= WitherTimeWithoutWater)
+		if (StepResult.bWitheredThisStep)
 		{
 			bIsWithered = true;
-			OnCropWithered.Broadcast(GetOwner());
+			{
+				FARM_ALLOCATION_GUARD_EXEMPT();
+				FScopedFarmSimTiming EventTiming(&FFarmSimTimings::EventCycles, &FFarmSimTimings::EventCount);
+				INC_DWORD_STAT(STAT_FarmEventsBroadcast);
+				OnCropWithered.Broadcast(GetOwner());
+			}
 
 			if (bGrowthActive && GetWorld())
 			{
@@ -172,35 +192,121 @@ void UCropGrowthComponent::UpdateGrowth(float DeltaTime)
 	}
 }
 
-void UCropGrowthComponent::UpdateMesh()
+void UCropGrowthComponent::SetGrowthProgress(float NewProgress)
 {
-	if (bIsWithered)
+	float OldProgress = CurrentGrowthProgress;
+	CurrentGrowthProgress = FMath::Clamp(NewProgress, 0.0f, 1.0f);
+
+	if (FCropGrowthRules::IsFullyGrown(CurrentGrowthProgress) && !FCropGrowthRules::IsFullyGrown(OldProgress))
+	{
+		{
+			FARM_ALLOCATION_GUARD_EXEMPT();
+			FScopedFarmSimTiming EventTiming(&FFarmSimTimings::EventCycles, &FFarmSimTimings::EventCount);
+			INC_DWORD_STAT(STAT_FarmEventsBroadcast);
+			OnCropFullyGrown.Broadcast(GetOwner());
+		}
+		UpdateMesh();
+	}
+	else if (CurrentGrowthProgress != OldProgress)
+	{
+		UpdateMesh();
+	}
+
+	const int32 NextStage = FCropGrowthRules::GetGrowthStage(CurrentGrowthProgress) + 1;
+	if (NextStage < FCropGrowthRules::NumGrowthStages
+		&& FCropGrowthRules::GetTimeToStage(CurrentGrowthProgress, NextStage, GrowthIncrementPerSecond) <= StagePrefetchSeconds)
+	{
+		NotifyStageApproaching(NextStage);
+	}
+}
+
+void UCropGrowthComponent::NotifyStageApproaching(int32 Stage)
+{
+	if (Stage == LastApproachingStage)
 	{
 		return;
 	}
 
-	int32 CurrentStageIndex = -1;
+	LastApproachingStage = Stage;
+
+	FARM_ALLOCATION_GUARD_EXEMPT();
+	FScopedFarmSimTiming EventTiming(&FFarmSimTimings::EventCycles, &FFarmSimTimings::EventCount);
+	INC_DWORD_STAT(STAT_FarmEventsBroadcast);
+	OnVisualStageApproaching.Broadcast(GetOwner(), Stage);
+}
 
-	if (CurrentGrowthProgress >= 1.0f)
+void UCropGrowthComponent::RestoreSavedState(float Progress, bool bWithered, float InTimeWithoutWater)
+{
+	TimeWithoutWater = FMath::Max(0.0f, InTimeWithoutWater);
+	SetGrowthProgress(Progress);
+
+	if (bWithered && !bIsWithered)
 	{
-		CurrentStageIndex = 3; // 100%
+		bIsWithered = true;
+		OnCropWithered.Broadcast(GetOwner());
+		PauseGrowth();
 	}
-	else if (CurrentGrowthProgress >= 0.5f)
+}
+
+void UCropGrowthComponent::ApplyReplicatedState(float SampleProgress, float GrowthRate, float SampleServerTime, bool bGrowing, bool bWithered)
+{
+	bReplicatedProxy = true;
+	bReplicatedGrowing = bGrowing;
+	ReplicatedSampleProgress = SampleProgress;
+	ReplicatedSampleTime = SampleServerTime;
+	if (GrowthRate > 0.0f)
 	{
-		CurrentStageIndex = 2; // 50%
+		GrowthIncrementPerSecond = GrowthRate;
 	}
-	else if (CurrentGrowthProgress >= 0.25f)
+
+	if (bWithered)
 	{
-		CurrentStageIndex = 1; // 25%
+		if (!bIsWithered)
+		{
+			bIsWithered = true;
+			OnCropWithered.Broadcast(GetOwner());
+			PauseGrowth();
+		}
+		return;
 	}
-	else
+
+	UpdateReplicatedGrowth();
+}
+
+void UCropGrowthComponent::UpdateReplicatedGrowth()
+{
+	if (!bReplicatedGrowing)
+	{
+		SetGrowthProgress(ReplicatedSampleProgress);
+		return;
+	}
+
+	float ServerTime = ReplicatedSampleTime;
+	if (UFarmReplicationSubsystem* FarmReplication = UFarmReplicationSubsystem::Get(this))
+	{
+		ServerTime = FarmReplication->GetServerWorldTime();
+	}
+
+	const float Elapsed = FMath::Max(0.0f, ServerTime - ReplicatedSampleTime);
+	SetGrowthProgress(ReplicatedSampleProgress + GrowthIncrementPerSecond * Elapsed);
+}
+
+void UCropGrowthComponent::UpdateMesh()
+{
+	if (bIsWithered)
 	{
-		CurrentStageIndex = 0;
+		return;
 	}
 
+	const int32 CurrentStageIndex = FCropGrowthRules::GetGrowthStage(CurrentGrowthProgress);
+
 	if (CurrentStageIndex != LastGrowthStageIndex)
 	{
 		LastGrowthStageIndex = CurrentStageIndex;
+
+		FARM_ALLOCATION_GUARD_EXEMPT();
+		FScopedFarmSimTiming EventTiming(&FFarmSimTimings::EventCycles, &FFarmSimTimings::EventCount);
+		INC_DWORD_STAT(STAT_FarmEventsBroadcast);
 		OnGrowthStageChanged.Broadcast(GetOwner(), CurrentGrowthProgress);
 	}
 }
\ No newline at end of file
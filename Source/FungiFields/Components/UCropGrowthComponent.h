@@ -10,6 +10,7 @@ class ASoilPlot;
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnGrowthStageChanged, AActor*, Crop, float, Progress);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnCropFullyGrown, AActor*, Crop);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnCropWithered, AActor*, Crop);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnVisualStageApproaching, AActor*, Crop, int32, Stage);
 
 /**
  * Component responsible for managing crop growth lifecycle.
@@ -55,6 +56,37 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Crop Growth")
 	bool IsWithered() const { return bIsWithered; }
 
+	/**
+	 * Get the growth rate at the current soil fertility.
+	 * @return Growth progress gained per second while watered
+	 */
+	float GetGrowthRate() const { return GrowthIncrementPerSecond; }
+
+	/**
+	 * Get how long the crop has gone without water.
+	 * @return Seconds since the soil last had water
+	 */
+	float GetTimeWithoutWater() const { return TimeWithoutWater; }
+
+	/**
+	 * Restore simulated growth from a save. Call after Initialize.
+	 * @param Progress Saved growth progress (0.0 to 1.0)
+	 * @param bWithered Whether the crop had withered
+	 * @param InTimeWithoutWater Saved time without water (seconds)
+	 */
+	void RestoreSavedState(float Progress, bool bWithered, float InTimeWithoutWater);
+
+	/**
+	 * Client: follow replicated growth instead of simulating it.
+	 * Progress is extrapolated from the sample using server time, without consuming water or withering locally.
+	 * @param SampleProgress Growth progress at SampleServerTime
+	 * @param GrowthRate Progress gained per second while growing
+	 * @param SampleServerTime Server world time the sample was taken
+	 * @param bGrowing Whether the crop is currently growing on the server
+	 * @param bWithered Whether the crop has withered on the server
+	 */
+	void ApplyReplicatedState(float SampleProgress, float GrowthRate, float SampleServerTime, bool bGrowing, bool bWithered);
+
 	/**
 	 * Start the growth (registers with crop manager).
 	 */
@@ -93,6 +125,18 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Crop Growth")
 	FOnCropWithered OnCropWithered;
 
+	/**
+	 * Delegate broadcast once per stage when the crop is expected to reach its next visual stage within
+	 * StagePrefetchSeconds, so its mesh can be streamed in ahead of time. Stage is the next growth stage,
+	 * or FCropGrowthRules::WitheredStage when the crop is close to withering.
+	 */
+	UPROPERTY(BlueprintAssignable, Category = "Crop Growth")
+	FOnVisualStageApproaching OnVisualStageApproaching;
+
+	/** How far ahead of a visual stage change OnVisualStageApproaching is broadcast, in seconds */
+	UPROPERTY(EditDefaultsOnly, Category = "Crop Growth Settings", meta = (ClampMin = "0.0"))
+	float StagePrefetchSeconds = 5.0f;
+
 private:
 	/** Configuration data for this crop */
 	UPROPERTY(VisibleAnywhere, Category = "Crop Growth Data")
@@ -124,4 +168,31 @@ private:
 
 	/** Last growth stage index for mesh updates */
 	int32 LastGrowthStageIndex = -1;
+
+	/** Last stage OnVisualStageApproaching was broadcast for */
+	int32 LastApproachingStage = -1;
+
+	/** Whether growth follows replicated samples instead of local simulation */
+	bool bReplicatedProxy = false;
+
+	/** Whether the replicated crop is growing */
+	bool bReplicatedGrowing = false;
+
+	/** Replicated growth progress at ReplicatedSampleTime */
+	float ReplicatedSampleProgress = 0.0f;
+
+	/** Server world time of the replicated growth sample */
+	float ReplicatedSampleTime = 0.0f;
+
+	/** Advance CurrentGrowthProgress from the replicated sample to the current server time */
+	void UpdateReplicatedGrowth();
+
+	/** Set growth progress and fire stage and fully grown events for any change */
+	void SetGrowthProgress(float NewProgress);
+
+	/**
+	 * Broadcast OnVisualStageApproaching if it has not been for this stage yet.
+	 * @param Stage The stage the crop is approaching
+	 */
+	void NotifyStageApproaching(int32 Stage);
 };
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "UFarmingComponent.h"
+#include "../FungiFieldsStats.h"
+#include "../Subsystems/FFarmAllocationCounter.h"
 #include "Camera/CameraComponent.h"
 #include "../Components/InventoryComponent.h"
 #include "../Inventory/FInventorySlot.h"
@@ -7,6 +9,10 @@
 #include "../Data/UCropDataAsset.h"
 #include "../Data/UItemDataAsset.h"
 #include "../Actors/ACropBase.h"
+#include "../Actors/ASoilPlot.h"
+#include "../Components/USoilComponent.h"
+#include "../Subsystems/UFarmReplicationSubsystem.h"
+#include "../Subsystems/UFarmSimulationSubsystem.h"
 #include "../Interfaces/IFarmableInterface.h"
 #include "../Interfaces/IHarvestableInterface.h"
 #include "../Data/FHarvestResult.h"
@@ -17,6 +23,7 @@
 #include "Engine/World.h"
 #include "DrawDebugHelpers.h"
 #include "Blueprint/UserWidget.h"
+#include "InputActionValue.h"
 
 UFarmingComponent::UFarmingComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -34,6 +41,8 @@ UFarmingComponent::UFarmingComponent(const FObjectInitializer& ObjectInitializer
 	FarmingTooltipWidget = nullptr;
 	TooltipTraceDistance = 800.0f;
 	TooltipClearDelay = 3.0f;
+
+	SetIsReplicatedByDefault(true);
 }
 
 void UFarmingComponent::BeginPlay()
@@ -47,6 +56,7 @@ void UFarmingComponent::TickComponent(float DeltaTime, ELevelTick TickType, FAct
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 	TraceForFarmable();
+	FlushFarmActions();
 }
 
 void UFarmingComponent::SetCamera(UCameraComponent* Camera)
@@ -79,9 +89,243 @@ void UFarmingComponent::UseEquippedTool(const FInputActionValue& Value)
 	EToolType ToolType = bHasValidTool ? CurrentToolType : EToolType::None;
 	float ToolPower = bHasValidTool ? CurrentToolPower : 1.0f;
 
+	if (GetOwnerRole() == ROLE_AutonomousProxy)
+	{
+		PredictFarmingAction(HitActor, ActionLocation, ToolType, ToolPower, SeedData);
+		return;
+	}
+
 	ExecuteFarmingAction(HitActor, ActionLocation, ToolType, ToolPower, SeedData);
 }
 
+void UFarmingComponent::PredictFarmingAction(AActor* TargetActor, const FVector& ActionLocation, EToolType ToolType, float ToolPower, USeedDataAsset* SeedData)
+{
+	ASoilPlot* Plot = Cast<ASoilPlot>(TargetActor);
+	ACropBase* Crop = Cast<ACropBase>(TargetActor);
+	if (Crop)
+	{
+		Plot = Crop->GetParentSoil();
+	}
+
+	UFarmReplicationSubsystem* FarmReplication = UFarmReplicationSubsystem::Get(this);
+	UInventoryComponent* InventoryComp = GetOwner()->FindComponentByClass<UInventoryComponent>();
+	if (!Plot || !FarmReplication || !InventoryComp)
+	{
+		return;
+	}
+
+	const int32 SlotIndex = InventoryComp->GetEquippedSlot();
+	const TArray<FInventorySlot>& Slots = InventoryComp->GetInventorySlots();
+	if (!Slots.IsValidIndex(SlotIndex) || SlotIndex > MAX_uint8)
+	{
+		return;
+	}
+
+	FPredictedFarmAction Prediction;
+	Prediction.Plot = Plot;
+	Prediction.Snapshot = Plot->BuildReplicationRecord(FarmReplication->GetServerWorldTime());
+
+	const float StaminaBefore = GetCurrentStamina();
+
+	if (!ExecuteFarmingAction(TargetActor, ActionLocation, ToolType, ToolPower, SeedData))
+	{
+		return;
+	}
+
+	Prediction.StaminaSpent = FMath::Max(0.0f, StaminaBefore - GetCurrentStamina());
+
+	FFarmActionCommand& Command = PendingActionCommands.AddDefaulted_GetRef();
+	Command.Sequence = ++LastActionSequence;
+	Command.TargetLocation = Plot->GetActorLocation();
+	Command.ToolSlot = static_cast<uint8>(SlotIndex);
+	Command.bTargetCrop = Crop != nullptr;
+	Command.ClientTimestamp = FarmReplication->GetServerWorldTime();
+
+	Prediction.Sequence = Command.Sequence;
+	PredictedActions.Add(Prediction);
+	FarmReplication->BeginPlotPrediction(Plot);
+}
+
+void UFarmingComponent::FlushFarmActions()
+{
+	if (PendingActionCommands.Num() == 0)
+	{
+		return;
+	}
+
+	ServerExecuteFarmActions(PendingActionCommands);
+	PendingActionCommands.Reset();
+}
+
+bool UFarmingComponent::PerformPlotAction(ASoilPlot* Plot, int32 ToolSlot, bool bTargetCrop, bool bCheckRange)
+{
+	AActor* Owner = GetOwner();
+	UInventoryComponent* InventoryComp = Owner ? Owner->FindComponentByClass<UInventoryComponent>() : nullptr;
+	if (!Plot || !InventoryComp)
+	{
+		return false;
+	}
+
+	// The server keeps its own equipped slot; follow the client's choice so the tool is read from server state
+	if (InventoryComp->GetEquippedSlot() != ToolSlot)
+	{
+		InventoryComp->EquipSlot(FInputActionValue(), ToolSlot);
+	}
+
+	// The slot may not be equippable on the server, so the client's tool cannot be trusted
+	if (InventoryComp->GetEquippedSlot() != ToolSlot)
+	{
+		return false;
+	}
+	UpdateEquippedTool();
+
+	AActor* TargetActor = Plot;
+	if (bTargetCrop)
+	{
+		USoilComponent* SoilComp = Plot->GetSoilComponent();
+		TargetActor = SoilComp ? SoilComp->GetCrop() : nullptr;
+	}
+
+	const float MaxDistance = ToolTraceDistance + ServerActionDistanceSlack;
+	if (!TargetActor || (bCheckRange && FVector::DistSquared(Owner->GetActorLocation(), Plot->GetActorLocation()) > FMath::Square(MaxDistance)))
+	{
+		return false;
+	}
+
+	USeedDataAsset* SeedData = bHasSeedEquipped ? EquippedSeedData : nullptr;
+	EToolType ToolType = bHasValidTool ? CurrentToolType : EToolType::None;
+	float ToolPower = bHasValidTool ? CurrentToolPower : 1.0f;
+
+	return ExecuteFarmingAction(TargetActor, TargetActor->GetActorLocation(), ToolType, ToolPower, SeedData);
+}
+
+bool UFarmingComponent::ReplayFarmAction(ASoilPlot* Plot, int32 ToolSlot, bool bTargetCrop)
+{
+	return PerformPlotAction(Plot, ToolSlot, bTargetCrop, false);
+}
+
+void UFarmingComponent::ServerExecuteFarmActions_Implementation(const TArray<FFarmActionCommand>& Commands)
+{
+	TArray<FFarmActionResult> Results;
+	Results.Reserve(Commands.Num());
+
+	AActor* Owner = GetOwner();
+	UInventoryComponent* InventoryComp = Owner ? Owner->FindComponentByClass<UInventoryComponent>() : nullptr;
+
+	for (int32 Index = 0; Index < Commands.Num(); ++Index)
+	{
+		if (Index < MaxActionCommandsPerBatch)
+		{
+			Results.Add(ExecuteFarmActionCommand(Commands[Index]));
+			continue;
+		}
+
+		FFarmActionResult& Rejected = Results.AddDefaulted_GetRef();
+		Rejected.Sequence = Commands[Index].Sequence;
+
+		if (InventoryComp)
+		{
+			InventoryComp->ForceSlotResync(Commands[Index].ToolSlot);
+		}
+	}
+
+	ClientAckFarmActions(Results);
+}
+
+FFarmActionResult UFarmingComponent::ExecuteFarmActionCommand(const FFarmActionCommand& Command)
+{
+	FFarmActionResult Result;
+	Result.Sequence = Command.Sequence;
+
+	AActor* Owner = GetOwner();
+	UFarmReplicationSubsystem* FarmReplication = UFarmReplicationSubsystem::Get(this);
+	UInventoryComponent* InventoryComp = Owner ? Owner->FindComponentByClass<UInventoryComponent>() : nullptr;
+	if (!FarmReplication || !InventoryComp)
+	{
+		return Result;
+	}
+
+	// The client may have predicted consuming a seed or soil bag from this slot; resend it unless the action is performed
+	ASoilPlot* Plot = FarmReplication->FindServerPlotNear(Command.TargetLocation);
+	if (!Plot)
+	{
+		InventoryComp->ForceSlotResync(Command.ToolSlot);
+		UE_LOG(LogTemp, Verbose, TEXT("UFarmingComponent::ExecuteFarmActionCommand: No plot at %s for command %d"), *Command.TargetLocation.ToString(), Command.Sequence);
+		return Result;
+	}
+
+	Result.bHasPlotState = true;
+
+	if (FarmReplication->GetServerWorldTime() - Command.ClientTimestamp > MaxActionCommandAge)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("UFarmingComponent::ExecuteFarmActionCommand: Command %d is too old"), Command.Sequence);
+		InventoryComp->ForceSlotResync(Command.ToolSlot);
+		Result.PlotState = Plot->BuildReplicationRecord(FarmReplication->GetServerWorldTime());
+		return Result;
+	}
+
+	Result.bAccepted = PerformPlotAction(Plot, Command.ToolSlot, Command.bTargetCrop, true);
+
+	if (!Result.bAccepted)
+	{
+		InventoryComp->ForceSlotResync(Command.ToolSlot);
+	}
+
+	Result.PlotState = Plot->BuildReplicationRecord(FarmReplication->GetServerWorldTime());
+	return Result;
+}
+
+void UFarmingComponent::ClientAckFarmActions_Implementation(const TArray<FFarmActionResult>& Results)
+{
+	UFarmReplicationSubsystem* FarmReplication = UFarmReplicationSubsystem::Get(this);
+
+	for (const FFarmActionResult& Result : Results)
+	{
+		const int32 PredictionIndex = PredictedActions.IndexOfByPredicate([&Result](const FPredictedFarmAction& Prediction)
+		{
+			return Prediction.Sequence == Result.Sequence;
+		});
+		if (PredictionIndex == INDEX_NONE)
+		{
+			continue;
+		}
+
+		const FPredictedFarmAction Prediction = PredictedActions[PredictionIndex];
+		PredictedActions.RemoveAt(PredictionIndex);
+
+		if (!Result.bAccepted)
+		{
+			UE_LOG(LogTemp, Verbose, TEXT("UFarmingComponent::ClientAckFarmActions: Server rejected command %d, rolling back"), Result.Sequence);
+
+			// Any seed or soil bag the prediction used comes back with the server's resync of the tool slot
+			RefundStamina(Prediction.StaminaSpent);
+		}
+
+		ASoilPlot* Plot = Prediction.Plot.Get();
+		if (!Plot)
+		{
+			continue;
+		}
+
+		// Later predictions on the same plot build on this one; their own acks carry the newer state
+		const bool bLastPredictionOnPlot = !PredictedActions.ContainsByPredicate([Plot](const FPredictedFarmAction& Other)
+		{
+			return Other.Plot == Plot;
+		});
+
+		const FFarmPlotRecord& AckState = Result.bHasPlotState ? Result.PlotState : Prediction.Snapshot;
+		if (bLastPredictionOnPlot && (Result.bHasPlotState || !Result.bAccepted))
+		{
+			Plot->ApplyReplicationRecord(AckState);
+		}
+
+		if (FarmReplication)
+		{
+			FarmReplication->EndPlotPrediction(Plot, AckState.SampleServerTime);
+		}
+	}
+}
+
 bool UFarmingComponent::ExecuteFarmingAction(AActor* TargetActor, const FVector& ActionLocation, EToolType ToolType, float ToolPower, USeedDataAsset* SeedData)
 {
 	if (!TargetActor)
@@ -89,6 +333,15 @@ bool UFarmingComponent::ExecuteFarmingAction(AActor* TargetActor, const FVector&
 		return false;
 	}
 
+	UFarmSimulationSubsystem* Simulation = UFarmSimulationSubsystem::Get(this);
+	if (Simulation && Simulation->IsRecording())
+	{
+		const ACropBase* TargetCrop = Cast<ACropBase>(TargetActor);
+		const ASoilPlot* TargetPlot = TargetCrop ? TargetCrop->GetParentSoil() : Cast<ASoilPlot>(TargetActor);
+		const UInventoryComponent* InventoryComp = GetOwner()->FindComponentByClass<UInventoryComponent>();
+		Simulation->RecordFarmAction(GetOwner(), TargetPlot, InventoryComp ? InventoryComp->GetEquippedSlot() : INDEX_NONE, TargetCrop != nullptr);
+	}
+
 	if (UInventoryComponent* InventoryComp = GetOwner()->FindComponentByClass<UInventoryComponent>())
 	{
 		const int32 EquippedSlotIndex = InventoryComp->GetEquippedSlot();
@@ -377,6 +630,7 @@ bool UFarmingComponent::PerformToolTrace(FHitResult& OutHit) const
 	TraceParams.bReturnPhysicalMaterial = false;
 	TraceParams.bTraceComplex = true;
 
+	FARM_INC_COUNTER(STAT_FarmTraces, TraceCount);
 	bool bHit = GetWorld()->LineTraceSingleByChannel(
 		OutHit,
 		Start,
@@ -429,8 +683,36 @@ bool UFarmingComponent::ConsumeStamina(float StaminaCost)
 	return false;
 }
 
+float UFarmingComponent::GetCurrentStamina() const
+{
+	const IAbilitySystemInterface* ASCInterface = Cast<IAbilitySystemInterface>(GetOwner());
+	const UAbilitySystemComponent* ASC = ASCInterface ? ASCInterface->GetAbilitySystemComponent() : nullptr;
+	const UCharacterAttributeSet* AttributeSet = ASC ? ASC->GetSet<UCharacterAttributeSet>() : nullptr;
+	return AttributeSet ? AttributeSet->GetStamina() : 0.0f;
+}
+
+void UFarmingComponent::RefundStamina(float Amount)
+{
+	if (Amount <= 0.0f)
+	{
+		return;
+	}
+
+	if (IAbilitySystemInterface* ASCInterface = Cast<IAbilitySystemInterface>(GetOwner()))
+	{
+		if (UAbilitySystemComponent* ASC = ASCInterface->GetAbilitySystemComponent())
+		{
+			ASC->ApplyModToAttribute(UCharacterAttributeSet::GetStaminaAttribute(), EGameplayModOp::Additive, Amount);
+		}
+	}
+}
+
 void UFarmingComponent::TraceForFarmable()
 {
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmTraceForFarmable, "UFarmingComponent::TraceForFarmable");
+	FScopedFarmSimTiming TraceTiming(&FFarmSimTimings::TraceCycles);
+	FARM_ALLOCATION_GUARD("UFarmingComponent::TraceForFarmable");
+
 	if (!CameraComponent)
 	{
 		return;
@@ -484,8 +766,9 @@ void UFarmingComponent::TraceForFarmable()
 	FVector End = Start + (CameraComponent->GetForwardVector() * TooltipTraceDistance);
 
 	FHitResult HitResult;
-	FCollisionQueryParams Params(FName(TEXT("FarmingTooltipTrace")), true, GetOwner());
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(FarmingTooltipTrace), true, GetOwner());
 
+	FARM_INC_COUNTER(STAT_FarmTraces, TraceCount);
 	World->LineTraceSingleByChannel(HitResult, Start, End, ECC_Visibility, Params);
 	
 	AActor* HitActor = HitResult.GetActor();
@@ -532,7 +815,7 @@ void UFarmingComponent::TraceForFarmable()
 							if (IFarmableInterface::Execute_CanAcceptSoilBag(HitActor, const_cast<UItemDataAsset*>(ItemData)))
 							{
 								UE_LOG(LogTemp, VeryVerbose, TEXT("UFarmingComponent::TraceForFarmable: Can accept soil bag - showing tooltip"));
-								TooltipText = FText::FromString(TEXT("Left Click to Place Soil"));
+								TooltipText = GetActionPrompt(EFarmingPrompt::PlaceSoil);
 								bShouldShowTooltip = true;
 							}
 							else
@@ -554,8 +837,7 @@ void UFarmingComponent::TraceForFarmable()
 	{
 		if (IFarmableInterface::Execute_CanAcceptSeed(HitActor))
 		{
-			FString SeedName = EquippedSeedData->CropToPlant->CropName.ToString();
-			TooltipText = FText::FromString(FString::Printf(TEXT("Left Click to Plant %s"), *SeedName));
+			TooltipText = GetActionPrompt(EFarmingPrompt::Plant, EquippedSeedData->CropToPlant->CropName);
 			bShouldShowTooltip = true;
 		}
 	}
@@ -563,24 +845,19 @@ void UFarmingComponent::TraceForFarmable()
 	{
 		if (IFarmableInterface::Execute_CanInteractWithTool(HitActor, CurrentToolType, GetOwner()) && CurrentToolType != EToolType::Scythe)
 		{
-			FString ActionText;
 			switch (CurrentToolType)
 			{
 			case EToolType::Hoe:
-				ActionText = "Till Soil";
+				TooltipText = GetActionPrompt(EFarmingPrompt::Till);
+				bShouldShowTooltip = true;
 				break;
 			case EToolType::WateringCan:
-				ActionText = "Water Soil";
+				TooltipText = GetActionPrompt(EFarmingPrompt::Water);
+				bShouldShowTooltip = true;
 				break;
 			default:
 				break;
 			}
-
-			if (!ActionText.IsEmpty())
-			{
-				TooltipText = FText::FromString(FString::Printf(TEXT("Left Click to %s"), *ActionText));
-				bShouldShowTooltip = true;
-			}
 		}
 	}
 	else if (bHasValidTool && HitActor->Implements<UHarvestableInterface>())
@@ -597,13 +874,14 @@ void UFarmingComponent::TraceForFarmable()
 			}
 			if (!TooltipText.IsEmpty())
 			{
-				TooltipText = FText::FromString(FString::Printf(TEXT("Left Click to %s"), *TooltipText.ToString()));
+				TooltipText = GetActionPrompt(EFarmingPrompt::Harvest, TooltipText);
 				bShouldShowTooltip = true;
 			}
 		}
 	}
 
-	bool bShouldUpdateTooltip = bShouldShowTooltip && (HitActor != LastFarmableTarget || !TooltipText.EqualTo(LastTooltipText));
+	// Prompts are cached, so the same prompt is the same text instance
+	bool bShouldUpdateTooltip = bShouldShowTooltip && (HitActor != LastFarmableTarget || !TooltipText.IdenticalTo(LastTooltipText));
 	
 	if (bShouldUpdateTooltip)
 	{
@@ -632,6 +910,41 @@ void UFarmingComponent::TraceForFarmable()
 	}
 }
 
+const FText& UFarmingComponent::GetActionPrompt(EFarmingPrompt Prompt, const FText& Subject)
+{
+	FCachedPrompt& Cached = CachedPrompts[static_cast<int32>(Prompt)];
+	if (!Cached.Prompt.IsEmpty() && Cached.Subject.IdenticalTo(Subject))
+	{
+		return Cached.Prompt;
+	}
+
+	Cached.Subject = Subject;
+
+	switch (Prompt)
+	{
+	case EFarmingPrompt::PlaceSoil:
+		Cached.Prompt = NSLOCTEXT("FarmingComponent", "PlaceSoilPrompt", "Left Click to Place Soil");
+		break;
+	case EFarmingPrompt::Plant:
+		Cached.Prompt = FText::Format(NSLOCTEXT("FarmingComponent", "PlantPrompt", "Left Click to Plant {0}"), Subject);
+		break;
+	case EFarmingPrompt::Till:
+		Cached.Prompt = NSLOCTEXT("FarmingComponent", "TillPrompt", "Left Click to Till Soil");
+		break;
+	case EFarmingPrompt::Water:
+		Cached.Prompt = NSLOCTEXT("FarmingComponent", "WaterPrompt", "Left Click to Water Soil");
+		break;
+	case EFarmingPrompt::Harvest:
+		Cached.Prompt = FText::Format(NSLOCTEXT("FarmingComponent", "HarvestPrompt", "Left Click to {0}"), Subject);
+		break;
+	default:
+		Cached.Prompt = FText::GetEmpty();
+		break;
+	}
+
+	return Cached.Prompt;
+}
+
 void UFarmingComponent::ShowFarmingTooltip(AActor* Target, const FText& Prompt)
 {
 	UWorld* World = GetWorld();
@@ -5,6 +5,7 @@
 #include "../ENUM/EToolType.h"
 #include "../Data/UCropDataAsset.h"
 #include "../Data/USeedDataAsset.h"
+#include "../Data/FFarmActionCommand.h"
 #include "UFarmingComponent.generated.h"
 
 class UCameraComponent;
@@ -12,6 +13,7 @@ class UInventoryComponent;
 class UCharacterAttributeSet;
 class UToolDataAsset;
 class UItemDataAsset;
+class ASoilPlot;
 struct FInputActionValue;
 
 // Forward declarations
@@ -26,6 +28,8 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnSoilWatered, AActor*, Waterer, A
 /**
  * Component responsible for handling farming tool usage.
  * Performs line traces and interacts with farmable/harvestable actors via interfaces.
+ * On network clients, actions are predicted locally and sent to the server as compact commands,
+ * batched into one RPC per frame; the server acknowledges each batch with the authoritative plot states.
  */
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class FUNGIFIELDS_API UFarmingComponent : public UActorComponent
@@ -103,6 +107,16 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Farming")
 	bool ExecuteFarmingAction(AActor* TargetActor, const FVector& ActionLocation, EToolType ToolType, float ToolPower, USeedDataAsset* SeedData = nullptr);
 
+	/**
+	 * Authority: perform a recorded farming action again, with the tool held in a given slot.
+	 * Skips the range check, since the player's position is not part of a recording.
+	 * @param Plot The targeted plot
+	 * @param ToolSlot Inventory slot to equip before the action
+	 * @param bTargetCrop Whether to target the plot's crop rather than the plot
+	 * @return True if the action was successful
+	 */
+	bool ReplayFarmAction(ASoilPlot* Plot, int32 ToolSlot, bool bTargetCrop);
+
 	/**
 	 * Check if a farming action can be performed on a target actor.
 	 * @param TargetActor The actor to check
@@ -185,6 +199,57 @@ protected:
 	 */
 	bool ConsumeStamina(float StaminaCost);
 
+	/**
+	 * Get the owner's current stamina.
+	 * @return Current stamina, or 0 if the owner has no attribute set
+	 */
+	float GetCurrentStamina() const;
+
+	/**
+	 * Give back stamina spent on an action the server rejected.
+	 * @param Amount Amount of stamina to restore
+	 */
+	void RefundStamina(float Amount);
+
+	/**
+	 * Client: perform a farming action locally and queue it for the server.
+	 * The target plot is snapshotted first so the prediction can be rolled back if the server rejects it.
+	 * @param TargetActor The traced soil plot or crop
+	 * @param ActionLocation The world location where the action is being performed
+	 * @param ToolType The type of tool being used (or None for planting)
+	 * @param ToolPower The power of the tool
+	 * @param SeedData Optional seed data if planting
+	 */
+	void PredictFarmingAction(AActor* TargetActor, const FVector& ActionLocation, EToolType ToolType, float ToolPower, USeedDataAsset* SeedData);
+
+	/** Client: send all farming commands queued this frame in a single batch */
+	void FlushFarmActions();
+
+	/**
+	 * Server: validate and perform one client farming command.
+	 * @param Command The command to perform
+	 * @return The result to acknowledge, including the plot state after the action
+	 */
+	FFarmActionResult ExecuteFarmActionCommand(const FFarmActionCommand& Command);
+
+	/**
+	 * Server: equip a slot and perform the farming action it allows on a plot or its crop.
+	 * @param Plot The targeted plot
+	 * @param ToolSlot Inventory slot to equip
+	 * @param bTargetCrop Whether to target the plot's crop rather than the plot
+	 * @param bCheckRange Whether to reject plots beyond the tool range
+	 * @return True if the action was performed
+	 */
+	bool PerformPlotAction(ASoilPlot* Plot, int32 ToolSlot, bool bTargetCrop, bool bCheckRange);
+
+	/** Server: perform a frame's batch of farming commands and acknowledge them */
+	UFUNCTION(Server, Reliable)
+	void ServerExecuteFarmActions(const TArray<FFarmActionCommand>& Commands);
+
+	/** Client: reconcile predicted farming actions with the server's results */
+	UFUNCTION(Client, Reliable)
+	void ClientAckFarmActions(const TArray<FFarmActionResult>& Results);
+
 	/** Widget class to use for displaying farming tooltips */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Farming Settings")
 	TSubclassOf<UUserWidget> FarmingTooltipWidgetClass;
@@ -197,6 +262,18 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Farming Settings", meta = (ClampMin = "0.0"))
 	float TooltipClearDelay = 3.0f;
 
+	/** Server: commands older than this (seconds of server time) are rejected */
+	UPROPERTY(EditDefaultsOnly, Category = "Farming Settings|Network", meta = (ClampMin = "0.0"))
+	float MaxActionCommandAge = 2.0f;
+
+	/** Server: extra distance allowed beyond the tool range, covering the camera offset and movement during latency */
+	UPROPERTY(EditDefaultsOnly, Category = "Farming Settings|Network", meta = (ClampMin = "0.0"))
+	float ServerActionDistanceSlack = 400.0f;
+
+	/** Server: commands beyond this count in a single batch are rejected */
+	UPROPERTY(EditDefaultsOnly, Category = "Farming Settings|Network", meta = (ClampMin = "1"))
+	int32 MaxActionCommandsPerBatch = 16;
+
 private:
 	/** Camera component for line traces */
 	UPROPERTY()
@@ -231,6 +308,24 @@ private:
 	int32 EquippedSlotIndexCached = INDEX_NONE;
 
 private:
+	/** Client: a predicted action awaiting its ack, with what is needed to undo it */
+	struct FPredictedFarmAction
+	{
+		uint16 Sequence = 0;
+		TWeakObjectPtr<ASoilPlot> Plot;
+		FFarmPlotRecord Snapshot;
+		float StaminaSpent = 0.0f;
+	};
+
+	/** Client: commands performed this frame, sent on the next tick */
+	TArray<FFarmActionCommand> PendingActionCommands;
+
+	/** Client: predicted actions not yet acknowledged, oldest first */
+	TArray<FPredictedFarmAction> PredictedActions;
+
+	/** Client: sequence number of the last command issued */
+	uint16 LastActionSequence = 0;
+
 	/** The currently focused farmable/harvestable actor */
 	UPROPERTY()
 	AActor* LastFarmableTarget = nullptr;
@@ -238,6 +333,36 @@ private:
 	/** The last tooltip text that was displayed */
 	FText LastTooltipText;
 
+	/** Tooltip actions, each with its own cached prompt */
+	enum class EFarmingPrompt : uint8
+	{
+		PlaceSoil,
+		Plant,
+		Till,
+		Water,
+		Harvest,
+		Count
+	};
+
+	/** A formatted prompt and the subject it was formatted with */
+	struct FCachedPrompt
+	{
+		FText Subject;
+		FText Prompt;
+	};
+
+	/**
+	 * Get the tooltip prompt for an action. Prompts are formatted once per subject, so tracing the same
+	 * target every frame does not build new text.
+	 * @param Prompt The action
+	 * @param Subject What the action applies to, for actions whose prompt names it
+	 * @return The prompt text
+	 */
+	const FText& GetActionPrompt(EFarmingPrompt Prompt, const FText& Subject = FText::GetEmpty());
+
+	/** Cached prompts by action */
+	FCachedPrompt CachedPrompts[static_cast<int32>(EFarmingPrompt::Count)];
+
 	/** Timer handle for clearing the widget after losing focus */
 	FTimerHandle FarmableResetTimer;
 
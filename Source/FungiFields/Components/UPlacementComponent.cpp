@@ -1,10 +1,13 @@
 #include "UPlacementComponent.h"
+#include "../FungiFieldsStats.h"
+#include "../Subsystems/FFarmAllocationCounter.h"
 #include "Camera/CameraComponent.h"
 #include "../Data/UItemDataAsset.h"
 #include "../Data/USoilDataAsset.h"
 #include "../Data/USoilContainerDataAsset.h"
 #include "../Actors/ASoilPlot.h"
 #include "../Components/InventoryComponent.h"
+#include "../Subsystems/UFarmSimulationSubsystem.h"
 #include "../Widgets/InteractionWidget.h"
 #include "Engine/World.h"
 #include "Engine/OverlapResult.h"
@@ -133,10 +136,11 @@ void UPlacementComponent::PickupItem(const FInputActionValue& Value)
 	FVector ForwardVector = CameraComponent->GetForwardVector();
 	FVector End = Start + (ForwardVector * GroundTraceDistance);
 
-	FCollisionQueryParams TraceParams(FName(TEXT("PickupTrace")), true, GetOwner());
+	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(PickupTrace), true, GetOwner());
 	TraceParams.bReturnPhysicalMaterial = false;
 	TraceParams.bTraceComplex = true;
 
+	FARM_INC_COUNTER(STAT_FarmTraces, TraceCount);
 	bool bHit = GetWorld()->LineTraceSingleByChannel(
 		HitResult,
 		Start,
@@ -150,33 +154,52 @@ void UPlacementComponent::PickupItem(const FInputActionValue& Value)
 		ASoilPlot* HitSoilPlot = Cast<ASoilPlot>(HitResult.GetActor());
 		if (HitSoilPlot)
 		{
-			USoilContainerDataAsset* ContainerData = HitSoilPlot->GetContainerDataAsset();
-			
-			if (!ContainerData)
-			{
-				USoilDataAsset* SoilData = HitSoilPlot->GetSoilDataAsset();
-				if (!SoilData && HitSoilPlot->GetSoilComponent())
-				{
-					SoilData = HitSoilPlot->GetSoilComponent()->GetSoilData();
-				}
+			PickupPlot(HitSoilPlot);
+		}
+	}
+}
 
-				if (SoilData)
-				{
-					OnPlaceablePickedUp.Broadcast(GetOwner(), SoilData);
-					HitSoilPlot->Destroy();
-				}
-			}
-			else
-			{
-				OnContainerPickedUp.Broadcast(GetOwner(), ContainerData);
-				HitSoilPlot->Destroy();
-			}
+void UPlacementComponent::PickupPlot(ASoilPlot* Plot)
+{
+	if (!Plot)
+	{
+		return;
+	}
+
+	if (UFarmSimulationSubsystem* Simulation = UFarmSimulationSubsystem::Get(this))
+	{
+		Simulation->RecordPickup(GetOwner(), Plot);
+	}
+
+	USoilContainerDataAsset* ContainerData = Plot->GetContainerDataAsset();
+	
+	if (!ContainerData)
+	{
+		USoilDataAsset* SoilData = Plot->GetSoilDataAsset();
+		if (!SoilData && Plot->GetSoilComponent())
+		{
+			SoilData = Plot->GetSoilComponent()->GetSoilData();
+		}
+
+		if (SoilData)
+		{
+			OnPlaceablePickedUp.Broadcast(GetOwner(), SoilData);
+			Plot->Destroy();
 		}
 	}
+	else
+	{
+		OnContainerPickedUp.Broadcast(GetOwner(), ContainerData);
+		Plot->Destroy();
+	}
 }
 
 void UPlacementComponent::UpdatePreview()
 {
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmPlacementPreview, "UPlacementComponent::UpdatePreview");
+	FScopedFarmSimTiming TraceTiming(&FFarmSimTimings::TraceCycles);
+	FARM_ALLOCATION_GUARD("UPlacementComponent::UpdatePreview");
+
 	if (!CameraComponent || !CurrentPlaceableItem)
 	{
 		return;
@@ -222,6 +245,8 @@ void UPlacementComponent::UpdatePreview()
 
 	if (PreviewActor)
 	{
+		// Moving the preview updates its render and physics state, which allocates
+		FARM_ALLOCATION_GUARD_EXEMPT();
 		PreviewActor->SetActorLocation(PreviewLocation);
 		PreviewActor->SetActorRotation(PreviewRotation);
 		PreviewActor->SetActorHiddenInGame(false);
@@ -252,10 +277,11 @@ bool UPlacementComponent::PerformGroundTrace(FHitResult& OutHit) const
 	float TraceDistance = 1000.0f;
 	FVector End = Start + (ForwardVector * TraceDistance);
 
-	FCollisionQueryParams TraceParams(FName(TEXT("PlacementTrace")), true, GetOwner());
+	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(PlacementTrace), true, GetOwner());
 	TraceParams.bReturnPhysicalMaterial = false;
 	TraceParams.bTraceComplex = true;
 
+	FARM_INC_COUNTER(STAT_FarmTraces, TraceCount);
 	bool bHit = GetWorld()->LineTraceSingleByChannel(
 		OutHit,
 		Start,
@@ -275,6 +301,8 @@ FRotator UPlacementComponent::CalculateRotationFromNormal(const FVector& Normal)
 
 bool UPlacementComponent::CanPlaceAtLocation(const FVector& Location, const FVector& Normal) const
 {
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmCanPlace, "UPlacementComponent::CanPlaceAtLocation");
+
 	if (!GetWorld() || !GetOwner())
 	{
 		return false;
@@ -287,16 +315,17 @@ bool UPlacementComponent::CanPlaceAtLocation(const FVector& Location, const FVec
 		return false;
 	}
 
-	TArray<FOverlapResult> OverlapResults;
-	FCollisionQueryParams QueryParams;
+	OverlapScratch.Reset();
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(PlacementOverlap), false);
 	QueryParams.AddIgnoredActor(GetOwner());
 	if (PreviewActor)
 	{
 		QueryParams.AddIgnoredActor(PreviewActor);
 	}
 
+	FARM_INC_COUNTER(STAT_FarmTraces, TraceCount);
 	bool bHasOverlap = GetWorld()->OverlapMultiByChannel(
-		OverlapResults,
+		OverlapScratch,
 		Location,
 		FQuat::Identity,
 		ECC_WorldDynamic,
@@ -307,7 +336,7 @@ bool UPlacementComponent::CanPlaceAtLocation(const FVector& Location, const FVec
 	if (bHasOverlap && CurrentPlaceableItem && CurrentPlaceableItem->PlaceableActorClass)
 	{
 		TSubclassOf<AActor> PlaceableClass = CurrentPlaceableItem->PlaceableActorClass;
-		for (const FOverlapResult& Overlap : OverlapResults)
+		for (const FOverlapResult& Overlap : OverlapScratch)
 		{
 			if (Overlap.GetActor() && Overlap.GetActor()->GetClass() == PlaceableClass)
 			{
@@ -326,31 +355,9 @@ void UPlacementComponent::PlaceItemAtLocation(const FVector& Location, const FRo
 		return;
 	}
 
-	TSubclassOf<AActor> PlaceableClass = CurrentPlaceableItem->PlaceableActorClass;
-	if (!PlaceableClass)
-	{
-		PlaceableClass = ASoilPlot::StaticClass();
-	}
-
-	FActorSpawnParameters SpawnParams;
-	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-	
-	AActor* NewPlaceable = GetWorld()->SpawnActor<AActor>(PlaceableClass, Location, Rotation, SpawnParams);
+	AActor* NewPlaceable = SpawnPlaceable(CurrentPlaceableItem, Location, Rotation);
 	if (NewPlaceable)
 	{
-		if (ASoilPlot* NewSoilPlot = Cast<ASoilPlot>(NewPlaceable))
-		{
-			USoilContainerDataAsset* ContainerData = CurrentPlaceableItem->PlaceableContainerDataAsset;
-			if (!ContainerData && CurrentPlaceableItem->PlaceableSoilDataAsset)
-			{
-				NewSoilPlot->Initialize(CurrentPlaceableItem->PlaceableSoilDataAsset);
-			}
-			else
-			{
-				NewSoilPlot->Initialize(ContainerData, nullptr);
-			}
-		}
-
 		float BottomOffset = CachedBottomOffset;
 		if (!bBottomOffsetCached)
 		{
@@ -371,29 +378,89 @@ void UPlacementComponent::PlaceItemAtLocation(const FVector& Location, const FRo
 		AdjustedLocation.Z -= BottomOffset;
 		NewPlaceable->SetActorLocation(AdjustedLocation);
 
-		OnPlaceablePlaced.Broadcast(GetOwner(), NewPlaceable, CurrentPlaceableItem);
+		FinishPlacement(NewPlaceable, CurrentPlaceableItem);
+	}
+}
+
+AActor* UPlacementComponent::SpawnPlaceable(UItemDataAsset* Item, const FVector& Location, const FRotator& Rotation)
+{
+	if (!GetWorld() || !Item)
+	{
+		return nullptr;
+	}
+
+	TSubclassOf<AActor> PlaceableClass = Item->PlaceableActorClass;
+	if (!PlaceableClass)
+	{
+		PlaceableClass = ASoilPlot::StaticClass();
+	}
 
-		if (UInventoryComponent* InventoryComp = GetOwner()->FindComponentByClass<UInventoryComponent>())
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	
+	FARM_INC_COUNTER(STAT_FarmActorsSpawned, ActorSpawnCount);
+	FARM_HITCH_SCOPE(Spawn, PlaceableClass);
+	AActor* NewPlaceable = GetWorld()->SpawnActor<AActor>(PlaceableClass, Location, Rotation, SpawnParams);
+	if (ASoilPlot* NewSoilPlot = Cast<ASoilPlot>(NewPlaceable))
+	{
+		USoilContainerDataAsset* ContainerData = Item->PlaceableContainerDataAsset;
+		if (!ContainerData && Item->PlaceableSoilDataAsset)
 		{
-			int32 EquippedSlot = InventoryComp->GetEquippedSlot();
-			if (EquippedSlot != INDEX_NONE)
+			NewSoilPlot->Initialize(Item->PlaceableSoilDataAsset);
+		}
+		else
+		{
+			NewSoilPlot->Initialize(ContainerData, nullptr);
+		}
+	}
+
+	return NewPlaceable;
+}
+
+void UPlacementComponent::FinishPlacement(AActor* Placed, UItemDataAsset* Item)
+{
+	OnPlaceablePlaced.Broadcast(GetOwner(), Placed, Item);
+
+	if (UInventoryComponent* InventoryComp = GetOwner()->FindComponentByClass<UInventoryComponent>())
+	{
+		int32 EquippedSlot = InventoryComp->GetEquippedSlot();
+
+		if (UFarmSimulationSubsystem* Simulation = UFarmSimulationSubsystem::Get(this))
+		{
+			Simulation->RecordPlacement(GetOwner(), Item, Placed, EquippedSlot);
+		}
+
+		if (EquippedSlot != INDEX_NONE)
+		{
+			InventoryComp->ConsumeFromSlot(EquippedSlot, 1);
+			
+			const TArray<FInventorySlot>& Slots = InventoryComp->GetInventorySlots();
+			if (Slots.IsValidIndex(EquippedSlot) && bIsInPlacementMode)
 			{
-				InventoryComp->ConsumeFromSlot(EquippedSlot, 1);
-				
-				const TArray<FInventorySlot>& Slots = InventoryComp->GetInventorySlots();
-				if (Slots.IsValidIndex(EquippedSlot))
+				const FInventorySlot& Slot = Slots[EquippedSlot];
+				if (Slot.IsEmpty() || !Slot.ItemDefinition || !Slot.ItemDefinition->bIsPlaceable)
 				{
-					const FInventorySlot& Slot = Slots[EquippedSlot];
-					if (Slot.IsEmpty() || !Slot.ItemDefinition || !Slot.ItemDefinition->bIsPlaceable)
-					{
-						ExitPlacementMode();
-					}
+					ExitPlacementMode();
 				}
 			}
 		}
 	}
 }
 
+void UPlacementComponent::ReplayPlacement(UItemDataAsset* Item, const FVector& Location, const FRotator& Rotation, int32 Slot)
+{
+	UInventoryComponent* InventoryComp = GetOwner()->FindComponentByClass<UInventoryComponent>();
+	if (InventoryComp && InventoryComp->GetEquippedSlot() != Slot)
+	{
+		InventoryComp->EquipSlot(FInputActionValue(), Slot);
+	}
+
+	if (AActor* Placed = SpawnPlaceable(Item, Location, Rotation))
+	{
+		FinishPlacement(Placed, Item);
+	}
+}
+
 void UPlacementComponent::UpdatePreviewActor()
 {
 	if (!GetWorld() || !CurrentPlaceableItem)
@@ -422,11 +489,16 @@ void UPlacementComponent::UpdatePreviewActor()
 	FActorSpawnParameters SpawnParams;
 	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 	
+	FARM_INC_COUNTER(STAT_FarmActorsSpawned, ActorSpawnCount);
+	FARM_HITCH_SCOPE(Spawn, PreviewClass);
 	PreviewActor = GetWorld()->SpawnActor<AActor>(PreviewClass, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
 	if (PreviewActor)
 	{
 		if (ASoilPlot* SoilPlotPreview = Cast<ASoilPlot>(PreviewActor))
 		{
+			// The preview only exists for the local player
+			SoilPlotPreview->SetReplicateFarmState(false);
+
 			USoilContainerDataAsset* ContainerData = CurrentPlaceableItem->PlaceableContainerDataAsset;
 			if (!ContainerData && CurrentPlaceableItem->PlaceableSoilDataAsset)
 			{
@@ -524,8 +596,8 @@ float UPlacementComponent::CalculateActorBottomOffset(AActor* Actor) const
 
 	FTransform ActorTransform = Actor->GetActorTransform();
 
-	TArray<UStaticMeshComponent*> StaticMeshComponents;
-	Actor->GetComponents<UStaticMeshComponent>(StaticMeshComponents);
+	TInlineComponentArray<UStaticMeshComponent*> StaticMeshComponents;
+	Actor->GetComponents(StaticMeshComponents);
 	
 	UStaticMeshComponent* MainMesh = nullptr;
 	for (UStaticMeshComponent* MeshComp : StaticMeshComponents)
@@ -573,8 +645,8 @@ float UPlacementComponent::CalculateActorBottomOffset(AActor* Actor) const
 	FBox CombinedBounds(ForceInit);
 	bool bHasBounds = false;
 
-	TArray<UPrimitiveComponent*> PrimitiveComponents;
-	Actor->GetComponents<UPrimitiveComponent>(PrimitiveComponents);
+	TInlineComponentArray<UPrimitiveComponent*> PrimitiveComponents;
+	Actor->GetComponents(PrimitiveComponents);
 
 	for (UPrimitiveComponent* Comp : PrimitiveComponents)
 	{
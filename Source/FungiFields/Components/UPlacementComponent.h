@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Engine/OverlapResult.h"
 #include "UPlacementComponent.generated.h"
 
 class UCameraComponent;
@@ -86,6 +87,21 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Placement")
 	void AdjustPlacementRotation(const FInputActionValue& Value);
 
+	/**
+	 * Pick up a soil plot, returning its container or soil to the owner.
+	 * @param Plot The plot to pick up
+	 */
+	void PickupPlot(ASoilPlot* Plot);
+
+	/**
+	 * Authority: perform a recorded placement again, without a preview or ground trace.
+	 * @param Item The item to place
+	 * @param Location Final location of the placed actor
+	 * @param Rotation Rotation of the placed actor
+	 * @param Slot Inventory slot to place the item from
+	 */
+	void ReplayPlacement(UItemDataAsset* Item, const FVector& Location, const FRotator& Rotation, int32 Slot);
+
 	/** Delegate broadcast when a placeable item is placed */
 	UPROPERTY(BlueprintAssignable, Category = "Placement Events")
 	FOnPlaceablePlaced OnPlaceablePlaced;
@@ -134,6 +150,22 @@ protected:
 	 */
 	void PlaceItemAtLocation(const FVector& Location, const FRotator& Rotation);
 
+	/**
+	 * Spawn the actor for a placeable item and initialize it.
+	 * @param Item The item to place
+	 * @param Location World location to spawn at
+	 * @param Rotation Rotation to spawn with
+	 * @return The spawned actor, or nullptr if spawning failed
+	 */
+	AActor* SpawnPlaceable(UItemDataAsset* Item, const FVector& Location, const FRotator& Rotation);
+
+	/**
+	 * Announce a placed actor and consume the placed item from the equipped slot.
+	 * @param Placed The placed actor, at its final location
+	 * @param Item The placed item
+	 */
+	void FinishPlacement(AActor* Placed, UItemDataAsset* Item);
+
 	/**
 	 * Create or update the preview actor.
 	 */
@@ -242,6 +274,9 @@ private:
 	/** Whether the bottom offset has been calculated and cached */
 	UPROPERTY(VisibleAnywhere, Category = "Placement Data")
 	bool bBottomOffsetCached = false;
+
+	/** Overlap results of the placement check, reused every preview update */
+	mutable TArray<FOverlapResult> OverlapScratch;
 };
 
 
@@ -1,8 +1,13 @@
 #include "USoilComponent.h"
+#include "../FungiFieldsStats.h"
 #include "../Data/USoilDataAsset.h"
 #include "../Actors/ACropBase.h"
+#include "../Subsystems/FFarmAllocationCounter.h"
+#include "../Subsystems/FFarmSimTimings.h"
+#include "../Subsystems/UFarmSimulationSubsystem.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
+#include "FSoilWaterRules.h"
 
 USoilComponent::USoilComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -64,9 +69,9 @@ void USoilComponent::AddWater(float Amount)
 
 	ESoilState OldState = GetSoilState();
 	float OldWaterLevel = CurrentWaterLevel;
-	CurrentWaterLevel = FMath::Clamp(CurrentWaterLevel + Amount, 0.0f, SoilData->MaxWaterLevel);
+	CurrentWaterLevel = FSoilWaterRules::AddWater(CurrentWaterLevel, Amount, SoilData->MaxWaterLevel);
 	UE_LOG(LogTemp, Display, TEXT("Water level at %f"), CurrentWaterLevel);
-	if (CurrentWaterLevel > 0.0f && !WaterEvaporationTimerHandle.IsValid())
+	if (CurrentWaterLevel > 0.0f && !WaterEvaporationTimerHandle.IsValid() && !UFarmSimulationSubsystem::IsDeterministicWorld(this))
 	{
 		if (UWorld* World = GetWorld())
 		{
@@ -80,8 +85,11 @@ void USoilComponent::AddWater(float Amount)
 		}
 	}
 
-	if (FMath::Abs(CurrentWaterLevel - OldWaterLevel) > 0.01f)
+	if (FSoilWaterRules::IsSignificantChange(OldWaterLevel, CurrentWaterLevel))
 	{
+		FScopedFarmSimTiming EventTiming(&FFarmSimTimings::EventCycles, &FFarmSimTimings::EventCount);
+		INC_DWORD_STAT(STAT_FarmEventsBroadcast);
+
 		OnWaterLevelChanged.Broadcast(GetOwner(), CurrentWaterLevel);
 		
 		ESoilState NewState = GetSoilState();
@@ -103,7 +111,7 @@ bool USoilComponent::ConsumeWater(float Amount)
 
 	ESoilState OldState = GetSoilState();
 	float OldWaterLevel = CurrentWaterLevel;
-	CurrentWaterLevel = FMath::Max(0.0f, CurrentWaterLevel - Amount);
+	CurrentWaterLevel = FSoilWaterRules::ConsumeWater(CurrentWaterLevel, Amount);
 
 	if (CurrentWaterLevel <= 0.0f && WaterEvaporationTimerHandle.IsValid())
 	{
@@ -113,13 +121,18 @@ bool USoilComponent::ConsumeWater(float Amount)
 		}
 	}
 
-	if (FMath::Abs(CurrentWaterLevel - OldWaterLevel) > 0.01f)
+	if (FSoilWaterRules::IsSignificantChange(OldWaterLevel, CurrentWaterLevel))
 	{
+		FScopedFarmSimTiming EventTiming(&FFarmSimTimings::EventCycles, &FFarmSimTimings::EventCount);
+		INC_DWORD_STAT(STAT_FarmEventsBroadcast);
+
 		OnWaterLevelChanged.Broadcast(GetOwner(), CurrentWaterLevel);
 		
 		ESoilState NewState = GetSoilState();
 		if (OldState != NewState)
 		{
+			// Drying out is a state change rather than steady-state work
+			FARM_ALLOCATION_GUARD_EXEMPT();
 			OnSoilStateChanged.Broadcast(GetOwner(), NewState);
 		}
 		
@@ -183,7 +196,10 @@ void USoilComponent::RemoveCrop()
 
 void USoilComponent::OnWaterEvaporationTimer()
 {
-	if (!SoilData || CurrentWaterLevel <= 0.0f)
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmEvaporation, "USoilComponent::OnWaterEvaporationTimer");
+	FScopedFarmSimTiming EvaporationTiming(&FFarmSimTimings::EvaporationCycles);
+
+	if (!SoilData || CurrentWaterLevel <= 0.0f || UFarmSimulationSubsystem::IsDeterministicWorld(this))
 	{
 		if (UWorld* World = GetWorld())
 		{
@@ -192,8 +208,19 @@ void USoilComponent::OnWaterEvaporationTimer()
 		return;
 	}
 
-	float EvaporationAmount = WaterEvaporationRate / SoilData->WaterRetentionMultiplier;
-	ConsumeWater(EvaporationAmount * EvaporationCheckInterval);
+	StepEvaporation(EvaporationCheckInterval);
+}
+
+void USoilComponent::StepEvaporation(float DeltaTime)
+{
+	if (!SoilData || CurrentWaterLevel <= 0.0f)
+	{
+		return;
+	}
+
+	FARM_ALLOCATION_GUARD("USoilComponent::StepEvaporation");
+	FFarmSimTimings::Count(&FFarmSimTimings::EvaporationCount);
+	ConsumeWater(FSoilWaterRules::GetEvaporation(WaterEvaporationRate, SoilData->WaterRetentionMultiplier, DeltaTime));
 }
 
 void USoilComponent::SetSoilType(USoilDataAsset* InSoilData)
@@ -231,6 +258,52 @@ ESoilState USoilComponent::GetSoilState() const
 	return ESoilState::Dry;
 }
 
+void USoilComponent::ApplyReplicatedState(bool bTilled, float WaterLevel)
+{
+	if (!SoilData)
+	{
+		return;
+	}
+
+	if (bTilled != bIsTilled)
+	{
+		bIsTilled = bTilled;
+		TillProgress = bTilled ? TillThreshold : 0.0f;
+		if (bTilled)
+		{
+			OnSoilTilled.Broadcast(GetOwner());
+		}
+	}
+
+	ESoilState OldState = GetSoilState();
+	float OldWaterLevel = CurrentWaterLevel;
+	CurrentWaterLevel = FMath::Clamp(WaterLevel, 0.0f, SoilData->MaxWaterLevel);
+
+	if (FSoilWaterRules::IsSignificantChange(OldWaterLevel, CurrentWaterLevel))
+	{
+		OnWaterLevelChanged.Broadcast(GetOwner(), CurrentWaterLevel);
+
+		ESoilState NewState = GetSoilState();
+		if (OldState != NewState)
+		{
+			OnSoilStateChanged.Broadcast(GetOwner(), NewState);
+		}
+	}
+
+	UpdateVisuals();
+}
+
+void USoilComponent::RestoreSavedState(bool bTilled, float WaterLevel)
+{
+	if (!SoilData)
+	{
+		return;
+	}
+
+	ApplyReplicatedState(bTilled, 0.0f);
+	AddWater(WaterLevel);
+}
+
 void USoilComponent::UpdateVisuals()
 {
 }
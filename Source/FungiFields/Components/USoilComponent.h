@@ -140,6 +140,28 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Soil")
 	ESoilState GetSoilState() const;
 
+	/**
+	 * Client: overwrite tilled state and water level with replicated values.
+	 * Broadcasts the usual change delegates but never starts evaporation; the server owns the simulation.
+	 * @param bTilled Replicated tilled state
+	 * @param WaterLevel Replicated water level
+	 */
+	void ApplyReplicatedState(bool bTilled, float WaterLevel);
+
+	/**
+	 * Restore tilled state and water level from a save. Unlike ApplyReplicatedState, evaporation resumes.
+	 * @param bTilled Saved tilled state
+	 * @param WaterLevel Saved water level
+	 */
+	void RestoreSavedState(bool bTilled, float WaterLevel);
+
+	/**
+	 * Evaporate water for a span of time. Called by the evaporation timer, or by UFarmSimulationSubsystem
+	 * for every plot in deterministic mode.
+	 * @param DeltaTime Simulated seconds to evaporate for
+	 */
+	void StepEvaporation(float DeltaTime);
+
 	/** Delegate broadcast when soil is tilled */
 	UPROPERTY(BlueprintAssignable, Category = "Soil")
 	FOnSoilTilledState OnSoilTilled;
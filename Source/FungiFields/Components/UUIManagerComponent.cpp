@@ -0,0 +1,149 @@
+#include "UUIManagerComponent.h"
+#include "../FungiFieldsStats.h"
+#include "../Subsystems/UFarmWidgetPoolSubsystem.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/App.h"
+
+UUIManagerComponent::UUIManagerComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+void UUIManagerComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	PrewarmDelayRemaining = PrewarmDelaySeconds;
+}
+
+void UUIManagerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	PrewarmQueue.Empty();
+	ConstructedMenus.Empty();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UUIManagerComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (PrewarmQueue.Num() == 0)
+	{
+		SetComponentTickEnabled(false);
+		return;
+	}
+
+	if (PrewarmDelayRemaining > 0.0f)
+	{
+		PrewarmDelayRemaining -= DeltaTime;
+		return;
+	}
+
+	// Only spend time on frames that had headroom; a step is skipped until one does
+	if (FApp::GetDeltaTime() * 1000.0 > PrewarmFrameBudgetMs)
+	{
+		return;
+	}
+
+	TFunction<void()> PrewarmStep = MoveTemp(PrewarmQueue[0]);
+	PrewarmQueue.RemoveAt(0);
+	PrewarmStep();
+}
+
+UUserWidget* UUIManagerComponent::CreateMenuWidget(TSubclassOf<UUserWidget> WidgetClass)
+{
+	if (!WidgetClass)
+	{
+		return nullptr;
+	}
+
+	APlayerController* PC = GetLocalPlayerController();
+	if (!PC)
+	{
+		return nullptr;
+	}
+
+	LLM_SCOPE_BYTAG(Farm_Widgets);
+	FARM_HITCH_SCOPE(WidgetRebuild, WidgetClass);
+	return CreateWidget<UUserWidget>(PC, WidgetClass);
+}
+
+APlayerController* UUIManagerComponent::GetLocalPlayerController() const
+{
+	const APawn* OwnerPawn = Cast<APawn>(GetOwner());
+	APlayerController* PC = OwnerPawn ? Cast<APlayerController>(OwnerPawn->GetController()) : nullptr;
+	return PC && PC->IsLocalController() ? PC : nullptr;
+}
+
+void UUIManagerComponent::ConstructMenu(UUserWidget* Widget)
+{
+	if (!Widget || ConstructedMenus.Contains(Widget))
+	{
+		return;
+	}
+
+	LLM_SCOPE_BYTAG(Farm_Widgets);
+	FARM_HITCH_SCOPE(WidgetRebuild, Widget);
+	ConstructedMenus.Add(Widget, Widget->TakeWidget());
+}
+
+void UUIManagerComponent::ShowMenu(UUserWidget* Widget, int32 ZOrder)
+{
+	if (!Widget)
+	{
+		return;
+	}
+
+	ConstructMenu(Widget);
+
+	if (!Widget->IsInViewport())
+	{
+		Widget->AddToViewport(ZOrder);
+	}
+	Widget->SetVisibility(ESlateVisibility::Visible);
+}
+
+void UUIManagerComponent::HideMenu(UUserWidget* Widget)
+{
+	if (Widget && Widget->IsInViewport())
+	{
+		Widget->RemoveFromParent();
+	}
+}
+
+void UUIManagerComponent::QueuePrewarm(TFunction<void()> PrewarmStep)
+{
+	if (!bPrewarmMenus || !PrewarmStep)
+	{
+		return;
+	}
+
+	PrewarmQueue.Add(MoveTemp(PrewarmStep));
+	SetComponentTickEnabled(true);
+}
+
+void UUIManagerComponent::QueueWidgetPoolPrewarm()
+{
+	UFarmWidgetPoolSubsystem* WidgetPool = UFarmWidgetPoolSubsystem::Get(this);
+	if (!WidgetPool || !GetLocalPlayerController())
+	{
+		return;
+	}
+
+	const int32 NumBatches = WidgetPool->GetNumPrewarmBatches();
+	for (int32 Batch = 0; Batch < NumBatches; ++Batch)
+	{
+		QueuePrewarm([this]()
+		{
+			UFarmWidgetPoolSubsystem* Pool = UFarmWidgetPoolSubsystem::Get(this);
+			APlayerController* PC = GetLocalPlayerController();
+			if (Pool && PC)
+			{
+				Pool->PrewarmBatch(PC);
+			}
+		});
+	}
+}
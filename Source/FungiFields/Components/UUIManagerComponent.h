@@ -0,0 +1,104 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Blueprint/UserWidget.h"
+#include "UUIManagerComponent.generated.h"
+
+class APlayerController;
+class SWidget;
+
+/**
+ * Component that owns the lifetime of a player's menu widgets.
+ * Menus are created the first time they are needed rather than at spawn, and shown menus are the only ones
+ * in the viewport: hiding a menu removes it so it costs no layout, paint or tick. The Slate tree of a menu
+ * is kept while it is hidden so reopening it does not construct it again. Menus can be prewarmed: queued
+ * steps run one per frame, after PrewarmDelaySeconds and only on frames shorter than PrewarmFrameBudgetMs,
+ * so construction happens in idle time instead of on the first open.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class FUNGIFIELDS_API UUIManagerComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UUIManagerComponent();
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/**
+	 * Create a menu widget for the owning player. The widget is not added to the viewport.
+	 * @param WidgetClass Class of the widget
+	 * @return The widget, or nullptr if the owner has no local player controller
+	 */
+	template<typename T>
+	T* CreateMenu(TSubclassOf<T> WidgetClass)
+	{
+		return Cast<T>(CreateMenuWidget(WidgetClass));
+	}
+
+	/**
+	 * Build a menu's Slate tree without showing it, running its construction now rather than on first open.
+	 * @param Widget The menu
+	 */
+	void ConstructMenu(UUserWidget* Widget);
+
+	/**
+	 * Add a menu to the viewport and make it visible.
+	 * @param Widget The menu
+	 * @param ZOrder Viewport z-order
+	 */
+	void ShowMenu(UUserWidget* Widget, int32 ZOrder = 0);
+
+	/**
+	 * Remove a menu from the viewport, keeping its Slate tree for the next time it is shown.
+	 * @param Widget The menu
+	 */
+	void HideMenu(UUserWidget* Widget);
+
+	/**
+	 * Queue work to run in an idle frame after spawn, such as creating and constructing a menu.
+	 * @param PrewarmStep The work; it should be safe to run after the menu has already been opened
+	 */
+	void QueuePrewarm(TFunction<void()> PrewarmStep);
+
+	/** Queue steps that fill the world's widget pool for the owning player, one batch per step */
+	void QueueWidgetPoolPrewarm();
+
+	/** Whether queued prewarm steps run; if not, menus are built when first opened */
+	UPROPERTY(EditDefaultsOnly, Category = "UI Manager Settings")
+	bool bPrewarmMenus = true;
+
+	/** Time after spawn before prewarming starts, in seconds */
+	UPROPERTY(EditDefaultsOnly, Category = "UI Manager Settings", meta = (ClampMin = "0.0"))
+	float PrewarmDelaySeconds = 1.0f;
+
+	/** Prewarm steps only run after frames shorter than this, in milliseconds */
+	UPROPERTY(EditDefaultsOnly, Category = "UI Manager Settings", meta = (ClampMin = "1.0"))
+	float PrewarmFrameBudgetMs = 20.0f;
+
+private:
+	/**
+	 * Create a menu widget for the owning player.
+	 * @param WidgetClass Class of the widget
+	 * @return The widget, or nullptr if it could not be created
+	 */
+	UUserWidget* CreateMenuWidget(TSubclassOf<UUserWidget> WidgetClass);
+
+	/**
+	 * Get the controller of the owning pawn if it is local.
+	 * @return The controller, or nullptr if the owner is not locally controlled
+	 */
+	APlayerController* GetLocalPlayerController() const;
+
+	/** Steps waiting for an idle frame */
+	TArray<TFunction<void()>> PrewarmQueue;
+
+	/** Slate trees of constructed menus, kept while the menus are out of the viewport */
+	TMap<TWeakObjectPtr<UUserWidget>, TSharedPtr<SWidget>> ConstructedMenus;
+
+	/** Time left before prewarming starts */
+	float PrewarmDelayRemaining = 0.0f;
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetSerialization.h"
+#include "FFarmPlotRecord.h"
+#include "FFarmActionCommand.generated.h"
+
+/**
+ * Compact farming action sent from a client to the server.
+ * Plots do not replicate as actors, so the target is identified by its plot's quantized location,
+ * and the tool by the inventory slot it is held in; the server reads the item from its own copy of that slot.
+ */
+USTRUCT()
+struct FUNGIFIELDS_API FFarmActionCommand
+{
+	GENERATED_BODY()
+
+	/** Client sequence number, echoed back in the ack */
+	UPROPERTY()
+	uint16 Sequence = 0;
+
+	/** Location of the targeted soil plot */
+	UPROPERTY()
+	FVector_NetQuantize TargetLocation = FVector::ZeroVector;
+
+	/** Equipped inventory slot the action was performed with */
+	UPROPERTY()
+	uint8 ToolSlot = 0;
+
+	/** Whether the action targeted the plot's crop rather than the plot itself */
+	UPROPERTY()
+	bool bTargetCrop = false;
+
+	/** Server world time on the client when the action was performed */
+	UPROPERTY()
+	float ClientTimestamp = 0.0f;
+};
+
+/**
+ * Server response to a single farming action.
+ * Carries the authoritative state of the targeted plot after the action, so the client can reconcile
+ * its prediction without waiting for the plot's chunk to replicate.
+ */
+USTRUCT()
+struct FUNGIFIELDS_API FFarmActionResult
+{
+	GENERATED_BODY()
+
+	/** Sequence number of the acknowledged command */
+	UPROPERTY()
+	uint16 Sequence = 0;
+
+	/** Whether the server performed the action */
+	UPROPERTY()
+	bool bAccepted = false;
+
+	/** Whether PlotState holds the targeted plot; false if the server could not find it */
+	UPROPERTY()
+	bool bHasPlotState = false;
+
+	/** Authoritative state of the targeted plot after the action */
+	UPROPERTY()
+	FFarmPlotRecord PlotState;
+};
@@ -0,0 +1,83 @@
+#include "FFarmPlotRecord.h"
+#include "../Actors/AFarmChunk.h"
+
+void FFarmPlotRecord::SetFlag(EFarmPlotFlags Flag, bool bSet)
+{
+	EFarmPlotFlags NewFlags = static_cast<EFarmPlotFlags>(Flags);
+	if (bSet)
+	{
+		EnumAddFlags(NewFlags, Flag);
+	}
+	else
+	{
+		EnumRemoveFlags(NewFlags, Flag);
+	}
+	Flags = static_cast<uint8>(NewFlags);
+}
+
+float FFarmPlotRecord::GetExtrapolatedProgress(float ServerTime) const
+{
+	const float SampledProgress = DequantizeUnit(GrowthProgress);
+	if (!HasFlag(EFarmPlotFlags::Growing) || FullGrowthSeconds == 0)
+	{
+		return SampledProgress;
+	}
+
+	const float Elapsed = FMath::Max(0.0f, ServerTime - SampleServerTime);
+	return FMath::Min(1.0f, SampledProgress + Elapsed / FullGrowthSeconds);
+}
+
+bool FFarmPlotRecord::NeedsResync(const FFarmPlotRecord& Sent, const FFarmPlotRecord& Sampled, uint8 WaterResyncStep)
+{
+	if (Sent.Flags != Sampled.Flags
+		|| Sent.FullGrowthSeconds != Sampled.FullGrowthSeconds
+		|| Sent.Yaw != Sampled.Yaw
+		|| Sent.PlotClass != Sampled.PlotClass
+		|| Sent.ContainerData != Sampled.ContainerData
+		|| Sent.SoilData != Sampled.SoilData
+		|| Sent.CropData != Sampled.CropData
+		|| !Sent.Location.Equals(Sampled.Location, 1.0f))
+	{
+		return true;
+	}
+
+	// Running dry or being refilled always resends; gradual evaporation only every WaterResyncStep
+	if ((Sent.WaterLevel == 0) != (Sampled.WaterLevel == 0))
+	{
+		return true;
+	}
+
+	return FMath::Abs(static_cast<int32>(Sent.WaterLevel) - static_cast<int32>(Sampled.WaterLevel)) >= WaterResyncStep;
+}
+
+void FFarmPlotRecord::PreReplicatedRemove(const FFarmPlotRecordList& InArraySerializer)
+{
+	if (InArraySerializer.OwnerChunk)
+	{
+		InArraySerializer.OwnerChunk->HandleRecordRemoved(*this);
+	}
+}
+
+void FFarmPlotRecord::PostReplicatedAdd(const FFarmPlotRecordList& InArraySerializer)
+{
+	if (InArraySerializer.OwnerChunk)
+	{
+		InArraySerializer.OwnerChunk->HandleRecordReplicated(*this);
+	}
+}
+
+void FFarmPlotRecord::PostReplicatedChange(const FFarmPlotRecordList& InArraySerializer)
+{
+	if (InArraySerializer.OwnerChunk)
+	{
+		InArraySerializer.OwnerChunk->HandleRecordReplicated(*this);
+	}
+}
+
+void FFarmPlotRecordList::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+	if (OwnerChunk)
+	{
+		OwnerChunk->HandleRecordsReceived();
+	}
+}
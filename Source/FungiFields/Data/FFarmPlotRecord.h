@@ -0,0 +1,141 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetSerialization.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "FFarmPlotRecord.generated.h"
+
+class AFarmChunk;
+class ASoilPlot;
+class USoilDataAsset;
+class USoilContainerDataAsset;
+class UCropDataAsset;
+
+/** State bits packed into FFarmPlotRecord::Flags */
+enum class EFarmPlotFlags : uint8
+{
+	None		= 0,
+	HasSoil		= 1 << 0,
+	Tilled		= 1 << 1,
+	HasCrop		= 1 << 2,
+	Withered	= 1 << 3,
+	Growing		= 1 << 4,
+	/** Level-placed plot that was destroyed on the server */
+	Removed		= 1 << 5
+};
+ENUM_CLASS_FLAGS(EFarmPlotFlags);
+
+/**
+ * Quantized replicated state of a single soil plot.
+ * Growth is sent as a sample (progress + server time) and a rate; clients extrapolate between samples,
+ * so records only resend when something discontinuous happens.
+ */
+USTRUCT()
+struct FUNGIFIELDS_API FFarmPlotRecord : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	/** Server-assigned key, unique within the owning chunk */
+	UPROPERTY()
+	uint16 PlotKey = 0;
+
+	/** World location of the plot, used to match or spawn the client plot */
+	UPROPERTY()
+	FVector_NetQuantize Location = FVector::ZeroVector;
+
+	/** Plot yaw, 0-255 maps to 0-360 degrees */
+	UPROPERTY()
+	uint8 Yaw = 0;
+
+	/** Plot actor class to spawn on clients that do not already have the plot */
+	UPROPERTY()
+	TSubclassOf<ASoilPlot> PlotClass;
+
+	UPROPERTY()
+	TObjectPtr<USoilContainerDataAsset> ContainerData = nullptr;
+
+	UPROPERTY()
+	TObjectPtr<USoilDataAsset> SoilData = nullptr;
+
+	UPROPERTY()
+	TObjectPtr<UCropDataAsset> CropData = nullptr;
+
+	/** Growth progress at SampleServerTime, 0-255 maps to 0-1 */
+	UPROPERTY()
+	uint8 GrowthProgress = 0;
+
+	/** Water level as a fraction of the soil's MaxWaterLevel, 0-255 maps to 0-1 */
+	UPROPERTY()
+	uint8 WaterLevel = 0;
+
+	/** EFarmPlotFlags bits */
+	UPROPERTY()
+	uint8 Flags = 0;
+
+	/** Seconds from planting to full growth at this plot's fertility; 0 if nothing is growing */
+	UPROPERTY()
+	uint16 FullGrowthSeconds = 0;
+
+	/** Server world time the growth sample was taken */
+	UPROPERTY()
+	float SampleServerTime = 0.0f;
+
+	bool HasFlag(EFarmPlotFlags Flag) const { return EnumHasAnyFlags(static_cast<EFarmPlotFlags>(Flags), Flag); }
+	void SetFlag(EFarmPlotFlags Flag, bool bSet);
+
+	/** Growth progress extrapolated to the given server time */
+	float GetExtrapolatedProgress(float ServerTime) const;
+
+	static uint8 QuantizeUnit(float Value) { return static_cast<uint8>(FMath::RoundToInt(FMath::Clamp(Value, 0.0f, 1.0f) * 255.0f)); }
+	static float DequantizeUnit(uint8 Value) { return Value / 255.0f; }
+
+	/**
+	 * Decide whether a freshly sampled record must be sent, or whether clients can keep extrapolating the old one.
+	 * @param Sent The record clients currently have
+	 * @param Sampled The record just built from the plot
+	 * @param WaterResyncStep Quantized water difference that forces a resend
+	 * @return True if Sampled should replace Sent
+	 */
+	static bool NeedsResync(const FFarmPlotRecord& Sent, const FFarmPlotRecord& Sampled, uint8 WaterResyncStep);
+
+	// FFastArraySerializerItem contract
+	void PreReplicatedRemove(const struct FFarmPlotRecordList& InArraySerializer);
+	void PostReplicatedAdd(const struct FFarmPlotRecordList& InArraySerializer);
+	void PostReplicatedChange(const struct FFarmPlotRecordList& InArraySerializer);
+};
+
+/**
+ * Fast array of plot records for one farm chunk.
+ */
+USTRUCT()
+struct FUNGIFIELDS_API FFarmPlotRecordList : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	FFarmPlotRecordList() {}
+	explicit FFarmPlotRecordList(AFarmChunk* InOwnerChunk) : OwnerChunk(InOwnerChunk) {}
+
+	UPROPERTY()
+	TArray<FFarmPlotRecord> Records;
+
+	/** Chunk that receives replication notifications */
+	UPROPERTY(NotReplicated)
+	TObjectPtr<AFarmChunk> OwnerChunk = nullptr;
+
+	// FFastArraySerializer contract
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FFarmPlotRecord, FFarmPlotRecordList>(Records, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FFarmPlotRecordList> : public TStructOpsTypeTraitsBase2<FFarmPlotRecordList>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
@@ -0,0 +1,17 @@
+#include "FFarmPrimaryAssets.h"
+
+const FPrimaryAssetType FFarmPrimaryAssets::Item(TEXT("Item"));
+const FPrimaryAssetType FFarmPrimaryAssets::Crop(TEXT("Crop"));
+const FPrimaryAssetType FFarmPrimaryAssets::Soil(TEXT("Soil"));
+const FPrimaryAssetType FFarmPrimaryAssets::SoilContainer(TEXT("SoilContainer"));
+const FPrimaryAssetType FFarmPrimaryAssets::Quest(TEXT("Quest"));
+
+const FName FFarmPrimaryAssets::GameplayBundle(TEXT("Gameplay"));
+const FName FFarmPrimaryAssets::UIBundle(TEXT("UI"));
+const FName FFarmPrimaryAssets::VisualBundle(TEXT("Visual"));
+
+TConstArrayView<FPrimaryAssetType> FFarmPrimaryAssets::GetTypes()
+{
+	static const FPrimaryAssetType Types[] = { Item, Crop, Soil, SoilContainer, Quest };
+	return Types;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/PrimaryAssetId.h"
+
+/**
+ * Primary asset types and bundles of the farm data assets, registered with the Asset Manager in
+ * DefaultGame.ini. Soft references on the data assets are tagged with a bundle: Gameplay for assets
+ * the simulation needs, UI for menu and hotbar art, Visual for world art. Crop stage meshes are in no
+ * bundle because UCropVisualStreamingSubsystem streams them per planted crop type.
+ */
+struct FUNGIFIELDS_API FFarmPrimaryAssets
+{
+	/** Items, including seeds and tools */
+	static const FPrimaryAssetType Item;
+	static const FPrimaryAssetType Crop;
+	static const FPrimaryAssetType Soil;
+	static const FPrimaryAssetType SoilContainer;
+	static const FPrimaryAssetType Quest;
+
+	static const FName GameplayBundle;
+	static const FName UIBundle;
+	static const FName VisualBundle;
+
+	/**
+	 * Get every farm primary asset type.
+	 * @return The types
+	 */
+	static TConstArrayView<FPrimaryAssetType> GetTypes();
+};
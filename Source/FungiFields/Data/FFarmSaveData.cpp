@@ -0,0 +1,452 @@
+#include "FFarmSaveData.h"
+#include "Hash/CityHash.h"
+#include "HAL/FileManager.h"
+#include "Misc/Compression.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace FarmSaveFormat
+{
+	/** Identifies farm save files */
+	static constexpr uint32 Magic = 0x46465356; // 'FFSV'
+
+	/** Bumped whenever the snapshot layout changes */
+	static constexpr uint32 Version = 2;
+
+	/** Oldest snapshot version that can still be read */
+	static constexpr uint32 MinVersion = 1;
+
+	/** Version that added the journal epoch to the header */
+	static constexpr uint32 JournalEpochVersion = 2;
+
+	/** Marks the start of each journal block */
+	static constexpr uint32 JournalBlockMagic = 0x46464A42; // 'FFJB'
+}
+
+FArchive& operator<<(FArchive& Ar, FFarmPlotSaveRecord& Record)
+{
+	Ar << Record.Location;
+	Ar << Record.Yaw;
+	Ar << Record.PlotClass;
+	Ar << Record.ContainerData;
+	Ar << Record.SoilData;
+	Ar << Record.CropData;
+	Ar << Record.Flags;
+	Ar << Record.WaterLevel;
+	Ar << Record.GrowthProgress;
+	Ar << Record.TimeWithoutWater;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FFarmInventorySaveRecord& Record)
+{
+	Ar << Record.OwnerKey;
+	Ar << Record.Slots;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FFarmQuestSaveRecord& Record)
+{
+	Ar << Record.OwnerKey;
+	Ar << Record.Quest;
+	Ar << Record.Progress;
+	Ar << Record.State;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FFarmJournalBlock& Block)
+{
+	Ar << Block.AssetPalette;
+	Ar << Block.Plots;
+	Ar << Block.RemovedPlots;
+	Ar << Block.Inventories;
+	return Ar;
+}
+
+bool FFarmJournalBlock::AppendToFile(const FString& FilePath) const
+{
+	TArray<uint8> Payload;
+	FMemoryWriter PayloadWriter(Payload);
+	PayloadWriter << const_cast<FFarmJournalBlock&>(*this);
+
+	TUniquePtr<FArchive> File(IFileManager::Get().CreateFileWriter(*FilePath, FILEWRITE_Append | FILEWRITE_AllowRead));
+	if (!File)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FFarmJournalBlock::AppendToFile: Failed to open %s"), *FilePath);
+		return false;
+	}
+
+	uint32 Magic = FarmSaveFormat::JournalBlockMagic;
+	int64 BlockEpoch = Epoch;
+	int32 PayloadSize = Payload.Num();
+	uint32 PayloadCrc = FCrc::MemCrc32(Payload.GetData(), Payload.Num());
+
+	*File << Magic;
+	*File << BlockEpoch;
+	*File << PayloadSize;
+	*File << PayloadCrc;
+	File->Serialize(Payload.GetData(), PayloadSize);
+	File->Flush();
+
+	return File->Close() && !File->IsError();
+}
+
+bool FFarmJournalBlock::ReadAllFromFile(const FString& FilePath, TArray<FFarmJournalBlock>& OutBlocks)
+{
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *FilePath, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	constexpr int64 HeaderSize = sizeof(uint32) + sizeof(int64) + sizeof(int32) + sizeof(uint32);
+	FMemoryReader FileReader(FileData);
+
+	while (FileReader.Tell() + HeaderSize <= FileData.Num())
+	{
+		uint32 Magic = 0;
+		int64 BlockEpoch = 0;
+		int32 PayloadSize = 0;
+		uint32 PayloadCrc = 0;
+
+		FileReader << Magic;
+		FileReader << BlockEpoch;
+		FileReader << PayloadSize;
+		FileReader << PayloadCrc;
+
+		const int64 PayloadOffset = FileReader.Tell();
+		if (Magic != FarmSaveFormat::JournalBlockMagic || PayloadSize < 0 || PayloadOffset + PayloadSize > FileData.Num()
+			|| FCrc::MemCrc32(FileData.GetData() + PayloadOffset, PayloadSize) != PayloadCrc)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("FFarmJournalBlock::ReadAllFromFile: Discarding torn journal tail in %s after %d blocks"), *FilePath, OutBlocks.Num());
+			break;
+		}
+
+		FMemoryReaderView PayloadReader(MakeArrayView(FileData.GetData() + PayloadOffset, PayloadSize));
+		FFarmJournalBlock& Block = OutBlocks.AddDefaulted_GetRef();
+		Block.Epoch = BlockEpoch;
+		PayloadReader << Block;
+
+		if (PayloadReader.IsError())
+		{
+			OutBlocks.Pop();
+			break;
+		}
+
+		FileReader.Seek(PayloadOffset + PayloadSize);
+	}
+
+	return true;
+}
+
+FArchive& operator<<(FArchive& Ar, FFarmSaveSnapshot& Snapshot)
+{
+	Ar << Snapshot.AssetPalette;
+	Ar << Snapshot.Plots;
+	Ar << Snapshot.RemovedLevelPlots;
+	Ar << Snapshot.Inventories;
+	Ar << Snapshot.Quests;
+	return Ar;
+}
+
+const FSoftObjectPath& FFarmSaveSnapshot::GetPaletteAsset(uint16 PaletteIndex) const
+{
+	static const FSoftObjectPath EmptyPath;
+	return AssetPalette.IsValidIndex(PaletteIndex - 1) ? AssetPalette[PaletteIndex - 1] : EmptyPath;
+}
+
+int32 FFarmSaveSnapshot::ApplyJournal(TConstArrayView<FFarmJournalBlock> Blocks)
+{
+	TMap<FSoftObjectPath, uint16> PaletteIndices;
+	for (int32 PaletteIndex = 0; PaletteIndex < AssetPalette.Num(); ++PaletteIndex)
+	{
+		PaletteIndices.Add(AssetPalette[PaletteIndex], static_cast<uint16>(PaletteIndex + 1));
+	}
+
+	TMap<FIntVector, int32> PlotsByLocation;
+	for (int32 PlotIndex = 0; PlotIndex < Plots.Num(); ++PlotIndex)
+	{
+		PlotsByLocation.Add(FFarmPlotSaveRecord::MakeLocationKey(Plots[PlotIndex].Location), PlotIndex);
+	}
+
+	TMap<FString, int32> InventoriesByKey;
+	for (int32 InventoryIndex = 0; InventoryIndex < Inventories.Num(); ++InventoryIndex)
+	{
+		InventoriesByKey.Add(Inventories[InventoryIndex].OwnerKey, InventoryIndex);
+	}
+
+	int32 NumReplayed = 0;
+	for (const FFarmJournalBlock& Block : Blocks)
+	{
+		if (Block.Epoch < JournalEpoch)
+		{
+			continue;
+		}
+
+		++NumReplayed;
+
+		auto RemapPaletteIndex = [this, &Block, &PaletteIndices](uint16 BlockIndex) -> uint16
+		{
+			if (!Block.AssetPalette.IsValidIndex(BlockIndex - 1))
+			{
+				return 0;
+			}
+
+			const FSoftObjectPath& Path = Block.AssetPalette[BlockIndex - 1];
+			if (const uint16* Found = PaletteIndices.Find(Path))
+			{
+				return *Found;
+			}
+
+			if (AssetPalette.Num() >= MAX_uint16)
+			{
+				return 0;
+			}
+
+			AssetPalette.Add(Path);
+			const uint16 PaletteIndex = static_cast<uint16>(AssetPalette.Num());
+			PaletteIndices.Add(Path, PaletteIndex);
+			return PaletteIndex;
+		};
+
+		for (const FVector3f& RemovedLocation : Block.RemovedPlots)
+		{
+			int32 PlotIndex = INDEX_NONE;
+			if (PlotsByLocation.RemoveAndCopyValue(FFarmPlotSaveRecord::MakeLocationKey(RemovedLocation), PlotIndex))
+			{
+				Plots.RemoveAtSwap(PlotIndex);
+				if (Plots.IsValidIndex(PlotIndex))
+				{
+					PlotsByLocation.Add(FFarmPlotSaveRecord::MakeLocationKey(Plots[PlotIndex].Location), PlotIndex);
+				}
+			}
+
+			// Whether the plot was level-placed is not recorded, so always leave a removal behind for the level copy
+			RemovedLevelPlots.Add(RemovedLocation);
+		}
+
+		for (const FFarmPlotSaveRecord& BlockRecord : Block.Plots)
+		{
+			FFarmPlotSaveRecord Record = BlockRecord;
+			Record.PlotClass = RemapPaletteIndex(BlockRecord.PlotClass);
+			Record.ContainerData = RemapPaletteIndex(BlockRecord.ContainerData);
+			Record.SoilData = RemapPaletteIndex(BlockRecord.SoilData);
+			Record.CropData = RemapPaletteIndex(BlockRecord.CropData);
+
+			const FIntVector LocationKey = FFarmPlotSaveRecord::MakeLocationKey(Record.Location);
+			if (const int32* PlotIndex = PlotsByLocation.Find(LocationKey))
+			{
+				Plots[*PlotIndex] = Record;
+			}
+			else
+			{
+				PlotsByLocation.Add(LocationKey, Plots.Add(Record));
+			}
+		}
+
+		for (const FFarmInventorySaveRecord& Inventory : Block.Inventories)
+		{
+			if (const int32* InventoryIndex = InventoriesByKey.Find(Inventory.OwnerKey))
+			{
+				Inventories[*InventoryIndex] = Inventory;
+			}
+			else
+			{
+				InventoriesByKey.Add(Inventory.OwnerKey, Inventories.Add(Inventory));
+			}
+		}
+	}
+
+	return NumReplayed;
+}
+
+SIZE_T FFarmSaveSnapshot::GetAllocatedSize() const
+{
+	SIZE_T Size = AssetPalette.GetAllocatedSize() + Plots.GetAllocatedSize() + RemovedLevelPlots.GetAllocatedSize()
+		+ Inventories.GetAllocatedSize() + Quests.GetAllocatedSize();
+
+	for (const FFarmInventorySaveRecord& Inventory : Inventories)
+	{
+		Size += Inventory.Slots.GetAllocatedSize();
+	}
+
+	return Size;
+}
+
+bool FFarmSaveSnapshot::SaveToFile(const FString& FilePath, FName CompressionFormat) const
+{
+	TArray<uint8> RawData;
+	FMemoryWriter RawWriter(RawData);
+	RawWriter << const_cast<FFarmSaveSnapshot&>(*this);
+
+	int32 CompressedSize = FCompression::CompressMemoryBound(CompressionFormat, RawData.Num());
+	TArray<uint8> CompressedData;
+	CompressedData.SetNumUninitialized(CompressedSize);
+
+	if (!FCompression::CompressMemory(CompressionFormat, CompressedData.GetData(), CompressedSize, RawData.GetData(), RawData.Num()))
+	{
+		UE_LOG(LogTemp, Error, TEXT("FFarmSaveSnapshot::SaveToFile: Failed to compress %d bytes with %s"), RawData.Num(), *CompressionFormat.ToString());
+		return false;
+	}
+
+	TArray<uint8> FileData;
+	FMemoryWriter FileWriter(FileData);
+
+	uint32 Magic = FarmSaveFormat::Magic;
+	uint32 Version = FarmSaveFormat::Version;
+	FString FormatName = CompressionFormat.ToString();
+	int32 UncompressedSize = RawData.Num();
+
+	int64 Epoch = JournalEpoch;
+
+	FileWriter << Magic;
+	FileWriter << Version;
+	FileWriter << Epoch;
+	FileWriter << FormatName;
+	FileWriter << UncompressedSize;
+	FileWriter << CompressedSize;
+	FileWriter.Serialize(CompressedData.GetData(), CompressedSize);
+
+	const FString TempPath = FilePath + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(FileData, *TempPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("FFarmSaveSnapshot::SaveToFile: Failed to write %s"), *TempPath);
+		return false;
+	}
+
+	if (!IFileManager::Get().Move(*FilePath, *TempPath, true, true))
+	{
+		UE_LOG(LogTemp, Error, TEXT("FFarmSaveSnapshot::SaveToFile: Failed to replace %s"), *FilePath);
+		return false;
+	}
+
+	return true;
+}
+
+bool FFarmSaveSnapshot::LoadFromFile(const FString& FilePath)
+{
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *FilePath, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader FileReader(FileData);
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	FString FormatName;
+	int32 UncompressedSize = 0;
+	int32 CompressedSize = 0;
+
+	FileReader << Magic;
+	FileReader << Version;
+
+	if (Magic != FarmSaveFormat::Magic || Version < FarmSaveFormat::MinVersion || Version > FarmSaveFormat::Version)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FFarmSaveSnapshot::LoadFromFile: %s is not a supported farm save (version %u)"), *FilePath, Version);
+		return false;
+	}
+
+	JournalEpoch = 0;
+	if (Version >= FarmSaveFormat::JournalEpochVersion)
+	{
+		FileReader << JournalEpoch;
+	}
+
+	FileReader << FormatName;
+	FileReader << UncompressedSize;
+	FileReader << CompressedSize;
+
+	if (FileReader.IsError() || UncompressedSize < 0 || CompressedSize < 0 || FileReader.Tell() + CompressedSize > FileData.Num())
+	{
+		UE_LOG(LogTemp, Error, TEXT("FFarmSaveSnapshot::LoadFromFile: %s is truncated"), *FilePath);
+		*this = FFarmSaveSnapshot();
+		return false;
+	}
+
+	TArray<uint8> RawData;
+	RawData.SetNumUninitialized(UncompressedSize);
+
+	if (!FCompression::UncompressMemory(FName(*FormatName), RawData.GetData(), UncompressedSize, FileData.GetData() + FileReader.Tell(), CompressedSize))
+	{
+		UE_LOG(LogTemp, Error, TEXT("FFarmSaveSnapshot::LoadFromFile: Failed to decompress %s"), *FilePath);
+		*this = FFarmSaveSnapshot();
+		return false;
+	}
+
+	FMemoryReader RawReader(RawData);
+	RawReader << *this;
+
+	if (RawReader.IsError())
+	{
+		// Replaying a journal onto a partly read save would restore a farm that never existed
+		UE_LOG(LogTemp, Error, TEXT("FFarmSaveSnapshot::LoadFromFile: %s is corrupt"), *FilePath);
+		*this = FFarmSaveSnapshot();
+		return false;
+	}
+
+	return true;
+}
+
+uint64 FFarmSaveSnapshot::ComputeStateHash()
+{
+	auto IsLocationLess = [](const FVector3f& A, const FVector3f& B)
+	{
+		const FIntVector KeyA = FFarmPlotSaveRecord::MakeLocationKey(A);
+		const FIntVector KeyB = FFarmPlotSaveRecord::MakeLocationKey(B);
+		if (KeyA.X != KeyB.X)
+		{
+			return KeyA.X < KeyB.X;
+		}
+		if (KeyA.Y != KeyB.Y)
+		{
+			return KeyA.Y < KeyB.Y;
+		}
+		return KeyA.Z < KeyB.Z;
+	};
+
+	Plots.Sort([&IsLocationLess](const FFarmPlotSaveRecord& A, const FFarmPlotSaveRecord& B)
+	{
+		return IsLocationLess(A.Location, B.Location);
+	});
+	RemovedLevelPlots.Sort(IsLocationLess);
+	Inventories.Sort([](const FFarmInventorySaveRecord& A, const FFarmInventorySaveRecord& B)
+	{
+		return A.OwnerKey < B.OwnerKey;
+	});
+	Quests.Sort([](const FFarmQuestSaveRecord& A, const FFarmQuestSaveRecord& B)
+	{
+		return A.OwnerKey != B.OwnerKey ? A.OwnerKey < B.OwnerKey : A.Quest.ToString() < B.Quest.ToString();
+	});
+
+	TArray<uint8> StateData;
+	FMemoryWriter Writer(StateData);
+
+	for (FFarmPlotSaveRecord& Plot : Plots)
+	{
+		FString PlotClass = GetPaletteAsset(Plot.PlotClass).ToString();
+		FString ContainerData = GetPaletteAsset(Plot.ContainerData).ToString();
+		FString SoilData = GetPaletteAsset(Plot.SoilData).ToString();
+		FString CropData = GetPaletteAsset(Plot.CropData).ToString();
+
+		Writer << Plot.Location;
+		Writer << Plot.Yaw;
+		Writer << PlotClass;
+		Writer << ContainerData;
+		Writer << SoilData;
+		Writer << CropData;
+		Writer << Plot.Flags;
+		Writer << Plot.WaterLevel;
+		Writer << Plot.GrowthProgress;
+		Writer << Plot.TimeWithoutWater;
+	}
+
+	Writer << RemovedLevelPlots;
+	Writer << Inventories;
+	Writer << Quests;
+
+	return CityHash64(reinterpret_cast<const char*>(StateData.GetData()), StateData.Num());
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+#include "../Inventory/FPackedInventory.h"
+
+/**
+ * Saved state of a single soil plot.
+ * Plain data only, so snapshots can be serialized and compressed off the game thread.
+ * Asset references are indices into FFarmSaveSnapshot::AssetPalette; 0 means none.
+ */
+struct FUNGIFIELDS_API FFarmPlotSaveRecord
+{
+	FVector3f Location = FVector3f::ZeroVector;
+	float Yaw = 0.0f;
+
+	uint16 PlotClass = 0;
+	uint16 ContainerData = 0;
+	uint16 SoilData = 0;
+	uint16 CropData = 0;
+
+	/** EFarmPlotFlags */
+	uint8 Flags = 0;
+
+	float WaterLevel = 0.0f;
+	float GrowthProgress = 0.0f;
+	float TimeWithoutWater = 0.0f;
+
+	/**
+	 * Get the key that identifies a plot location across sessions. Plots never share a location,
+	 * and level-placed plots never move, so rounding to whole units is exact enough.
+	 * @param InLocation Plot location
+	 * @return Rounded location
+	 */
+	static FIntVector MakeLocationKey(const FVector3f& InLocation)
+	{
+		return FIntVector(FMath::RoundToInt(InLocation.X), FMath::RoundToInt(InLocation.Y), FMath::RoundToInt(InLocation.Z));
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FFarmPlotSaveRecord& Record);
+};
+
+/** Saved contents of one persistent inventory */
+struct FUNGIFIELDS_API FFarmInventorySaveRecord
+{
+	/** Persistent key of the owning actor, see UFarmSaveSubsystem::GetPersistentKey */
+	FString OwnerKey;
+
+	FPackedInventory Slots;
+
+	friend FArchive& operator<<(FArchive& Ar, FFarmInventorySaveRecord& Record);
+};
+
+/** Saved progress of one active quest */
+struct FUNGIFIELDS_API FFarmQuestSaveRecord
+{
+	/** Persistent key of the owning actor */
+	FString OwnerKey;
+
+	FSoftObjectPath Quest;
+	int32 Progress = 0;
+
+	/** EQuestState */
+	uint8 State = 0;
+
+	friend FArchive& operator<<(FArchive& Ar, FFarmQuestSaveRecord& Record);
+};
+
+/**
+ * Farm changes recorded since the previous journal flush, stored as the state after the change.
+ * Blocks are appended to a journal file next to the save and replayed on top of it when loading.
+ * Each block carries its own asset palette, so any block can be replayed on its own.
+ */
+struct FUNGIFIELDS_API FFarmJournalBlock
+{
+	/** Checkpoint this block follows; blocks older than a save's epoch are already part of it */
+	int64 Epoch = 0;
+
+	/** Assets referenced by plot records in this block; record index N refers to AssetPalette[N - 1] */
+	TArray<FSoftObjectPath> AssetPalette;
+
+	/** Plots placed or changed */
+	TArray<FFarmPlotSaveRecord> Plots;
+
+	/** Locations of plots that were picked up or destroyed; applied before Plots */
+	TArray<FVector3f> RemovedPlots;
+
+	/** Inventories that changed */
+	TArray<FFarmInventorySaveRecord> Inventories;
+
+	/** True if the block records no changes */
+	bool IsEmpty() const { return Plots.Num() == 0 && RemovedPlots.Num() == 0 && Inventories.Num() == 0; }
+
+	/**
+	 * Append this block to a journal file and flush it to disk. Safe to call from any thread.
+	 * @param FilePath Journal file
+	 * @return True if the block was written
+	 */
+	bool AppendToFile(const FString& FilePath) const;
+
+	/**
+	 * Read every intact block from a journal file. Reading stops at the first torn or corrupt block,
+	 * which is what a crash during an append leaves behind. Safe to call from any thread.
+	 * @param FilePath Journal file
+	 * @param OutBlocks Receives the blocks in the order they were written
+	 * @return True if the file existed
+	 */
+	static bool ReadAllFromFile(const FString& FilePath, TArray<FFarmJournalBlock>& OutBlocks);
+
+	friend FArchive& operator<<(FArchive& Ar, FFarmJournalBlock& Block);
+};
+
+/**
+ * Complete farm save: every plot, persistent inventory and quest.
+ * Captured on the game thread, then written to disk compressed on a worker thread.
+ */
+struct FUNGIFIELDS_API FFarmSaveSnapshot
+{
+	/** Assets referenced by plot records; record index N refers to AssetPalette[N - 1] */
+	TArray<FSoftObjectPath> AssetPalette;
+
+	TArray<FFarmPlotSaveRecord> Plots;
+
+	/** Locations of level-placed plots that were destroyed */
+	TArray<FVector3f> RemovedLevelPlots;
+
+	TArray<FFarmInventorySaveRecord> Inventories;
+
+	TArray<FFarmQuestSaveRecord> Quests;
+
+	/** Journal epoch started when this save was captured; only journal blocks from this epoch on are replayed */
+	int64 JournalEpoch = 0;
+
+	/** Get the asset a palette index refers to, or an empty path for 0 and invalid indices */
+	const FSoftObjectPath& GetPaletteAsset(uint16 PaletteIndex) const;
+
+	/** Approximate in-memory size in bytes */
+	SIZE_T GetAllocatedSize() const;
+
+	/**
+	 * Replay journal blocks on top of this save, in order. Blocks older than JournalEpoch are skipped.
+	 * @param Blocks Journal blocks in the order they were written
+	 * @return Number of blocks replayed
+	 */
+	int32 ApplyJournal(TConstArrayView<FFarmJournalBlock> Blocks);
+
+	/**
+	 * Serialize, compress and write the snapshot. Safe to call from any thread.
+	 * Writes to a temporary file first, so an interrupted save never replaces a good one.
+	 * @param FilePath Destination file
+	 * @param CompressionFormat Compression format name, e.g. NAME_Oodle
+	 * @return True if the file was written
+	 */
+	bool SaveToFile(const FString& FilePath, FName CompressionFormat) const;
+
+	/**
+	 * Read, decompress and deserialize a snapshot. Safe to call from any thread. On failure the snapshot is left empty.
+	 * @param FilePath Source file
+	 * @return True if the file existed and was valid
+	 */
+	bool LoadFromFile(const FString& FilePath);
+
+	/**
+	 * Hash the simulated state in this snapshot, independent of the order records were captured in.
+	 * Sorts the records into a canonical order first. Asset references are hashed by path, so
+	 * snapshots with differently ordered palettes hash the same.
+	 * @return 64-bit state hash
+	 */
+	uint64 ComputeStateHash();
+
+	friend FArchive& operator<<(FArchive& Ar, FFarmSaveSnapshot& Snapshot);
+};
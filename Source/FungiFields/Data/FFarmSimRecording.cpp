@@ -0,0 +1,106 @@
+#include "FFarmSimRecording.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace FarmRecordingFormat
+{
+	/** Identifies farm recording files */
+	static constexpr uint32 Magic = 0x46465243; // 'FFRC'
+
+	/** Bumped whenever the recording layout changes */
+	static constexpr uint32 Version = 2;
+}
+
+FArchive& operator<<(FArchive& Ar, FFarmSimAction& Action)
+{
+	uint8 Type = static_cast<uint8>(Action.Type);
+
+	Ar << Action.Step;
+	Ar << Type;
+	Ar << Action.OwnerKey;
+	Ar << Action.Location;
+	Ar << Action.Rotation;
+	Ar << Action.Item;
+	Ar << Action.SlotIndex;
+	Ar << Action.OtherSlotIndex;
+	Ar << Action.Amount;
+	Ar << Action.CommandType;
+	Ar << Action.OtherOwnerKey;
+	Ar << Action.bTargetCrop;
+
+	Action.Type = static_cast<EFarmSimActionType>(Type);
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FFarmSimRecording& Recording)
+{
+	Ar << Recording.StartSlot;
+	Ar << Recording.Seed;
+	Ar << Recording.FixedStepSeconds;
+	Ar << Recording.StepCount;
+	Ar << Recording.HashInterval;
+	Ar << Recording.Actions;
+	Ar << Recording.StepHashes;
+	return Ar;
+}
+
+bool FFarmSimRecording::SaveToFile(const FString& FilePath) const
+{
+	TArray<uint8> FileData;
+	FMemoryWriter Writer(FileData);
+
+	uint32 Magic = FarmRecordingFormat::Magic;
+	uint32 Version = FarmRecordingFormat::Version;
+
+	Writer << Magic;
+	Writer << Version;
+	Writer << const_cast<FFarmSimRecording&>(*this);
+
+	if (!FFileHelper::SaveArrayToFile(FileData, *FilePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("FFarmSimRecording::SaveToFile: Failed to write %s"), *FilePath);
+		return false;
+	}
+
+	return true;
+}
+
+bool FFarmSimRecording::LoadFromFile(const FString& FilePath)
+{
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *FilePath, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(FileData);
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+
+	Reader << Magic;
+	Reader << Version;
+
+	if (Magic != FarmRecordingFormat::Magic || Version != FarmRecordingFormat::Version)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FFarmSimRecording::LoadFromFile: %s is not a supported farm recording (version %u)"), *FilePath, Version);
+		return false;
+	}
+
+	Reader << *this;
+
+	if (Reader.IsError())
+	{
+		UE_LOG(LogTemp, Error, TEXT("FFarmSimRecording::LoadFromFile: %s is corrupt"), *FilePath);
+		return false;
+	}
+
+	return true;
+}
+
+FString FFarmSimRecording::GetFilePath(const FString& RecordingName)
+{
+	return FPaths::ProjectSavedDir() / TEXT("FarmRecordings") / RecordingName + TEXT(".farmrec");
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+
+/** Kind of player action stored in a farm recording */
+enum class EFarmSimActionType : uint8
+{
+	/** Tool use, planting or harvesting on a plot */
+	FarmAction,
+
+	/** A placeable item was placed */
+	Place,
+
+	/** A plot was picked up */
+	Pickup,
+
+	/** An inventory command: move, swap, remove or transfer */
+	Inventory,
+
+	/** Items were added to an inventory from a pickup */
+	AddItem
+};
+
+/**
+ * One recorded player action. Actors are identified the way saves identify them, by persistent key,
+ * and plots by location, so a recording stays valid across sessions.
+ */
+struct FUNGIFIELDS_API FFarmSimAction
+{
+	/** Simulation step the action was performed before */
+	int32 Step = 0;
+
+	EFarmSimActionType Type = EFarmSimActionType::FarmAction;
+
+	/** Persistent key of the acting player, or of the inventory's owner for Inventory and AddItem */
+	FString OwnerKey;
+
+	/** FarmAction and Pickup: target plot location. Place: final location of the placed actor */
+	FVector3f Location = FVector3f::ZeroVector;
+
+	/** Place: rotation of the placed actor */
+	FRotator3f Rotation = FRotator3f::ZeroRotator;
+
+	/** Place: the placed item. AddItem: the added item */
+	FSoftObjectPath Item;
+
+	/** FarmAction and Place: equipped slot. Inventory: source slot */
+	int32 SlotIndex = 0;
+
+	/** Inventory Move and Swap: destination slot */
+	int32 OtherSlotIndex = 0;
+
+	/** Inventory Remove and AddItem: number of items */
+	int32 Amount = 0;
+
+	/** Inventory: EInventoryCommandType */
+	uint8 CommandType = 0;
+
+	/** Inventory Transfer: persistent key of the receiving inventory's owner */
+	FString OtherOwnerKey;
+
+	/** FarmAction: whether the plot's crop was targeted rather than the plot */
+	bool bTargetCrop = false;
+
+	friend FArchive& operator<<(FArchive& Ar, FFarmSimAction& Action);
+};
+
+/**
+ * A recorded run of the deterministic farm simulation: the save it started from, the seed and step it ran with,
+ * every player action stamped with its simulation step, and the state hash every HashInterval steps.
+ * Replaying it from the same save reproduces the run step for step.
+ */
+struct FUNGIFIELDS_API FFarmSimRecording
+{
+	/** Save slot holding the farm as it was when recording started */
+	FString StartSlot;
+
+	/** Seed for per-plot random streams */
+	int32 Seed = 0;
+
+	/** Simulated seconds per step */
+	float FixedStepSeconds = 1.0f;
+
+	/** Number of steps recorded */
+	int32 StepCount = 0;
+
+	/** Actions in the order they were performed */
+	TArray<FFarmSimAction> Actions;
+
+	/** Steps between state hashes */
+	int32 HashInterval = 1;
+
+	/** State hash after every HashInterval-th step, if hashing was enabled while recording */
+	TArray<uint64> StepHashes;
+
+	/**
+	 * Write the recording.
+	 * @param FilePath Destination file
+	 * @return True if the file was written
+	 */
+	bool SaveToFile(const FString& FilePath) const;
+
+	/**
+	 * Read a recording.
+	 * @param FilePath Source file
+	 * @return True if the file existed and was valid
+	 */
+	bool LoadFromFile(const FString& FilePath);
+
+	/**
+	 * Get the file a named recording is stored in.
+	 * @param RecordingName Recording name
+	 * @return Absolute file path
+	 */
+	static FString GetFilePath(const FString& RecordingName);
+
+	friend FArchive& operator<<(FArchive& Ar, FFarmSimRecording& Recording);
+};
@@ -1,7 +1,15 @@
 #include "Quest.h"
+#include "FFarmPrimaryAssets.h"
 #include "../Data/UItemDataAsset.h"
 #include "../Data/UCropDataAsset.h"
 #include "../Data/USeedDataAsset.h"
+#include "../Subsystems/FFarmAssetLoading.h"
+
+FPrimaryAssetId UQuest::GetPrimaryAssetId() const
+{
+	// Quests created at runtime are not assets and have no ID
+	return IsAsset() ? FPrimaryAssetId(FFarmPrimaryAssets::Quest, GetFName()) : FPrimaryAssetId();
+}
 
 bool UQuest::ShouldRespondToItemAdded(UItemDataAsset* Item, int32 Quantity) const
 {
@@ -10,13 +18,13 @@ bool UQuest::ShouldRespondToItemAdded(UItemDataAsset* Item, int32 Quantity) cons
 		return false;
 	}
 
-	if (!RequiredItem.IsValid())
+	if (RequiredItem.IsNull())
 	{
 		return true;
 	}
 
-	UItemDataAsset* RequiredItemPtr = RequiredItem.LoadSynchronous();
-	return RequiredItemPtr && Item == RequiredItemPtr;
+	// A required asset that is the event's asset is already in memory, so it resolves without a load
+	return Item && Item == RequiredItem.Get();
 }
 
 bool UQuest::ShouldRespondToCropHarvested(UCropDataAsset* CropData, int32 Quantity) const
@@ -26,13 +34,12 @@ bool UQuest::ShouldRespondToCropHarvested(UCropDataAsset* CropData, int32 Quanti
 		return false;
 	}
 
-	if (!RequiredCrop.IsValid())
+	if (RequiredCrop.IsNull())
 	{
 		return true;
 	}
 
-	UCropDataAsset* RequiredCropPtr = RequiredCrop.LoadSynchronous();
-	return RequiredCropPtr && CropData == RequiredCropPtr;
+	return CropData && CropData == RequiredCrop.Get();
 }
 
 bool UQuest::ShouldRespondToSeedPlanted(USeedDataAsset* SeedData) const
@@ -42,13 +49,22 @@ bool UQuest::ShouldRespondToSeedPlanted(USeedDataAsset* SeedData) const
 		return false;
 	}
 
-	if (!RequiredSeed.IsValid())
+	if (RequiredSeed.IsNull())
 	{
 		return true;
 	}
 
-	USeedDataAsset* RequiredSeedPtr = RequiredSeed.LoadSynchronous();
-	return RequiredSeedPtr && SeedData == RequiredSeedPtr;
+	return SeedData && SeedData == RequiredSeed.Get();
+}
+
+void UQuest::PrefetchRequirements()
+{
+	if (RequirementsHandle.IsValid())
+	{
+		return;
+	}
+
+	RequirementsHandle = FFarmAssetLoading::Prefetch({ RequiredItem.ToSoftObjectPath(), RequiredCrop.ToSoftObjectPath(), RequiredSeed.ToSoftObjectPath() });
 }
 
 void UQuest::StartQuest()
@@ -79,4 +95,10 @@ void UQuest::FailQuest()
 	{
 		State = EQuestState::Failed;
 	}
-}
\ No newline at end of file
+}
+
+void UQuest::RestoreProgress(int32 Progress, EQuestState SavedState)
+{
+	CurrentProgress = FMath::Clamp(Progress, 0, RequiredProgress);
+	State = SavedState;
+}
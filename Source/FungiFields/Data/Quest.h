@@ -3,19 +3,23 @@
 #include "CoreMinimal.h"
 #include "FungiFields/ENUM/QuestState.h"
 #include "FungiFields/ENUM/EQuestEventType.h"
-#include "UObject/Object.h"
+#include "Engine/DataAsset.h"
 #include "Quest.generated.h"
 
 class UItemDataAsset;
 class UCropDataAsset;
 class USeedDataAsset;
+struct FStreamableHandle;
 
 UCLASS()
-class FUNGIFIELDS_API UQuest : public UDataAsset
+class FUNGIFIELDS_API UQuest : public UPrimaryDataAsset
 {
 	GENERATED_BODY()
 
 public:
+	// UPrimaryDataAsset interface
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Quest")
 	FName QuestID;
 
@@ -36,15 +40,15 @@ public:
 	EQuestEventType QuestEventType = EQuestEventType::None;
 
 	/** Optional: Specific item this quest requires (for ItemAdded/ItemRemoved events) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Quest Requirements", meta = (EditCondition = "QuestEventType == EQuestEventType::ItemAdded || QuestEventType == EQuestEventType::ItemRemoved"))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Quest Requirements", meta = (EditCondition = "QuestEventType == EQuestEventType::ItemAdded || QuestEventType == EQuestEventType::ItemRemoved", AssetBundles = "Gameplay"))
 	TSoftObjectPtr<UItemDataAsset> RequiredItem;
 
 	/** Optional: Specific crop this quest requires (for CropHarvested events) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Quest Requirements", meta = (EditCondition = "QuestEventType == EQuestEventType::CropHarvested"))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Quest Requirements", meta = (EditCondition = "QuestEventType == EQuestEventType::CropHarvested", AssetBundles = "Gameplay"))
 	TSoftObjectPtr<UCropDataAsset> RequiredCrop;
 
 	/** Optional: Specific seed this quest requires (for SeedPlanted events) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Quest Requirements", meta = (EditCondition = "QuestEventType == EQuestEventType::SeedPlanted"))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Quest Requirements", meta = (EditCondition = "QuestEventType == EQuestEventType::SeedPlanted", AssetBundles = "Gameplay"))
 	TSoftObjectPtr<USeedDataAsset> RequiredSeed;
 
 	/**
@@ -73,6 +77,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Quest")
 	bool ShouldRespondToSeedPlanted(USeedDataAsset* SeedData) const;
 
+	/**
+	 * Start loading the required item, crop and seed in the background so event checks never load them.
+	 * Called when the quest is added to a player; the assets stay loaded while the quest exists.
+	 */
+	void PrefetchRequirements();
+
 	UFUNCTION(BlueprintCallable, Category="Quest")
 	void StartQuest();
 
@@ -81,4 +91,15 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category="Quest")
 	void FailQuest();
+
+	/**
+	 * Restore progress and state from a save.
+	 * @param Progress Saved progress, clamped to RequiredProgress
+	 * @param SavedState Saved quest state
+	 */
+	void RestoreProgress(int32 Progress, EQuestState SavedState);
+
+private:
+	/** Keeps the prefetched requirements loaded */
+	TSharedPtr<FStreamableHandle> RequirementsHandle;
 };
@@ -1,4 +1,5 @@
 #include "UCropDataAsset.h"
+#include "FFarmPrimaryAssets.h"
 
 UCropDataAsset::UCropDataAsset()
 {
@@ -7,4 +8,9 @@ UCropDataAsset::UCropDataAsset()
 	WitherTimeWithoutWater = 30.0f;
 	BaseHarvestQuantity = 1;
 	HarvestPowerNeeded = 100.0f;
+}
+
+FPrimaryAssetId UCropDataAsset::GetPrimaryAssetId() const
+{
+	return FPrimaryAssetId(FFarmPrimaryAssets::Crop, GetFName());
 }
\ No newline at end of file
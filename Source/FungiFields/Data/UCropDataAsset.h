@@ -12,13 +12,16 @@
  * Follows data-driven design principles - all crop configuration is external to C++ code.
  */
 UCLASS(BlueprintType)
-class FUNGIFIELDS_API UCropDataAsset : public UDataAsset
+class FUNGIFIELDS_API UCropDataAsset : public UPrimaryDataAsset
 {
 	GENERATED_BODY()
 
 public:
 	UCropDataAsset();
 
+	// UPrimaryDataAsset interface
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
 	/** Name of the crop */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Crop Properties")
 	FName CropName;
@@ -36,7 +39,7 @@ public:
 	float WitherTimeWithoutWater = 30.0f;
 
 	/** Item added to inventory on harvest */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Crop Properties")
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Crop Properties", AssetRegistrySearchable, meta = (AssetBundles = "Gameplay"))
 	TSoftObjectPtr<UItemDataAsset> HarvestItem;
 
 	/** Base number of items harvested */
@@ -47,13 +50,13 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Crop Properties", meta = (ClampMin = "0.0"))
 	float HarvestPowerNeeded = 100.0f;
 
-	/** Meshes for different growth stages (0%, 25%, 50%, 100%) */
+	/** Meshes for different growth stages (0%, 25%, 50%, 100%), streamed by UCropVisualStreamingSubsystem */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Crop Visuals")
-	TArray<UStaticMesh*> GrowthMeshes;
+	TArray<TSoftObjectPtr<UStaticMesh>> GrowthMeshes;
 
-	/** Mesh when crop wilts from lack of water */
+	/** Mesh when crop wilts from lack of water, streamed by UCropVisualStreamingSubsystem */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Crop Visuals")
-	UStaticMesh* WitheredMesh;
+	TSoftObjectPtr<UStaticMesh> WitheredMesh;
 
 	/** Particle effect to spawn when harvesting this crop (Niagara) */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Crop Visuals")
@@ -1,6 +1,11 @@
 #include "UItemDataAsset.h"
+#include "FFarmPrimaryAssets.h"
 
 UItemDataAsset::UItemDataAsset()
 {
 }
 
+FPrimaryAssetId UItemDataAsset::GetPrimaryAssetId() const
+{
+	return FPrimaryAssetId(FFarmPrimaryAssets::Item, GetFName());
+}
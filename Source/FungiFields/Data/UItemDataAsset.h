@@ -12,39 +12,43 @@ class AActor;
 /**
  * Data Asset for defining immutable item properties.
  * Follows data-driven design principles - all item configuration is external to C++ code.
+ * Seeds and tools share the Item primary asset type so item IDs and lookups cover every item.
  */
 UCLASS(BlueprintType)
-class FUNGIFIELDS_API UItemDataAsset : public UDataAsset
+class FUNGIFIELDS_API UItemDataAsset : public UPrimaryDataAsset
 {
 	GENERATED_BODY()
 
 public:
 	UItemDataAsset();
 
+	// UPrimaryDataAsset interface
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Properties")
 	FText ItemName;
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Properties", meta = (ClampMin = "1"))
 	int32 MaxStackSize = 1;
 
-	/** Image to display in Inventory and Hotbar */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Properties")
-	UTexture2D* ItemIcon;
+	/** Image to display in Inventory and Hotbar; loaded when a slot first shows the item */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Properties", meta = (AssetBundles = "UI"))
+	TSoftObjectPtr<UTexture2D> ItemIcon;
 
-	/** Mesh to display when item is equipped (attached to RightHandItemSlot socket) */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Properties")
-	UStaticMesh* ItemMesh;
+	/** Mesh to display when item is equipped (attached to RightHandItemSlot socket); loaded on equip */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Properties", meta = (AssetBundles = "Visual"))
+	TSoftObjectPtr<UStaticMesh> ItemMesh;
 
 	/** If true, this item can be placed in the world (e.g., soil containers) */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Placement")
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Placement", AssetRegistrySearchable)
 	bool bIsPlaceable = false;
 
 	/** The container data asset to use when placing (only used if bIsPlaceable is true) */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Placement", meta = (EditCondition = "bIsPlaceable"))
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Placement", AssetRegistrySearchable, meta = (EditCondition = "bIsPlaceable"))
 	TObjectPtr<USoilContainerDataAsset> PlaceableContainerDataAsset;
 
 	/** The soil type to place (deprecated - use PlaceableContainerDataAsset instead) */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Placement", meta = (EditCondition = "bIsPlaceable", DeprecatedProperty, DeprecationMessage = "Use PlaceableContainerDataAsset instead"))
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Placement", AssetRegistrySearchable, meta = (EditCondition = "bIsPlaceable", DeprecatedProperty, DeprecationMessage = "Use PlaceableContainerDataAsset instead"))
 	TObjectPtr<USoilDataAsset> PlaceableSoilDataAsset;
 
 	/** Actor class to spawn when placing (defaults to ASoilPlot for soil items, but can be any actor for cosmetics, etc.) */
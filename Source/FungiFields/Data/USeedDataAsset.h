@@ -19,7 +19,7 @@ public:
 	USeedDataAsset();
 
 	/** Crop to plant when this seed is used on soil */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Seed")
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Seed", AssetRegistrySearchable)
 	TObjectPtr<UCropDataAsset> CropToPlant;
 };
 
@@ -1,8 +1,12 @@
 #include "USoilContainerDataAsset.h"
+#include "FFarmPrimaryAssets.h"
 #include "Engine/StaticMesh.h"
 
 USoilContainerDataAsset::USoilContainerDataAsset()
 {
 }
 
-
+FPrimaryAssetId USoilContainerDataAsset::GetPrimaryAssetId() const
+{
+	return FPrimaryAssetId(FFarmPrimaryAssets::SoilContainer, GetFName());
+}
@@ -9,13 +9,16 @@
  * Contains information about the container mesh and container-specific settings.
  */
 UCLASS(BlueprintType)
-class FUNGIFIELDS_API USoilContainerDataAsset : public UDataAsset
+class FUNGIFIELDS_API USoilContainerDataAsset : public UPrimaryDataAsset
 {
 	GENERATED_BODY()
 
 public:
 	USoilContainerDataAsset();
 
+	// UPrimaryDataAsset interface
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
 	/** Name of the container type */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Container Properties")
 	FName ContainerName;
@@ -1,4 +1,5 @@
 #include "USoilDataAsset.h"
+#include "FFarmPrimaryAssets.h"
 
 USoilDataAsset::USoilDataAsset()
 {
@@ -6,4 +7,9 @@ USoilDataAsset::USoilDataAsset()
 	WaterRetentionMultiplier = 1.0f;
 	YieldChance = 0.0f;
 	MaxWaterLevel = 100.0f;
+}
+
+FPrimaryAssetId USoilDataAsset::GetPrimaryAssetId() const
+{
+	return FPrimaryAssetId(FFarmPrimaryAssets::Soil, GetFName());
 }
\ No newline at end of file
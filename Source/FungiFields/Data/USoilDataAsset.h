@@ -10,13 +10,16 @@
  * Follows data-driven design principles - all soil configuration is external to C++ code.
  */
 UCLASS(BlueprintType)
-class FUNGIFIELDS_API USoilDataAsset : public UDataAsset
+class FUNGIFIELDS_API USoilDataAsset : public UPrimaryDataAsset
 {
 	GENERATED_BODY()
 
 public:
 	USoilDataAsset();
 
+	// UPrimaryDataAsset interface
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
 	/** Name of the soil type */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Soil Properties")
 	FName SoilName;
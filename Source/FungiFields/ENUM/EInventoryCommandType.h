@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EInventoryCommandType.generated.h"
+
+/**
+ * Enum defining the inventory operations a client can request from the server.
+ */
+UENUM()
+enum class EInventoryCommandType : uint8
+{
+	/** MoveItemToSlot within one inventory */
+	Move,
+
+	/** SwapSlots within one inventory */
+	Swap,
+
+	/** RemoveFromSlot */
+	Remove,
+
+	/** Move a whole slot into another inventory */
+	Transfer
+};
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EInventoryRelevancy.generated.h"
+
+/**
+ * Enum controlling which connections receive a replicated inventory's contents.
+ */
+UENUM(BlueprintType)
+enum class EInventoryRelevancy : uint8
+{
+	/** Replicate to every connection the owning actor is relevant to */
+	Default			UMETA(DisplayName = "Default"),
+	
+	/** Only connections that have the inventory open or are within range */
+	OpenOrInRange	UMETA(DisplayName = "Open Or In Range")
+};
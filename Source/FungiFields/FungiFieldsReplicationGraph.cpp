@@ -0,0 +1,211 @@
+#include "FungiFieldsReplicationGraph.h"
+#include "Actors/AFarmChunk.h"
+#include "Actors/AChestActor.h"
+#include "Actors/ItemPickup.h"
+#include "Engine/LevelScriptActor.h"
+#include "GameFramework/Info.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "UObject/UObjectIterator.h"
+
+void UFungiFieldsReplicationGraphNode_ForConnection::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	Super::GatherActorListsForConnection(Params);
+
+	if (!OwnerRelevantActors || OwnerRelevantActors->Num() == 0)
+	{
+		return;
+	}
+
+	OwnedActors.Reset();
+	const UNetConnection* Connection = Params.ConnectionManager.NetConnection;
+	for (AActor* Actor : *OwnerRelevantActors)
+	{
+		if (IsValid(Actor) && Actor->GetNetConnection() == Connection)
+		{
+			OwnedActors.Add(Actor);
+		}
+	}
+
+	if (OwnedActors.Num() > 0)
+	{
+		Params.OutGatheredReplicationLists.AddReplicationActorList(OwnedActors);
+	}
+}
+
+UFungiFieldsReplicationGraph::UFungiFieldsReplicationGraph()
+{
+}
+
+void UFungiFieldsReplicationGraph::InitGlobalActorClassSettings()
+{
+	Super::InitGlobalActorClassSettings();
+
+	// Farm classes get explicit policies; everything else is derived from its defaults below
+	ClassRepNodePolicies.Set(AFarmChunk::StaticClass(), EFarmRepNodeMapping::SpatializeStatic);
+	ClassRepNodePolicies.Set(AChestActor::StaticClass(), EFarmRepNodeMapping::SpatializeStatic);
+	ClassRepNodePolicies.Set(AItemPickup::StaticClass(), EFarmRepNodeMapping::SpatializeDynamic);
+	ClassRepNodePolicies.Set(ALevelScriptActor::StaticClass(), EFarmRepNodeMapping::NotRouted);
+	ClassRepNodePolicies.Set(AInfo::StaticClass(), EFarmRepNodeMapping::AlwaysRelevant);
+
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		UClass* Class = *It;
+		if (!Class->IsChildOf(AActor::StaticClass())
+			|| Class->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated | CLASS_NewerVersionExists)
+			|| Class->GetName().StartsWith(TEXT("SKEL_"))
+			|| Class->GetName().StartsWith(TEXT("REINST_")))
+		{
+			continue;
+		}
+
+		const AActor* ActorCDO = Cast<AActor>(Class->GetDefaultObject());
+		if (!ActorCDO || !ActorCDO->GetIsReplicated())
+		{
+			continue;
+		}
+
+		if (!ClassRepNodePolicies.Contains(Class, false))
+		{
+			ClassRepNodePolicies.Set(Class, GetMappingForClass(Class));
+		}
+
+		FClassReplicationInfo ClassInfo;
+		ClassInfo.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(ActorCDO->NetUpdateFrequency);
+		ClassInfo.SetCullDistanceSquared(ActorCDO->NetCullDistanceSquared);
+
+		if (Class->IsChildOf(AFarmChunk::StaticClass()))
+		{
+			ClassInfo.SetCullDistanceSquared(FMath::Square(FarmChunkCullDistance));
+		}
+		else if (Class->IsChildOf(AChestActor::StaticClass()))
+		{
+			ClassInfo.SetCullDistanceSquared(FMath::Square(ChestCullDistance));
+		}
+		else if (Class->IsChildOf(AItemPickup::StaticClass()))
+		{
+			ClassInfo.SetCullDistanceSquared(FMath::Square(PickupCullDistance));
+		}
+
+		GlobalActorReplicationInfoMap.SetClassInfo(Class, ClassInfo);
+	}
+}
+
+EFarmRepNodeMapping UFungiFieldsReplicationGraph::GetMappingForClass(UClass* Class) const
+{
+	const AActor* ActorCDO = Cast<AActor>(Class->GetDefaultObject());
+	if (!ActorCDO)
+	{
+		return EFarmRepNodeMapping::NotRouted;
+	}
+
+	if (ActorCDO->bAlwaysRelevant)
+	{
+		return EFarmRepNodeMapping::AlwaysRelevant;
+	}
+
+	// The per-connection node already gathers each connection's own controller
+	if (Class->IsChildOf(APlayerController::StaticClass()))
+	{
+		return EFarmRepNodeMapping::NotRouted;
+	}
+
+	// Owned equipment and the like reach their owner through the per-connection node
+	if (ActorCDO->bOnlyRelevantToOwner)
+	{
+		return EFarmRepNodeMapping::OwnerRelevant;
+	}
+
+	if (Class->IsChildOf(APawn::StaticClass()) || ActorCDO->IsReplicatingMovement())
+	{
+		return EFarmRepNodeMapping::SpatializeDynamic;
+	}
+
+	if (ActorCDO->NetDormancy > DORM_Awake)
+	{
+		return EFarmRepNodeMapping::SpatializeDormancy;
+	}
+
+	return EFarmRepNodeMapping::SpatializeStatic;
+}
+
+void UFungiFieldsReplicationGraph::InitGlobalGraphNodes()
+{
+	GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+	GridNode->CellSize = SpatialCellSize;
+	GridNode->SpatialBias = SpatialBias;
+	AddGlobalGraphNode(GridNode);
+
+	AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+	AddGlobalGraphNode(AlwaysRelevantNode);
+}
+
+void UFungiFieldsReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
+{
+	Super::InitConnectionGraphNodes(RepGraphConnection);
+
+	// Each connection always gets its own controller and view target, and the owner-only actors it owns
+	UFungiFieldsReplicationGraphNode_ForConnection* ConnectionNode = CreateNewNode<UFungiFieldsReplicationGraphNode_ForConnection>();
+	ConnectionNode->OwnerRelevantActors = &OwnerRelevantActors;
+	AddConnectionGraphNode(ConnectionNode, RepGraphConnection);
+}
+
+void UFungiFieldsReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	const EFarmRepNodeMapping* Mapping = ClassRepNodePolicies.Get(ActorInfo.Class);
+	switch (Mapping ? *Mapping : EFarmRepNodeMapping::SpatializeDynamic)
+	{
+	case EFarmRepNodeMapping::AlwaysRelevant:
+		AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+		break;
+
+	case EFarmRepNodeMapping::OwnerRelevant:
+		OwnerRelevantActors.Add(ActorInfo.Actor);
+		break;
+
+	case EFarmRepNodeMapping::SpatializeStatic:
+		GridNode->AddActor_Static(ActorInfo, GlobalInfo);
+		break;
+
+	case EFarmRepNodeMapping::SpatializeDynamic:
+		GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+		break;
+
+	case EFarmRepNodeMapping::SpatializeDormancy:
+		GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+		break;
+
+	default:
+		break;
+	}
+}
+
+void UFungiFieldsReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	const EFarmRepNodeMapping* Mapping = ClassRepNodePolicies.Get(ActorInfo.Class);
+	switch (Mapping ? *Mapping : EFarmRepNodeMapping::SpatializeDynamic)
+	{
+	case EFarmRepNodeMapping::AlwaysRelevant:
+		AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+		break;
+
+	case EFarmRepNodeMapping::OwnerRelevant:
+		OwnerRelevantActors.RemoveFast(ActorInfo.Actor);
+		break;
+
+	case EFarmRepNodeMapping::SpatializeStatic:
+		GridNode->RemoveActor_Static(ActorInfo);
+		break;
+
+	case EFarmRepNodeMapping::SpatializeDynamic:
+		GridNode->RemoveActor_Dynamic(ActorInfo);
+		break;
+
+	case EFarmRepNodeMapping::SpatializeDormancy:
+		GridNode->RemoveActor_Dormancy(ActorInfo);
+		break;
+
+	default:
+		break;
+	}
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicationGraph.h"
+#include "FungiFieldsReplicationGraph.generated.h"
+
+class UReplicationGraphNode_GridSpatialization2D;
+class UReplicationGraphNode_ActorList;
+class UReplicationGraphNode_AlwaysRelevant_ForConnection;
+
+/** How a replicated actor class is routed through the replication graph */
+enum class EFarmRepNodeMapping : uint8
+{
+	/** Not routed to any node; player controllers reach their connection through its per-connection node */
+	NotRouted,
+	/** Replicated only to the connection that owns it (bOnlyRelevantToOwner) */
+	OwnerRelevant,
+	/** Replicated to every connection */
+	AlwaysRelevant,
+	/** Placed in grid cells once; never moves */
+	SpatializeStatic,
+	/** Re-bucketed into grid cells every frame */
+	SpatializeDynamic,
+	/** Static while dormant, dynamic while awake */
+	SpatializeDormancy
+};
+
+/**
+ * Per-connection node that adds the connection's owner-only actors to its controller and view target.
+ * The actors are checked for ownership each gather, so an actor whose owner changes follows it.
+ */
+UCLASS()
+class FUNGIFIELDS_API UFungiFieldsReplicationGraphNode_ForConnection : public UReplicationGraphNode_AlwaysRelevant_ForConnection
+{
+	GENERATED_BODY()
+
+public:
+	// UReplicationGraphNode interface
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+	/** Owner-only actors of every connection, kept by the graph */
+	const FActorRepListRefView* OwnerRelevantActors = nullptr;
+
+private:
+	/** The owner-only actors owned by this node's connection, rebuilt each gather */
+	FActorRepListRefView OwnedActors;
+};
+
+/**
+ * Replication graph with a spatial policy for farm actors.
+ * Replicated actors are bucketed into a 2D grid so each connection only considers the cells around its view,
+ * instead of running a relevancy check on every actor for every connection.
+ * Farm chunks and chests are static cell residents and cost nothing while dormant;
+ * dropped pickups are dynamic cell residents. Owner-only actors are replicated to their owning connection alone.
+ * Soil plots and crops do not replicate as actors at all - their state travels inside farm chunks.
+ *
+ * Enabled through ReplicationDriverClassName in DefaultEngine.ini.
+ */
+UCLASS(Transient, Config = Engine)
+class FUNGIFIELDS_API UFungiFieldsReplicationGraph : public UReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	UFungiFieldsReplicationGraph();
+
+	// UReplicationGraph interface
+	virtual void InitGlobalActorClassSettings() override;
+	virtual void InitGlobalGraphNodes() override;
+	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+
+protected:
+	/** Size of a spatial grid cell (world units) */
+	UPROPERTY(Config)
+	float SpatialCellSize = 1600.0f;
+
+	/** Offset applied to locations before bucketing, so the grid covers negative coordinates */
+	UPROPERTY(Config)
+	FVector2D SpatialBias = FVector2D(-150000.0f, -150000.0f);
+
+	/** Distance at which farm chunks stop replicating to a connection (world units) */
+	UPROPERTY(Config)
+	float FarmChunkCullDistance = 6000.0f;
+
+	/** Distance at which dropped pickups stop replicating to a connection (world units) */
+	UPROPERTY(Config)
+	float PickupCullDistance = 3000.0f;
+
+	/** Distance at which chests stop replicating to a connection (world units) */
+	UPROPERTY(Config)
+	float ChestCullDistance = 6000.0f;
+
+	/** Spatial grid for all located actors */
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_GridSpatialization2D> GridNode;
+
+	/** Actors relevant to every connection */
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_ActorList> AlwaysRelevantNode;
+
+	/** Actors relevant only to their owner, handed out by each connection's node */
+	FActorRepListRefView OwnerRelevantActors;
+
+private:
+	/** Pick a routing policy for a replicated class from its defaults */
+	EFarmRepNodeMapping GetMappingForClass(UClass* Class) const;
+
+	/** Routing policy per class, resolved through the class hierarchy */
+	TClassMap<EFarmRepNodeMapping> ClassRepNodePolicies;
+};
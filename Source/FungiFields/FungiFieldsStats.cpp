@@ -0,0 +1,45 @@
+#include "FungiFieldsStats.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_STAT(STAT_FarmGrowthTimer);
+DEFINE_STAT(STAT_FarmUpdateGrowth);
+DEFINE_STAT(STAT_FarmEvaporation);
+DEFINE_STAT(STAT_FarmSimulationStep);
+DEFINE_STAT(STAT_FarmPlotVisuals);
+DEFINE_STAT(STAT_FarmCropVisuals);
+DEFINE_STAT(STAT_FarmTraceForFarmable);
+DEFINE_STAT(STAT_FarmTraceForInteractable);
+DEFINE_STAT(STAT_FarmPlacementPreview);
+DEFINE_STAT(STAT_FarmCanPlace);
+DEFINE_STAT(STAT_FarmInventoryMutation);
+DEFINE_STAT(STAT_FarmWidgetRefresh);
+
+DEFINE_STAT(STAT_FarmRegisteredCrops);
+DEFINE_STAT(STAT_FarmEventsBroadcast);
+DEFINE_STAT(STAT_FarmTraces);
+DEFINE_STAT(STAT_FarmActorsSpawned);
+DEFINE_STAT(STAT_FarmPoolReuses);
+
+UE_TRACE_CHANNEL_DEFINE(FarmChannel);
+
+LLM_DEFINE_TAG(Farm);
+LLM_DEFINE_TAG(Farm_Plots);
+LLM_DEFINE_TAG(Farm_Crops);
+LLM_DEFINE_TAG(Farm_Materials);
+LLM_DEFINE_TAG(Farm_Inventory);
+LLM_DEFINE_TAG(Farm_Widgets);
+LLM_DEFINE_TAG(Farm_Pickups);
+LLM_DEFINE_TAG(Farm_CropManager);
+
+namespace
+{
+	FAutoConsoleCommand FarmTraceCommand(
+		TEXT("Farm.Trace"),
+		TEXT("Farm.Trace [0|1]: toggle the Farm trace channel's CPU events in Unreal Insights. No argument flips it."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			const bool bEnable = Args.Num() > 0 ? FCString::ToBool(*Args[0]) : !FarmChannel.IsEnabled();
+			UE::Trace::ToggleChannel(TEXT("Farm"), bEnable);
+			UE_LOG(LogTemp, Display, TEXT("Farm.Trace: Farm trace channel %s"), bEnable ? TEXT("enabled") : TEXT("disabled"));
+		}));
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Trace/Trace.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Subsystems/FFarmHitchLog.h"
+#include "Subsystems/FFarmSimTimings.h"
+
+/**
+ * Farm profiling: the FungiFields stat group ("stat FungiFields") and the Farm trace channel for Unreal Insights.
+ * The channel is off by default; enable it with -trace=cpu,farm or at runtime with Farm.Trace 1.
+ */
+DECLARE_STATS_GROUP(TEXT("FungiFields"), STATGROUP_FungiFields, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Crop Growth Timer"), STAT_FarmGrowthTimer, STATGROUP_FungiFields, FUNGIFIELDS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Crop UpdateGrowth"), STAT_FarmUpdateGrowth, STATGROUP_FungiFields, FUNGIFIELDS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Water Evaporation"), STAT_FarmEvaporation, STATGROUP_FungiFields, FUNGIFIELDS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Simulation Step"), STAT_FarmSimulationStep, STATGROUP_FungiFields, FUNGIFIELDS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Plot Visuals"), STAT_FarmPlotVisuals, STATGROUP_FungiFields, FUNGIFIELDS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Crop Visuals"), STAT_FarmCropVisuals, STATGROUP_FungiFields, FUNGIFIELDS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Farmable Trace"), STAT_FarmTraceForFarmable, STATGROUP_FungiFields, FUNGIFIELDS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Interactable Trace"), STAT_FarmTraceForInteractable, STATGROUP_FungiFields, FUNGIFIELDS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Placement Preview"), STAT_FarmPlacementPreview, STATGROUP_FungiFields, FUNGIFIELDS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Placement Check"), STAT_FarmCanPlace, STATGROUP_FungiFields, FUNGIFIELDS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Inventory Mutation"), STAT_FarmInventoryMutation, STATGROUP_FungiFields, FUNGIFIELDS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Widget Refresh"), STAT_FarmWidgetRefresh, STATGROUP_FungiFields, FUNGIFIELDS_API);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Registered Crops"), STAT_FarmRegisteredCrops, STATGROUP_FungiFields, FUNGIFIELDS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Events Broadcast"), STAT_FarmEventsBroadcast, STATGROUP_FungiFields, FUNGIFIELDS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Traces"), STAT_FarmTraces, STATGROUP_FungiFields, FUNGIFIELDS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Actors Spawned"), STAT_FarmActorsSpawned, STATGROUP_FungiFields, FUNGIFIELDS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pool Reuses"), STAT_FarmPoolReuses, STATGROUP_FungiFields, FUNGIFIELDS_API);
+
+UE_TRACE_CHANNEL_EXTERN(FarmChannel, FUNGIFIELDS_API);
+
+/** Low-Level Memory tracker tags, shown under Farm/ with -llm */
+LLM_DECLARE_TAG_API(Farm_Plots, FUNGIFIELDS_API);
+LLM_DECLARE_TAG_API(Farm_Crops, FUNGIFIELDS_API);
+LLM_DECLARE_TAG_API(Farm_Materials, FUNGIFIELDS_API);
+LLM_DECLARE_TAG_API(Farm_Inventory, FUNGIFIELDS_API);
+LLM_DECLARE_TAG_API(Farm_Widgets, FUNGIFIELDS_API);
+LLM_DECLARE_TAG_API(Farm_Pickups, FUNGIFIELDS_API);
+LLM_DECLARE_TAG_API(Farm_CropManager, FUNGIFIELDS_API);
+
+/** Time a scope under a FungiFields stat and, while the Farm trace channel is on, as a named Insights event */
+#define FARM_SCOPE_CYCLE_COUNTER(Stat, EventName) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(EventName, FarmChannel)
+
+/** Increment a FungiFields counter stat together with its FFarmSimTimings counter for the perf overlay */
+#define FARM_INC_COUNTER(Stat, Counter) \
+	INC_DWORD_STAT(Stat); \
+	FFarmSimTimings::Count(&FFarmSimTimings::Counter)
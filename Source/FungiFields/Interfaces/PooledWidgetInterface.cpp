@@ -0,0 +1 @@
+#include "PooledWidgetInterface.h"
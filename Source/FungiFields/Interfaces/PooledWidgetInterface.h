@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "PooledWidgetInterface.generated.h"
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UPooledWidgetInterface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Interface for widgets handed out by UFarmWidgetPoolSubsystem that hold state or bindings from their last user.
+ */
+class FUNGIFIELDS_API IPooledWidgetInterface
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Called when the widget is released to the pool, after it has been removed from its parent.
+	 * Clear delegate bindings and any data from the last user so the next one starts from an empty widget.
+	 */
+	virtual void ResetForPool() = 0;
+};
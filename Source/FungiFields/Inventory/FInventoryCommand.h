@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "../ENUM/EInventoryCommandType.h"
+#include "FInventoryCommand.generated.h"
+
+class UInventoryComponent;
+
+/**
+ * Inventory operation recorded on a client, predicted locally and sent to the server in a per-frame batch.
+ * Commands are issued through the local player's own inventory, since only components on owned actors can call
+ * server RPCs; they may target any replicated inventory, such as an open chest.
+ */
+USTRUCT()
+struct FUNGIFIELDS_API FInventoryCommand
+{
+	GENERATED_BODY()
+
+	/** Client sequence number, acknowledged by the server */
+	UPROPERTY()
+	uint16 Sequence = 0;
+
+	/** Operation to perform */
+	UPROPERTY()
+	EInventoryCommandType Type = EInventoryCommandType::Move;
+
+	/** Inventory the operation is performed on */
+	UPROPERTY()
+	TObjectPtr<UInventoryComponent> Inventory = nullptr;
+
+	/** Source slot in Inventory */
+	UPROPERTY()
+	uint16 SlotIndex = 0;
+
+	/** Move/Swap: destination slot in Inventory */
+	UPROPERTY()
+	uint16 OtherSlotIndex = 0;
+
+	/** Transfer: inventory receiving the slot's contents */
+	UPROPERTY()
+	TObjectPtr<UInventoryComponent> OtherInventory = nullptr;
+
+	/** Remove: number of items to remove */
+	UPROPERTY()
+	int32 Amount = 0;
+};
@@ -0,0 +1,73 @@
+#include "FInventorySlot.h"
+#include "../Data/UItemDataAsset.h"
+#include "../Subsystems/UItemCatalogSubsystem.h"
+#include "UObject/CoreNet.h"
+
+bool FInventorySlot::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+
+	uint8 bHasItem = Ar.IsSaving() ? (IsEmpty() ? 0 : 1) : 0;
+	Ar.SerializeBits(&bHasItem, 1);
+
+	if (!bHasItem)
+	{
+		if (Ar.IsLoading())
+		{
+			Clear();
+		}
+		return true;
+	}
+
+	const UItemCatalogSubsystem* Catalog = UItemCatalogSubsystem::GetActive();
+
+	// A slot still waiting for its item is sent by the catalog ID it is waiting on
+	int32 ItemId = INDEX_NONE;
+	if (Ar.IsSaving())
+	{
+		ItemId = IsPendingLoad() ? PendingItemId : (Catalog ? Catalog->GetItemId(ItemDefinition) : INDEX_NONE);
+	}
+
+	uint8 bUsesCatalogId = Ar.IsSaving() ? (ItemId != INDEX_NONE && ItemId <= UItemCatalogSubsystem::MaxPackedItemId ? 1 : 0) : 0;
+	Ar.SerializeBits(&bUsesCatalogId, 1);
+
+	if (bUsesCatalogId)
+	{
+		uint16 PackedId = static_cast<uint16>(ItemId);
+		Ar << PackedId;
+
+		if (Ar.IsLoading())
+		{
+			ItemDefinition = Catalog ? Catalog->GetLoadedItem(PackedId) : nullptr;
+			PendingItemId = ItemDefinition ? INDEX_NONE : PackedId;
+
+			if (!Catalog || PackedId >= Catalog->GetNumItems())
+			{
+				UE_LOG(LogTemp, Warning, TEXT("FInventorySlot::NetSerialize: Could not resolve catalog item %d"), PackedId);
+				PendingItemId = INDEX_NONE;
+				bOutSuccess = false;
+			}
+		}
+	}
+	else
+	{
+		UObject* ItemObject = const_cast<UItemDataAsset*>(ItemDefinition.Get());
+		bOutSuccess &= Map ? Map->SerializeObject(Ar, UItemDataAsset::StaticClass(), ItemObject) : false;
+
+		if (Ar.IsLoading())
+		{
+			ItemDefinition = Cast<UItemDataAsset>(ItemObject);
+			PendingItemId = INDEX_NONE;
+		}
+	}
+
+	uint32 PackedCount = static_cast<uint32>(FMath::Max(Count, 0));
+	Ar.SerializeIntPacked(PackedCount);
+
+	if (Ar.IsLoading())
+	{
+		Count = static_cast<int32>(PackedCount);
+	}
+
+	return true;
+}
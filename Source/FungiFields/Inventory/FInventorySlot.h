@@ -1,17 +1,21 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Net/Serialization/FastArraySerializer.h"
 #include "FInventorySlot.generated.h"
 
 class UItemDataAsset;
+class UPackageMap;
 
 /**
  * Struct representing a single inventory slot.
  * Contains a reference to the item definition and the count of items in the slot.
  * USTRUCT is appropriate here as slots are lightweight data containers, not garbage collected.
+ * Slots are fast array items so replicated inventories only send the slots that changed.
+ * Copy contents between slots with SetContents/SwapContents so replication IDs stay with their slot.
  */
 USTRUCT(BlueprintType)
-struct FUNGIFIELDS_API FInventorySlot
+struct FUNGIFIELDS_API FInventorySlot : public FFastArraySerializerItem
 {
 	GENERATED_BODY()
 
@@ -21,6 +25,76 @@ struct FUNGIFIELDS_API FInventorySlot
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Inventory Slot")
 	int32 Count = 0;
 
-	bool IsEmpty() const { return Count <= 0 || ItemDefinition == nullptr; }
+	/**
+	 * Catalog ID of an item that was received or restored before it was loaded, or INDEX_NONE.
+	 * The slot is not empty, so nothing is put in it, but has no item to use until the owning inventory
+	 * has loaded the item and filled it in.
+	 */
+	int32 PendingItemId = INDEX_NONE;
+
+	/** True if nothing is in the slot; a slot waiting for its item to load is not empty */
+	bool IsEmpty() const { return Count <= 0 || (ItemDefinition == nullptr && !IsPendingLoad()); }
+
+	/** True if the slot holds a loaded item that can be used, stacked or removed */
+	bool HasItem() const { return Count > 0 && ItemDefinition != nullptr; }
+
+	/** True if the slot is waiting for its item to load */
+	bool IsPendingLoad() const { return PendingItemId != INDEX_NONE; }
+
+	/** Set the item and count, leaving replication state untouched */
+	void SetContents(const UItemDataAsset* Item, int32 NewCount)
+	{
+		ItemDefinition = Item;
+		Count = NewCount;
+		PendingItemId = INDEX_NONE;
+	}
+
+	/** Hold a count of an item that is still loading, leaving replication state untouched */
+	void SetPendingContents(int32 ItemId, int32 NewCount)
+	{
+		ItemDefinition = nullptr;
+		Count = NewCount;
+		PendingItemId = ItemId;
+	}
+
+	/** Copy the contents of another slot, including a pending item, leaving replication state untouched */
+	void CopyContents(const FInventorySlot& Other)
+	{
+		ItemDefinition = Other.ItemDefinition;
+		Count = Other.Count;
+		PendingItemId = Other.PendingItemId;
+	}
+
+	/** True if another slot holds the same contents */
+	bool HasSameContents(const FInventorySlot& Other) const
+	{
+		return ItemDefinition == Other.ItemDefinition && Count == Other.Count && PendingItemId == Other.PendingItemId;
+	}
+
+	/** Empty the slot, leaving replication state untouched */
+	void Clear() { SetContents(nullptr, 0); }
+
+	/** Exchange item and count with another slot, leaving replication state untouched */
+	void SwapContents(FInventorySlot& Other)
+	{
+		Swap(ItemDefinition, Other.ItemDefinition);
+		Swap(Count, Other.Count);
+		Swap(PendingItemId, Other.PendingItemId);
+	}
+
+	/**
+	 * Packed network encoding: one bit for empty slots, otherwise a 16-bit catalog item ID and a variable-length count.
+	 * Items missing from the item catalog fall back to a regular object reference. A received catalog item that is
+	 * not loaded is never loaded here; the slot keeps its ID as PendingItemId for the inventory to load.
+	 */
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
 };
 
+template<>
+struct TStructOpsTypeTraits<FInventorySlot> : public TStructOpsTypeTraitsBase2<FInventorySlot>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
@@ -0,0 +1,26 @@
+#include "FInventorySlotList.h"
+#include "../Components/InventoryComponent.h"
+
+void FInventorySlotList::PostReplicatedAdd(const TArrayView<int32>& AddedIndices, int32 FinalSize)
+{
+	if (OwnerComponent)
+	{
+		OwnerComponent->NotifySlotsReplicated(AddedIndices);
+	}
+}
+
+void FInventorySlotList::PostReplicatedChange(const TArrayView<int32>& ChangedIndices, int32 FinalSize)
+{
+	if (OwnerComponent)
+	{
+		OwnerComponent->NotifySlotsReplicated(ChangedIndices);
+	}
+}
+
+void FInventorySlotList::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+	if (OwnerComponent)
+	{
+		OwnerComponent->FlushChangedSlots();
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "FInventorySlot.h"
+#include "FInventorySlotList.generated.h"
+
+class UInventoryComponent;
+
+/**
+ * Fast array of inventory slots.
+ * Slots are created once on the server and never reordered, so array index is the slot index on every machine.
+ * Received changes are forwarded to the owning component as a list of slot indices.
+ */
+USTRUCT()
+struct FUNGIFIELDS_API FInventorySlotList : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	FInventorySlotList() {}
+	explicit FInventorySlotList(UInventoryComponent* InOwnerComponent) : OwnerComponent(InOwnerComponent) {}
+
+	UPROPERTY(VisibleAnywhere, Category = "Inventory Data")
+	TArray<FInventorySlot> Slots;
+
+	/** Component that receives replication notifications; set by the component itself, never copied from an archetype */
+	UPROPERTY(Transient, NotReplicated)
+	TObjectPtr<UInventoryComponent> OwnerComponent = nullptr;
+
+	// FFastArraySerializer contract
+	void PostReplicatedAdd(const TArrayView<int32>& AddedIndices, int32 FinalSize);
+	void PostReplicatedChange(const TArrayView<int32>& ChangedIndices, int32 FinalSize);
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FInventorySlot, FInventorySlotList>(Slots, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FInventorySlotList> : public TStructOpsTypeTraitsBase2<FInventorySlotList>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
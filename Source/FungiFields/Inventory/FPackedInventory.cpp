@@ -0,0 +1,188 @@
+#include "FPackedInventory.h"
+#include "FInventorySlot.h"
+#include "../Data/UItemDataAsset.h"
+#include "../Subsystems/UItemCatalogSubsystem.h"
+
+namespace PackedInventoryFormat
+{
+	/** Bumped whenever the archive layout changes */
+	static constexpr uint8 Version = 1;
+
+	/** Most slots a packed inventory can hold; larger counts in an archive mean it is corrupt */
+	static constexpr uint32 MaxSlots = 1 << 16;
+}
+
+void FPackedInventory::Pack(const TArray<FInventorySlot>& Slots)
+{
+	Palette.Reset();
+	SlotItems.SetNumUninitialized(Slots.Num());
+	SlotCounts.SetNumUninitialized(Slots.Num());
+
+	const UItemCatalogSubsystem* Catalog = UItemCatalogSubsystem::GetActive();
+	TMap<const UItemDataAsset*, uint16, TInlineSetAllocator<16>> PaletteLookup;
+	TMap<int32, uint16, TInlineSetAllocator<4>> PendingPaletteLookup;
+
+	for (int32 i = 0; i < Slots.Num(); ++i)
+	{
+		const FInventorySlot& Slot = Slots[i];
+		uint16* PaletteIndex = nullptr;
+
+		if (Slot.HasItem())
+		{
+			PaletteIndex = PaletteLookup.Find(Slot.ItemDefinition.Get());
+			if (!PaletteIndex && Palette.Num() < MAX_uint16)
+			{
+				Palette.Add(FSoftObjectPath(Slot.ItemDefinition.Get()));
+				PaletteIndex = &PaletteLookup.Add(Slot.ItemDefinition.Get(), static_cast<uint16>(Palette.Num()));
+			}
+		}
+		else if (Slot.IsPendingLoad() && Slot.Count > 0 && Catalog)
+		{
+			// Items still loading are kept, so a save made in the meantime does not drop them
+			PaletteIndex = PendingPaletteLookup.Find(Slot.PendingItemId);
+			const FSoftObjectPath& ItemPath = Catalog->GetItemPath(Slot.PendingItemId);
+			if (!PaletteIndex && !ItemPath.IsNull() && Palette.Num() < MAX_uint16)
+			{
+				Palette.Add(ItemPath);
+				PaletteIndex = &PendingPaletteLookup.Add(Slot.PendingItemId, static_cast<uint16>(Palette.Num()));
+			}
+		}
+
+		if (!PaletteIndex)
+		{
+			SlotItems[i] = EmptySlot;
+			SlotCounts[i] = 0;
+			continue;
+		}
+
+		SlotItems[i] = *PaletteIndex;
+		SlotCounts[i] = Slot.Count;
+	}
+}
+
+void FPackedInventory::Unpack(TArray<FInventorySlot>& OutSlots) const
+{
+	const UItemCatalogSubsystem* Catalog = UItemCatalogSubsystem::GetActive();
+
+	// Items are only resolved; one that is not loaded keeps its catalog ID for the inventory to load
+	TArray<const UItemDataAsset*, TInlineAllocator<16>> ResolvedPalette;
+	TArray<int32, TInlineAllocator<16>> PendingPalette;
+	ResolvedPalette.Reserve(Palette.Num());
+	PendingPalette.Reserve(Palette.Num());
+
+	for (const FSoftObjectPath& ItemPath : Palette)
+	{
+		const UItemDataAsset* Item = Cast<UItemDataAsset>(ItemPath.ResolveObject());
+		const int32 PendingItemId = !Item && Catalog ? Catalog->GetItemIdByPath(ItemPath) : INDEX_NONE;
+		if (!Item && PendingItemId == INDEX_NONE)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("FPackedInventory::Unpack: Item '%s' no longer exists, dropping its slots"), *ItemPath.ToString());
+		}
+		ResolvedPalette.Add(Item);
+		PendingPalette.Add(PendingItemId);
+	}
+
+	OutSlots.SetNum(SlotItems.Num());
+
+	for (int32 i = 0; i < SlotItems.Num(); ++i)
+	{
+		FInventorySlot& Slot = OutSlots[i];
+		const uint16 PaletteIndex = SlotItems[i];
+
+		if (PaletteIndex == EmptySlot || !ResolvedPalette.IsValidIndex(PaletteIndex - 1))
+		{
+			Slot.Clear();
+		}
+		else if (ResolvedPalette[PaletteIndex - 1])
+		{
+			Slot.SetContents(ResolvedPalette[PaletteIndex - 1], SlotCounts[i]);
+		}
+		else if (PendingPalette[PaletteIndex - 1] != INDEX_NONE)
+		{
+			Slot.SetPendingContents(PendingPalette[PaletteIndex - 1], SlotCounts[i]);
+		}
+		else
+		{
+			Slot.Clear();
+		}
+	}
+}
+
+const FSoftObjectPath& FPackedInventory::GetSlotItemPath(int32 SlotIndex) const
+{
+	static const FSoftObjectPath EmptyPath;
+	return IsSlotEmpty(SlotIndex) ? EmptyPath : Palette[SlotItems[SlotIndex] - 1];
+}
+
+SIZE_T FPackedInventory::GetAllocatedSize() const
+{
+	return Palette.GetAllocatedSize() + SlotItems.GetAllocatedSize() + SlotCounts.GetAllocatedSize();
+}
+
+FArchive& operator<<(FArchive& Ar, FPackedInventory& Inventory)
+{
+	uint8 Version = PackedInventoryFormat::Version;
+	Ar << Version;
+
+	if (Ar.IsLoading() && Version != PackedInventoryFormat::Version)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FPackedInventory: Unsupported packed inventory version %d"), Version);
+		Ar.SetError();
+		return Ar;
+	}
+
+	uint32 PaletteNum = Inventory.Palette.Num();
+	Ar.SerializeIntPacked(PaletteNum);
+	if (Ar.IsLoading())
+	{
+		if (PaletteNum > MAX_uint16)
+		{
+			UE_LOG(LogTemp, Error, TEXT("FPackedInventory: Palette of %u items is out of range"), PaletteNum);
+			Ar.SetError();
+			return Ar;
+		}
+		Inventory.Palette.SetNum(PaletteNum);
+	}
+	for (FSoftObjectPath& ItemPath : Inventory.Palette)
+	{
+		Ar << ItemPath;
+	}
+
+	uint32 SlotNum = Inventory.SlotItems.Num();
+	Ar.SerializeIntPacked(SlotNum);
+	if (Ar.IsLoading())
+	{
+		// Every slot takes at least a byte, so a count larger than what is left cannot be real
+		if (Ar.IsError() || SlotNum > PackedInventoryFormat::MaxSlots || (Ar.TotalSize() >= 0 && SlotNum > Ar.TotalSize() - Ar.Tell()))
+		{
+			UE_LOG(LogTemp, Error, TEXT("FPackedInventory: Slot count %u is out of range"), SlotNum);
+			Ar.SetError();
+			return Ar;
+		}
+
+		Inventory.SlotItems.SetNumUninitialized(SlotNum);
+		Inventory.SlotCounts.SetNumUninitialized(SlotNum);
+	}
+
+	for (uint32 i = 0; i < SlotNum && !Ar.IsError(); ++i)
+	{
+		uint32 PaletteIndex = Inventory.SlotItems[i];
+		Ar.SerializeIntPacked(PaletteIndex);
+
+		uint32 Count = 0;
+		if (PaletteIndex != FPackedInventory::EmptySlot)
+		{
+			Count = static_cast<uint32>(FMath::Max(Inventory.SlotCounts[i], 0));
+			Ar.SerializeIntPacked(Count);
+		}
+
+		if (Ar.IsLoading())
+		{
+			const bool bValidIndex = PaletteIndex <= static_cast<uint32>(Inventory.Palette.Num());
+			Inventory.SlotItems[i] = bValidIndex ? static_cast<uint16>(PaletteIndex) : FPackedInventory::EmptySlot;
+			Inventory.SlotCounts[i] = bValidIndex ? static_cast<int32>(Count) : 0;
+		}
+	}
+
+	return Ar;
+}
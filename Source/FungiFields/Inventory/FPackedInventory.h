@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+
+struct FInventorySlot;
+
+/**
+ * Compact storage form of an inventory, used for save data and large containers.
+ * Each distinct item is stored once in a palette; slots hold a 16-bit palette index and a count.
+ * Archive form writes variable-length integers, so empty slots cost a single byte.
+ */
+struct FUNGIFIELDS_API FPackedInventory
+{
+	/** Palette index stored for empty slots */
+	static constexpr uint16 EmptySlot = 0;
+
+	/**
+	 * Pack a slot array, replacing any previous contents.
+	 * @param Slots The slots to pack
+	 */
+	void Pack(const TArray<FInventorySlot>& Slots);
+
+	/**
+	 * Unpack into a slot array sized to the packed slot count.
+	 * Items are never loaded here: catalogued items that are not resident leave their slot pending on their item ID,
+	 * and unknown items leave their slot empty.
+	 * @param OutSlots Receives the unpacked slots
+	 */
+	void Unpack(TArray<FInventorySlot>& OutSlots) const;
+
+	/** Number of slots, including empty ones */
+	int32 Num() const { return SlotItems.Num(); }
+
+	/** True if the slot holds no item */
+	bool IsSlotEmpty(int32 SlotIndex) const { return !SlotItems.IsValidIndex(SlotIndex) || SlotItems[SlotIndex] == EmptySlot; }
+
+	/** Path of the item in a slot, or an empty path for empty slots */
+	const FSoftObjectPath& GetSlotItemPath(int32 SlotIndex) const;
+
+	/** Count of the item in a slot, or 0 for empty slots */
+	int32 GetSlotCount(int32 SlotIndex) const { return IsSlotEmpty(SlotIndex) ? 0 : SlotCounts[SlotIndex]; }
+
+	/** Approximate in-memory size in bytes */
+	SIZE_T GetAllocatedSize() const;
+
+	friend FUNGIFIELDS_API FArchive& operator<<(FArchive& Ar, FPackedInventory& Inventory);
+
+private:
+	/** Distinct items referenced by the slots; palette index N is stored as N + 1 */
+	TArray<FSoftObjectPath> Palette;
+
+	/** Per-slot palette index + 1, or EmptySlot */
+	TArray<uint16> SlotItems;
+
+	/** Per-slot count, 0 for empty slots */
+	TArray<int32> SlotCounts;
+};
@@ -0,0 +1,322 @@
+#include "FFarmAllocationCounter.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTLS.h"
+
+#if !UE_BUILD_SHIPPING
+
+namespace FarmAllocationCounter
+{
+	/** Forwards every call to the allocator it replaced, counting allocations made on one thread */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		FMalloc* Inner = nullptr;
+		uint32 CountedThreadId = 0;
+		uint64 Count = 0;
+
+		virtual void* Malloc(SIZE_T Size, uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->Malloc(Size, Alignment);
+		}
+
+		virtual void* TryMalloc(SIZE_T Size, uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->TryMalloc(Size, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Size, uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->Realloc(Original, Size, Alignment);
+		}
+
+		virtual void* TryRealloc(void* Original, SIZE_T Size, uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->TryRealloc(Original, Size, Alignment);
+		}
+
+		virtual void Free(void* Original) override
+		{
+			Inner->Free(Original);
+		}
+
+		virtual SIZE_T QuantizeSize(SIZE_T Size, uint32 Alignment) override
+		{
+			return Inner->QuantizeSize(Size, Alignment);
+		}
+
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+		{
+			return Inner->GetAllocationSize(Original, SizeOut);
+		}
+
+		virtual void Trim(bool bTrimThreadCaches) override
+		{
+			Inner->Trim(bTrimThreadCaches);
+		}
+
+		virtual void SetupTLSCachesOnCurrentThread() override
+		{
+			Inner->SetupTLSCachesOnCurrentThread();
+		}
+
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+		{
+			Inner->ClearAndDisableTLSCachesOnCurrentThread();
+		}
+
+		virtual bool IsInternallyThreadSafe() const override
+		{
+			return Inner->IsInternallyThreadSafe();
+		}
+
+		virtual bool ValidateHeap() override
+		{
+			return Inner->ValidateHeap();
+		}
+
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override
+		{
+			Inner->GetAllocatorStats(OutStats);
+		}
+
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override
+		{
+			Inner->DumpAllocatorStats(Ar);
+		}
+
+		virtual const TCHAR* GetDescriptiveName() override
+		{
+			return Inner->GetDescriptiveName();
+		}
+
+	private:
+		void CountAllocation()
+		{
+			if (FPlatformTLS::GetCurrentThreadId() == CountedThreadId)
+			{
+				++Count;
+			}
+		}
+	};
+
+	// Never destroyed: other threads may still be inside it after GMalloc is restored
+	static FCountingMalloc CountingMalloc;
+
+	/** Number of live scopes */
+	static int32 ActiveScopes = 0;
+}
+
+FScopedFarmAllocationCounter::FScopedFarmAllocationCounter()
+{
+	using namespace FarmAllocationCounter;
+
+	if (ActiveScopes++ == 0)
+	{
+		CountingMalloc.Inner = GMalloc;
+		CountingMalloc.CountedThreadId = FPlatformTLS::GetCurrentThreadId();
+		CountingMalloc.Count = 0;
+		GMalloc = &CountingMalloc;
+	}
+
+	StartCount = CountingMalloc.Count;
+}
+
+FScopedFarmAllocationCounter::~FScopedFarmAllocationCounter()
+{
+	using namespace FarmAllocationCounter;
+
+	if (--ActiveScopes == 0)
+	{
+		GMalloc = CountingMalloc.Inner;
+	}
+}
+
+uint64 FScopedFarmAllocationCounter::GetCount() const
+{
+	return FarmAllocationCounter::CountingMalloc.Count - StartCount;
+}
+
+namespace FarmAllocationGuard
+{
+	static bool bEnabled = false;
+
+	/** Live guards and exemptions */
+	static int32 GuardDepth = 0;
+	static int32 ExemptDepth = 0;
+
+	/** Allocations counted by outermost guards */
+	static uint64 AllocationCount = 0;
+
+	/** Allocations made inside exemptions, subtracted by the enclosing guard */
+	static uint64 ExemptCount = 0;
+
+	/** Scope names already logged */
+	static TSet<const TCHAR*> ReportedScopes;
+
+	FAutoConsoleCommand FarmAllocGuardCommand(
+		TEXT("Farm.AllocGuard"),
+		TEXT("Count heap allocations in the steady-state farm scopes and log the first allocating call of each. Usage: Farm.AllocGuard [0|1]"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			FScopedFarmAllocationGuard::SetEnabled(Args.Num() > 0 ? FCString::ToBool(*Args[0]) : !bEnabled);
+			UE_LOG(LogTemp, Display, TEXT("Farm.AllocGuard: %s, %llu allocations counted so far"), bEnabled ? TEXT("enabled") : TEXT("disabled"), AllocationCount);
+		}));
+}
+
+FScopedFarmAllocationGuard::FScopedFarmAllocationGuard(const TCHAR* InScopeName)
+{
+	using namespace FarmAllocationGuard;
+
+	if (!bEnabled || !IsInGameThread())
+	{
+		return;
+	}
+
+	bActive = true;
+	if (GuardDepth++ == 0)
+	{
+		ScopeName = InScopeName;
+		StartExemptCount = ExemptCount;
+		Counter.Emplace();
+	}
+}
+
+FScopedFarmAllocationGuard::~FScopedFarmAllocationGuard()
+{
+	using namespace FarmAllocationGuard;
+
+	if (!bActive)
+	{
+		return;
+	}
+
+	--GuardDepth;
+	if (!Counter.IsSet())
+	{
+		return;
+	}
+
+	const uint64 Allocations = Counter->GetCount() - (ExemptCount - StartExemptCount);
+	Counter.Reset();
+
+	if (Allocations > 0)
+	{
+		AllocationCount += Allocations;
+
+		if (!ReportedScopes.Contains(ScopeName))
+		{
+			ReportedScopes.Add(ScopeName);
+			UE_LOG(LogTemp, Warning, TEXT("FScopedFarmAllocationGuard: %s allocated %llu times in steady state"), ScopeName, Allocations);
+		}
+	}
+}
+
+bool FScopedFarmAllocationGuard::IsEnabled()
+{
+	return FarmAllocationGuard::bEnabled;
+}
+
+void FScopedFarmAllocationGuard::SetEnabled(bool bInEnabled)
+{
+	FarmAllocationGuard::bEnabled = bInEnabled;
+}
+
+uint64 FScopedFarmAllocationGuard::GetAllocationCount()
+{
+	return FarmAllocationGuard::AllocationCount;
+}
+
+void FScopedFarmAllocationGuard::ResetAllocationCount()
+{
+	FarmAllocationGuard::AllocationCount = 0;
+	FarmAllocationGuard::ReportedScopes.Empty();
+}
+
+FScopedFarmAllocationGuardExemption::FScopedFarmAllocationGuardExemption()
+{
+	using namespace FarmAllocationGuard;
+
+	if (GuardDepth == 0 || !IsInGameThread())
+	{
+		return;
+	}
+
+	bActive = true;
+	if (ExemptDepth++ == 0)
+	{
+		Counter.Emplace();
+	}
+}
+
+FScopedFarmAllocationGuardExemption::~FScopedFarmAllocationGuardExemption()
+{
+	using namespace FarmAllocationGuard;
+
+	if (!bActive)
+	{
+		return;
+	}
+
+	--ExemptDepth;
+	if (Counter.IsSet())
+	{
+		ExemptCount += Counter->GetCount();
+		Counter.Reset();
+	}
+}
+
+#else
+
+FScopedFarmAllocationCounter::FScopedFarmAllocationCounter()
+{
+}
+
+FScopedFarmAllocationCounter::~FScopedFarmAllocationCounter()
+{
+}
+
+uint64 FScopedFarmAllocationCounter::GetCount() const
+{
+	return 0;
+}
+
+FScopedFarmAllocationGuard::FScopedFarmAllocationGuard(const TCHAR* InScopeName)
+{
+}
+
+FScopedFarmAllocationGuard::~FScopedFarmAllocationGuard()
+{
+}
+
+bool FScopedFarmAllocationGuard::IsEnabled()
+{
+	return false;
+}
+
+void FScopedFarmAllocationGuard::SetEnabled(bool bInEnabled)
+{
+}
+
+uint64 FScopedFarmAllocationGuard::GetAllocationCount()
+{
+	return 0;
+}
+
+void FScopedFarmAllocationGuard::ResetAllocationCount()
+{
+}
+
+FScopedFarmAllocationGuardExemption::FScopedFarmAllocationGuardExemption()
+{
+}
+
+FScopedFarmAllocationGuardExemption::~FScopedFarmAllocationGuardExemption()
+{
+}
+
+#endif
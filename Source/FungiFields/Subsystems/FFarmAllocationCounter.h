@@ -0,0 +1,88 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/Optional.h"
+
+/**
+ * Counts heap allocations made on the calling thread while in scope, for benchmarks and allocation checks.
+ * Installs a forwarding allocator in front of GMalloc for the lifetime of the outermost scope; allocations
+ * on other threads pass through uncounted. Reallocations count as allocations.
+ * Not available in shipping builds, where GetCount always returns 0.
+ */
+class FUNGIFIELDS_API FScopedFarmAllocationCounter
+{
+public:
+	FScopedFarmAllocationCounter();
+	~FScopedFarmAllocationCounter();
+
+	/**
+	 * Get the number of allocations made on this thread since the scope began.
+	 * @return Allocation count
+	 */
+	uint64 GetCount() const;
+
+private:
+	/** Allocations already counted when the scope began */
+	uint64 StartCount = 0;
+};
+
+/**
+ * Checks that a steady-state scope does not allocate. While guards are enabled (Farm.AllocGuard 1, or by a
+ * benchmark), counts heap allocations made on the game thread inside the scope, adds them to
+ * GetAllocationCount and logs the first allocating call of each scope name. Work inside a
+ * FScopedFarmAllocationGuardExemption, such as render state updates, is not counted.
+ * Guards nest; only the outermost one counts. Not available in shipping builds.
+ */
+class FUNGIFIELDS_API FScopedFarmAllocationGuard
+{
+public:
+	explicit FScopedFarmAllocationGuard(const TCHAR* InScopeName);
+	~FScopedFarmAllocationGuard();
+
+	/** Whether guards count allocations */
+	static bool IsEnabled();
+
+	/** Turn allocation counting on or off */
+	static void SetEnabled(bool bInEnabled);
+
+	/**
+	 * Get the allocations counted by guards since the last reset.
+	 * @return Allocation count
+	 */
+	static uint64 GetAllocationCount();
+
+	/** Clear the allocation count and the list of reported scopes */
+	static void ResetAllocationCount();
+
+private:
+	friend class FScopedFarmAllocationGuardExemption;
+
+	TOptional<FScopedFarmAllocationCounter> Counter;
+	const TCHAR* ScopeName = nullptr;
+
+	/** Whether the guard was entered while enabled */
+	bool bActive = false;
+
+	/** Exempted allocations already recorded when the guard began */
+	uint64 StartExemptCount = 0;
+};
+
+/** Excludes its scope from the enclosing FScopedFarmAllocationGuard */
+class FUNGIFIELDS_API FScopedFarmAllocationGuardExemption
+{
+public:
+	FScopedFarmAllocationGuardExemption();
+	~FScopedFarmAllocationGuardExemption();
+
+private:
+	TOptional<FScopedFarmAllocationCounter> Counter;
+	bool bActive = false;
+};
+
+#if !UE_BUILD_SHIPPING
+#define FARM_ALLOCATION_GUARD(ScopeName) FScopedFarmAllocationGuard ANONYMOUS_VARIABLE(FarmAllocationGuard)(TEXT(ScopeName))
+#define FARM_ALLOCATION_GUARD_EXEMPT() FScopedFarmAllocationGuardExemption ANONYMOUS_VARIABLE(FarmAllocationGuardExemption)
+#else
+#define FARM_ALLOCATION_GUARD(ScopeName)
+#define FARM_ALLOCATION_GUARD_EXEMPT()
+#endif
@@ -0,0 +1,40 @@
+#include "FFarmAssetLoading.h"
+#include "FFarmHitchLog.h"
+#include "Engine/AssetManager.h"
+#include "HAL/IConsoleManager.h"
+
+namespace FarmAssetLoading
+{
+	static bool bAssertOnSyncLoad = false;
+
+	FAutoConsoleVariableRef AssertOnSyncLoadVariable(
+		TEXT("Farm.AssertOnSyncLoad"),
+		bAssertOnSyncLoad,
+		TEXT("Assert when gameplay code has to load an asset synchronously because it was not prefetched"));
+}
+
+TSharedPtr<FStreamableHandle> FFarmAssetLoading::Prefetch(TArray<FSoftObjectPath> Paths, FStreamableDelegate OnLoaded)
+{
+	Paths.RemoveAll([](const FSoftObjectPath& Path)
+	{
+		return Path.IsNull();
+	});
+
+	if (Paths.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	return UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(Paths), MoveTemp(OnLoaded), FStreamableManager::DefaultAsyncLoadPriority);
+}
+
+UObject* FFarmAssetLoading::LoadSynchronous(const FSoftObjectPath& Path, const UObject* Context)
+{
+	ensureMsgf(!FarmAssetLoading::bAssertOnSyncLoad, TEXT("FFarmAssetLoading: %s loaded %s synchronously; prefetch it when the owner is set up"),
+		*GetNameSafe(Context), *Path.ToString());
+
+	UE_LOG(LogTemp, Warning, TEXT("FFarmAssetLoading::LoadSynchronous: %s loaded %s synchronously"), *GetNameSafe(Context), *Path.ToString());
+
+	FARM_HITCH_SCOPE(SyncLoad, Context);
+	return Path.TryLoad();
+}
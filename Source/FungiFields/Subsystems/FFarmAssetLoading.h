@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+#include "UObject/SoftObjectPtr.h"
+
+/**
+ * Asset loading for gameplay code. Soft references a system will need are prefetched asynchronously when it
+ * is set up, for example when a quest is added or a crop is planted, and kept loaded by the returned handle;
+ * hot paths then resolve them with Resolve, which does not load. A reference that is still not loaded falls
+ * back to a synchronous load, which is recorded as a hitch and, with Farm.AssertOnSyncLoad 1, asserts.
+ * Game thread only.
+ */
+struct FUNGIFIELDS_API FFarmAssetLoading
+{
+	/**
+	 * Start loading assets in the background.
+	 * @param Paths Assets to load; null paths are skipped
+	 * @param OnLoaded Called when the assets have loaded
+	 * @return Handle that keeps the assets loaded, or nullptr if there was nothing to load
+	 */
+	static TSharedPtr<FStreamableHandle> Prefetch(TArray<FSoftObjectPath> Paths, FStreamableDelegate OnLoaded = FStreamableDelegate());
+
+	/**
+	 * Get the object a soft reference points to, loading it synchronously only if it was not prefetched.
+	 * @param Reference The soft reference
+	 * @param Context Object making the request, reported with any synchronous load
+	 * @return The object, or nullptr if the reference is null or fails to load
+	 */
+	template<typename T>
+	static T* Resolve(const TSoftObjectPtr<T>& Reference, const UObject* Context)
+	{
+		if (T* Loaded = Reference.Get())
+		{
+			return Loaded;
+		}
+
+		if (Reference.IsNull())
+		{
+			return nullptr;
+		}
+
+		return Cast<T>(LoadSynchronous(Reference.ToSoftObjectPath(), Context));
+	}
+
+private:
+	/**
+	 * Load an asset that was needed before it was prefetched.
+	 * @param Path The asset
+	 * @param Context Object making the request
+	 * @return The loaded object, or nullptr if it failed to load
+	 */
+	static UObject* LoadSynchronous(const FSoftObjectPath& Path, const UObject* Context);
+};
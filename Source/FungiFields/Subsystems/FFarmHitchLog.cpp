@@ -0,0 +1,67 @@
+#include "FFarmHitchLog.h"
+
+bool FFarmHitchLog::bEnabled = false;
+FFarmHitchOpRecord FFarmHitchLog::Records[FFarmHitchLog::Capacity];
+int32 FFarmHitchLog::NextIndex = 0;
+int32 FFarmHitchLog::Num = 0;
+
+void FFarmHitchLog::Add(const FFarmHitchOpRecord& Record)
+{
+	Records[NextIndex] = Record;
+	NextIndex = (NextIndex + 1) % Capacity;
+	Num = FMath::Min(Num + 1, Capacity);
+}
+
+void FFarmHitchLog::GetSince(double SinceSeconds, TArray<FFarmHitchOpRecord>& OutRecords)
+{
+	OutRecords.Reset();
+
+	const int32 OldestIndex = (NextIndex - Num + Capacity) % Capacity;
+	for (int32 Offset = 0; Offset < Num; ++Offset)
+	{
+		const FFarmHitchOpRecord& Record = Records[(OldestIndex + Offset) % Capacity];
+		if (Record.StartSeconds >= SinceSeconds)
+		{
+			OutRecords.Add(Record);
+		}
+	}
+}
+
+const TCHAR* FFarmHitchLog::GetOpName(EFarmHitchOp Op)
+{
+	switch (Op)
+	{
+	case EFarmHitchOp::Harvest:
+		return TEXT("Harvest");
+	case EFarmHitchOp::Spawn:
+		return TEXT("Spawn");
+	case EFarmHitchOp::SyncLoad:
+		return TEXT("SyncLoad");
+	case EFarmHitchOp::WidgetRebuild:
+		return TEXT("WidgetRebuild");
+	case EFarmHitchOp::RegistryScan:
+		return TEXT("RegistryScan");
+	case EFarmHitchOp::MemoryMeasure:
+		return TEXT("MemoryMeasure");
+	default:
+		return TEXT("Unknown");
+	}
+}
+
+FScopedFarmHitchOp::~FScopedFarmHitchOp()
+{
+	if (StartCycles == 0 || !FFarmHitchLog::bEnabled)
+	{
+		return;
+	}
+
+	const uint64 EndCycles = FPlatformTime::Cycles64();
+
+	FFarmHitchOpRecord Record;
+	Record.Op = Op;
+	Record.Context = Context ? Context->GetFName() : NAME_None;
+	Record.Frame = GFrameCounter;
+	Record.StartSeconds = FPlatformTime::Seconds() - FPlatformTime::ToSeconds64(EndCycles - StartCycles);
+	Record.DurationMs = static_cast<float>(FPlatformTime::ToMilliseconds64(EndCycles - StartCycles));
+	FFarmHitchLog::Add(Record);
+}
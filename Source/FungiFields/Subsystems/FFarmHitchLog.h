@@ -0,0 +1,104 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+
+/** Kinds of farm operation recorded for hitch attribution */
+enum class EFarmHitchOp : uint8
+{
+	Harvest,
+	Spawn,
+	SyncLoad,
+	WidgetRebuild,
+	RegistryScan,
+	MemoryMeasure
+};
+
+/** One recorded farm operation */
+struct FFarmHitchOpRecord
+{
+	EFarmHitchOp Op = EFarmHitchOp::Harvest;
+
+	/** Object the operation ran on or produced */
+	FName Context;
+
+	/** Frame the operation started in */
+	uint64 Frame = 0;
+
+	/** Start time in seconds, from FPlatformTime::Seconds */
+	double StartSeconds = 0.0;
+
+	float DurationMs = 0.0f;
+};
+
+/**
+ * Ring buffer of recent farm operations that are likely to cause hitches: harvests, spawns, synchronous
+ * loads, widget rebuilds, registry scans and memory measurements. UFarmHitchMonitorSubsystem dumps it when a frame runs long.
+ * Recording is off until the monitor enables it, and costs a name lookup and two clock reads per operation.
+ * Game thread only. Not available in shipping builds.
+ */
+struct FUNGIFIELDS_API FFarmHitchLog
+{
+	/** Number of operations kept; older ones are overwritten */
+	static constexpr int32 Capacity = 256;
+
+	/** Whether operations are being recorded */
+	static bool bEnabled;
+
+	/**
+	 * Add an operation to the buffer.
+	 * @param Record The operation
+	 */
+	static void Add(const FFarmHitchOpRecord& Record);
+
+	/**
+	 * Copy the recorded operations that started at or after a time, oldest first.
+	 * @param SinceSeconds Earliest start time to include
+	 * @param OutRecords Filled with the operations
+	 */
+	static void GetSince(double SinceSeconds, TArray<FFarmHitchOpRecord>& OutRecords);
+
+	/**
+	 * Get a display name for an operation kind.
+	 * @param Op The operation kind
+	 * @return Name for logs and CSV files
+	 */
+	static const TCHAR* GetOpName(EFarmHitchOp Op);
+
+private:
+	static FFarmHitchOpRecord Records[Capacity];
+
+	/** Index the next record is written to */
+	static int32 NextIndex;
+
+	/** Number of valid records, up to Capacity */
+	static int32 Num;
+};
+
+/** Records the time spent in its scope as a farm operation while the hitch log is enabled */
+class FUNGIFIELDS_API FScopedFarmHitchOp
+{
+public:
+	FScopedFarmHitchOp(EFarmHitchOp InOp, const UObject* InContext)
+		: Context(InContext)
+		, StartCycles(FFarmHitchLog::bEnabled ? FPlatformTime::Cycles64() : 0)
+		, Op(InOp)
+	{
+	}
+
+	~FScopedFarmHitchOp();
+
+private:
+	const UObject* Context;
+
+	/** Zero when the log was disabled at the start of the scope */
+	uint64 StartCycles;
+
+	EFarmHitchOp Op;
+};
+
+#if !UE_BUILD_SHIPPING
+#define FARM_HITCH_SCOPE(Op, Context) FScopedFarmHitchOp ANONYMOUS_VARIABLE(FarmHitchOp)(EFarmHitchOp::Op, Context)
+#else
+#define FARM_HITCH_SCOPE(Op, Context)
+#endif
@@ -0,0 +1,31 @@
+#include "FFarmSimTimings.h"
+
+int32 FFarmSimTimings::EnableCount = 0;
+
+uint64 FFarmSimTimings::* FScopedFarmSimTiming::ActiveCycles[FScopedFarmSimTiming::MaxActive] = {};
+int32 FScopedFarmSimTiming::NumActive = 0;
+
+FFarmSimTimings& FFarmSimTimings::Get()
+{
+	static FFarmSimTimings Timings;
+	return Timings;
+}
+
+bool FScopedFarmSimTiming::Push(uint64 FFarmSimTimings::* InCycles)
+{
+	if (NumActive >= MaxActive)
+	{
+		return false;
+	}
+
+	for (int32 Index = 0; Index < NumActive; ++Index)
+	{
+		if (ActiveCycles[Index] == InCycles)
+		{
+			return false;
+		}
+	}
+
+	ActiveCycles[NumActive++] = InCycles;
+	return true;
+}
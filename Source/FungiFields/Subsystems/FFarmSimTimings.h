@@ -0,0 +1,123 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+
+/**
+ * Time spent in each part of the farm simulation, collected only while a benchmark, the hitch monitor or
+ * the perf overlay holds an enable reference. Game thread only. Scopes of different parts nest: growth and evaporation time include
+ * the events they fire, and event time includes the visual updates those events trigger. A part that
+ * re-enters itself is only timed once.
+ */
+struct FUNGIFIELDS_API FFarmSimTimings
+{
+	uint64 GrowthCycles = 0;
+	uint64 EvaporationCycles = 0;
+	uint64 EventCycles = 0;
+	uint64 VisualCycles = 0;
+
+	/** Farmable, interactable and placement traces */
+	uint64 TraceCycles = 0;
+
+	/** Inventory mutations, including the events and widget refreshes they trigger */
+	uint64 InventoryCycles = 0;
+
+	/** HUD and menu widget refreshes */
+	uint64 WidgetCycles = 0;
+
+	/** Number of farm delegate broadcasts */
+	uint64 EventCount = 0;
+
+	/** Number of plot and crop visual updates */
+	uint64 VisualCount = 0;
+
+	/** Number of crop growth updates */
+	uint64 CropUpdateCount = 0;
+
+	/** Number of soil evaporation updates */
+	uint64 EvaporationCount = 0;
+
+	/** Number of line traces and overlap queries */
+	uint64 TraceCount = 0;
+
+	/** Number of inventory mutations */
+	uint64 InventoryOpCount = 0;
+
+	/** Number of farm actors spawned */
+	uint64 ActorSpawnCount = 0;
+
+	/** Number of actors and widgets taken from a pool instead of being created */
+	uint64 PoolReuseCount = 0;
+
+	/** Whether timings are being collected; true while anything holds an enable reference */
+	static bool IsEnabled() { return EnableCount > 0; }
+
+	/** Start collecting timings until the matching ReleaseEnableRef */
+	static void AddEnableRef() { ++EnableCount; }
+
+	/** Release a reference taken with AddEnableRef; collection stops once none are left */
+	static void ReleaseEnableRef()
+	{
+		if (ensure(EnableCount > 0))
+		{
+			--EnableCount;
+		}
+	}
+
+	/** Get the timings collected so far */
+	static FFarmSimTimings& Get();
+
+	/** Clear the collected timings */
+	static void Reset() { Get() = FFarmSimTimings(); }
+
+	/** Increment a counter while collection is enabled */
+	static void Count(uint64 FFarmSimTimings::* Counter)
+	{
+		if (IsEnabled())
+		{
+			++(Get().*Counter);
+		}
+	}
+
+private:
+	/** Number of benchmarks, monitors and overlays collecting timings */
+	static int32 EnableCount;
+};
+
+/** Adds the time spent in its scope to one of the FFarmSimTimings counters while collection is enabled */
+class FUNGIFIELDS_API FScopedFarmSimTiming
+{
+public:
+	FScopedFarmSimTiming(uint64 FFarmSimTimings::* InCycles, uint64 FFarmSimTimings::* InCount = nullptr)
+		: Cycles(FFarmSimTimings::IsEnabled() && Push(InCycles) ? InCycles : nullptr)
+		, StartCycles(Cycles ? FPlatformTime::Cycles64() : 0)
+	{
+		if (InCount)
+		{
+			FFarmSimTimings::Count(InCount);
+		}
+	}
+
+	~FScopedFarmSimTiming()
+	{
+		if (Cycles)
+		{
+			FFarmSimTimings::Get().*Cycles += FPlatformTime::Cycles64() - StartCycles;
+			--NumActive;
+		}
+	}
+
+private:
+	/**
+	 * Mark a part as being timed.
+	 * @return False if the part is already being timed further up the stack
+	 */
+	static bool Push(uint64 FFarmSimTimings::* InCycles);
+
+	uint64 FFarmSimTimings::* Cycles;
+	uint64 StartCycles;
+
+	static constexpr int32 MaxActive = 16;
+	static uint64 FFarmSimTimings::* ActiveCycles[MaxActive];
+	static int32 NumActive;
+};
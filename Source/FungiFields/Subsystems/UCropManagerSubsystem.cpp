@@ -1,5 +1,11 @@
 #include "UCropManagerSubsystem.h"
+#include "../FungiFieldsStats.h"
+#include "FFarmAllocationCounter.h"
+#include "FFarmAssetLoading.h"
+#include "FFarmSimTimings.h"
+#include "UFarmSimulationSubsystem.h"
 #include "../Components/UCropGrowthComponent.h"
+#include "../Data/UCropDataAsset.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
 
@@ -30,10 +36,21 @@ void UCropManagerSubsystem::Deinitialize()
 	}
 
 	RegisteredCrops.Empty();
+	CropAssetHandles.Empty();
 
 	Super::Deinitialize();
 }
 
+void UCropManagerSubsystem::PrefetchCropAssets(const UCropDataAsset* CropData)
+{
+	if (!CropData || CropAssetHandles.Contains(CropData))
+	{
+		return;
+	}
+
+	CropAssetHandles.Add(CropData, FFarmAssetLoading::Prefetch({ CropData->HarvestItem.ToSoftObjectPath() }));
+}
+
 void UCropManagerSubsystem::RegisterCrop(UCropGrowthComponent* GrowthComponent)
 {
 	if (!GrowthComponent)
@@ -42,7 +59,9 @@ void UCropManagerSubsystem::RegisterCrop(UCropGrowthComponent* GrowthComponent)
 		return;
 	}
 
+	LLM_SCOPE_BYTAG(Farm_CropManager);
 	RegisteredCrops.Add(GrowthComponent);
+	SET_DWORD_STAT(STAT_FarmRegisteredCrops, RegisteredCrops.Num());
 }
 
 void UCropManagerSubsystem::UnregisterCrop(UCropGrowthComponent* GrowthComponent)
@@ -53,6 +72,7 @@ void UCropManagerSubsystem::UnregisterCrop(UCropGrowthComponent* GrowthComponent
 	}
 
 	RegisteredCrops.Remove(GrowthComponent);
+	SET_DWORD_STAT(STAT_FarmRegisteredCrops, RegisteredCrops.Num());
 }
 
 void UCropManagerSubsystem::PauseAllGrowth()
@@ -66,25 +86,47 @@ void UCropManagerSubsystem::ResumeAllGrowth()
 }
 
 void UCropManagerSubsystem::OnGrowthUpdateTimer()
+{
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmGrowthTimer, "UCropManagerSubsystem::OnGrowthUpdateTimer");
+
+	// Deterministic mode steps growth together with evaporation instead
+	if (UFarmSimulationSubsystem::IsDeterministicWorld(this))
+	{
+		return;
+	}
+
+	StepGrowth(GrowthUpdateInterval);
+}
+
+void UCropManagerSubsystem::StepGrowth(float DeltaTime)
 {
 	if (bGrowthPaused)
 	{
 		return;
 	}
 
-	TArray<TObjectPtr<UCropGrowthComponent>> CropsToUpdate(RegisteredCrops.Array());
+	FScopedFarmSimTiming GrowthTiming(&FFarmSimTimings::GrowthCycles);
+	FARM_ALLOCATION_GUARD("UCropManagerSubsystem::StepGrowth");
+
+	CropsToUpdate.Reset();
+	for (UCropGrowthComponent* GrowthComponent : RegisteredCrops)
+	{
+		CropsToUpdate.Add(GrowthComponent);
+	}
 
 	for (UCropGrowthComponent* GrowthComponent : CropsToUpdate)
 	{
 		if (IsValid(GrowthComponent))
 		{
-			GrowthComponent->UpdateGrowth(GrowthUpdateInterval);
+			GrowthComponent->UpdateGrowth(DeltaTime);
 		}
 		else
 		{
 			RegisteredCrops.Remove(GrowthComponent);
 		}
 	}
+
+	SET_DWORD_STAT(STAT_FarmRegisteredCrops, RegisteredCrops.Num());
 }
 
 
@@ -2,9 +2,12 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
 #include "UCropManagerSubsystem.generated.h"
 
+class UCropDataAsset;
 class UCropGrowthComponent;
+struct FStreamableHandle;
 
 /**
  * Centralized manager for all crop growth in the world.
@@ -54,6 +57,26 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Crop Manager")
 	int32 GetRegisteredCropCount() const { return RegisteredCrops.Num(); }
 
+	/**
+	 * Get the memory used by the manager's containers.
+	 * @return Bytes allocated
+	 */
+	SIZE_T GetAllocatedSize() const { return RegisteredCrops.GetAllocatedSize() + CropAssetHandles.GetAllocatedSize(); }
+
+	/**
+	 * Advance every registered crop by a fixed amount of time, unless growth is paused.
+	 * Called by the growth timer, or by UFarmSimulationSubsystem in deterministic mode.
+	 * @param DeltaTime Simulated seconds to advance
+	 */
+	void StepGrowth(float DeltaTime);
+
+	/**
+	 * Start loading the assets a crop type needs at harvest in the background, so harvesting never loads.
+	 * Each crop type is requested once; its assets stay loaded for the lifetime of the world.
+	 * @param CropData The crop type being planted
+	 */
+	void PrefetchCropAssets(const UCropDataAsset* CropData);
+
 protected:
 	/**
 	 * Timer callback that updates all registered crops.
@@ -66,6 +89,12 @@ private:
 	UPROPERTY()
 	TSet<TObjectPtr<UCropGrowthComponent>> RegisteredCrops;
 
+	/** Crops being updated by StepGrowth, which may register or unregister crops. Kept between steps so they do not allocate */
+	TArray<UCropGrowthComponent*> CropsToUpdate;
+
+	/** Handles keeping each planted crop type's harvest assets loaded */
+	TMap<TObjectKey<UCropDataAsset>, TSharedPtr<FStreamableHandle>> CropAssetHandles;
+
 	/** Timer handle for the global growth update */
 	FTimerHandle GrowthUpdateTimerHandle;
 
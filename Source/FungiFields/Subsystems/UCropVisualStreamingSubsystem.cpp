@@ -0,0 +1,179 @@
+#include "UCropVisualStreamingSubsystem.h"
+#include "FFarmAssetLoading.h"
+#include "../Actors/ACropBase.h"
+#include "../Data/UCropDataAsset.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+	FAutoConsoleCommandWithWorldAndArgs FarmCropVisualsCommand(
+		TEXT("Farm.CropVisuals"),
+		TEXT("Log the crop stage meshes that are held and loaded"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (const UCropVisualStreamingSubsystem* CropVisuals = UCropVisualStreamingSubsystem::Get(World))
+			{
+				CropVisuals->LogResidentVisuals();
+			}
+		}));
+}
+
+void UCropVisualStreamingSubsystem::Deinitialize()
+{
+	for (TPair<TObjectKey<UCropDataAsset>, FCropTypeVisuals>& CropType : CropTypes)
+	{
+		for (FStageVisual& Visual : CropType.Value.Stages)
+		{
+			if (Visual.Handle.IsValid())
+			{
+				Visual.Handle->ReleaseHandle();
+			}
+		}
+	}
+
+	CropTypes.Empty();
+
+	Super::Deinitialize();
+}
+
+UCropVisualStreamingSubsystem* UCropVisualStreamingSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject)
+	{
+		return nullptr;
+	}
+
+	const UWorld* World = WorldContextObject->GetWorld();
+	return World ? World->GetSubsystem<UCropVisualStreamingSubsystem>() : nullptr;
+}
+
+const TSoftObjectPtr<UStaticMesh>* UCropVisualStreamingSubsystem::FindStageMeshReference(const UCropDataAsset* CropData, int32 Stage)
+{
+	if (!CropData)
+	{
+		return nullptr;
+	}
+
+	if (Stage == FCropGrowthRules::WitheredStage)
+	{
+		return &CropData->WitheredMesh;
+	}
+
+	return CropData->GrowthMeshes.IsValidIndex(Stage) ? &CropData->GrowthMeshes[Stage] : nullptr;
+}
+
+UStaticMesh* UCropVisualStreamingSubsystem::GetStageMesh(const UCropDataAsset* CropData, int32 Stage)
+{
+	const TSoftObjectPtr<UStaticMesh>* MeshReference = FindStageMeshReference(CropData, Stage);
+	return MeshReference ? MeshReference->Get() : nullptr;
+}
+
+void UCropVisualStreamingSubsystem::AcquireStage(const UCropDataAsset* CropData, int32 Stage, ACropBase* WaitingCrop)
+{
+	if (!CropData || Stage < 0 || Stage >= NumStages)
+	{
+		return;
+	}
+
+	FCropTypeVisuals& Visuals = CropTypes.FindOrAdd(CropData);
+	FStageVisual& Visual = Visuals.Stages[Stage];
+	++Visuals.Holders;
+
+	const TSoftObjectPtr<UStaticMesh>* MeshReference = FindStageMeshReference(CropData, Stage);
+	if (!MeshReference || MeshReference->IsNull())
+	{
+		++Visual.Holders;
+		return;
+	}
+
+	if (Visual.Holders++ == 0)
+	{
+		TWeakObjectPtr<UCropVisualStreamingSubsystem> WeakThis(this);
+		const TObjectKey<UCropDataAsset> CropKey(CropData);
+
+		Visual.Handle = FFarmAssetLoading::Prefetch({ MeshReference->ToSoftObjectPath() }, FStreamableDelegate::CreateLambda([WeakThis, CropKey, Stage]()
+		{
+			if (UCropVisualStreamingSubsystem* CropVisuals = WeakThis.Get())
+			{
+				CropVisuals->OnStageLoaded(CropKey, Stage);
+			}
+		}));
+	}
+
+	if (WaitingCrop && !MeshReference->Get())
+	{
+		Visual.WaitingCrops.Add(WaitingCrop);
+	}
+}
+
+void UCropVisualStreamingSubsystem::ReleaseStage(const UCropDataAsset* CropData, int32 Stage)
+{
+	FCropTypeVisuals* Visuals = CropTypes.Find(CropData);
+	if (!Visuals || Stage < 0 || Stage >= NumStages || Visuals->Stages[Stage].Holders <= 0)
+	{
+		return;
+	}
+
+	FStageVisual& Visual = Visuals->Stages[Stage];
+	if (--Visual.Holders == 0)
+	{
+		if (Visual.Handle.IsValid())
+		{
+			Visual.Handle->ReleaseHandle();
+			Visual.Handle.Reset();
+		}
+		Visual.WaitingCrops.Reset();
+	}
+
+	if (--Visuals->Holders == 0)
+	{
+		CropTypes.Remove(CropData);
+	}
+}
+
+void UCropVisualStreamingSubsystem::OnStageLoaded(TObjectKey<UCropDataAsset> CropData, int32 Stage)
+{
+	FCropTypeVisuals* Visuals = CropTypes.Find(CropData);
+	if (!Visuals)
+	{
+		return;
+	}
+
+	// Crops may change stage while being updated, so work from a copy of the list
+	const TArray<TWeakObjectPtr<ACropBase>> WaitingCrops = MoveTemp(Visuals->Stages[Stage].WaitingCrops);
+	Visuals->Stages[Stage].WaitingCrops.Reset();
+
+	for (const TWeakObjectPtr<ACropBase>& WeakCrop : WaitingCrops)
+	{
+		if (ACropBase* Crop = WeakCrop.Get())
+		{
+			Crop->OnStageMeshLoaded(Stage);
+		}
+	}
+}
+
+void UCropVisualStreamingSubsystem::LogResidentVisuals() const
+{
+	UE_LOG(LogTemp, Display, TEXT("UCropVisualStreamingSubsystem::LogResidentVisuals: %d crop types held"), CropTypes.Num());
+
+	for (const TPair<TObjectKey<UCropDataAsset>, FCropTypeVisuals>& CropType : CropTypes)
+	{
+		const UCropDataAsset* CropData = CropType.Key.ResolveObjectPtr();
+
+		FString Stages;
+		for (int32 Stage = 0; Stage < NumStages; ++Stage)
+		{
+			const FStageVisual& Visual = CropType.Value.Stages[Stage];
+			if (Visual.Holders > 0)
+			{
+				Stages += FString::Printf(TEXT(" %s=%d%s"),
+					Stage == FCropGrowthRules::WitheredStage ? TEXT("withered") : *FString::FromInt(Stage),
+					Visual.Holders, GetStageMesh(CropData, Stage) ? TEXT("") : TEXT(" (loading)"));
+			}
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("    %s:%s"), *GetNameSafe(CropData), *Stages);
+	}
+}
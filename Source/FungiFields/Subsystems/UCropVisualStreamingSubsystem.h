@@ -0,0 +1,105 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/SoftObjectPtr.h"
+#include "FCropGrowthRules.h"
+#include "UCropVisualStreamingSubsystem.generated.h"
+
+class ACropBase;
+class UCropDataAsset;
+class UStaticMesh;
+struct FStreamableHandle;
+
+/**
+ * Streams crop stage meshes so that only the meshes of planted crops are resident. Crops hold a stage of
+ * their crop type while they show it, and one more while they are about to reach it; a stage mesh is loaded
+ * asynchronously when its first holder arrives and released when its last one leaves, so a crop type that is
+ * no longer planted has none of its meshes loaded. Crops waiting on a load are given their mesh when it
+ * completes. Farm.CropVisuals logs what is resident.
+ */
+UCLASS()
+class FUNGIFIELDS_API UCropVisualStreamingSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem interface
+	virtual void Deinitialize() override;
+
+	/**
+	 * Get the crop visual streaming subsystem for the world of the given object.
+	 * @param WorldContextObject Any object with a valid world
+	 * @return The subsystem, or nullptr if there is no world
+	 */
+	static UCropVisualStreamingSubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	 * Get a visual stage's mesh if it is loaded.
+	 * @param CropData The crop type
+	 * @param Stage A growth stage, or FCropGrowthRules::WitheredStage
+	 * @return The mesh, or nullptr if the stage has none or it has not loaded yet
+	 */
+	static UStaticMesh* GetStageMesh(const UCropDataAsset* CropData, int32 Stage);
+
+	/**
+	 * Hold a visual stage of a crop type, loading its mesh if this is the first holder.
+	 * @param CropData The crop type
+	 * @param Stage A growth stage, or FCropGrowthRules::WitheredStage
+	 * @param WaitingCrop Crop to give the mesh to when it finishes loading, or nullptr for a prefetch
+	 */
+	void AcquireStage(const UCropDataAsset* CropData, int32 Stage, ACropBase* WaitingCrop = nullptr);
+
+	/**
+	 * Release a visual stage held with AcquireStage, unloading its mesh if this was the last holder.
+	 * @param CropData The crop type
+	 * @param Stage The stage that was acquired
+	 */
+	void ReleaseStage(const UCropDataAsset* CropData, int32 Stage);
+
+	/** Log the crop types and stages that are held and loaded */
+	void LogResidentVisuals() const;
+
+private:
+	static constexpr int32 NumStages = FCropGrowthRules::NumGrowthStages + 1;
+
+	/** One visual stage of a crop type */
+	struct FStageVisual
+	{
+		/** Crops showing or about to show the stage */
+		int32 Holders = 0;
+
+		/** Keeps the mesh loaded while the stage is held */
+		TSharedPtr<FStreamableHandle> Handle;
+
+		/** Crops to update when the mesh finishes loading */
+		TArray<TWeakObjectPtr<ACropBase>> WaitingCrops;
+	};
+
+	/** Visual stages of one crop type */
+	struct FCropTypeVisuals
+	{
+		FStageVisual Stages[NumStages];
+
+		/** Total holders across stages; the entry is removed at zero */
+		int32 Holders = 0;
+	};
+
+	/**
+	 * Get the soft reference to a visual stage's mesh.
+	 * @param CropData The crop type
+	 * @param Stage A growth stage, or FCropGrowthRules::WitheredStage
+	 * @return The mesh reference, or nullptr if the crop type has no mesh slot for the stage
+	 */
+	static const TSoftObjectPtr<UStaticMesh>* FindStageMeshReference(const UCropDataAsset* CropData, int32 Stage);
+
+	/**
+	 * Hand a loaded stage mesh to the crops waiting on it.
+	 * @param CropData The crop type
+	 * @param Stage The stage that finished loading
+	 */
+	void OnStageLoaded(TObjectKey<UCropDataAsset> CropData, int32 Stage);
+
+	TMap<TObjectKey<UCropDataAsset>, FCropTypeVisuals> CropTypes;
+};
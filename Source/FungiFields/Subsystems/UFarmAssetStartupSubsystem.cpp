@@ -0,0 +1,151 @@
+#include "UFarmAssetStartupSubsystem.h"
+#include "../Data/FFarmPrimaryAssets.h"
+#include "../Data/UItemDataAsset.h"
+#include "Engine/AssetManager.h"
+#include "Engine/GameInstance.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	FAutoConsoleCommandWithWorldAndArgs FarmStartupTimingsCommand(
+		TEXT("Farm.StartupTimings"),
+		TEXT("Log how long the farm primary asset bundles took to load at startup"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (const UFarmAssetStartupSubsystem* AssetStartup = UFarmAssetStartupSubsystem::Get(World))
+			{
+				AssetStartup->LogTimings();
+			}
+		}));
+}
+
+bool UFarmAssetStartupSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return !IsRunningCommandlet() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UFarmAssetStartupSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	StartSeconds = FPlatformTime::Seconds();
+
+	if (!UAssetManager::IsInitialized())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UFarmAssetStartupSubsystem::Initialize: Asset Manager is not initialized, farm assets load on demand"));
+		bGameplayReady = true;
+		return;
+	}
+
+	UAssetManager& AssetManager = UAssetManager::Get();
+	for (const FPrimaryAssetType& AssetType : FFarmPrimaryAssets::GetTypes())
+	{
+		AssetManager.GetPrimaryAssetIdList(AssetType, StartupAssetIds);
+	}
+
+	WorldInitializedActorsHandle = FWorldDelegates::OnWorldInitializedActors.AddUObject(this, &UFarmAssetStartupSubsystem::OnWorldInitializedActors);
+
+	GameplayHandle = AssetManager.LoadPrimaryAssets(StartupAssetIds, { FFarmPrimaryAssets::GameplayBundle },
+		FStreamableDelegate::CreateUObject(this, &UFarmAssetStartupSubsystem::OnGameplayAssetsLoaded));
+
+	// No handle means there was nothing left to load
+	if (!GameplayHandle.IsValid())
+	{
+		OnGameplayAssetsLoaded();
+	}
+}
+
+void UFarmAssetStartupSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldInitializedActors.Remove(WorldInitializedActorsHandle);
+	WorldInitializedActorsHandle.Reset();
+
+	if (GameplayHandle.IsValid())
+	{
+		GameplayHandle->CancelHandle();
+		GameplayHandle.Reset();
+	}
+
+	RequestedItemBundles.Empty();
+	StartupAssetIds.Empty();
+
+	Super::Deinitialize();
+}
+
+UFarmAssetStartupSubsystem* UFarmAssetStartupSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject)
+	{
+		return nullptr;
+	}
+
+	const UWorld* World = WorldContextObject->GetWorld();
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	UGameInstance* GameInstance = World->GetGameInstance();
+	return GameInstance ? GameInstance->GetSubsystem<UFarmAssetStartupSubsystem>() : nullptr;
+}
+
+void UFarmAssetStartupSubsystem::RequestItemBundle(const UItemDataAsset* Item, FName BundleName)
+{
+	if (!Item || BundleName.IsNone() || !UAssetManager::IsInitialized())
+	{
+		return;
+	}
+
+	const FPrimaryAssetId ItemId = Item->GetPrimaryAssetId();
+	if (!ItemId.IsValid())
+	{
+		return;
+	}
+
+	bool bAlreadyRequested = false;
+	RequestedItemBundles.Add(TPair<FPrimaryAssetId, FName>(ItemId, BundleName), &bAlreadyRequested);
+	if (bAlreadyRequested)
+	{
+		return;
+	}
+
+	// The Asset Manager holds the bundle state, so the returned handle does not need to be kept
+	UAssetManager::Get().ChangeBundleStateForPrimaryAssets({ ItemId }, { BundleName }, TArray<FName>());
+}
+
+void UFarmAssetStartupSubsystem::OnGameplayAssetsLoaded()
+{
+	if (bGameplayReady)
+	{
+		return;
+	}
+
+	bGameplayReady = true;
+	GameplayReadyMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+
+	UE_LOG(LogTemp, Log, TEXT("UFarmAssetStartupSubsystem::OnGameplayAssetsLoaded: Gameplay bundle of %d farm assets loaded in %.1f ms"),
+		StartupAssetIds.Num(), GameplayReadyMs);
+}
+
+void UFarmAssetStartupSubsystem::OnWorldInitializedActors(const UWorld::FActorsInitializedParams& Params)
+{
+	UWorld* World = Params.World;
+	if (!World || !World->IsGameWorld() || World->GetGameInstance() != GetGameInstance() || FirstWorldReadyMs >= 0.0)
+	{
+		return;
+	}
+
+	FirstWorldReadyMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+
+	UE_LOG(LogTemp, Log, TEXT("UFarmAssetStartupSubsystem::OnWorldInitializedActors: First world ready %.1f ms after startup, gameplay assets %s"),
+		FirstWorldReadyMs, bGameplayReady ? TEXT("already loaded") : TEXT("still loading"));
+}
+
+void UFarmAssetStartupSubsystem::LogTimings() const
+{
+	UE_LOG(LogTemp, Display, TEXT("UFarmAssetStartupSubsystem::LogTimings: %d farm assets, times in ms after startup (-1 = not reached)"), StartupAssetIds.Num());
+	UE_LOG(LogTemp, Display, TEXT("    Gameplay bundle: %.1f"), GameplayReadyMs);
+	UE_LOG(LogTemp, Display, TEXT("    First world ready: %.1f"), FirstWorldReadyMs);
+	UE_LOG(LogTemp, Display, TEXT("    Item bundles requested: %d"), RequestedItemBundles.Num());
+}
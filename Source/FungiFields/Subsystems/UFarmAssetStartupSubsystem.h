@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Engine/World.h"
+#include "UObject/PrimaryAssetId.h"
+#include "UFarmAssetStartupSubsystem.generated.h"
+
+struct FStreamableHandle;
+class UItemDataAsset;
+
+/**
+ * Loads the farm primary assets at startup. When the game instance starts it begins an async load of every
+ * farm primary asset with only its Gameplay bundle; the first world does not wait for it, and code that needs
+ * those assets prefetches or resolves them itself (see FFarmAssetLoading). The UI and Visual bundles are never
+ * loaded for every asset: RequestItemBundle adds them per item once a player owns or is shown that item. The
+ * timings are logged and shown by Farm.StartupTimings. Not created in commandlets.
+ */
+UCLASS()
+class FUNGIFIELDS_API UFarmAssetStartupSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem interface
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/**
+	 * Get the startup loader for the game instance that owns the given world context.
+	 * @param WorldContextObject Any object with a valid world
+	 * @return The subsystem, or nullptr if there is no game instance or it is not available
+	 */
+	static UFarmAssetStartupSubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	 * Check whether the Gameplay bundle of every farm primary asset is loaded.
+	 * @return True once the startup load has completed
+	 */
+	bool IsGameplayReady() const { return bGameplayReady; }
+
+	/**
+	 * Load a bundle of one item in the background, keeping the bundles it already has. Each item and bundle
+	 * is requested once; the Asset Manager keeps it loaded for the rest of the session.
+	 * @param Item The item, e.g. one that has just entered an inventory
+	 * @param BundleName FFarmPrimaryAssets::UIBundle or VisualBundle
+	 */
+	void RequestItemBundle(const UItemDataAsset* Item, FName BundleName);
+
+	/** Log how long each startup stage took */
+	void LogTimings() const;
+
+private:
+	/** Called when the Gameplay bundle finishes loading */
+	void OnGameplayAssetsLoaded();
+
+	/** Record when the first world's actors are ready to begin play */
+	void OnWorldInitializedActors(const UWorld::FActorsInitializedParams& Params);
+
+	/** Farm primary assets found by the Asset Manager */
+	TArray<FPrimaryAssetId> StartupAssetIds;
+
+	TSharedPtr<FStreamableHandle> GameplayHandle;
+
+	/** Item bundles already requested by RequestItemBundle */
+	TSet<TPair<FPrimaryAssetId, FName>> RequestedItemBundles;
+
+	FDelegateHandle WorldInitializedActorsHandle;
+
+	bool bGameplayReady = false;
+
+	/** Startup timings, in milliseconds from Initialize; negative until the stage is reached */
+	double StartSeconds = 0.0;
+	double GameplayReadyMs = -1.0;
+	double FirstWorldReadyMs = -1.0;
+};
@@ -0,0 +1,192 @@
+#include "UFarmHitchMonitorSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	FAutoConsoleCommandWithWorldAndArgs FarmHitchMonitorCommand(
+		TEXT("Farm.HitchMonitor"),
+		TEXT("Report frames over the hitch threshold with the farm operations that ran in them. Usage: Farm.HitchMonitor [0|1]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UFarmHitchMonitorSubsystem* HitchMonitor = UFarmHitchMonitorSubsystem::Get(World))
+			{
+				HitchMonitor->SetMonitoring(Args.Num() > 0 ? FCString::ToBool(*Args[0]) : !HitchMonitor->IsMonitoring());
+			}
+		}));
+
+	/** Per-system timings reported with each hitch */
+	struct FHitchTimingColumn
+	{
+		const TCHAR* Name;
+		uint64 FFarmSimTimings::* Cycles;
+	};
+
+	const FHitchTimingColumn HitchTimingColumns[] =
+	{
+		{ TEXT("Growth"), &FFarmSimTimings::GrowthCycles },
+		{ TEXT("Evaporation"), &FFarmSimTimings::EvaporationCycles },
+		{ TEXT("Events"), &FFarmSimTimings::EventCycles },
+		{ TEXT("Visuals"), &FFarmSimTimings::VisualCycles },
+		{ TEXT("Traces"), &FFarmSimTimings::TraceCycles },
+		{ TEXT("Inventory"), &FFarmSimTimings::InventoryCycles },
+		{ TEXT("Widgets"), &FFarmSimTimings::WidgetCycles }
+	};
+}
+
+bool UFarmHitchMonitorSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if UE_BUILD_SHIPPING
+	return false;
+#else
+	return !IsRunningCommandlet() && Super::ShouldCreateSubsystem(Outer);
+#endif
+}
+
+void UFarmHitchMonitorSubsystem::Deinitialize()
+{
+	SetMonitoring(false);
+
+	Super::Deinitialize();
+}
+
+void UFarmHitchMonitorSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (InWorld.IsGameWorld() && bEnabledOnStart)
+	{
+		SetMonitoring(true);
+	}
+}
+
+UFarmHitchMonitorSubsystem* UFarmHitchMonitorSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject)
+	{
+		return nullptr;
+	}
+
+	const UWorld* World = WorldContextObject->GetWorld();
+	return World ? World->GetSubsystem<UFarmHitchMonitorSubsystem>() : nullptr;
+}
+
+TStatId UFarmHitchMonitorSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFarmHitchMonitorSubsystem, STATGROUP_Tickables);
+}
+
+void UFarmHitchMonitorSubsystem::SetMonitoring(bool bInEnabled)
+{
+	if (bMonitoring == bInEnabled)
+	{
+		return;
+	}
+
+	bMonitoring = bInEnabled;
+	FFarmHitchLog::bEnabled = bInEnabled;
+
+	if (bInEnabled)
+	{
+		FFarmSimTimings::AddEnableRef();
+		LastTickSeconds = 0.0;
+
+		UE_LOG(LogTemp, Log, TEXT("UFarmHitchMonitorSubsystem::SetMonitoring: Reporting frames over %.1f ms"), HitchThresholdMs);
+	}
+	else
+	{
+		FFarmSimTimings::ReleaseEnableRef();
+	}
+}
+
+void UFarmHitchMonitorSubsystem::Tick(float DeltaTime)
+{
+	if (!bMonitoring)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (LastTickSeconds > 0.0)
+	{
+		const double FrameMs = (Now - LastTickSeconds) * 1000.0;
+		if (FrameMs > HitchThresholdMs)
+		{
+			ReportHitch(FrameMs, LastTickSeconds);
+		}
+	}
+
+	// Read the clock again so the time spent reporting is not blamed on the next frame
+	LastTickSeconds = FPlatformTime::Seconds();
+	LastTimings = FFarmSimTimings::Get();
+}
+
+void UFarmHitchMonitorSubsystem::ReportHitch(double FrameMs, double FrameStartSeconds)
+{
+	++HitchCount;
+
+	FFarmHitchLog::GetSince(FrameStartSeconds, HitchOps);
+	HitchOps.RemoveAll([this](const FFarmHitchOpRecord& Record)
+	{
+		return Record.DurationMs < MinReportedOpMs;
+	});
+	HitchOps.Sort([](const FFarmHitchOpRecord& A, const FFarmHitchOpRecord& B)
+	{
+		return A.DurationMs > B.DurationMs;
+	});
+
+	const FFarmSimTimings& Timings = FFarmSimTimings::Get();
+
+	// Counters go backwards if a benchmark reset them; report that system as zero
+	auto DeltaMs = [this, &Timings](uint64 FFarmSimTimings::* Cycles) -> double
+	{
+		return Timings.*Cycles >= LastTimings.*Cycles ? FPlatformTime::ToMilliseconds64(Timings.*Cycles - LastTimings.*Cycles) : 0.0;
+	};
+
+	FString TimingSummary;
+	for (const FHitchTimingColumn& Column : HitchTimingColumns)
+	{
+		TimingSummary += FString::Printf(TEXT("%s%s %.2f"), TimingSummary.IsEmpty() ? TEXT("") : TEXT(", "), Column.Name, DeltaMs(Column.Cycles));
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("UFarmHitchMonitorSubsystem::ReportHitch: Frame %llu took %.1f ms (%s ms), %d farm operations"),
+		GFrameCounter, FrameMs, *TimingSummary, HitchOps.Num());
+
+	for (const FFarmHitchOpRecord& Record : HitchOps)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("    %.2f ms %s %s"), Record.DurationMs, FFarmHitchLog::GetOpName(Record.Op), *Record.Context.ToString());
+	}
+
+	if (!bWriteCsv)
+	{
+		return;
+	}
+
+	FString Csv;
+	if (CsvPath.IsEmpty())
+	{
+		CsvPath = FPaths::ProjectSavedDir() / TEXT("Hitches") / FString::Printf(TEXT("FarmHitches_%s.csv"), *FDateTime::Now().ToString());
+		Csv = TEXT("Hitch,Frame,FrameMs,Kind,Name,Ms\n");
+	}
+
+	for (const FHitchTimingColumn& Column : HitchTimingColumns)
+	{
+		Csv += FString::Printf(TEXT("%d,%llu,%.2f,Timing,%s,%.3f\n"), HitchCount, GFrameCounter, FrameMs, Column.Name, DeltaMs(Column.Cycles));
+	}
+
+	for (const FFarmHitchOpRecord& Record : HitchOps)
+	{
+		Csv += FString::Printf(TEXT("%d,%llu,%.2f,%s,%s,%.3f\n"), HitchCount, GFrameCounter, FrameMs,
+			FFarmHitchLog::GetOpName(Record.Op), *Record.Context.ToString(), Record.DurationMs);
+	}
+
+	if (!FFileHelper::SaveStringToFile(Csv, *CsvPath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append))
+	{
+		UE_LOG(LogTemp, Error, TEXT("UFarmHitchMonitorSubsystem::ReportHitch: Failed to write %s"), *CsvPath);
+	}
+}
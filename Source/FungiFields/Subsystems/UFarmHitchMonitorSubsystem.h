@@ -0,0 +1,93 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FFarmHitchLog.h"
+#include "FFarmSimTimings.h"
+#include "UFarmHitchMonitorSubsystem.generated.h"
+
+/**
+ * Detects long frames and attributes them to farm work. While enabled it records recent harvests, spawns,
+ * synchronous loads, widget rebuilds and registry scans in FFarmHitchLog and collects FFarmSimTimings.
+ * When a frame takes longer than HitchThresholdMs it logs the operations that ran during that frame,
+ * slowest first, with the frame's per-system timings, and appends them to a CSV in Saved/Hitches.
+ * Toggle with Farm.HitchMonitor; defaults come from the [/Script/FungiFields.FarmHitchMonitorSubsystem]
+ * section of DefaultGame.ini. Game worlds only, not in commandlets or shipping builds.
+ */
+UCLASS(config=Game)
+class FUNGIFIELDS_API UFarmHitchMonitorSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem interface
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+
+	// UWorldSubsystem interface
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickableWhenPaused() const override { return true; }
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Get the hitch monitor for the world of the given object.
+	 * @param WorldContextObject Any object with a valid world
+	 * @return The subsystem, or nullptr if there is no world or the monitor is not available
+	 */
+	static UFarmHitchMonitorSubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	 * Start or stop monitoring.
+	 * @param bInEnabled Whether to record operations and check frame times
+	 */
+	void SetMonitoring(bool bInEnabled);
+
+	/**
+	 * Check whether frames are being monitored.
+	 * @return True while monitoring
+	 */
+	bool IsMonitoring() const { return bMonitoring; }
+
+	/** Whether monitoring starts with the world */
+	UPROPERTY(Config)
+	bool bEnabledOnStart = false;
+
+	/** Frames longer than this are reported, in milliseconds */
+	UPROPERTY(Config)
+	float HitchThresholdMs = 33.0f;
+
+	/** Operations shorter than this are left out of reports, in milliseconds */
+	UPROPERTY(Config)
+	float MinReportedOpMs = 0.1f;
+
+	/** Whether hitches are also appended to a CSV file */
+	UPROPERTY(Config)
+	bool bWriteCsv = true;
+
+private:
+	/**
+	 * Log a long frame and append it to the CSV.
+	 * @param FrameMs Length of the frame
+	 * @param FrameStartSeconds When the frame started
+	 */
+	void ReportHitch(double FrameMs, double FrameStartSeconds);
+
+	bool bMonitoring = false;
+
+	/** Time of the previous tick; zero until the first tick after monitoring starts */
+	double LastTickSeconds = 0.0;
+
+	/** Timings at the previous tick */
+	FFarmSimTimings LastTimings;
+
+	/** Operations of the frame being reported, kept to avoid reallocating */
+	TArray<FFarmHitchOpRecord> HitchOps;
+
+	/** CSV file for this session */
+	FString CsvPath;
+
+	int32 HitchCount = 0;
+};
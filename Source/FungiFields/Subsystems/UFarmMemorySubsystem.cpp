@@ -0,0 +1,116 @@
+#include "UFarmMemorySubsystem.h"
+#include "FFarmHitchLog.h"
+#include "UCropManagerSubsystem.h"
+#include "../Actors/ACropBase.h"
+#include "../Actors/ASoilPlot.h"
+#include "../Components/USoilComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "UObject/UObjectHash.h"
+
+namespace
+{
+	FAutoConsoleCommandWithWorldAndArgs FarmMemoryCommand(
+		TEXT("Farm.Memory"),
+		TEXT("Log the memory used per plot and per crop and warn about exceeded budgets"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (const UFarmMemorySubsystem* FarmMemory = UFarmMemorySubsystem::Get(World))
+			{
+				FarmMemory->ReportAndCheckBudgets();
+			}
+		}));
+}
+
+UFarmMemorySubsystem* UFarmMemorySubsystem::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject)
+	{
+		return nullptr;
+	}
+
+	const UWorld* World = WorldContextObject->GetWorld();
+	return World ? World->GetSubsystem<UFarmMemorySubsystem>() : nullptr;
+}
+
+FFarmMemoryReport UFarmMemorySubsystem::Measure() const
+{
+	FARM_HITCH_SCOPE(MemoryMeasure, this);
+	FFarmMemoryReport Report;
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return Report;
+	}
+
+	for (TActorIterator<ASoilPlot> It(World); It; ++It)
+	{
+		ASoilPlot* Plot = *It;
+		++Report.PlotCount;
+		Report.PlotBytes += GetActorBytes(Plot, Report.MaterialBytes);
+
+		const USoilComponent* SoilComp = Plot->GetSoilComponent();
+		if (ACropBase* Crop = SoilComp ? SoilComp->GetCrop() : nullptr)
+		{
+			++Report.CropCount;
+			Report.CropBytes += GetActorBytes(Crop, Report.MaterialBytes);
+		}
+	}
+
+	if (const UCropManagerSubsystem* CropManager = World->GetSubsystem<UCropManagerSubsystem>())
+	{
+		Report.CropManagerBytes = CropManager->GetAllocatedSize();
+	}
+
+	return Report;
+}
+
+bool UFarmMemorySubsystem::ReportAndCheckBudgets() const
+{
+	const FFarmMemoryReport Report = Measure();
+
+	UE_LOG(LogTemp, Display, TEXT("UFarmMemorySubsystem: %d plots, %lld bytes per plot; %d crops, %lld bytes per crop; %lld bytes of dynamic materials; %lld bytes in the crop manager"),
+		Report.PlotCount, Report.GetBytesPerPlot(), Report.CropCount, Report.GetBytesPerCrop(), Report.MaterialBytes, Report.CropManagerBytes);
+
+	return CheckBudgets(Report);
+}
+
+bool UFarmMemorySubsystem::CheckBudgets(const FFarmMemoryReport& Report) const
+{
+	bool bWithinBudget = true;
+
+	if (PlotBudgetBytes > 0 && Report.GetBytesPerPlot() > PlotBudgetBytes)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UFarmMemorySubsystem::CheckBudgets: Plots use %lld bytes each, over the budget of %lld"), Report.GetBytesPerPlot(), PlotBudgetBytes);
+		bWithinBudget = false;
+	}
+
+	if (CropBudgetBytes > 0 && Report.GetBytesPerCrop() > CropBudgetBytes)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UFarmMemorySubsystem::CheckBudgets: Crops use %lld bytes each, over the budget of %lld"), Report.GetBytesPerCrop(), CropBudgetBytes);
+		bWithinBudget = false;
+	}
+
+	return bWithinBudget;
+}
+
+int64 UFarmMemorySubsystem::GetActorBytes(AActor* Actor, int64& OutMaterialBytes)
+{
+	int64 Bytes = Actor->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+
+	ForEachObjectWithOuter(Actor, [&Bytes, &OutMaterialBytes](UObject* Object)
+	{
+		const int64 ObjectBytes = Object->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+		Bytes += ObjectBytes;
+
+		if (Object->IsA<UMaterialInstanceDynamic>())
+		{
+			OutMaterialBytes += ObjectBytes;
+		}
+	}, true);
+
+	return Bytes;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UFarmMemorySubsystem.generated.h"
+
+/** Memory used by the farm in one world, measured from the plot and crop objects */
+struct FFarmMemoryReport
+{
+	int32 PlotCount = 0;
+	int32 CropCount = 0;
+
+	/** Plot actors with their components and dynamic materials */
+	int64 PlotBytes = 0;
+
+	/** Dynamic material instances, also included in PlotBytes and CropBytes */
+	int64 MaterialBytes = 0;
+
+	/** Crop actors with their components */
+	int64 CropBytes = 0;
+
+	/** Crop manager containers */
+	int64 CropManagerBytes = 0;
+
+	int64 GetBytesPerPlot() const { return PlotCount > 0 ? PlotBytes / PlotCount : 0; }
+
+	/** Crop cost includes its share of the crop manager's containers */
+	int64 GetBytesPerCrop() const { return CropCount > 0 ? (CropBytes + CropManagerBytes) / CropCount : 0; }
+};
+
+/**
+ * Farm memory accounting and budgets. Allocations made by farm systems are also tagged for the Low-Level
+ * Memory tracker under Farm/ (run with -llm and use "stat LLMFULL"); this subsystem measures the live
+ * objects directly so it works in any build. Farm.Memory logs bytes per plot and per crop and warns when
+ * either exceeds its budget from the [/Script/FungiFields.FarmMemorySubsystem] section of DefaultGame.ini.
+ */
+UCLASS(config=Game)
+class FUNGIFIELDS_API UFarmMemorySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Get the farm memory subsystem for the world of the given object.
+	 * @param WorldContextObject Any object with a valid world
+	 * @return The subsystem, or nullptr if there is no world
+	 */
+	static UFarmMemorySubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	 * Measure the memory used by every plot and crop in the world. Walks every farm object, so this is
+	 * meant for debugging and benchmarks rather than gameplay.
+	 * @return The measurements
+	 */
+	FFarmMemoryReport Measure() const;
+
+	/**
+	 * Measure the farm, log the result and warn about exceeded budgets.
+	 * @return True if the farm is within budget
+	 */
+	bool ReportAndCheckBudgets() const;
+
+	/**
+	 * Warn about the budgets a measurement exceeds.
+	 * @param Report Measurement from Measure
+	 * @return True if the measurement is within budget
+	 */
+	bool CheckBudgets(const FFarmMemoryReport& Report) const;
+
+	/** Budget for one plot with its components and materials, in bytes; 0 disables the check */
+	UPROPERTY(Config)
+	int64 PlotBudgetBytes = 0;
+
+	/** Budget for one crop with its components and crop manager share, in bytes; 0 disables the check */
+	UPROPERTY(Config)
+	int64 CropBudgetBytes = 0;
+
+private:
+	/**
+	 * Get the bytes used by an actor and every object it owns.
+	 * @param Actor The actor
+	 * @param OutMaterialBytes Incremented by the bytes of the actor's dynamic material instances
+	 * @return Bytes used
+	 */
+	static int64 GetActorBytes(AActor* Actor, int64& OutMaterialBytes);
+};
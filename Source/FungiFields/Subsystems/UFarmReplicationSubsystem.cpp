@@ -0,0 +1,489 @@
+#include "UFarmReplicationSubsystem.h"
+#include "../FungiFieldsStats.h"
+#include "../Actors/AFarmChunk.h"
+#include "../Actors/ASoilPlot.h"
+#include "../Data/FFarmPlotRecord.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "TimerManager.h"
+
+void UFarmReplicationSubsystem::Deinitialize()
+{
+	Chunks.Empty();
+	RegisteredPlots.Empty();
+	DirtyPlots.Empty();
+	ServerPlotsByCell.Empty();
+	PredictedPlots.Empty();
+	LocalPlotsByCell.Empty();
+	OrphanedPlotsByChunk.Empty();
+
+	Super::Deinitialize();
+}
+
+UFarmReplicationSubsystem* UFarmReplicationSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject)
+	{
+		return nullptr;
+	}
+
+	const UWorld* World = WorldContextObject->GetWorld();
+	return World ? World->GetSubsystem<UFarmReplicationSubsystem>() : nullptr;
+}
+
+FIntPoint UFarmReplicationSubsystem::GetCellForLocation(const FVector& Location) const
+{
+	return FIntPoint(
+		FMath::FloorToInt(Location.X / CellSize),
+		FMath::FloorToInt(Location.Y / CellSize)
+	);
+}
+
+FIntPoint UFarmReplicationSubsystem::GetChunkForCell(const FIntPoint& Cell) const
+{
+	return FIntPoint(
+		FMath::FloorToInt(static_cast<float>(Cell.X) / ChunkSizeInCells),
+		FMath::FloorToInt(static_cast<float>(Cell.Y) / ChunkSizeInCells)
+	);
+}
+
+bool UFarmReplicationSubsystem::IsFarmServer() const
+{
+	const UWorld* World = GetWorld();
+	if (!World)
+	{
+		return false;
+	}
+
+	const ENetMode NetMode = World->GetNetMode();
+	return NetMode == NM_DedicatedServer || NetMode == NM_ListenServer;
+}
+
+float UFarmReplicationSubsystem::GetServerWorldTime() const
+{
+	const UWorld* World = GetWorld();
+	if (!World)
+	{
+		return 0.0f;
+	}
+
+	if (const AGameStateBase* GameState = World->GetGameState())
+	{
+		return GameState->GetServerWorldTimeSeconds();
+	}
+
+	return World->GetTimeSeconds();
+}
+
+void UFarmReplicationSubsystem::MarkPlotDirty(ASoilPlot* Plot)
+{
+	if (!Plot || !IsFarmServer())
+	{
+		return;
+	}
+
+	DirtyPlots.Add(Plot);
+
+	if (!bFlushScheduled)
+	{
+		if (UWorld* World = GetWorld())
+		{
+			World->GetTimerManager().SetTimerForNextTick(this, &UFarmReplicationSubsystem::FlushDirtyPlots);
+			bFlushScheduled = true;
+		}
+	}
+}
+
+void UFarmReplicationSubsystem::FlushDirtyPlots()
+{
+	bFlushScheduled = false;
+
+	const float ServerTime = GetServerWorldTime();
+
+	for (const TWeakObjectPtr<ASoilPlot>& WeakPlot : DirtyPlots)
+	{
+		ASoilPlot* Plot = WeakPlot.Get();
+		if (!IsValid(Plot))
+		{
+			continue;
+		}
+
+		FFarmPlotRecord Sampled = Plot->BuildReplicationRecord(ServerTime);
+
+		if (FRegisteredFarmPlot* Registered = RegisteredPlots.Find(Plot))
+		{
+			if (AFarmChunk* Chunk = Registered->Chunk.Get())
+			{
+				Sampled.PlotKey = Registered->PlotKey;
+				Chunk->UpdatePlotRecord(Sampled, WaterResyncStep);
+			}
+			continue;
+		}
+
+		const FIntPoint ChunkCoord = GetChunkForCell(GetCellForLocation(Plot->GetActorLocation()));
+		if (AFarmChunk* Chunk = GetOrCreateChunk(ChunkCoord))
+		{
+			FRegisteredFarmPlot& Registered = RegisteredPlots.Add(Plot);
+			Registered.Chunk = Chunk;
+			Registered.PlotKey = Chunk->AddPlotRecord(Sampled);
+		}
+	}
+
+	DirtyPlots.Reset();
+}
+
+AFarmChunk* UFarmReplicationSubsystem::GetOrCreateChunk(const FIntPoint& ChunkCoord)
+{
+	if (TObjectPtr<AFarmChunk>* Existing = Chunks.Find(ChunkCoord))
+	{
+		if (IsValid(*Existing))
+		{
+			return *Existing;
+		}
+	}
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	const float ChunkWorldSize = CellSize * ChunkSizeInCells;
+	const FVector ChunkOrigin((ChunkCoord.X + 0.5f) * ChunkWorldSize, (ChunkCoord.Y + 0.5f) * ChunkWorldSize, 0.0f);
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParams.bDeferConstruction = true;
+
+	FARM_INC_COUNTER(STAT_FarmActorsSpawned, ActorSpawnCount);
+	FARM_HITCH_SCOPE(Spawn, AFarmChunk::StaticClass());
+	AFarmChunk* Chunk = World->SpawnActor<AFarmChunk>(AFarmChunk::StaticClass(), ChunkOrigin, FRotator::ZeroRotator, SpawnParams);
+	if (!Chunk)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UFarmReplicationSubsystem::GetOrCreateChunk: Failed to spawn chunk (%d, %d)"), ChunkCoord.X, ChunkCoord.Y);
+		return nullptr;
+	}
+
+	Chunk->SetChunkCoord(ChunkCoord);
+	Chunk->FinishSpawning(FTransform(FRotator::ZeroRotator, ChunkOrigin));
+
+	Chunks.Add(ChunkCoord, Chunk);
+	return Chunk;
+}
+
+void UFarmReplicationSubsystem::RegisterLocalPlot(ASoilPlot* Plot)
+{
+	const UWorld* World = GetWorld();
+	if (!Plot || !World)
+	{
+		return;
+	}
+
+	if (IsFarmServer())
+	{
+		ServerPlotsByCell.FindOrAdd(GetCellForLocation(Plot->GetActorLocation())).Add(Plot);
+		return;
+	}
+
+	if (World->GetNetMode() != NM_Client)
+	{
+		return;
+	}
+
+	LocalPlotsByCell.FindOrAdd(GetCellForLocation(Plot->GetActorLocation())).Add(Plot);
+}
+
+ASoilPlot* UFarmReplicationSubsystem::FindServerPlotNear(const FVector& Location) const
+{
+	const FIntPoint CenterCell = GetCellForLocation(Location);
+	const float ToleranceSquared = FMath::Square(MatchTolerance);
+
+	for (int32 OffsetX = -1; OffsetX <= 1; ++OffsetX)
+	{
+		for (int32 OffsetY = -1; OffsetY <= 1; ++OffsetY)
+		{
+			const TArray<TWeakObjectPtr<ASoilPlot>>* CellPlots = ServerPlotsByCell.Find(CenterCell + FIntPoint(OffsetX, OffsetY));
+			if (!CellPlots)
+			{
+				continue;
+			}
+
+			for (const TWeakObjectPtr<ASoilPlot>& WeakPlot : *CellPlots)
+			{
+				ASoilPlot* Candidate = WeakPlot.Get();
+				if (IsValid(Candidate) && Candidate->ShouldReplicateFarmState()
+					&& FVector::DistSquared2D(Candidate->GetActorLocation(), Location) <= ToleranceSquared)
+				{
+					return Candidate;
+				}
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+void UFarmReplicationSubsystem::BeginPlotPrediction(ASoilPlot* Plot)
+{
+	if (!Plot)
+	{
+		return;
+	}
+
+	++PredictedPlots.FindOrAdd(Plot).PendingCount;
+}
+
+void UFarmReplicationSubsystem::EndPlotPrediction(ASoilPlot* Plot, float AckSampleTime)
+{
+	if (!Plot)
+	{
+		return;
+	}
+
+	FPredictedFarmPlot* Predicted = PredictedPlots.Find(Plot);
+	if (!Predicted || --Predicted->PendingCount > 0)
+	{
+		return;
+	}
+
+	FPredictedFarmPlot Finished;
+	PredictedPlots.RemoveAndCopyValue(Plot, Finished);
+
+	if (Finished.DeferredRecord.IsSet() && Finished.DeferredRecord->SampleServerTime > AckSampleTime)
+	{
+		Plot->ApplyReplicationRecord(Finished.DeferredRecord.GetValue());
+	}
+}
+
+void UFarmReplicationSubsystem::UnregisterPlot(ASoilPlot* Plot, EEndPlayReason::Type EndPlayReason)
+{
+	if (!Plot)
+	{
+		return;
+	}
+
+	DirtyPlots.Remove(Plot);
+
+	if (!IsFarmServer())
+	{
+		PredictedPlots.Remove(Plot);
+		RemoveLocalPlot(Plot);
+		return;
+	}
+
+	if (TArray<TWeakObjectPtr<ASoilPlot>>* CellPlots = ServerPlotsByCell.Find(GetCellForLocation(Plot->GetActorLocation())))
+	{
+		CellPlots->RemoveSwap(Plot);
+	}
+
+	if (EndPlayReason != EEndPlayReason::Destroyed)
+	{
+		RegisteredPlots.Remove(Plot);
+		return;
+	}
+
+	FRegisteredFarmPlot Registered;
+	const bool bWasRegistered = RegisteredPlots.RemoveAndCopyValue(Plot, Registered);
+
+	// Clients load level-placed plots themselves, so they need an explicit record telling them to remove it
+	if (Plot->IsNetStartupActor())
+	{
+		FFarmPlotRecord Tombstone;
+		Tombstone.Location = Plot->GetActorLocation();
+		Tombstone.SetFlag(EFarmPlotFlags::Removed, true);
+
+		if (bWasRegistered)
+		{
+			if (AFarmChunk* Chunk = Registered.Chunk.Get())
+			{
+				Tombstone.PlotKey = Registered.PlotKey;
+				Chunk->UpdatePlotRecord(Tombstone, WaterResyncStep);
+			}
+		}
+		else if (AFarmChunk* Chunk = GetOrCreateChunk(GetChunkForCell(GetCellForLocation(Tombstone.Location))))
+		{
+			Chunk->AddPlotRecord(Tombstone);
+		}
+		return;
+	}
+
+	if (bWasRegistered)
+	{
+		if (AFarmChunk* Chunk = Registered.Chunk.Get())
+		{
+			Chunk->RemovePlotRecord(Registered.PlotKey);
+		}
+	}
+}
+
+void UFarmReplicationSubsystem::ApplyClientRecord(AFarmChunk* Chunk, const FFarmPlotRecord& Record)
+{
+	UWorld* World = GetWorld();
+	if (!Chunk || !World)
+	{
+		return;
+	}
+
+	const bool bRemoved = Record.HasFlag(EFarmPlotFlags::Removed);
+
+	ASoilPlot* Plot = Chunk->GetClientPlot(Record.PlotKey);
+	if (!Plot)
+	{
+		Plot = TakeLocalPlotNear(Record.Location);
+	}
+
+	if (bRemoved)
+	{
+		if (Plot)
+		{
+			Plot->Destroy();
+		}
+		Chunk->SetClientPlot(Record.PlotKey, nullptr);
+		return;
+	}
+
+	if (!Plot)
+	{
+		const TSubclassOf<ASoilPlot> PlotClass = Record.PlotClass ? Record.PlotClass : TSubclassOf<ASoilPlot>(ASoilPlot::StaticClass());
+		const FRotator Rotation(0.0f, FRotator::DecompressAxisFromByte(Record.Yaw), 0.0f);
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		LLM_SCOPE_BYTAG(Farm_Plots);
+		FARM_INC_COUNTER(STAT_FarmActorsSpawned, ActorSpawnCount);
+		FARM_HITCH_SCOPE(Spawn, PlotClass);
+		Plot = World->SpawnActor<ASoilPlot>(PlotClass, Record.Location, Rotation, SpawnParams);
+		if (!Plot)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("UFarmReplicationSubsystem::ApplyClientRecord: Failed to spawn plot for key %d"), Record.PlotKey);
+			return;
+		}
+		RemoveLocalPlot(Plot);
+	}
+
+	Chunk->SetClientPlot(Record.PlotKey, Plot);
+
+	if (FPredictedFarmPlot* Predicted = PredictedPlots.Find(Plot))
+	{
+		Predicted->DeferredRecord = Record;
+		return;
+	}
+
+	Plot->ApplyReplicationRecord(Record);
+}
+
+void UFarmReplicationSubsystem::RemoveClientRecord(AFarmChunk* Chunk, const FFarmPlotRecord& Record)
+{
+	if (!Chunk)
+	{
+		return;
+	}
+
+	if (ASoilPlot* Plot = Chunk->GetClientPlot(Record.PlotKey))
+	{
+		Plot->Destroy();
+	}
+	Chunk->SetClientPlot(Record.PlotKey, nullptr);
+}
+
+void UFarmReplicationSubsystem::ReleaseClientChunk(AFarmChunk* Chunk)
+{
+	if (!Chunk)
+	{
+		return;
+	}
+
+	TArray<TWeakObjectPtr<ASoilPlot>>& Orphans = OrphanedPlotsByChunk.FindOrAdd(Chunk->GetChunkCoord());
+	for (const TPair<uint16, TWeakObjectPtr<ASoilPlot>>& Pair : Chunk->GetClientPlots())
+	{
+		if (ASoilPlot* Plot = Pair.Value.Get())
+		{
+			RegisterLocalPlot(Plot);
+			Orphans.Add(Plot);
+		}
+	}
+}
+
+void UFarmReplicationSubsystem::ResolveOrphanedPlots(AFarmChunk* Chunk)
+{
+	if (!Chunk)
+	{
+		return;
+	}
+
+	TArray<TWeakObjectPtr<ASoilPlot>> Orphans;
+	if (!OrphanedPlotsByChunk.RemoveAndCopyValue(Chunk->GetChunkCoord(), Orphans))
+	{
+		return;
+	}
+
+	for (const TWeakObjectPtr<ASoilPlot>& WeakPlot : Orphans)
+	{
+		ASoilPlot* Plot = WeakPlot.Get();
+		if (!Plot)
+		{
+			continue;
+		}
+
+		bool bRebound = false;
+		for (const TPair<uint16, TWeakObjectPtr<ASoilPlot>>& Pair : Chunk->GetClientPlots())
+		{
+			if (Pair.Value == Plot)
+			{
+				bRebound = true;
+				break;
+			}
+		}
+
+		if (!bRebound)
+		{
+			RemoveLocalPlot(Plot);
+			Plot->Destroy();
+		}
+	}
+}
+
+ASoilPlot* UFarmReplicationSubsystem::TakeLocalPlotNear(const FVector& Location)
+{
+	const FIntPoint CenterCell = GetCellForLocation(Location);
+	const float ToleranceSquared = FMath::Square(MatchTolerance);
+
+	// Quantized locations can land just across a cell edge, so search the neighbouring cells too
+	for (int32 OffsetX = -1; OffsetX <= 1; ++OffsetX)
+	{
+		for (int32 OffsetY = -1; OffsetY <= 1; ++OffsetY)
+		{
+			TArray<TWeakObjectPtr<ASoilPlot>>* CellPlots = LocalPlotsByCell.Find(CenterCell + FIntPoint(OffsetX, OffsetY));
+			if (!CellPlots)
+			{
+				continue;
+			}
+
+			for (int32 Index = 0; Index < CellPlots->Num(); ++Index)
+			{
+				ASoilPlot* Candidate = (*CellPlots)[Index].Get();
+				if (!IsValid(Candidate) || !Candidate->ShouldReplicateFarmState())
+				{
+					continue;
+				}
+
+				if (FVector::DistSquared2D(Candidate->GetActorLocation(), Location) <= ToleranceSquared)
+				{
+					CellPlots->RemoveAtSwap(Index);
+					return Candidate;
+				}
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+void UFarmReplicationSubsystem::RemoveLocalPlot(ASoilPlot* Plot)
+{
+	if (TArray<TWeakObjectPtr<ASoilPlot>>* CellPlots = LocalPlotsByCell.Find(GetCellForLocation(Plot->GetActorLocation())))
+	{
+		CellPlots->RemoveSwap(Plot);
+	}
+}
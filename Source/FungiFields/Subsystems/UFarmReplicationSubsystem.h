@@ -0,0 +1,200 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "../Data/FFarmPlotRecord.h"
+#include "UFarmReplicationSubsystem.generated.h"
+
+class AFarmChunk;
+class ASoilPlot;
+
+/**
+ * Replicates farm state by grid chunk instead of per actor.
+ * The server buckets changed soil plots into AFarmChunk actors by location; each chunk replicates a fast array
+ * of quantized plot records and stays dormant while nothing in it changes.
+ * Clients apply records to their own plot actors, matching level-placed plots by location and spawning the rest.
+ * Does nothing in standalone games.
+ */
+UCLASS()
+class FUNGIFIELDS_API UFarmReplicationSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem interface
+	virtual void Deinitialize() override;
+
+	/**
+	 * Get the farm replication subsystem for the world of the given object.
+	 * @param WorldContextObject Any object with a valid world
+	 * @return The subsystem, or nullptr if there is no world
+	 */
+	static UFarmReplicationSubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	 * Get the farm grid cell containing a world location.
+	 * @param Location World location
+	 * @return Cell coordinate
+	 */
+	FIntPoint GetCellForLocation(const FVector& Location) const;
+
+	/**
+	 * Get the chunk containing a farm grid cell.
+	 * @param Cell Cell coordinate
+	 * @return Chunk coordinate
+	 */
+	FIntPoint GetChunkForCell(const FIntPoint& Cell) const;
+
+	/**
+	 * Check whether this world is the authority for replicated farm state.
+	 * @return True on listen and dedicated servers
+	 */
+	bool IsFarmServer() const;
+
+	/**
+	 * Get the current server world time, which is the time base for replicated growth samples.
+	 * @return Server world time in seconds
+	 */
+	float GetServerWorldTime() const;
+
+	/**
+	 * Server: queue a plot whose state changed. Dirty plots are sampled once at the start of the next frame,
+	 * so several changes in one frame produce a single record update.
+	 * @param Plot The plot that changed
+	 */
+	void MarkPlotDirty(ASoilPlot* Plot);
+
+	/**
+	 * Make a plot findable by location. On the server this indexes it for resolving client farming commands;
+	 * on clients it makes the plot available for matching against replicated records.
+	 * @param Plot The local plot
+	 */
+	void RegisterLocalPlot(ASoilPlot* Plot);
+
+	/**
+	 * Server: find the replicated plot at a location sent by a client.
+	 * @param Location Quantized plot location
+	 * @return The plot within MatchTolerance of the location, or nullptr
+	 */
+	ASoilPlot* FindServerPlotNear(const FVector& Location) const;
+
+	/**
+	 * Client: a farming action was predicted on a plot. Records arriving for the plot are held back
+	 * until every prediction on it has been acknowledged, so stale server state does not undo the prediction.
+	 * @param Plot The predicted plot
+	 */
+	void BeginPlotPrediction(ASoilPlot* Plot);
+
+	/**
+	 * Client: a predicted action on a plot was acknowledged. Once no predictions remain, a held back record
+	 * is applied if it was sampled after the acknowledged state.
+	 * @param Plot The predicted plot
+	 * @param AckSampleTime Server time the acknowledged plot state was sampled at
+	 */
+	void EndPlotPrediction(ASoilPlot* Plot, float AckSampleTime);
+
+	/**
+	 * Forget a plot that is leaving play. On the server, destroyed plots are removed from their chunk;
+	 * level-placed plots leave a removal record behind so joining clients remove their copy too.
+	 * @param Plot The plot leaving play
+	 * @param EndPlayReason Why the plot is leaving play
+	 */
+	void UnregisterPlot(ASoilPlot* Plot, EEndPlayReason::Type EndPlayReason);
+
+	/** Client: apply a replicated record to its local plot, spawning the plot if needed */
+	void ApplyClientRecord(AFarmChunk* Chunk, const FFarmPlotRecord& Record);
+
+	/** Client: destroy the local plot of a removed record */
+	void RemoveClientRecord(AFarmChunk* Chunk, const FFarmPlotRecord& Record);
+
+	/**
+	 * Client: a chunk went out of relevancy. Its plots keep their last known state and become matchable again,
+	 * so the chunk rebinds them when it comes back into range.
+	 * @param Chunk The chunk leaving play
+	 */
+	void ReleaseClientChunk(AFarmChunk* Chunk);
+
+	/**
+	 * Client: after a returning chunk has delivered its records, destroy plots it used to own that were
+	 * removed on the server while the chunk was out of range.
+	 * @param Chunk The chunk that received records
+	 */
+	void ResolveOrphanedPlots(AFarmChunk* Chunk);
+
+	/**
+	 * Get the number of chunks spawned by the server.
+	 * @return Chunk count
+	 */
+	UFUNCTION(BlueprintPure, Category = "Farm Replication")
+	int32 GetNumChunks() const { return Chunks.Num(); }
+
+protected:
+	/** Sample all dirty plots and push changed records to their chunks */
+	void FlushDirtyPlots();
+
+	/** Get the chunk actor for a chunk coordinate, spawning it if needed */
+	AFarmChunk* GetOrCreateChunk(const FIntPoint& ChunkCoord);
+
+	/** Find an unbound local plot within MatchTolerance of a location and take it out of the candidate index */
+	ASoilPlot* TakeLocalPlotNear(const FVector& Location);
+
+	/** Remove a plot from the client candidate index */
+	void RemoveLocalPlot(ASoilPlot* Plot);
+
+private:
+	/** Chunk a registered plot lives in, and its key in that chunk */
+	struct FRegisteredFarmPlot
+	{
+		TWeakObjectPtr<AFarmChunk> Chunk;
+		uint16 PlotKey = 0;
+	};
+
+	/** Outstanding predictions on a plot, and the newest record held back meanwhile */
+	struct FPredictedFarmPlot
+	{
+		int32 PendingCount = 0;
+		TOptional<FFarmPlotRecord> DeferredRecord;
+	};
+
+	/** Server: chunk actors by chunk coordinate */
+	UPROPERTY()
+	TMap<FIntPoint, TObjectPtr<AFarmChunk>> Chunks;
+
+	/** Server: plots that have a record */
+	TMap<TObjectKey<ASoilPlot>, FRegisteredFarmPlot> RegisteredPlots;
+
+	/** Server: plots changed since the last flush */
+	TSet<TWeakObjectPtr<ASoilPlot>> DirtyPlots;
+
+	/** Server: all replicated plots, by cell */
+	TMap<FIntPoint, TArray<TWeakObjectPtr<ASoilPlot>>> ServerPlotsByCell;
+
+	/** Client: plots with unacknowledged predicted actions */
+	TMap<TObjectKey<ASoilPlot>, FPredictedFarmPlot> PredictedPlots;
+
+	/** Client: plots not yet bound to a record, by cell */
+	TMap<FIntPoint, TArray<TWeakObjectPtr<ASoilPlot>>> LocalPlotsByCell;
+
+	/** Client: plots that were bound to a chunk when it went out of relevancy, by chunk coordinate */
+	TMap<FIntPoint, TArray<TWeakObjectPtr<ASoilPlot>>> OrphanedPlotsByChunk;
+
+	/** Whether a flush is already scheduled for next frame */
+	bool bFlushScheduled = false;
+
+	/** Size of one farm grid cell (world units) */
+	UPROPERTY(EditDefaultsOnly, Category = "Farm Replication Settings", meta = (ClampMin = "1.0"))
+	float CellSize = 100.0f;
+
+	/** Width of a chunk in cells */
+	UPROPERTY(EditDefaultsOnly, Category = "Farm Replication Settings", meta = (ClampMin = "1"))
+	int32 ChunkSizeInCells = 16;
+
+	/** Quantized water change (out of 255) that forces a record resend; smaller changes are left stale on clients */
+	UPROPERTY(EditDefaultsOnly, Category = "Farm Replication Settings", meta = (ClampMin = "1", ClampMax = "255"))
+	uint8 WaterResyncStep = 8;
+
+	/** Distance within which a replicated record or client command binds to an existing plot (world units) */
+	UPROPERTY(EditDefaultsOnly, Category = "Farm Replication Settings", meta = (ClampMin = "0.0"))
+	float MatchTolerance = 10.0f;
+};
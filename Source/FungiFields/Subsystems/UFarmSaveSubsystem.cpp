@@ -0,0 +1,840 @@
+#include "UFarmSaveSubsystem.h"
+#include "../FungiFieldsStats.h"
+#include "../Actors/ASoilPlot.h"
+#include "../Actors/ACropBase.h"
+#include "../Components/USoilComponent.h"
+#include "../Components/InventoryComponent.h"
+#include "../Components/QuestComponent.h"
+#include "../Data/FFarmSaveData.h"
+#include "../Data/Quest.h"
+#include "Async/Async.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/FileManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "TimerManager.h"
+#include "UObject/UObjectHash.h"
+
+namespace
+{
+	/** Level-placed plots never move, so their rounded location identifies them across sessions */
+	FIntVector GetLevelPlotKey(const FVector& Location)
+	{
+		return FFarmPlotSaveRecord::MakeLocationKey(FVector3f(Location));
+	}
+
+	/** Assigns save palette indices to assets as records reference them */
+	struct FSavePaletteBuilder
+	{
+		explicit FSavePaletteBuilder(TArray<FSoftObjectPath>& InPalette)
+			: Palette(InPalette)
+		{
+		}
+
+		uint16 operator()(const UObject* Asset)
+		{
+			if (!Asset)
+			{
+				return 0;
+			}
+
+			if (const uint16* Found = Indices.Find(Asset))
+			{
+				return *Found;
+			}
+
+			if (Palette.Num() >= MAX_uint16)
+			{
+				return 0;
+			}
+
+			Palette.Add(FSoftObjectPath(Asset));
+			const uint16 PaletteIndex = static_cast<uint16>(Palette.Num());
+			Indices.Add(Asset, PaletteIndex);
+			return PaletteIndex;
+		}
+
+		TArray<FSoftObjectPath>& Palette;
+		TMap<const UObject*, uint16> Indices;
+	};
+
+	/** Destroy a plot together with its crop, which is a separate actor */
+	void DestroyPlot(ASoilPlot* Plot)
+	{
+		if (USoilComponent* SoilComp = Plot->GetSoilComponent())
+		{
+			if (ACropBase* Crop = SoilComp->GetCrop())
+			{
+				SoilComp->RemoveCrop();
+				Crop->Destroy();
+			}
+		}
+		Plot->Destroy();
+	}
+}
+
+void UFarmSaveSubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(AutosaveTimerHandle);
+		World->GetTimerManager().ClearTimer(JournalFlushTimerHandle);
+	}
+
+	FlushJournal();
+
+	// Workers only hold shared snapshots and a weak pointer back, but a half-written save should still finish
+	FilePipe.WaitUntilEmpty();
+	if (PendingLoadTask.IsValid())
+	{
+		PendingLoadTask.Wait();
+	}
+
+	if (LoadingAssetsHandle.IsValid())
+	{
+		LoadingAssetsHandle->CancelHandle();
+		LoadingAssetsHandle.Reset();
+	}
+
+	LoadingSnapshot.Reset();
+	UnmatchedLevelPlots.Empty();
+	Plots.Empty();
+	PlotIndices.Empty();
+	JournalDirtyPlots.Empty();
+	JournalRemovedPlots.Empty();
+	JournalDirtyInventories.Empty();
+
+	Super::Deinitialize();
+}
+
+void UFarmSaveSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Worlds that suspend autosaves before play begins, such as benchmark worlds, never touch the autosave slot
+	if (InWorld.GetNetMode() == NM_Client || bAutosaveSuspended)
+	{
+		return;
+	}
+
+	if (AutosaveInterval > 0.0f)
+	{
+		InWorld.GetTimerManager().SetTimer(AutosaveTimerHandle, this, &UFarmSaveSubsystem::Autosave, AutosaveInterval, true);
+	}
+
+	if (bEnableJournal)
+	{
+		JournalEpoch = FDateTime::UtcNow().GetTicks();
+		InWorld.GetTimerManager().SetTimer(JournalFlushTimerHandle, this, &UFarmSaveSubsystem::FlushJournal, JournalFlushInterval, true);
+	}
+
+	if (bLoadAutosaveOnBeginPlay)
+	{
+		LoadGame(AutosaveSlot);
+	}
+	else if (bEnableJournal)
+	{
+		// The autosave on disk belongs to a farm this session did not load. It is copied aside before this
+		// session's first autosave replaces it, and its journal is moved aside so this session's epoch does not
+		// append to it. The file pipe runs in order, so both finish before the first flush or autosave.
+		const FString FilePath = GetSlotFilePath(AutosaveSlot);
+		const FString JournalPath = GetJournalFilePath(AutosaveSlot);
+		FilePipe.Launch(UE_SOURCE_LOCATION, [FilePath, JournalPath]()
+		{
+			IFileManager& FileManager = IFileManager::Get();
+			if (FileManager.FileExists(*FilePath))
+			{
+				FileManager.Copy(*(FilePath + TEXT(".prev")), *FilePath, true);
+			}
+			if (FileManager.FileExists(*JournalPath))
+			{
+				FileManager.Move(*(JournalPath + TEXT(".prev")), *JournalPath, true, true);
+			}
+		});
+	}
+}
+
+UFarmSaveSubsystem* UFarmSaveSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject)
+	{
+		return nullptr;
+	}
+
+	const UWorld* World = WorldContextObject->GetWorld();
+	return World ? World->GetSubsystem<UFarmSaveSubsystem>() : nullptr;
+}
+
+void UFarmSaveSubsystem::RegisterPlot(ASoilPlot* Plot)
+{
+	const UWorld* World = GetWorld();
+	if (!Plot || !World || World->GetNetMode() == NM_Client || PlotIndices.Contains(Plot))
+	{
+		return;
+	}
+
+	PlotIndices.Add(Plot, Plots.Add(Plot));
+
+	// Plots beginning play after the world has are placed by players
+	if (World->HasBegunPlay())
+	{
+		JournalPlot(Plot);
+	}
+}
+
+void UFarmSaveSubsystem::UnregisterPlot(ASoilPlot* Plot, EEndPlayReason::Type EndPlayReason)
+{
+	int32 Index = INDEX_NONE;
+	if (!Plot || !PlotIndices.RemoveAndCopyValue(Plot, Index))
+	{
+		return;
+	}
+
+	Plots.RemoveAtSwap(Index);
+	if (Plots.IsValidIndex(Index))
+	{
+		PlotIndices.Add(Plots[Index], Index);
+	}
+
+	JournalDirtyPlots.Remove(Plot);
+
+	if (EndPlayReason != EEndPlayReason::Destroyed || !Plot->ShouldReplicateFarmState())
+	{
+		return;
+	}
+
+	if (Plot->IsNetStartupActor())
+	{
+		RemovedLevelPlots.Add(FVector3f(Plot->GetActorLocation()));
+	}
+
+	if (IsJournaling())
+	{
+		JournalRemovedPlots.Add(FVector3f(Plot->GetActorLocation()));
+	}
+}
+
+bool UFarmSaveSubsystem::IsJournaling() const
+{
+	// Restoring a load touches every plot; the checkpoint that follows the load covers it instead
+	return bEnableJournal && !bLoadInFlight && !bAutosaveSuspended && !bAutosaveUnreadable;
+}
+
+void UFarmSaveSubsystem::JournalPlot(ASoilPlot* Plot)
+{
+	if (Plot && IsJournaling() && Plot->ShouldReplicateFarmState() && PlotIndices.Contains(Plot))
+	{
+		JournalDirtyPlots.Add(Plot);
+	}
+}
+
+void UFarmSaveSubsystem::JournalInventory(UInventoryComponent* Inventory)
+{
+	const UWorld* World = GetWorld();
+	if (Inventory && IsJournaling() && World && World->GetNetMode() != NM_Client)
+	{
+		JournalDirtyInventories.Add(Inventory);
+	}
+}
+
+void UFarmSaveSubsystem::FlushJournal()
+{
+	if (!IsJournaling() || (JournalDirtyPlots.Num() == 0 && JournalRemovedPlots.Num() == 0 && JournalDirtyInventories.Num() == 0))
+	{
+		return;
+	}
+
+	TSharedRef<FFarmJournalBlock> Block = MakeShared<FFarmJournalBlock>();
+	Block->Epoch = JournalEpoch;
+	Block->RemovedPlots = MoveTemp(JournalRemovedPlots);
+	Block->Plots.Reserve(JournalDirtyPlots.Num());
+
+	FSavePaletteBuilder GetPaletteIndex(Block->AssetPalette);
+	for (const TWeakObjectPtr<ASoilPlot>& WeakPlot : JournalDirtyPlots)
+	{
+		if (const ASoilPlot* Plot = WeakPlot.Get())
+		{
+			Block->Plots.Add(Plot->BuildSaveRecord(GetPaletteIndex));
+		}
+	}
+
+	for (const TWeakObjectPtr<UInventoryComponent>& WeakInventory : JournalDirtyInventories)
+	{
+		const UInventoryComponent* Inventory = WeakInventory.Get();
+		FString OwnerKey = Inventory ? GetPersistentKey(Inventory->GetOwner()) : FString();
+		if (OwnerKey.IsEmpty())
+		{
+			continue;
+		}
+
+		FFarmInventorySaveRecord& Record = Block->Inventories.AddDefaulted_GetRef();
+		Record.OwnerKey = MoveTemp(OwnerKey);
+		Record.Slots.Pack(Inventory->GetInventorySlots());
+	}
+
+	JournalDirtyPlots.Reset();
+	JournalRemovedPlots.Reset();
+	JournalDirtyInventories.Reset();
+
+	if (Block->IsEmpty())
+	{
+		return;
+	}
+
+	const FString JournalPath = GetJournalFilePath(AutosaveSlot);
+	FilePipe.Launch(UE_SOURCE_LOCATION, [Block, JournalPath]()
+	{
+		Block->AppendToFile(JournalPath);
+	});
+}
+
+FString UFarmSaveSubsystem::GetPersistentKey(const AActor* Owner) const
+{
+	const UWorld* World = GetWorld();
+	if (!Owner || !World)
+	{
+		return FString();
+	}
+
+	if (Owner->IsA<APawn>())
+	{
+		int32 PlayerIndex = 0;
+		for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It, ++PlayerIndex)
+		{
+			const APlayerController* PlayerController = It->Get();
+			if (PlayerController && PlayerController->GetPawn() == Owner)
+			{
+				return FString::Printf(TEXT("Player%d"), PlayerIndex);
+			}
+		}
+		return FString();
+	}
+
+	// Actors spawned at runtime get a different name every session
+	return Owner->IsNetStartupActor() ? Owner->GetFName().ToString() : FString();
+}
+
+ASoilPlot* UFarmSaveSubsystem::FindPlotAt(const FVector& Location) const
+{
+	const FIntVector Key = GetLevelPlotKey(Location);
+	for (const TWeakObjectPtr<ASoilPlot>& WeakPlot : Plots)
+	{
+		ASoilPlot* Plot = WeakPlot.Get();
+		if (IsValid(Plot) && Plot->ShouldReplicateFarmState() && GetLevelPlotKey(Plot->GetActorLocation()) == Key)
+		{
+			return Plot;
+		}
+	}
+	return nullptr;
+}
+
+uint64 UFarmSaveSubsystem::ComputeStateHash() const
+{
+	return CaptureSnapshot()->ComputeStateHash();
+}
+
+FString UFarmSaveSubsystem::GetSlotFilePath(const FString& SlotName)
+{
+	return FPaths::ProjectSavedDir() / TEXT("SaveGames") / SlotName + TEXT(".farm");
+}
+
+FString UFarmSaveSubsystem::GetJournalFilePath(const FString& SlotName)
+{
+	return FPaths::ProjectSavedDir() / TEXT("SaveGames") / SlotName + TEXT(".farmjournal");
+}
+
+TSharedRef<FFarmSaveSnapshot> UFarmSaveSubsystem::CaptureSnapshot() const
+{
+	TSharedRef<FFarmSaveSnapshot> Snapshot = MakeShared<FFarmSaveSnapshot>();
+	Snapshot->Plots.Reserve(Plots.Num());
+	Snapshot->RemovedLevelPlots = RemovedLevelPlots;
+
+	FSavePaletteBuilder GetPaletteIndex(Snapshot->AssetPalette);
+
+	for (const TWeakObjectPtr<ASoilPlot>& WeakPlot : Plots)
+	{
+		const ASoilPlot* Plot = WeakPlot.Get();
+		if (!Plot || !Plot->ShouldReplicateFarmState() || Plot->IsActorBeingDestroyed())
+		{
+			continue;
+		}
+
+		Snapshot->Plots.Add(Plot->BuildSaveRecord(GetPaletteIndex));
+	}
+
+	const UWorld* World = GetWorld();
+
+	ForEachObjectOfClass(UInventoryComponent::StaticClass(), [this, World, &Snapshot](UObject* Object)
+	{
+		const UInventoryComponent* Inventory = static_cast<UInventoryComponent*>(Object);
+		if (Inventory->IsTemplate() || Inventory->GetWorld() != World)
+		{
+			return;
+		}
+
+		FString OwnerKey = GetPersistentKey(Inventory->GetOwner());
+		if (OwnerKey.IsEmpty())
+		{
+			return;
+		}
+
+		FFarmInventorySaveRecord& Record = Snapshot->Inventories.AddDefaulted_GetRef();
+		Record.OwnerKey = MoveTemp(OwnerKey);
+		Record.Slots.Pack(Inventory->GetInventorySlots());
+	});
+
+	ForEachObjectOfClass(UQuestComponent::StaticClass(), [this, World, &Snapshot](UObject* Object)
+	{
+		const UQuestComponent* QuestComp = static_cast<UQuestComponent*>(Object);
+		if (QuestComp->IsTemplate() || QuestComp->GetWorld() != World)
+		{
+			return;
+		}
+
+		const FString OwnerKey = GetPersistentKey(QuestComp->GetOwner());
+		if (OwnerKey.IsEmpty())
+		{
+			return;
+		}
+
+		for (const UQuest* Quest : QuestComp->GetAllQuests())
+		{
+			if (!Quest)
+			{
+				continue;
+			}
+
+			FFarmQuestSaveRecord& Record = Snapshot->Quests.AddDefaulted_GetRef();
+			Record.OwnerKey = OwnerKey;
+			Record.Quest = FSoftObjectPath(Quest);
+			Record.Progress = Quest->CurrentProgress;
+			Record.State = static_cast<uint8>(Quest->State);
+		}
+	});
+
+	return Snapshot;
+}
+
+bool UFarmSaveSubsystem::SaveGame(const FString& SlotName)
+{
+	const UWorld* World = GetWorld();
+	if (!World || World->GetNetMode() == NM_Client || SlotName.IsEmpty())
+	{
+		return false;
+	}
+
+	if (bAutosaveSuspended && SlotName == AutosaveSlot)
+	{
+		return false;
+	}
+
+	// A save taken mid-load would persist a half restored farm
+	if (bSaveInFlight || bLoadInFlight)
+	{
+		UE_LOG(LogTemp, Log, TEXT("UFarmSaveSubsystem::SaveGame: Skipping save to '%s', a save or load is in progress"), *SlotName);
+		return false;
+	}
+
+	// Saving to the slot on request replaces an autosave that could not be read
+	if (SlotName == AutosaveSlot)
+	{
+		bAutosaveUnreadable = false;
+	}
+
+	const double CaptureStartTime = FPlatformTime::Seconds();
+	TSharedRef<FFarmSaveSnapshot> Snapshot = CaptureSnapshot();
+	UE_LOG(LogTemp, Log, TEXT("UFarmSaveSubsystem::SaveGame: Captured %d plots, %d inventories in %.3f ms (%llu bytes)"),
+		Snapshot->Plots.Num(), Snapshot->Inventories.Num(), (FPlatformTime::Seconds() - CaptureStartTime) * 1000.0,
+		static_cast<uint64>(Snapshot->GetAllocatedSize()));
+
+	bSaveInFlight = true;
+
+	// Saving the autosave slot is a checkpoint: the snapshot already holds every journaled change,
+	// so a new epoch starts and the journal is truncated once the snapshot is safely on disk
+	const bool bCheckpoint = bEnableJournal && SlotName == AutosaveSlot;
+	if (bCheckpoint)
+	{
+		JournalEpoch = FMath::Max(JournalEpoch + 1, FDateTime::UtcNow().GetTicks());
+		Snapshot->JournalEpoch = JournalEpoch;
+		JournalDirtyPlots.Reset();
+		JournalRemovedPlots.Reset();
+		JournalDirtyInventories.Reset();
+	}
+
+	const FString FilePath = GetSlotFilePath(SlotName);
+	const FString JournalPath = bCheckpoint ? GetJournalFilePath(SlotName) : FString();
+	const FName Format = CompressionFormat;
+	TWeakObjectPtr<UFarmSaveSubsystem> WeakThis(this);
+
+	FilePipe.Launch(UE_SOURCE_LOCATION, [WeakThis, Snapshot, FilePath, JournalPath, SlotName, Format]()
+	{
+		const bool bSuccess = Snapshot->SaveToFile(FilePath, Format);
+		if (bSuccess && !JournalPath.IsEmpty())
+		{
+			IFileManager::Get().Delete(*JournalPath, false, false, true);
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, SlotName, bSuccess]()
+		{
+			if (UFarmSaveSubsystem* FarmSave = WeakThis.Get())
+			{
+				FarmSave->OnSaveWritten(SlotName, bSuccess);
+			}
+		});
+	});
+
+	return true;
+}
+
+void UFarmSaveSubsystem::OnSaveWritten(const FString& SlotName, bool bSuccess)
+{
+	bSaveInFlight = false;
+
+	if (!bSuccess)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UFarmSaveSubsystem::OnSaveWritten: Failed to save '%s'"), *SlotName);
+	}
+
+	OnSaveCompleted.Broadcast(SlotName, bSuccess);
+}
+
+bool UFarmSaveSubsystem::LoadGame(const FString& SlotName)
+{
+	const UWorld* World = GetWorld();
+	if (!World || World->GetNetMode() == NM_Client || SlotName.IsEmpty() || bLoadInFlight)
+	{
+		return false;
+	}
+
+	bLoadInFlight = true;
+	LoadingSlot = SlotName;
+	LoadStartTime = FPlatformTime::Seconds();
+
+	// Plots are restored nearest this point first, so the area around the player is ready soonest
+	FVector FocusLocation = FVector::ZeroVector;
+	if (const APlayerController* PlayerController = World->GetFirstPlayerController())
+	{
+		if (const APawn* Pawn = PlayerController->GetPawn())
+		{
+			FocusLocation = Pawn->GetActorLocation();
+		}
+	}
+
+	const FString FilePath = GetSlotFilePath(SlotName);
+	const FString JournalPath = bEnableJournal && SlotName == AutosaveSlot ? GetJournalFilePath(SlotName) : FString();
+	TWeakObjectPtr<UFarmSaveSubsystem> WeakThis(this);
+
+	// Journal appends still queued from this session must land before the journal is read
+	PendingLoadTask = FilePipe.Launch(UE_SOURCE_LOCATION, [WeakThis, FilePath, JournalPath, SlotName, FocusLocation]()
+	{
+		TSharedPtr<FFarmSaveSnapshot> Snapshot = MakeShared<FFarmSaveSnapshot>();
+		const bool bHasSnapshot = Snapshot->LoadFromFile(FilePath);
+
+		// A save that exists but cannot be read is neither replayed onto nor restored
+		const bool bUnreadable = !bHasSnapshot && IFileManager::Get().FileExists(*FilePath);
+
+		TArray<FFarmJournalBlock> JournalBlocks;
+		if (!JournalPath.IsEmpty() && !bUnreadable)
+		{
+			FFarmJournalBlock::ReadAllFromFile(JournalPath, JournalBlocks);
+		}
+
+		if (JournalBlocks.Num() > 0)
+		{
+			// A crash before the first checkpoint leaves only a journal, which replays onto the level as loaded
+			const int32 NumReplayed = Snapshot->ApplyJournal(JournalBlocks);
+			UE_LOG(LogTemp, Log, TEXT("UFarmSaveSubsystem::LoadGame: Replayed %d of %d journal blocks onto '%s'"), NumReplayed, JournalBlocks.Num(), *SlotName);
+		}
+
+		if (!bUnreadable && (bHasSnapshot || JournalBlocks.Num() > 0))
+		{
+			const FVector3f Focus(FocusLocation);
+			Snapshot->Plots.Sort([&Focus](const FFarmPlotSaveRecord& A, const FFarmPlotSaveRecord& B)
+			{
+				return FVector3f::DistSquared(A.Location, Focus) < FVector3f::DistSquared(B.Location, Focus);
+			});
+		}
+		else
+		{
+			Snapshot.Reset();
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, SlotName, Snapshot, bUnreadable]()
+		{
+			if (UFarmSaveSubsystem* FarmSave = WeakThis.Get())
+			{
+				if (bUnreadable && SlotName == FarmSave->AutosaveSlot)
+				{
+					UE_LOG(LogTemp, Error, TEXT("UFarmSaveSubsystem::LoadGame: The autosave '%s' cannot be read; autosaving and journaling stop until the game is saved to it"), *SlotName);
+					FarmSave->bAutosaveUnreadable = true;
+				}
+
+				FarmSave->OnSaveRead(SlotName, Snapshot);
+			}
+		});
+	});
+
+	return true;
+}
+
+void UFarmSaveSubsystem::OnSaveRead(const FString& SlotName, TSharedPtr<FFarmSaveSnapshot> Snapshot)
+{
+	if (!Snapshot.IsValid())
+	{
+		UE_LOG(LogTemp, Log, TEXT("UFarmSaveSubsystem::OnSaveRead: No save to load in '%s'"), *SlotName);
+		FinishLoad(false);
+		return;
+	}
+
+	LoadingSnapshot = Snapshot;
+
+	TArray<FSoftObjectPath> AssetsToLoad;
+	AssetsToLoad.Reserve(Snapshot->AssetPalette.Num() + Snapshot->Quests.Num());
+	AssetsToLoad.Append(Snapshot->AssetPalette);
+
+	for (const FFarmInventorySaveRecord& Inventory : Snapshot->Inventories)
+	{
+		for (int32 SlotIndex = 0; SlotIndex < Inventory.Slots.Num(); ++SlotIndex)
+		{
+			if (!Inventory.Slots.IsSlotEmpty(SlotIndex))
+			{
+				AssetsToLoad.AddUnique(Inventory.Slots.GetSlotItemPath(SlotIndex));
+			}
+		}
+	}
+
+	for (const FFarmQuestSaveRecord& Quest : Snapshot->Quests)
+	{
+		AssetsToLoad.Add(Quest.Quest);
+	}
+
+	AssetsToLoad.RemoveAll([](const FSoftObjectPath& Path) { return Path.IsNull(); });
+
+	if (AssetsToLoad.Num() == 0)
+	{
+		BeginRestore();
+		return;
+	}
+
+	TWeakObjectPtr<UFarmSaveSubsystem> WeakThis(this);
+	LoadingAssetsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		MoveTemp(AssetsToLoad),
+		FStreamableDelegate::CreateLambda([WeakThis]()
+		{
+			if (UFarmSaveSubsystem* FarmSave = WeakThis.Get())
+			{
+				FarmSave->BeginRestore();
+			}
+		}),
+		FStreamableManager::AsyncLoadHighPriority
+	);
+}
+
+void UFarmSaveSubsystem::BeginRestore()
+{
+	UWorld* World = GetWorld();
+	if (!LoadingSnapshot.IsValid() || !World)
+	{
+		FinishLoad(false);
+		return;
+	}
+
+	const FFarmSaveSnapshot& Snapshot = *LoadingSnapshot;
+
+	// Level-placed plots are restored in place; plots placed at runtime are replaced by the saved ones
+	UnmatchedLevelPlots.Reset();
+	TArray<ASoilPlot*> RuntimePlots;
+	for (const TWeakObjectPtr<ASoilPlot>& WeakPlot : Plots)
+	{
+		ASoilPlot* Plot = WeakPlot.Get();
+		if (!Plot || !Plot->ShouldReplicateFarmState())
+		{
+			continue;
+		}
+
+		if (Plot->IsNetStartupActor())
+		{
+			UnmatchedLevelPlots.Add(GetLevelPlotKey(Plot->GetActorLocation()), Plot);
+		}
+		else
+		{
+			RuntimePlots.Add(Plot);
+		}
+	}
+
+	for (ASoilPlot* Plot : RuntimePlots)
+	{
+		DestroyPlot(Plot);
+	}
+
+	// Destroying a level plot records it as removed again
+	RemovedLevelPlots.Reset();
+	for (const FVector3f& RemovedLocation : Snapshot.RemovedLevelPlots)
+	{
+		TWeakObjectPtr<ASoilPlot> LevelPlot;
+		if (UnmatchedLevelPlots.RemoveAndCopyValue(GetLevelPlotKey(FVector(RemovedLocation)), LevelPlot) && LevelPlot.IsValid())
+		{
+			DestroyPlot(LevelPlot.Get());
+		}
+		else
+		{
+			RemovedLevelPlots.Add(RemovedLocation);
+		}
+	}
+
+	TMap<FString, UInventoryComponent*> InventoriesByKey;
+	ForEachObjectOfClass(UInventoryComponent::StaticClass(), [this, World, &InventoriesByKey](UObject* Object)
+	{
+		UInventoryComponent* Inventory = static_cast<UInventoryComponent*>(Object);
+		if (!Inventory->IsTemplate() && Inventory->GetWorld() == World)
+		{
+			InventoriesByKey.Add(GetPersistentKey(Inventory->GetOwner()), Inventory);
+		}
+	});
+
+	for (const FFarmInventorySaveRecord& Record : Snapshot.Inventories)
+	{
+		if (UInventoryComponent* Inventory = InventoriesByKey.FindRef(Record.OwnerKey))
+		{
+			Inventory->RestorePackedSlots(Record.Slots);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("UFarmSaveSubsystem::BeginRestore: No inventory for '%s'"), *Record.OwnerKey);
+		}
+	}
+
+	TMap<FString, UQuestComponent*> QuestComponentsByKey;
+	ForEachObjectOfClass(UQuestComponent::StaticClass(), [this, World, &QuestComponentsByKey](UObject* Object)
+	{
+		UQuestComponent* QuestComp = static_cast<UQuestComponent*>(Object);
+		if (!QuestComp->IsTemplate() && QuestComp->GetWorld() == World)
+		{
+			QuestComponentsByKey.Add(GetPersistentKey(QuestComp->GetOwner()), QuestComp);
+		}
+	});
+
+	for (const FFarmQuestSaveRecord& Record : Snapshot.Quests)
+	{
+		UQuestComponent* QuestComp = QuestComponentsByKey.FindRef(Record.OwnerKey);
+		UQuest* Quest = Cast<UQuest>(Record.Quest.ResolveObject());
+		if (QuestComp && Quest)
+		{
+			QuestComp->RestoreQuest(Quest, Record.Progress, static_cast<EQuestState>(Record.State));
+		}
+	}
+
+	NextPlotToRestore = 0;
+	RestoreNextPlots();
+}
+
+void UFarmSaveSubsystem::RestoreNextPlots()
+{
+	UWorld* World = GetWorld();
+	if (!LoadingSnapshot.IsValid() || !World)
+	{
+		FinishLoad(false);
+		return;
+	}
+
+	const FFarmSaveSnapshot& Snapshot = *LoadingSnapshot;
+	const double Deadline = FPlatformTime::Seconds() + RestoreBudgetMs / 1000.0;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	while (NextPlotToRestore < Snapshot.Plots.Num())
+	{
+		const FFarmPlotSaveRecord& Record = Snapshot.Plots[NextPlotToRestore++];
+		const FVector Location(Record.Location);
+
+		ASoilPlot* Plot = nullptr;
+		TWeakObjectPtr<ASoilPlot> LevelPlot;
+		if (UnmatchedLevelPlots.RemoveAndCopyValue(GetLevelPlotKey(Location), LevelPlot))
+		{
+			Plot = LevelPlot.Get();
+		}
+
+		if (!Plot)
+		{
+			UClass* PlotClass = Cast<UClass>(Snapshot.GetPaletteAsset(Record.PlotClass).ResolveObject());
+			if (PlotClass && PlotClass->IsChildOf(ASoilPlot::StaticClass()))
+			{
+				LLM_SCOPE_BYTAG(Farm_Plots);
+				FARM_INC_COUNTER(STAT_FarmActorsSpawned, ActorSpawnCount);
+				FARM_HITCH_SCOPE(Spawn, PlotClass);
+				Plot = World->SpawnActor<ASoilPlot>(PlotClass, Location, FRotator(0.0f, Record.Yaw, 0.0f), SpawnParams);
+			}
+			else
+			{
+				UE_LOG(LogTemp, Warning, TEXT("UFarmSaveSubsystem::RestoreNextPlots: Unknown plot class '%s'"), *Snapshot.GetPaletteAsset(Record.PlotClass).ToString());
+			}
+		}
+
+		if (Plot)
+		{
+			Plot->ApplySaveRecord(Record, Snapshot);
+		}
+
+		if (FPlatformTime::Seconds() >= Deadline)
+		{
+			break;
+		}
+	}
+
+	if (NextPlotToRestore < Snapshot.Plots.Num())
+	{
+		World->GetTimerManager().SetTimerForNextTick(this, &UFarmSaveSubsystem::RestoreNextPlots);
+		return;
+	}
+
+	FinishLoad(true);
+}
+
+void UFarmSaveSubsystem::FinishLoad(bool bSuccess)
+{
+	if (bSuccess && LoadingSnapshot.IsValid())
+	{
+		UE_LOG(LogTemp, Log, TEXT("UFarmSaveSubsystem::FinishLoad: Restored %d plots from '%s' in %.1f ms"),
+			LoadingSnapshot->Plots.Num(), *LoadingSlot, (FPlatformTime::Seconds() - LoadStartTime) * 1000.0);
+	}
+
+	// Restored plots hold their own references to the loaded assets now
+	if (LoadingAssetsHandle.IsValid())
+	{
+		LoadingAssetsHandle->ReleaseHandle();
+		LoadingAssetsHandle.Reset();
+	}
+
+	LoadingSnapshot.Reset();
+	UnmatchedLevelPlots.Reset();
+	NextPlotToRestore = 0;
+	bLoadInFlight = false;
+
+	const FString SlotName = MoveTemp(LoadingSlot);
+	LoadingSlot.Reset();
+
+	// Fold the replayed journal, and anything changed while plots were streaming in, into a new checkpoint.
+	// A failed load keeps whatever is on disk.
+	if (bSuccess && bEnableJournal && SlotName == AutosaveSlot)
+	{
+		SaveGame(AutosaveSlot);
+	}
+
+	OnLoadCompleted.Broadcast(SlotName, bSuccess);
+}
+
+void UFarmSaveSubsystem::Autosave()
+{
+	if (bAutosaveUnreadable)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UFarmSaveSubsystem::Autosave: Skipping autosave, '%s' could not be read and would be overwritten"), *AutosaveSlot);
+		return;
+	}
+
+	SaveGame(AutosaveSlot);
+}
@@ -0,0 +1,276 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tasks/Pipe.h"
+#include "Tasks/Task.h"
+#include "UFarmSaveSubsystem.generated.h"
+
+class ASoilPlot;
+class UInventoryComponent;
+struct FFarmSaveSnapshot;
+struct FStreamableHandle;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnFarmSaveCompleted, const FString&, SlotName, bool, bSuccess);
+
+/**
+ * Saves and loads the farm without stalling the game thread.
+ * Saving captures a compact snapshot of every plot, persistent inventory and quest on the game thread;
+ * serialization, compression and the file write run on a worker.
+ * Loading reads and decompresses on a worker, loads referenced assets asynchronously, then restores plots
+ * nearest the player first over several frames under a per-frame time budget.
+ * Between saves, player-driven changes are appended to a journal next to the autosave about once a second.
+ * Journal cost follows activity rather than farm size; each autosave is a checkpoint that folds the journal
+ * into a fresh snapshot and truncates it. Loading the autosave replays the journal on top of it.
+ * Only runs on the authority; clients receive restored state through farm replication.
+ */
+UCLASS()
+class FUNGIFIELDS_API UFarmSaveSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem interface
+	virtual void Deinitialize() override;
+
+	// UWorldSubsystem interface
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/**
+	 * Get the farm save subsystem for the world of the given object.
+	 * @param WorldContextObject Any object with a valid world
+	 * @return The subsystem, or nullptr if there is no world
+	 */
+	static UFarmSaveSubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	 * Track a plot for saving. Called by plots as they begin play.
+	 * @param Plot The plot
+	 */
+	void RegisterPlot(ASoilPlot* Plot);
+
+	/**
+	 * Stop tracking a plot. Destroyed level-placed plots are remembered so loading removes them again.
+	 * @param Plot The plot leaving play
+	 * @param EndPlayReason Why the plot is leaving play
+	 */
+	void UnregisterPlot(ASoilPlot* Plot, EEndPlayReason::Type EndPlayReason);
+
+	/**
+	 * Record that a plot was changed by a player action: tilled, watered, planted, harvested or placed.
+	 * The plot's state is sampled at the next journal flush. Gradual changes such as growth and evaporation
+	 * are not journaled and are caught up by the next checkpoint.
+	 * @param Plot The changed plot
+	 */
+	void JournalPlot(ASoilPlot* Plot);
+
+	/**
+	 * Record that an inventory's contents changed. Its contents are sampled at the next journal flush.
+	 * @param Inventory The changed inventory
+	 */
+	void JournalInventory(UInventoryComponent* Inventory);
+
+	/**
+	 * Save the farm to a slot in the background. Skipped while another save or a load is in progress.
+	 * @param SlotName Save slot name
+	 * @return True if the save was started
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Farm Save")
+	bool SaveGame(const FString& SlotName);
+
+	/**
+	 * Load the farm from a slot in the background. Skipped while another load is in progress.
+	 * If the autosave slot cannot be read, it is not autosaved over until SaveGame is called for it.
+	 * @param SlotName Save slot name
+	 * @return True if the load was started
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Farm Save")
+	bool LoadGame(const FString& SlotName);
+
+	/**
+	 * Check whether a load is still reading, loading assets or restoring plots.
+	 * @return True while a load is in progress
+	 */
+	UFUNCTION(BlueprintPure, Category = "Farm Save")
+	bool IsLoading() const { return bLoadInFlight; }
+
+	/**
+	 * Get the persistent key that identifies an inventory or quest owner across sessions.
+	 * @param Owner The owning actor
+	 * @return "Player<N>" for player pawns, the actor name for level-placed actors, or an empty string if the owner is not persistent
+	 */
+	FString GetPersistentKey(const AActor* Owner) const;
+
+	/**
+	 * Get every plot currently tracked for saving.
+	 * @return Tracked plots; entries may be stale while a plot is being destroyed
+	 */
+	TConstArrayView<TWeakObjectPtr<ASoilPlot>> GetPlots() const { return Plots; }
+
+	/**
+	 * Find a tracked plot by location. Scans every plot, so keep it off per-frame paths.
+	 * @param Location Plot location, matched after rounding to whole units
+	 * @return The plot, or nullptr if none is at that location
+	 */
+	ASoilPlot* FindPlotAt(const FVector& Location) const;
+
+	/**
+	 * Hash the current simulated state of the farm: every plot, persistent inventory and quest.
+	 * Captures a full snapshot, so it costs about as much as starting a save. Game thread only.
+	 * @return 64-bit state hash, equal for equal farms regardless of plot registration order
+	 */
+	uint64 ComputeStateHash() const;
+
+	/**
+	 * Stop or resume autosaves and journaling, e.g. while replaying a recording that must not
+	 * overwrite the player's farm. Explicit saves to other slots still work.
+	 * Suspending before the world begins play also skips loading the autosave and starting the autosave timers.
+	 * @param bSuspended Whether the autosave slot should be left untouched
+	 */
+	void SetAutosaveSuspended(bool bSuspended) { bAutosaveSuspended = bSuspended; }
+
+	/**
+	 * Get the file a save slot is written to.
+	 * @param SlotName Save slot name
+	 * @return Absolute file path
+	 */
+	static FString GetSlotFilePath(const FString& SlotName);
+
+	/**
+	 * Get the journal file that accompanies a save slot.
+	 * @param SlotName Save slot name
+	 * @return Absolute file path
+	 */
+	static FString GetJournalFilePath(const FString& SlotName);
+
+	/** Broadcast on the game thread when a save has been written or has failed */
+	UPROPERTY(BlueprintAssignable, Category = "Farm Save")
+	FOnFarmSaveCompleted OnSaveCompleted;
+
+	/** Broadcast once every plot of a load has been restored, or when a load fails */
+	UPROPERTY(BlueprintAssignable, Category = "Farm Save")
+	FOnFarmSaveCompleted OnLoadCompleted;
+
+protected:
+	/** Capture the current farm state. Game thread only. */
+	TSharedRef<FFarmSaveSnapshot> CaptureSnapshot() const;
+
+	/** Game thread: the worker finished writing a save */
+	void OnSaveWritten(const FString& SlotName, bool bSuccess);
+
+	/** Game thread: the worker finished reading a save; start loading the assets it references */
+	void OnSaveRead(const FString& SlotName, TSharedPtr<FFarmSaveSnapshot> Snapshot);
+
+	/** Game thread: assets are loaded; restore inventories and quests, then start streaming plots */
+	void BeginRestore();
+
+	/** Restore plots from the load queue until the frame budget is spent */
+	void RestoreNextPlots();
+
+	/** End the current load and notify listeners */
+	void FinishLoad(bool bSuccess);
+
+	/** Timer callback for autosaving */
+	void Autosave();
+
+	/** Append changes recorded since the last flush to the autosave journal */
+	void FlushJournal();
+
+	/** Whether changes are currently being journaled */
+	bool IsJournaling() const;
+
+private:
+	/** All live plots, densely packed for fast capture */
+	TArray<TWeakObjectPtr<ASoilPlot>> Plots;
+
+	/** Index of each plot in Plots */
+	TMap<TWeakObjectPtr<ASoilPlot>, int32> PlotIndices;
+
+	/** Locations of level-placed plots destroyed this session or by a loaded save */
+	TArray<FVector3f> RemovedLevelPlots;
+
+	/** Serializes save writes and journal appends, so a checkpoint never truncates blocks appended after it */
+	UE::Tasks::FPipe FilePipe{ TEXT("FarmSaveFiles") };
+
+	/** Save currently being read */
+	UE::Tasks::FTask PendingLoadTask;
+
+	/** Whether a save is being written */
+	bool bSaveInFlight = false;
+
+	/** Whether a load is in progress */
+	bool bLoadInFlight = false;
+
+	/** Whether autosaves and journaling are suspended */
+	bool bAutosaveSuspended = false;
+
+	/** Whether the autosave slot holds a save that could not be read; it is not autosaved over until saved to on request */
+	bool bAutosaveUnreadable = false;
+
+	/** Slot of the load in progress */
+	FString LoadingSlot;
+
+	/** Save being restored, plots sorted nearest the player first */
+	TSharedPtr<FFarmSaveSnapshot> LoadingSnapshot;
+
+	/** Next plot record of LoadingSnapshot to restore */
+	int32 NextPlotToRestore = 0;
+
+	/** Level-placed plots not yet matched to a record, by rounded location */
+	TMap<FIntVector, TWeakObjectPtr<ASoilPlot>> UnmatchedLevelPlots;
+
+	/** Keeps assets referenced by the loading save resident until it is restored */
+	TSharedPtr<FStreamableHandle> LoadingAssetsHandle;
+
+	/** Time the load in progress was requested */
+	double LoadStartTime = 0.0;
+
+	/** Autosave timer */
+	FTimerHandle AutosaveTimerHandle;
+
+	/** Journal flush timer */
+	FTimerHandle JournalFlushTimerHandle;
+
+	/** Epoch stamped on journal blocks; a new epoch starts at every checkpoint */
+	int64 JournalEpoch = 0;
+
+	/** Plots changed by player actions since the last flush */
+	TSet<TWeakObjectPtr<ASoilPlot>> JournalDirtyPlots;
+
+	/** Locations of plots removed since the last flush */
+	TArray<FVector3f> JournalRemovedPlots;
+
+	/** Inventories changed since the last flush */
+	TSet<TWeakObjectPtr<UInventoryComponent>> JournalDirtyInventories;
+
+	/** Seconds between autosaves; 0 disables autosaving. With journaling enabled, autosaves are checkpoints and can be infrequent */
+	UPROPERTY(EditDefaultsOnly, Category = "Farm Save Settings", meta = (ClampMin = "0.0"))
+	float AutosaveInterval = 300.0f;
+
+	/** Slot written by autosaves */
+	UPROPERTY(EditDefaultsOnly, Category = "Farm Save Settings")
+	FString AutosaveSlot = TEXT("Autosave");
+
+	/**
+	 * Whether to load the autosave slot when play begins. When not, the autosave is copied and its journal
+	 * moved to .prev files before this session autosaves or journals anything.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Farm Save Settings")
+	bool bLoadAutosaveOnBeginPlay = true;
+
+	/** Whether to journal changes between autosaves */
+	UPROPERTY(EditDefaultsOnly, Category = "Farm Save Settings")
+	bool bEnableJournal = true;
+
+	/** Seconds between journal flushes; the most play a crash can lose */
+	UPROPERTY(EditDefaultsOnly, Category = "Farm Save Settings", meta = (ClampMin = "0.1"))
+	float JournalFlushInterval = 1.0f;
+
+	/** Compression format for save files */
+	UPROPERTY(EditDefaultsOnly, Category = "Farm Save Settings")
+	FName CompressionFormat = NAME_Oodle;
+
+	/** Game thread time spent restoring plots per frame during a load (milliseconds) */
+	UPROPERTY(EditDefaultsOnly, Category = "Farm Save Settings", meta = (ClampMin = "0.1"))
+	float RestoreBudgetMs = 2.0f;
+};
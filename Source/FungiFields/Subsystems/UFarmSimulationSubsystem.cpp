@@ -0,0 +1,724 @@
+#include "UFarmSimulationSubsystem.h"
+#include "../FungiFieldsStats.h"
+#include "FFarmSimTimings.h"
+#include "UCropManagerSubsystem.h"
+#include "UFarmSaveSubsystem.h"
+#include "../Actors/ASoilPlot.h"
+#include "../Components/InventoryComponent.h"
+#include "../Components/UFarmingComponent.h"
+#include "../Components/UPlacementComponent.h"
+#include "../Components/USoilComponent.h"
+#include "../Data/FFarmSaveData.h"
+#include "../Data/UItemDataAsset.h"
+#include "../Inventory/FInventoryCommand.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMisc.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectHash.h"
+
+namespace
+{
+	FAutoConsoleCommandWithWorldAndArgs FarmSimDeterministicCommand(
+		TEXT("Farm.Sim.Deterministic"),
+		TEXT("Run the farm simulation in fixed steps with seeded random streams. Usage: Farm.Sim.Deterministic [Seed]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UFarmSimulationSubsystem* Simulation = UFarmSimulationSubsystem::Get(World))
+			{
+				Simulation->EnableDeterministicMode(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1);
+			}
+		}));
+
+	FAutoConsoleCommandWithWorldAndArgs FarmRecordStartCommand(
+		TEXT("Farm.Record.Start"),
+		TEXT("Save the farm and record player actions. Usage: Farm.Record.Start <Name>"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UFarmSimulationSubsystem* Simulation = UFarmSimulationSubsystem::Get(World);
+			if (Simulation && Args.Num() > 0)
+			{
+				Simulation->StartRecording(Args[0]);
+			}
+		}));
+
+	FAutoConsoleCommandWithWorldAndArgs FarmRecordStopCommand(
+		TEXT("Farm.Record.Stop"),
+		TEXT("Stop recording and write the recording to Saved/FarmRecordings"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UFarmSimulationSubsystem* Simulation = UFarmSimulationSubsystem::Get(World))
+			{
+				Simulation->StopRecording();
+			}
+		}));
+
+	FAutoConsoleCommandWithWorldAndArgs FarmReplayCommand(
+		TEXT("Farm.Replay"),
+		TEXT("Replay a recording from its start save and compare state hashes. Usage: Farm.Replay <Name>"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UFarmSimulationSubsystem* Simulation = UFarmSimulationSubsystem::Get(World);
+			if (Simulation && Args.Num() > 0)
+			{
+				Simulation->StartReplay(Args[0], false);
+			}
+		}));
+
+	FAutoConsoleCommandWithWorldAndArgs FarmSimHashCommand(
+		TEXT("Farm.Sim.Hash"),
+		TEXT("Log the current farm state hash"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (const UFarmSaveSubsystem* FarmSave = UFarmSaveSubsystem::Get(World))
+			{
+				UE_LOG(LogTemp, Display, TEXT("Farm state hash: %016llx"), FarmSave->ComputeStateHash());
+			}
+		}));
+}
+
+void UFarmSimulationSubsystem::Deinitialize()
+{
+	if (bRecording)
+	{
+		StopRecording();
+	}
+
+	ReplayPhase = EReplayPhase::None;
+	ReplayOwners.Empty();
+
+	Super::Deinitialize();
+}
+
+void UFarmSimulationSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (!InWorld.IsGameWorld() || InWorld.GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	int32 Seed = DefaultSeed;
+	if (FParse::Value(FCommandLine::Get(), TEXT("FarmSeed="), Seed) || bDeterministicByDefault)
+	{
+		EnableDeterministicMode(Seed);
+	}
+
+	FString ReplayName;
+	if (FParse::Value(FCommandLine::Get(), TEXT("FarmReplay="), ReplayName))
+	{
+		StartReplay(ReplayName, true);
+	}
+}
+
+UFarmSimulationSubsystem* UFarmSimulationSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject)
+	{
+		return nullptr;
+	}
+
+	const UWorld* World = WorldContextObject->GetWorld();
+	return World ? World->GetSubsystem<UFarmSimulationSubsystem>() : nullptr;
+}
+
+bool UFarmSimulationSubsystem::IsDeterministicWorld(const UObject* WorldContextObject)
+{
+	const UFarmSimulationSubsystem* Simulation = Get(WorldContextObject);
+	return Simulation && Simulation->IsDeterministic();
+}
+
+TStatId UFarmSimulationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFarmSimulationSubsystem, STATGROUP_Tickables);
+}
+
+void UFarmSimulationSubsystem::EnableDeterministicMode(int32 Seed)
+{
+	const UWorld* World = GetWorld();
+	if (!World || World->GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	// Growth and evaporation timers already running stop themselves when they next fire
+	bDeterministic = true;
+	SimulationSeed = Seed;
+	StepAccumulator = 0.0f;
+	ResetPlotRandomStreams();
+
+	UE_LOG(LogTemp, Log, TEXT("UFarmSimulationSubsystem::EnableDeterministicMode: Fixed %.2f s steps, seed %d"), FixedStepSeconds, SimulationSeed);
+}
+
+int32 UFarmSimulationSubsystem::GetPlotSeed(const FVector& PlotLocation) const
+{
+	if (!bDeterministic)
+	{
+		return FMath::Rand();
+	}
+
+	const FIntVector LocationKey = FFarmPlotSaveRecord::MakeLocationKey(FVector3f(PlotLocation));
+	return static_cast<int32>(HashCombine(static_cast<uint32>(SimulationSeed), GetTypeHash(LocationKey)));
+}
+
+void UFarmSimulationSubsystem::Tick(float DeltaTime)
+{
+	if (!bDeterministic)
+	{
+		return;
+	}
+
+	UFarmSaveSubsystem* FarmSave = UFarmSaveSubsystem::Get(this);
+
+	switch (ReplayPhase)
+	{
+	case EReplayPhase::WaitingToLoad:
+		// A load started at begin play has to finish before the recording's start save can be loaded
+		if (FarmSave && !FarmSave->IsLoading())
+		{
+			if (FarmSave->LoadGame(Recording.StartSlot))
+			{
+				ReplayPhase = EReplayPhase::Loading;
+			}
+			else
+			{
+				UE_LOG(LogTemp, Error, TEXT("UFarmSimulationSubsystem::Tick: Failed to load start slot '%s' of recording '%s'"), *Recording.StartSlot, *RecordingName);
+				FinishReplay(false);
+			}
+		}
+		return;
+
+	case EReplayPhase::Loading:
+		return;
+
+	case EReplayPhase::Running:
+		for (int32 Step = 0; Step < MaxReplayStepsPerFrame && StepIndex < Recording.StepCount; ++Step)
+		{
+			RunStep();
+		}
+		if (StepIndex >= Recording.StepCount)
+		{
+			FinishReplay(true);
+		}
+		return;
+
+	default:
+		break;
+	}
+
+	// Plots restored over several frames would otherwise step at different times
+	if (FarmSave && FarmSave->IsLoading())
+	{
+		return;
+	}
+
+	StepAccumulator += DeltaTime;
+
+	int32 StepsThisFrame = 0;
+	while (StepAccumulator >= FixedStepSeconds && StepsThisFrame < MaxStepsPerFrame)
+	{
+		StepAccumulator -= FixedStepSeconds;
+		RunStep();
+		++StepsThisFrame;
+	}
+
+	StepAccumulator = FMath::Min(StepAccumulator, FixedStepSeconds);
+}
+
+void UFarmSimulationSubsystem::RunStep()
+{
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmSimulationStep, "UFarmSimulationSubsystem::RunStep");
+
+	if (ReplayPhase == EReplayPhase::Running)
+	{
+		ApplyReplayActions();
+	}
+
+	// Growth reads the water left after the previous step's evaporation, in both live play and replay
+	if (UCropManagerSubsystem* CropManager = GetWorld()->GetSubsystem<UCropManagerSubsystem>())
+	{
+		CropManager->StepGrowth(FixedStepSeconds);
+	}
+
+	UFarmSaveSubsystem* FarmSave = UFarmSaveSubsystem::Get(this);
+	if (FarmSave)
+	{
+		FScopedFarmSimTiming EvaporationTiming(&FFarmSimTimings::EvaporationCycles);
+
+		for (const TWeakObjectPtr<ASoilPlot>& WeakPlot : FarmSave->GetPlots())
+		{
+			ASoilPlot* Plot = WeakPlot.Get();
+			USoilComponent* SoilComp = Plot ? Plot->GetSoilComponent() : nullptr;
+			if (SoilComp && Plot->ShouldReplicateFarmState())
+			{
+				SoilComp->StepEvaporation(FixedStepSeconds);
+			}
+		}
+	}
+
+	++StepIndex;
+
+	if (!FarmSave)
+	{
+		return;
+	}
+
+	if (StepIndex % FMath::Max(Recording.HashInterval, 1) != 0)
+	{
+		return;
+	}
+
+	if (bRecording && bHashWhileRecording)
+	{
+		Recording.StepHashes.Add(FarmSave->ComputeStateHash());
+	}
+	else if (ReplayPhase == EReplayPhase::Running)
+	{
+		const int32 HashIndex = ReplayHashes.Add(FarmSave->ComputeStateHash());
+		if (FirstMismatchStep == INDEX_NONE && Recording.StepHashes.IsValidIndex(HashIndex)
+			&& Recording.StepHashes[HashIndex] != ReplayHashes[HashIndex])
+		{
+			FirstMismatchStep = StepIndex;
+			UE_LOG(LogTemp, Warning, TEXT("UFarmSimulationSubsystem::RunStep: Replay of '%s' diverged by step %d"), *RecordingName, StepIndex);
+		}
+	}
+}
+
+bool UFarmSimulationSubsystem::StartRecording(const FString& InRecordingName)
+{
+	const UWorld* World = GetWorld();
+	UFarmSaveSubsystem* FarmSave = UFarmSaveSubsystem::Get(this);
+	if (!World || World->GetNetMode() == NM_Client || !FarmSave || InRecordingName.IsEmpty())
+	{
+		return false;
+	}
+
+	if (bRecording || IsReplaying() || FarmSave->IsLoading())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UFarmSimulationSubsystem::StartRecording: Busy recording, replaying or loading"));
+		return false;
+	}
+
+	if (!bDeterministic)
+	{
+		EnableDeterministicMode(DefaultSeed);
+	}
+
+	Recording = FFarmSimRecording();
+	Recording.StartSlot = TEXT("FarmRecording_") + InRecordingName;
+	Recording.Seed = SimulationSeed;
+	Recording.FixedStepSeconds = FixedStepSeconds;
+	Recording.HashInterval = HashIntervalSteps;
+
+	// The snapshot is captured before SaveGame returns, so it is exactly the state at step 0
+	if (!FarmSave->SaveGame(Recording.StartSlot))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UFarmSimulationSubsystem::StartRecording: Could not save start slot '%s'"), *Recording.StartSlot);
+		return false;
+	}
+
+	RecordingName = InRecordingName;
+	StepIndex = 0;
+	StepAccumulator = 0.0f;
+	ResetPlotRandomStreams();
+	bRecording = true;
+
+	UE_LOG(LogTemp, Log, TEXT("UFarmSimulationSubsystem::StartRecording: Recording '%s'"), *RecordingName);
+	return true;
+}
+
+bool UFarmSimulationSubsystem::StopRecording()
+{
+	if (!bRecording)
+	{
+		return false;
+	}
+
+	bRecording = false;
+	Recording.StepCount = StepIndex;
+
+	const FString FilePath = FFarmSimRecording::GetFilePath(RecordingName);
+	const bool bWritten = Recording.SaveToFile(FilePath);
+	if (bWritten)
+	{
+		UE_LOG(LogTemp, Log, TEXT("UFarmSimulationSubsystem::StopRecording: Wrote %d steps and %d actions to %s"),
+			Recording.StepCount, Recording.Actions.Num(), *FilePath);
+	}
+
+	Recording = FFarmSimRecording();
+	return bWritten;
+}
+
+bool UFarmSimulationSubsystem::StartReplay(const FString& InRecordingName, bool bExitWhenDone)
+{
+	const UWorld* World = GetWorld();
+	UFarmSaveSubsystem* FarmSave = UFarmSaveSubsystem::Get(this);
+	if (!World || World->GetNetMode() == NM_Client || !FarmSave)
+	{
+		return false;
+	}
+
+	if (bRecording || IsReplaying())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UFarmSimulationSubsystem::StartReplay: Busy recording or replaying"));
+		return false;
+	}
+
+	FFarmSimRecording LoadedRecording;
+	if (!LoadedRecording.LoadFromFile(FFarmSimRecording::GetFilePath(InRecordingName)))
+	{
+		UE_LOG(LogTemp, Error, TEXT("UFarmSimulationSubsystem::StartReplay: No recording named '%s'"), *InRecordingName);
+		if (bExitWhenDone)
+		{
+			FPlatformMisc::RequestExitWithStatus(false, 1);
+		}
+		return false;
+	}
+
+	Recording = MoveTemp(LoadedRecording);
+	RecordingName = InRecordingName;
+	bExitWhenReplayDone = bExitWhenDone;
+	FixedStepSeconds = Recording.FixedStepSeconds;
+	EnableDeterministicMode(Recording.Seed);
+
+	FarmSave->SetAutosaveSuspended(true);
+	FarmSave->OnLoadCompleted.AddUniqueDynamic(this, &UFarmSimulationSubsystem::OnReplayLoadCompleted);
+	ReplayPhase = EReplayPhase::WaitingToLoad;
+
+	UE_LOG(LogTemp, Log, TEXT("UFarmSimulationSubsystem::StartReplay: Replaying '%s' (%d steps, %d actions)"),
+		*RecordingName, Recording.StepCount, Recording.Actions.Num());
+	return true;
+}
+
+void UFarmSimulationSubsystem::OnReplayLoadCompleted(const FString& SlotName, bool bSuccess)
+{
+	if (ReplayPhase != EReplayPhase::Loading || SlotName != Recording.StartSlot)
+	{
+		return;
+	}
+
+	if (!bSuccess)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UFarmSimulationSubsystem::OnReplayLoadCompleted: Failed to restore '%s'"), *SlotName);
+		FinishReplay(false);
+		return;
+	}
+
+	StepIndex = 0;
+	NextReplayAction = 0;
+	FirstMismatchStep = INDEX_NONE;
+	ReplayHashes.Reset(Recording.StepHashes.Num());
+	ReplayOwners.Reset();
+	ResetPlotRandomStreams();
+	ReplayStartTime = FPlatformTime::Seconds();
+	ReplayPhase = EReplayPhase::Running;
+}
+
+void UFarmSimulationSubsystem::FinishReplay(bool bLoaded)
+{
+	if (UFarmSaveSubsystem* FarmSave = UFarmSaveSubsystem::Get(this))
+	{
+		FarmSave->OnLoadCompleted.RemoveDynamic(this, &UFarmSimulationSubsystem::OnReplayLoadCompleted);
+		FarmSave->SetAutosaveSuspended(false);
+	}
+
+	const bool bCompared = Recording.StepHashes.Num() > 0;
+	const bool bMatched = bLoaded && FirstMismatchStep == INDEX_NONE && (!bCompared || ReplayHashes.Num() == Recording.StepHashes.Num());
+
+	if (bLoaded)
+	{
+		FString Csv = TEXT("Step,Hash,RecordedHash\n");
+		for (int32 Index = 0; Index < ReplayHashes.Num(); ++Index)
+		{
+			const uint64 RecordedHash = Recording.StepHashes.IsValidIndex(Index) ? Recording.StepHashes[Index] : 0;
+			Csv += FString::Printf(TEXT("%d,%016llx,%016llx\n"), (Index + 1) * Recording.HashInterval, ReplayHashes[Index], RecordedHash);
+		}
+
+		const FString CsvPath = FPaths::GetPath(FFarmSimRecording::GetFilePath(RecordingName)) / RecordingName + TEXT("_replay.csv");
+		FFileHelper::SaveStringToFile(Csv, *CsvPath);
+
+		UE_LOG(LogTemp, Display, TEXT("UFarmSimulationSubsystem::FinishReplay: Replayed '%s': %d steps, %d actions in %.1f ms, last hash %016llx, %s"),
+			*RecordingName, StepIndex, NextReplayAction, (FPlatformTime::Seconds() - ReplayStartTime) * 1000.0,
+			ReplayHashes.Num() > 0 ? ReplayHashes.Last() : 0,
+			!bCompared ? TEXT("no recorded hashes to compare") : bMatched ? TEXT("identical to the recording") : TEXT("DIVERGED from the recording"));
+	}
+
+	ReplayPhase = EReplayPhase::None;
+	ReplayOwners.Reset();
+	Recording = FFarmSimRecording();
+
+	if (bExitWhenReplayDone)
+	{
+		FPlatformMisc::RequestExitWithStatus(false, bMatched ? 0 : 1);
+	}
+}
+
+void UFarmSimulationSubsystem::ApplyReplayActions()
+{
+	while (Recording.Actions.IsValidIndex(NextReplayAction) && Recording.Actions[NextReplayAction].Step <= StepIndex)
+	{
+		ApplyReplayAction(Recording.Actions[NextReplayAction]);
+		++NextReplayAction;
+	}
+}
+
+void UFarmSimulationSubsystem::ApplyReplayAction(const FFarmSimAction& Action)
+{
+	UFarmSaveSubsystem* FarmSave = UFarmSaveSubsystem::Get(this);
+	AActor* Owner = ResolveReplayOwner(Action.OwnerKey);
+	if (!FarmSave || !Owner)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UFarmSimulationSubsystem::ApplyReplayAction: No actor for '%s' at step %d"), *Action.OwnerKey, Action.Step);
+		return;
+	}
+
+	switch (Action.Type)
+	{
+	case EFarmSimActionType::FarmAction:
+	{
+		UFarmingComponent* FarmingComp = Owner->FindComponentByClass<UFarmingComponent>();
+		ASoilPlot* Plot = FarmSave->FindPlotAt(FVector(Action.Location));
+		if (FarmingComp && Plot)
+		{
+			FarmingComp->ReplayFarmAction(Plot, Action.SlotIndex, Action.bTargetCrop);
+		}
+		break;
+	}
+	case EFarmSimActionType::Place:
+	{
+		UPlacementComponent* PlacementComp = Owner->FindComponentByClass<UPlacementComponent>();
+		UItemDataAsset* Item = Cast<UItemDataAsset>(Action.Item.ResolveObject());
+		if (!Item)
+		{
+			Item = Cast<UItemDataAsset>(Action.Item.TryLoad());
+		}
+		if (PlacementComp && Item)
+		{
+			PlacementComp->ReplayPlacement(Item, FVector(Action.Location), FRotator(Action.Rotation), Action.SlotIndex);
+		}
+		break;
+	}
+	case EFarmSimActionType::Pickup:
+	{
+		UPlacementComponent* PlacementComp = Owner->FindComponentByClass<UPlacementComponent>();
+		ASoilPlot* Plot = FarmSave->FindPlotAt(FVector(Action.Location));
+		if (PlacementComp && Plot)
+		{
+			PlacementComp->PickupPlot(Plot);
+		}
+		break;
+	}
+	case EFarmSimActionType::Inventory:
+	{
+		UInventoryComponent* Inventory = Owner->FindComponentByClass<UInventoryComponent>();
+		if (!Inventory)
+		{
+			break;
+		}
+
+		switch (static_cast<EInventoryCommandType>(Action.CommandType))
+		{
+		case EInventoryCommandType::Move:
+			Inventory->MoveItemToSlot(Action.SlotIndex, Action.OtherSlotIndex);
+			break;
+		case EInventoryCommandType::Swap:
+			Inventory->SwapSlots(Action.SlotIndex, Action.OtherSlotIndex);
+			break;
+		case EInventoryCommandType::Remove:
+			Inventory->RemoveFromSlot(Action.SlotIndex, Action.Amount);
+			break;
+		case EInventoryCommandType::Transfer:
+		{
+			AActor* OtherOwner = ResolveReplayOwner(Action.OtherOwnerKey);
+			UInventoryComponent* OtherInventory = OtherOwner ? OtherOwner->FindComponentByClass<UInventoryComponent>() : nullptr;
+			Inventory->TransferSlotTo(Action.SlotIndex, OtherInventory);
+			break;
+		}
+		default:
+			break;
+		}
+		break;
+	}
+	case EFarmSimActionType::AddItem:
+	{
+		UInventoryComponent* Inventory = Owner->FindComponentByClass<UInventoryComponent>();
+		UItemDataAsset* Item = Cast<UItemDataAsset>(Action.Item.ResolveObject());
+		if (!Item)
+		{
+			Item = Cast<UItemDataAsset>(Action.Item.TryLoad());
+		}
+		if (Inventory && Item)
+		{
+			Inventory->TryAddItem(Item, Action.Amount);
+		}
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+AActor* UFarmSimulationSubsystem::ResolveReplayOwner(const FString& OwnerKey)
+{
+	if (const TWeakObjectPtr<AActor>* CachedOwner = ReplayOwners.Find(OwnerKey))
+	{
+		if (AActor* Owner = CachedOwner->Get())
+		{
+			return Owner;
+		}
+	}
+
+	const UWorld* World = GetWorld();
+	const UFarmSaveSubsystem* FarmSave = UFarmSaveSubsystem::Get(this);
+	if (!World || !FarmSave || OwnerKey.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	AActor* Found = nullptr;
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It && !Found; ++It)
+	{
+		APawn* Pawn = It->Get() ? It->Get()->GetPawn() : nullptr;
+		if (Pawn && FarmSave->GetPersistentKey(Pawn) == OwnerKey)
+		{
+			Found = Pawn;
+		}
+	}
+
+	if (!Found)
+	{
+		ForEachObjectOfClass(UInventoryComponent::StaticClass(), [World, FarmSave, &OwnerKey, &Found](UObject* Object)
+		{
+			const UInventoryComponent* Inventory = static_cast<UInventoryComponent*>(Object);
+			if (!Found && !Inventory->IsTemplate() && Inventory->GetWorld() == World && FarmSave->GetPersistentKey(Inventory->GetOwner()) == OwnerKey)
+			{
+				Found = Inventory->GetOwner();
+			}
+		});
+	}
+
+	if (Found)
+	{
+		ReplayOwners.Add(OwnerKey, Found);
+	}
+	return Found;
+}
+
+void UFarmSimulationSubsystem::ResetPlotRandomStreams()
+{
+	if (const UFarmSaveSubsystem* FarmSave = UFarmSaveSubsystem::Get(this))
+	{
+		for (const TWeakObjectPtr<ASoilPlot>& WeakPlot : FarmSave->GetPlots())
+		{
+			if (ASoilPlot* Plot = WeakPlot.Get())
+			{
+				Plot->ResetRandomStream();
+			}
+		}
+	}
+}
+
+FFarmSimAction* UFarmSimulationSubsystem::AddRecordedAction(EFarmSimActionType Type, const AActor* Owner)
+{
+	const UFarmSaveSubsystem* FarmSave = UFarmSaveSubsystem::Get(this);
+	FString OwnerKey = FarmSave ? FarmSave->GetPersistentKey(Owner) : FString();
+	if (OwnerKey.IsEmpty())
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("UFarmSimulationSubsystem::AddRecordedAction: %s is not persistent, action not recorded"), *GetNameSafe(Owner));
+		return nullptr;
+	}
+
+	FFarmSimAction& Action = Recording.Actions.AddDefaulted_GetRef();
+	Action.Step = StepIndex;
+	Action.Type = Type;
+	Action.OwnerKey = MoveTemp(OwnerKey);
+	return &Action;
+}
+
+void UFarmSimulationSubsystem::RecordFarmAction(const AActor* Instigator, const ASoilPlot* Plot, int32 ToolSlot, bool bTargetCrop)
+{
+	if (!bRecording || !Plot)
+	{
+		return;
+	}
+
+	if (FFarmSimAction* Action = AddRecordedAction(EFarmSimActionType::FarmAction, Instigator))
+	{
+		Action->Location = FVector3f(Plot->GetActorLocation());
+		Action->SlotIndex = ToolSlot;
+		Action->bTargetCrop = bTargetCrop;
+	}
+}
+
+void UFarmSimulationSubsystem::RecordPlacement(const AActor* Instigator, const UItemDataAsset* Item, const AActor* Placed, int32 Slot)
+{
+	if (!bRecording || !Item || !Placed)
+	{
+		return;
+	}
+
+	if (FFarmSimAction* Action = AddRecordedAction(EFarmSimActionType::Place, Instigator))
+	{
+		Action->Location = FVector3f(Placed->GetActorLocation());
+		Action->Rotation = FRotator3f(Placed->GetActorRotation());
+		Action->Item = FSoftObjectPath(Item);
+		Action->SlotIndex = Slot;
+	}
+}
+
+void UFarmSimulationSubsystem::RecordPickup(const AActor* Instigator, const ASoilPlot* Plot)
+{
+	if (!bRecording || !Plot)
+	{
+		return;
+	}
+
+	if (FFarmSimAction* Action = AddRecordedAction(EFarmSimActionType::Pickup, Instigator))
+	{
+		Action->Location = FVector3f(Plot->GetActorLocation());
+	}
+}
+
+void UFarmSimulationSubsystem::RecordInventoryCommand(const FInventoryCommand& Command)
+{
+	if (!bRecording || !Command.Inventory)
+	{
+		return;
+	}
+
+	if (FFarmSimAction* Action = AddRecordedAction(EFarmSimActionType::Inventory, Command.Inventory->GetOwner()))
+	{
+		Action->CommandType = static_cast<uint8>(Command.Type);
+		Action->SlotIndex = Command.SlotIndex;
+		Action->OtherSlotIndex = Command.OtherSlotIndex;
+		Action->Amount = Command.Amount;
+
+		if (Command.OtherInventory)
+		{
+			if (const UFarmSaveSubsystem* FarmSave = UFarmSaveSubsystem::Get(this))
+			{
+				Action->OtherOwnerKey = FarmSave->GetPersistentKey(Command.OtherInventory->GetOwner());
+			}
+		}
+	}
+}
+
+void UFarmSimulationSubsystem::RecordItemAdded(const UInventoryComponent* Inventory, const UItemDataAsset* Item, int32 Amount)
+{
+	if (!bRecording || !Inventory || !Item)
+	{
+		return;
+	}
+
+	if (FFarmSimAction* Action = AddRecordedAction(EFarmSimActionType::AddItem, Inventory->GetOwner()))
+	{
+		Action->Item = FSoftObjectPath(Item);
+		Action->Amount = Amount;
+	}
+}
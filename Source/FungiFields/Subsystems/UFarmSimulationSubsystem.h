@@ -0,0 +1,263 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "../Data/FFarmSimRecording.h"
+#include "UFarmSimulationSubsystem.generated.h"
+
+class ASoilPlot;
+class UInventoryComponent;
+class UItemDataAsset;
+struct FInventoryCommand;
+
+/**
+ * Deterministic mode for the farm simulation, with a recorder and a replay player for A/B comparisons.
+ * In deterministic mode crop growth and water evaporation advance together in fixed steps driven from here,
+ * instead of on their own timers, and each plot draws random numbers from a stream seeded by the simulation
+ * seed and its location. Player actions are recorded against the step they happened before, so replaying
+ * a recording from its start save reproduces every step exactly; the state hash after each step shows
+ * where two runs diverge.
+ * Headless replay: -nullrhi -FarmReplay=<Name> replays, writes the per-step hashes next to the recording
+ * and exits with code 1 if they differ from the recorded ones.
+ * Only runs on the authority.
+ */
+UCLASS()
+class FUNGIFIELDS_API UFarmSimulationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem interface
+	virtual void Deinitialize() override;
+
+	// UWorldSubsystem interface
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Get the farm simulation subsystem for the world of the given object.
+	 * @param WorldContextObject Any object with a valid world
+	 * @return The subsystem, or nullptr if there is no world
+	 */
+	static UFarmSimulationSubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	 * Check whether the world of the given object runs the farm simulation in fixed steps.
+	 * @param WorldContextObject Any object with a valid world
+	 * @return True if the world's simulation is deterministic
+	 */
+	static bool IsDeterministicWorld(const UObject* WorldContextObject);
+
+	/**
+	 * Switch the farm simulation to fixed steps and seeded random streams. Stays on for the rest of the session.
+	 * @param Seed Seed for per-plot random streams
+	 */
+	void EnableDeterministicMode(int32 Seed);
+
+	/**
+	 * Check whether the simulation runs in fixed steps.
+	 * @return True in deterministic mode
+	 */
+	bool IsDeterministic() const { return bDeterministic; }
+
+	/**
+	 * Get the number of fixed steps run since recording or replay started.
+	 * @return Current step index
+	 */
+	int32 GetStepIndex() const { return StepIndex; }
+
+	/**
+	 * Get the simulated time each fixed step advances.
+	 * @return Seconds per step
+	 */
+	float GetFixedStepSeconds() const { return FixedStepSeconds; }
+
+	/**
+	 * Get the seed for a plot's random stream.
+	 * @param PlotLocation Location of the plot
+	 * @return A seed derived from the simulation seed and the location in deterministic mode, otherwise a random seed
+	 */
+	int32 GetPlotSeed(const FVector& PlotLocation) const;
+
+	/**
+	 * Save the farm to the recording's start slot and record player actions from now on.
+	 * Turns on deterministic mode if it is not already on.
+	 * @param RecordingName Name to store the recording under
+	 * @return True if recording started
+	 */
+	bool StartRecording(const FString& RecordingName);
+
+	/**
+	 * Stop recording and write the recording to disk.
+	 * @return True if a recording was written
+	 */
+	bool StopRecording();
+
+	/**
+	 * Check whether player actions are being recorded.
+	 * @return True while recording
+	 */
+	bool IsRecording() const { return bRecording; }
+
+	/**
+	 * Load a recording's start save and replay its actions step by step, as fast as MaxReplayStepsPerFrame allows.
+	 * Autosaves are suspended for the duration so the player's farm is left untouched.
+	 * @param RecordingName Recording to replay
+	 * @param bExitWhenDone Whether to quit once the replay finishes, with exit code 1 on a hash mismatch
+	 * @return True if the replay started
+	 */
+	bool StartReplay(const FString& RecordingName, bool bExitWhenDone);
+
+	/**
+	 * Check whether a recording is being replayed.
+	 * @return True from StartReplay until the last step has run
+	 */
+	bool IsReplaying() const { return ReplayPhase != EReplayPhase::None; }
+
+	/**
+	 * Record a tool use, planting or harvest. Ignored unless recording.
+	 * @param Instigator The acting player
+	 * @param Plot The targeted plot
+	 * @param ToolSlot Equipped inventory slot
+	 * @param bTargetCrop Whether the plot's crop was targeted
+	 */
+	void RecordFarmAction(const AActor* Instigator, const ASoilPlot* Plot, int32 ToolSlot, bool bTargetCrop);
+
+	/**
+	 * Record a placement. Ignored unless recording.
+	 * @param Instigator The placing player
+	 * @param Item The placed item
+	 * @param Placed The spawned actor, at its final location
+	 * @param Slot Inventory slot the item was placed from
+	 */
+	void RecordPlacement(const AActor* Instigator, const UItemDataAsset* Item, const AActor* Placed, int32 Slot);
+
+	/**
+	 * Record a plot being picked up. Ignored unless recording.
+	 * @param Instigator The player picking the plot up
+	 * @param Plot The plot
+	 */
+	void RecordPickup(const AActor* Instigator, const ASoilPlot* Plot);
+
+	/**
+	 * Record an inventory command performed on the authority. Ignored unless recording.
+	 * @param Command The performed command
+	 */
+	void RecordInventoryCommand(const FInventoryCommand& Command);
+
+	/**
+	 * Record items added to an inventory from a pickup. Ignored unless recording.
+	 * @param Inventory The receiving inventory
+	 * @param Item The added item
+	 * @param Amount Number of items added
+	 */
+	void RecordItemAdded(const UInventoryComponent* Inventory, const UItemDataAsset* Item, int32 Amount);
+
+protected:
+	/** Advance the simulation by one fixed step */
+	void RunStep();
+
+	/** Perform recorded actions due before the current step */
+	void ApplyReplayActions();
+
+	/** Perform one recorded action */
+	void ApplyReplayAction(const FFarmSimAction& Action);
+
+	/** Find the actor a persistent key refers to */
+	AActor* ResolveReplayOwner(const FString& OwnerKey);
+
+	/** Reseed every plot's random stream from the simulation seed */
+	void ResetPlotRandomStreams();
+
+	/** Start stepping once the recording's start save has been restored */
+	UFUNCTION()
+	void OnReplayLoadCompleted(const FString& SlotName, bool bSuccess);
+
+	/** Report the replay's result and write its hashes */
+	void FinishReplay(bool bLoaded);
+
+	/** Start a recorded action for the current step */
+	FFarmSimAction* AddRecordedAction(EFarmSimActionType Type, const AActor* Owner);
+
+private:
+	enum class EReplayPhase : uint8
+	{
+		None,
+		WaitingToLoad,
+		Loading,
+		Running
+	};
+
+	/** Whether the simulation runs in fixed steps */
+	bool bDeterministic = false;
+
+	/** Seed for per-plot random streams */
+	int32 SimulationSeed = 0;
+
+	/** Steps run since recording or replay started */
+	int32 StepIndex = 0;
+
+	/** Game time not yet simulated */
+	float StepAccumulator = 0.0f;
+
+	/** Whether actions are being recorded */
+	bool bRecording = false;
+
+	/** Name of the recording being made or replayed */
+	FString RecordingName;
+
+	/** Recording being made or replayed */
+	FFarmSimRecording Recording;
+
+	/** Progress of the replay in progress */
+	EReplayPhase ReplayPhase = EReplayPhase::None;
+
+	/** Next recorded action to replay */
+	int32 NextReplayAction = 0;
+
+	/** State hash after every HashInterval-th replayed step */
+	TArray<uint64> ReplayHashes;
+
+	/** First replayed step whose hash differs from the recording; divergence is found within one hash interval */
+	int32 FirstMismatchStep = INDEX_NONE;
+
+	/** Whether to quit when the replay finishes */
+	bool bExitWhenReplayDone = false;
+
+	/** Time the replay started stepping */
+	double ReplayStartTime = 0.0;
+
+	/** Actors referred to by recorded actions, by persistent key */
+	TMap<FString, TWeakObjectPtr<AActor>> ReplayOwners;
+
+	/** Simulated seconds per step; matches the growth and evaporation timer intervals */
+	UPROPERTY(EditDefaultsOnly, Category = "Farm Simulation Settings", meta = (ClampMin = "0.01"))
+	float FixedStepSeconds = 1.0f;
+
+	/** Steps run per frame during live play before the backlog is dropped, so hitches do not snowball */
+	UPROPERTY(EditDefaultsOnly, Category = "Farm Simulation Settings", meta = (ClampMin = "1"))
+	int32 MaxStepsPerFrame = 4;
+
+	/** Steps run per frame while replaying */
+	UPROPERTY(EditDefaultsOnly, Category = "Farm Simulation Settings", meta = (ClampMin = "1"))
+	int32 MaxReplayStepsPerFrame = 1000;
+
+	/** Whether to store state hashes while recording */
+	UPROPERTY(EditDefaultsOnly, Category = "Farm Simulation Settings")
+	bool bHashWhileRecording = true;
+
+	/** Steps between state hashes while recording; hashing walks every plot, so it is not done every step */
+	UPROPERTY(EditDefaultsOnly, Category = "Farm Simulation Settings", meta = (ClampMin = "1"))
+	int32 HashIntervalSteps = 30;
+
+	/** Whether to run deterministically without -FarmSeed on the command line */
+	UPROPERTY(EditDefaultsOnly, Category = "Farm Simulation Settings")
+	bool bDeterministicByDefault = false;
+
+	/** Seed used when deterministic mode is enabled without one */
+	UPROPERTY(EditDefaultsOnly, Category = "Farm Simulation Settings")
+	int32 DefaultSeed = 1;
+};
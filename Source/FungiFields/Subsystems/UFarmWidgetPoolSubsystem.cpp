@@ -0,0 +1,185 @@
+#include "UFarmWidgetPoolSubsystem.h"
+#include "../FungiFieldsStats.h"
+#include "../Interfaces/PooledWidgetInterface.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+	FAutoConsoleCommandWithWorldAndArgs FarmWidgetPoolCommand(
+		TEXT("Farm.WidgetPool"),
+		TEXT("Log the idle widgets of each pooled class and how many widgets were created and reused"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (const UFarmWidgetPoolSubsystem* WidgetPool = UFarmWidgetPoolSubsystem::Get(World))
+			{
+				WidgetPool->LogPools();
+			}
+		}));
+}
+
+void UFarmWidgetPoolSubsystem::Deinitialize()
+{
+	IdleWidgets.Empty();
+	CachedSlateWidgets.Empty();
+
+	Super::Deinitialize();
+}
+
+UFarmWidgetPoolSubsystem* UFarmWidgetPoolSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject)
+	{
+		return nullptr;
+	}
+
+	const UWorld* World = WorldContextObject->GetWorld();
+	return World ? World->GetSubsystem<UFarmWidgetPoolSubsystem>() : nullptr;
+}
+
+UUserWidget* UFarmWidgetPoolSubsystem::AcquireWidget(TSubclassOf<UUserWidget> WidgetClass, APlayerController* OwningPlayer)
+{
+	if (!WidgetClass)
+	{
+		return nullptr;
+	}
+
+	if (FFarmIdleWidgets* Idle = IdleWidgets.Find(WidgetClass.Get()))
+	{
+		while (Idle->Widgets.Num() > 0)
+		{
+			// The widget's new parent holds its Slate tree from here on
+			UUserWidget* Widget = Idle->Widgets.Pop(false);
+			CachedSlateWidgets.Remove(Widget);
+			if (!IsValid(Widget))
+			{
+				continue;
+			}
+
+			if (OwningPlayer && Widget->GetOwningPlayer() != OwningPlayer)
+			{
+				Widget->SetOwningPlayer(OwningPlayer);
+			}
+
+			++ReusedCount;
+			FARM_INC_COUNTER(STAT_FarmPoolReuses, PoolReuseCount);
+			return Widget;
+		}
+	}
+
+	return CreatePooledWidget(WidgetClass, OwningPlayer);
+}
+
+void UFarmWidgetPoolSubsystem::Release(UUserWidget* Widget)
+{
+	if (!IsValid(Widget))
+	{
+		return;
+	}
+
+	FFarmIdleWidgets& Idle = IdleWidgets.FindOrAdd(Widget->GetClass());
+	if (Idle.Widgets.Contains(Widget))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UFarmWidgetPoolSubsystem::Release: %s was released twice"), *Widget->GetName());
+		return;
+	}
+
+	// Held across RemoveFromParent so the Slate tree survives the parent letting go of it
+	TSharedPtr<SWidget> SlateWidget = Widget->GetCachedWidget();
+	Widget->RemoveFromParent();
+
+	if (IPooledWidgetInterface* PooledWidget = Cast<IPooledWidgetInterface>(Widget))
+	{
+		PooledWidget->ResetForPool();
+	}
+
+	if (Idle.Widgets.Num() >= MaxIdlePerClass)
+	{
+		return;
+	}
+
+	Idle.Widgets.Add(Widget);
+	if (SlateWidget.IsValid())
+	{
+		CachedSlateWidgets.Add(Widget, MoveTemp(SlateWidget));
+	}
+}
+
+int32 UFarmWidgetPoolSubsystem::PrewarmBatch(APlayerController* OwningPlayer)
+{
+	int32 NumCreated = 0;
+
+	for (const FFarmWarmWidgetPool& WarmPool : WarmPools)
+	{
+		// Prewarming never loads a widget class; classes the game has not needed yet are skipped
+		UClass* WidgetClass = WarmPool.WidgetClass.Get();
+		if (!WidgetClass)
+		{
+			continue;
+		}
+
+		FFarmIdleWidgets& Idle = IdleWidgets.FindOrAdd(WidgetClass);
+		const int32 TargetCount = FMath::Min(WarmPool.Count, MaxIdlePerClass);
+
+		while (Idle.Widgets.Num() < TargetCount && NumCreated < PrewarmBatchSize)
+		{
+			UUserWidget* Widget = CreatePooledWidget(WidgetClass, OwningPlayer);
+			if (!Widget)
+			{
+				break;
+			}
+
+			Idle.Widgets.Add(Widget);
+			CachedSlateWidgets.Add(Widget, Widget->TakeWidget());
+			++NumCreated;
+		}
+
+		if (NumCreated >= PrewarmBatchSize)
+		{
+			break;
+		}
+	}
+
+	return NumCreated;
+}
+
+int32 UFarmWidgetPoolSubsystem::GetNumPrewarmBatches() const
+{
+	int32 TotalCount = 0;
+	for (const FFarmWarmWidgetPool& WarmPool : WarmPools)
+	{
+		TotalCount += FMath::Min(WarmPool.Count, MaxIdlePerClass);
+	}
+
+	return FMath::DivideAndRoundUp(TotalCount, FMath::Max(PrewarmBatchSize, 1));
+}
+
+UUserWidget* UFarmWidgetPoolSubsystem::CreatePooledWidget(TSubclassOf<UUserWidget> WidgetClass, APlayerController* OwningPlayer)
+{
+	LLM_SCOPE_BYTAG(Farm_Widgets);
+	FARM_HITCH_SCOPE(WidgetRebuild, WidgetClass);
+
+	UUserWidget* Widget = OwningPlayer
+		? CreateWidget<UUserWidget>(OwningPlayer, WidgetClass)
+		: CreateWidget<UUserWidget>(GetWorld(), WidgetClass);
+
+	if (!Widget)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UFarmWidgetPoolSubsystem::CreatePooledWidget: Failed to create %s"), *GetNameSafe(WidgetClass));
+		return nullptr;
+	}
+
+	++CreatedCount;
+	return Widget;
+}
+
+void UFarmWidgetPoolSubsystem::LogPools() const
+{
+	UE_LOG(LogTemp, Display, TEXT("UFarmWidgetPoolSubsystem::LogPools: %d widgets created, %d reused"), CreatedCount, ReusedCount);
+
+	for (const TPair<TObjectPtr<UClass>, FFarmIdleWidgets>& Idle : IdleWidgets)
+	{
+		UE_LOG(LogTemp, Display, TEXT("    %s: %d idle"), *GetNameSafe(Idle.Key), Idle.Value.Widgets.Num());
+	}
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Blueprint/UserWidget.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/SoftObjectPtr.h"
+#include "UFarmWidgetPoolSubsystem.generated.h"
+
+class APlayerController;
+class SWidget;
+
+/** A widget class to keep idle widgets of, listed in config */
+USTRUCT()
+struct FFarmWarmWidgetPool
+{
+	GENERATED_BODY()
+
+	/** Widget class to prewarm; it is only prewarmed once something else has loaded it */
+	UPROPERTY()
+	TSoftClassPtr<UUserWidget> WidgetClass;
+
+	/** Idle widgets of the class to have ready */
+	UPROPERTY()
+	int32 Count = 0;
+};
+
+/** Idle widgets of one class */
+USTRUCT()
+struct FFarmIdleWidgets
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<UUserWidget>> Widgets;
+};
+
+/**
+ * Pool of slot and entry widgets shared by the menus of a world. Widgets are handed out by class and given
+ * back when a menu no longer shows them; a released widget is removed from its parent and, if it implements
+ * IPooledWidgetInterface, reset so it keeps no bindings or data from its last user. Pooled widgets keep their
+ * Slate tree while idle, so a reused widget is not constructed again. The WarmPools listed in the
+ * [/Script/FungiFields.FarmWidgetPoolSubsystem] section of DefaultGame.ini are filled in idle frames, so once
+ * they are warm, opening and closing menus creates no widgets. Farm.WidgetPool logs the pools.
+ */
+UCLASS(config=Game)
+class FUNGIFIELDS_API UFarmWidgetPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem interface
+	virtual void Deinitialize() override;
+
+	/**
+	 * Get the widget pool for the world of the given object.
+	 * @param WorldContextObject Any object with a valid world
+	 * @return The subsystem, or nullptr if there is no world
+	 */
+	static UFarmWidgetPoolSubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	 * Take an idle widget of a class from the pool, creating one if there is none.
+	 * @param WidgetClass Class of the widget
+	 * @param OwningPlayer Player the widget is shown to, or nullptr to create it for the world
+	 * @return The widget, not in any parent, or nullptr if the class is not set
+	 */
+	template<typename T>
+	T* Acquire(TSubclassOf<T> WidgetClass, APlayerController* OwningPlayer)
+	{
+		return Cast<T>(AcquireWidget(WidgetClass, OwningPlayer));
+	}
+
+	/**
+	 * Take an idle widget of a class from the pool, creating one if there is none.
+	 * @param WidgetClass Class of the widget
+	 * @param OwningPlayer Player the widget is shown to, or nullptr to create it for the world
+	 * @return The widget, not in any parent, or nullptr if the class is not set
+	 */
+	UUserWidget* AcquireWidget(TSubclassOf<UUserWidget> WidgetClass, APlayerController* OwningPlayer);
+
+	/**
+	 * Give a widget back to the pool. It is removed from its parent and reset; the caller must drop its references.
+	 * @param Widget The widget; widgets beyond MaxIdlePerClass are left for garbage collection
+	 */
+	void Release(UUserWidget* Widget);
+
+	/**
+	 * Create up to PrewarmBatchSize idle widgets towards the WarmPools counts.
+	 * @param OwningPlayer Player the widgets are created for
+	 * @return Number of widgets created; zero once every loaded warm pool is full
+	 */
+	int32 PrewarmBatch(APlayerController* OwningPlayer);
+
+	/**
+	 * Get how many PrewarmBatch calls it takes to fill the WarmPools from empty.
+	 * @return Number of batches
+	 */
+	int32 GetNumPrewarmBatches() const;
+
+	/** Log the idle widgets of each class and how many widgets were created and reused */
+	void LogPools() const;
+
+	/** Widget classes to keep idle widgets of, and how many */
+	UPROPERTY(Config)
+	TArray<FFarmWarmWidgetPool> WarmPools;
+
+	/** Most widgets PrewarmBatch creates at once */
+	UPROPERTY(Config)
+	int32 PrewarmBatchSize = 16;
+
+	/** Most idle widgets kept per class */
+	UPROPERTY(Config)
+	int32 MaxIdlePerClass = 96;
+
+private:
+	/**
+	 * Create a widget for the pool.
+	 * @param WidgetClass Class of the widget
+	 * @param OwningPlayer Player the widget is shown to, or nullptr to create it for the world
+	 * @return The widget, or nullptr if it could not be created
+	 */
+	UUserWidget* CreatePooledWidget(TSubclassOf<UUserWidget> WidgetClass, APlayerController* OwningPlayer);
+
+	UPROPERTY()
+	TMap<TObjectPtr<UClass>, FFarmIdleWidgets> IdleWidgets;
+
+	/** Slate trees of idle widgets, kept so the widgets are not constructed again when reused; dropped on acquire */
+	TMap<TObjectKey<UUserWidget>, TSharedPtr<SWidget>> CachedSlateWidgets;
+
+	int32 CreatedCount = 0;
+	int32 ReusedCount = 0;
+};
@@ -0,0 +1,237 @@
+#include "UInteractionPromptSubsystem.h"
+#include "UFarmWidgetPoolSubsystem.h"
+#include "../FungiFieldsStats.h"
+#include "../Actors/InteractableActor.h"
+#include "../Interfaces/InteractableInterface.h"
+#include "../Widgets/InteractionWidget.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+void UInteractionPromptSubsystem::Deinitialize()
+{
+	Prompts.Empty();
+	PromptTargets.Empty();
+	PromptTexts.Empty();
+	Interactables.Empty();
+	FocusedInteractable.Reset();
+	FocusPlayer.Reset();
+
+	Super::Deinitialize();
+}
+
+UInteractionPromptSubsystem* UInteractionPromptSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject)
+	{
+		return nullptr;
+	}
+
+	const UWorld* World = WorldContextObject->GetWorld();
+	return World ? World->GetSubsystem<UInteractionPromptSubsystem>() : nullptr;
+}
+
+TStatId UInteractionPromptSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UInteractionPromptSubsystem, STATGROUP_Tickables);
+}
+
+void UInteractionPromptSubsystem::RegisterInteractable(AInteractableActor* Interactable)
+{
+	if (Interactable)
+	{
+		Interactables.AddUnique(Interactable);
+	}
+}
+
+void UInteractionPromptSubsystem::UnregisterInteractable(AInteractableActor* Interactable)
+{
+	Interactables.RemoveSwap(Interactable);
+
+	const int32 PromptIndex = PromptTargets.IndexOfByKey(Interactable);
+	if (PromptIndex != INDEX_NONE)
+	{
+		ReleasePrompts(PromptIndex);
+	}
+
+	if (FocusedInteractable == Interactable)
+	{
+		FocusedInteractable.Reset();
+		ReleasePrompts();
+	}
+}
+
+void UInteractionPromptSubsystem::SetFocus(APlayerController* Player, AActor* Focus, TSubclassOf<UInteractionWidget> DefaultPromptClass)
+{
+	// Only the player the prompts are shown to can clear them
+	if (!Focus && FocusPlayer.IsValid() && FocusPlayer != Player)
+	{
+		return;
+	}
+
+	if (FocusedInteractable == Focus && FocusPlayer == Player)
+	{
+		return;
+	}
+
+	FocusedInteractable = Focus;
+	FocusPlayer = Player;
+	FocusPromptClass = DefaultPromptClass;
+
+	if (!Focus || !Player)
+	{
+		ReleasePrompts();
+		return;
+	}
+
+	UpdatePrompts();
+}
+
+void UInteractionPromptSubsystem::Tick(float DeltaTime)
+{
+	UpdatePrompts();
+}
+
+void UInteractionPromptSubsystem::UpdatePrompts()
+{
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmWidgetRefresh, "UInteractionPromptSubsystem::UpdatePrompts");
+	FScopedFarmSimTiming WidgetTiming(&FFarmSimTimings::WidgetCycles);
+
+	AActor* Focus = FocusedInteractable.Get();
+	APlayerController* PC = FocusPlayer.Get();
+	if (!Focus || !PC || MaxPrompts <= 0)
+	{
+		FocusedInteractable.Reset();
+		ReleasePrompts();
+		return;
+	}
+
+	const FVector FocusLocation = Focus->GetActorLocation();
+	const float RadiusSquared = FMath::Square(PromptRadius);
+
+	// The focus always has the first prompt, whether or not it registered
+	TArray<TPair<float, AActor*>, TInlineAllocator<16>> Nearest;
+	Nearest.Emplace(-1.0f, Focus);
+
+	for (const TWeakObjectPtr<AInteractableActor>& InteractablePtr : Interactables)
+	{
+		AInteractableActor* Interactable = InteractablePtr.Get();
+		if (!Interactable || Interactable == Focus || Interactable->IsHidden())
+		{
+			continue;
+		}
+
+		const float DistanceSquared = FVector::DistSquared(FocusLocation, Interactable->GetActorLocation());
+		if (DistanceSquared <= RadiusSquared)
+		{
+			Nearest.Emplace(DistanceSquared, Interactable);
+		}
+	}
+
+	Nearest.Sort([](const TPair<float, AActor*>& A, const TPair<float, AActor*>& B)
+	{
+		return A.Key < B.Key;
+	});
+
+	const int32 NumPrompts = FMath::Min(Nearest.Num(), MaxPrompts);
+	ReleasePrompts(NumPrompts);
+
+	for (int32 i = 0; i < NumPrompts; ++i)
+	{
+		AActor* Interactable = Nearest[i].Value;
+		const AInteractableActor* RegisteredInteractable = Cast<AInteractableActor>(Interactable);
+
+		TSubclassOf<UInteractionWidget> PromptClass = RegisteredInteractable ? RegisteredInteractable->GetPromptClass() : nullptr;
+		if (!PromptClass)
+		{
+			PromptClass = FocusPromptClass;
+		}
+
+		UInteractionWidget* Prompt = AssignPrompt(i, Interactable, PromptClass);
+		if (!Prompt)
+		{
+			continue;
+		}
+
+		const FVector PromptLocation = RegisteredInteractable
+			? RegisteredInteractable->GetPromptLocation()
+			: Interactable->GetActorLocation() + FVector(0.0f, 0.0f, DefaultPromptHeight);
+
+		FVector2D ScreenPosition;
+		if (!PC->ProjectWorldLocationToScreen(PromptLocation, ScreenPosition, true))
+		{
+			Prompt->SetVisibility(ESlateVisibility::Collapsed);
+			continue;
+		}
+
+		Prompt->SetPositionInViewport(ScreenPosition);
+		Prompt->SetVisibility(ESlateVisibility::HitTestInvisible);
+	}
+}
+
+UInteractionWidget* UInteractionPromptSubsystem::AssignPrompt(int32 Index, AActor* Interactable, TSubclassOf<UInteractionWidget> PromptClass)
+{
+	// Interactables return the same text while their state is unchanged, so the identity check usually settles it
+	FText PromptText = IInteractableInterface::Execute_GetInteractionText(Interactable);
+
+	if (Prompts.IsValidIndex(Index) && Prompts[Index] && Prompts[Index]->GetClass() == PromptClass)
+	{
+		PromptTargets[Index] = Interactable;
+
+		FText& ShownText = PromptTexts[Index];
+		if (!PromptText.IdenticalTo(ShownText) && !PromptText.ToString().Equals(ShownText.ToString(), ESearchCase::CaseSensitive))
+		{
+			Prompts[Index]->SetPromptText(PromptText);
+		}
+		ShownText = MoveTemp(PromptText);
+
+		return Prompts[Index];
+	}
+
+	if (Prompts.IsValidIndex(Index))
+	{
+		ReleasePrompts(Index);
+	}
+
+	UFarmWidgetPoolSubsystem* WidgetPool = UFarmWidgetPoolSubsystem::Get(this);
+	if (!WidgetPool || !PromptClass)
+	{
+		return nullptr;
+	}
+
+	// Prompts are filled in order, so a new one always goes at the end
+	UInteractionWidget* Prompt = WidgetPool->Acquire<UInteractionWidget>(PromptClass, FocusPlayer.Get());
+	if (!Prompt || Prompts.Num() != Index)
+	{
+		WidgetPool->Release(Prompt);
+		return nullptr;
+	}
+
+	Prompt->SetAlignmentInViewport(FVector2D(0.5f, 1.0f));
+	Prompt->SetPromptText(PromptText);
+	Prompt->AddToViewport(PromptZOrder);
+
+	Prompts.Add(Prompt);
+	PromptTargets.Add(Interactable);
+	PromptTexts.Add(MoveTemp(PromptText));
+	return Prompt;
+}
+
+void UInteractionPromptSubsystem::ReleasePrompts(int32 FirstIndex)
+{
+	if (FirstIndex >= Prompts.Num())
+	{
+		return;
+	}
+
+	if (UFarmWidgetPoolSubsystem* WidgetPool = UFarmWidgetPoolSubsystem::Get(this))
+	{
+		for (int32 i = FirstIndex; i < Prompts.Num(); ++i)
+		{
+			WidgetPool->Release(Prompts[i]);
+		}
+	}
+
+	Prompts.SetNum(FirstIndex, false);
+	PromptTargets.SetNum(FirstIndex, false);
+	PromptTexts.SetNum(FirstIndex, false);
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UInteractionPromptSubsystem.generated.h"
+
+class AActor;
+class AInteractableActor;
+class APlayerController;
+class UInteractionWidget;
+
+/**
+ * Draws interaction prompts in screen space for the interactable in focus and the few interactables nearest it.
+ * Interactable actors register here instead of ticking their own world-space widget. Nothing runs while no
+ * interactable is in focus; while one is, each frame the MaxPrompts registered interactables nearest the focus
+ * within PromptRadius are projected to the screen and given a prompt widget. Prompt widgets come from the
+ * widget pool and go back to it when focus is lost. Settings come from the
+ * [/Script/FungiFields.InteractionPromptSubsystem] section of DefaultGame.ini.
+ */
+UCLASS(config=Game)
+class FUNGIFIELDS_API UInteractionPromptSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem interface
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return FocusedInteractable.IsValid() || Prompts.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Get the interaction prompt subsystem for the world of the given object.
+	 * @param WorldContextObject Any object with a valid world
+	 * @return The subsystem, or nullptr if there is no world
+	 */
+	static UInteractionPromptSubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	 * Add an interactable that can show a prompt when it is near the focus.
+	 * @param Interactable The interactable
+	 */
+	void RegisterInteractable(AInteractableActor* Interactable);
+
+	/**
+	 * Remove an interactable added with RegisterInteractable, hiding its prompt.
+	 * @param Interactable The interactable
+	 */
+	void UnregisterInteractable(AInteractableActor* Interactable);
+
+	/**
+	 * Set the interactable the player is looking at. Prompts are shown around it until focus is cleared.
+	 * @param Player Player the prompts are shown to
+	 * @param Focus The interactable in focus, or nullptr to hide every prompt; ignored unless Player is the
+	 *        player the prompts are shown to
+	 * @param DefaultPromptClass Prompt widget for interactables that do not set their own
+	 */
+	void SetFocus(APlayerController* Player, AActor* Focus, TSubclassOf<UInteractionWidget> DefaultPromptClass);
+
+	/** Most prompts shown at once, including the focus */
+	UPROPERTY(Config)
+	int32 MaxPrompts = 3;
+
+	/** Interactables further than this from the focus get no prompt */
+	UPROPERTY(Config)
+	float PromptRadius = 600.0f;
+
+	/** Height above an unregistered interactable at which its prompt is anchored */
+	UPROPERTY(Config)
+	float DefaultPromptHeight = 100.0f;
+
+	/** Viewport z-order of prompt widgets */
+	UPROPERTY(Config)
+	int32 PromptZOrder = 10;
+
+private:
+	/** Project the prompts of the interactables nearest the focus */
+	void UpdatePrompts();
+
+	/**
+	 * Give a prompt to an interactable, reusing the prompt in the same position if it has the right class.
+	 * The prompt's text is refreshed whenever the interactable's text changes.
+	 * @param Index Position of the prompt
+	 * @param Interactable The interactable
+	 * @param PromptClass Prompt widget class
+	 * @return The prompt, or nullptr if none could be created
+	 */
+	UInteractionWidget* AssignPrompt(int32 Index, AActor* Interactable, TSubclassOf<UInteractionWidget> PromptClass);
+
+	/**
+	 * Return prompts to the widget pool.
+	 * @param FirstIndex First prompt to release; every prompt after it is released too
+	 */
+	void ReleasePrompts(int32 FirstIndex = 0);
+
+	/** Interactables that can show a prompt */
+	TArray<TWeakObjectPtr<AInteractableActor>> Interactables;
+
+	TWeakObjectPtr<AActor> FocusedInteractable;
+	TWeakObjectPtr<APlayerController> FocusPlayer;
+	TSubclassOf<UInteractionWidget> FocusPromptClass;
+
+	/** Prompts on screen, nearest first, and the interactable each one is for */
+	UPROPERTY()
+	TArray<TObjectPtr<UInteractionWidget>> Prompts;
+
+	TArray<TWeakObjectPtr<AActor>> PromptTargets;
+
+	/** Text each prompt shows, refreshed when its interactable's text changes */
+	TArray<FText> PromptTexts;
+};
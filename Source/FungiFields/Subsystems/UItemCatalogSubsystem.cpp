@@ -0,0 +1,445 @@
+#include "UItemCatalogSubsystem.h"
+#include "FFarmHitchLog.h"
+#include "../Data/UItemDataAsset.h"
+#include "../Data/USeedDataAsset.h"
+#include "../Data/UCropDataAsset.h"
+#include "../Data/USoilDataAsset.h"
+#include "../Data/USoilContainerDataAsset.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/AssetManager.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+
+namespace ItemCatalogTags
+{
+	static const FName IsPlaceable(TEXT("bIsPlaceable"));
+	static const FName PlaceableSoilDataAsset(TEXT("PlaceableSoilDataAsset"));
+	static const FName PlaceableContainerDataAsset(TEXT("PlaceableContainerDataAsset"));
+	static const FName CropToPlant(TEXT("CropToPlant"));
+	static const FName HarvestItem(TEXT("HarvestItem"));
+}
+
+UItemCatalogSubsystem* UItemCatalogSubsystem::ActiveCatalog = nullptr;
+
+void UItemCatalogSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	ActiveCatalog = this;
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		FilesLoadedHandle = AssetRegistry.OnFilesLoaded().AddUObject(this, &UItemCatalogSubsystem::OnAssetRegistryFilesLoaded);
+	}
+
+	BuildCatalog();
+}
+
+void UItemCatalogSubsystem::Deinitialize()
+{
+	if (FilesLoadedHandle.IsValid())
+	{
+		if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+		{
+			AssetRegistryModule->Get().OnFilesLoaded().Remove(FilesLoadedHandle);
+		}
+		FilesLoadedHandle.Reset();
+	}
+
+	for (const TSharedPtr<FStreamableHandle>& Handle : PendingLoads)
+	{
+		if (Handle.IsValid())
+		{
+			Handle->CancelHandle();
+		}
+	}
+	PendingLoads.Empty();
+
+	if (UntaggedAssetsHandle.IsValid())
+	{
+		UntaggedAssetsHandle->CancelHandle();
+		UntaggedAssetsHandle.Reset();
+	}
+	ReverseIndexCallbacks.Empty();
+
+	ItemPaths.Empty();
+	ItemIdsByPath.Empty();
+	ItemBySoil.Empty();
+	ItemByContainer.Empty();
+	SeedByCrop.Empty();
+	HarvestItemByCrop.Empty();
+	UntaggedItemIds.Empty();
+	UntaggedCropPaths.Empty();
+	ReportedMisses.Empty();
+
+	if (ActiveCatalog == this)
+	{
+		ActiveCatalog = nullptr;
+	}
+
+	Super::Deinitialize();
+}
+
+UItemCatalogSubsystem* UItemCatalogSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject)
+	{
+		return nullptr;
+	}
+
+	const UWorld* World = WorldContextObject->GetWorld();
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	UGameInstance* GameInstance = World->GetGameInstance();
+	return GameInstance ? GameInstance->GetSubsystem<UItemCatalogSubsystem>() : nullptr;
+}
+
+void UItemCatalogSubsystem::OnAssetRegistryFilesLoaded()
+{
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		AssetRegistryModule->Get().OnFilesLoaded().Remove(FilesLoadedHandle);
+	}
+	FilesLoadedHandle.Reset();
+
+	BuildCatalog();
+}
+
+void UItemCatalogSubsystem::BuildCatalog()
+{
+	FARM_HITCH_SCOPE(RegistryScan, this);
+	const double StartTime = FPlatformTime::Seconds();
+
+	ItemPaths.Reset();
+	ItemIdsByPath.Reset();
+	ItemBySoil.Reset();
+	ItemByContainer.Reset();
+	SeedByCrop.Reset();
+	HarvestItemByCrop.Reset();
+	UntaggedItemIds.Reset();
+	UntaggedCropPaths.Reset();
+	ReportedMisses.Reset();
+	bUntaggedAssetsIndexed = false;
+
+	if (UntaggedAssetsHandle.IsValid())
+	{
+		UntaggedAssetsHandle->CancelHandle();
+		UntaggedAssetsHandle.Reset();
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	TArray<FAssetData> ItemAssets;
+	AssetRegistry.GetAssetsByClass(UItemDataAsset::StaticClass()->GetClassPathName(), ItemAssets, true);
+
+	ItemAssets.Sort([](const FAssetData& A, const FAssetData& B)
+	{
+		return A.GetSoftObjectPath().LexicalLess(B.GetSoftObjectPath());
+	});
+
+	ItemPaths.Reserve(ItemAssets.Num());
+	ItemIdsByPath.Reserve(ItemAssets.Num());
+
+	for (const FAssetData& AssetData : ItemAssets)
+	{
+		const FSoftObjectPath ItemPath = AssetData.GetSoftObjectPath();
+		const int32 ItemId = ItemPaths.Add(ItemPath);
+		ItemIdsByPath.Add(ItemPath, ItemId);
+
+		// Every item has the bIsPlaceable tag once it has been saved with the catalog tags
+		if (!AssetData.FindTag(ItemCatalogTags::IsPlaceable))
+		{
+			UntaggedItemIds.Add(ItemId);
+			continue;
+		}
+
+		FString IsPlaceableValue;
+		if (AssetData.GetTagValue(ItemCatalogTags::IsPlaceable, IsPlaceableValue) && IsPlaceableValue.ToBool())
+		{
+			AddReverseEntry(ItemBySoil, GetReferenceTag(AssetData, ItemCatalogTags::PlaceableSoilDataAsset), ItemId);
+			AddReverseEntry(ItemByContainer, GetReferenceTag(AssetData, ItemCatalogTags::PlaceableContainerDataAsset), ItemId);
+		}
+		AddReverseEntry(SeedByCrop, GetReferenceTag(AssetData, ItemCatalogTags::CropToPlant), ItemId);
+	}
+
+	TArray<FAssetData> CropAssets;
+	AssetRegistry.GetAssetsByClass(UCropDataAsset::StaticClass()->GetClassPathName(), CropAssets, true);
+
+	for (const FAssetData& AssetData : CropAssets)
+	{
+		if (!AssetData.FindTag(ItemCatalogTags::HarvestItem))
+		{
+			UntaggedCropPaths.Add(AssetData.GetSoftObjectPath());
+			continue;
+		}
+
+		const FSoftObjectPath HarvestPath = GetReferenceTag(AssetData, ItemCatalogTags::HarvestItem);
+		if (const int32* HarvestId = ItemIdsByPath.Find(HarvestPath))
+		{
+			AddReverseEntry(HarvestItemByCrop, AssetData.GetSoftObjectPath(), *HarvestId);
+		}
+	}
+
+	if (ItemPaths.Num() > MaxPackedItemId + 1)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UItemCatalogSubsystem::BuildCatalog: %d items exceed the packed slot limit of %d, extra items will replicate by reference"),
+			ItemPaths.Num(), MaxPackedItemId + 1);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("UItemCatalogSubsystem::BuildCatalog: Catalogued %d items and %d crops in %.2f ms"),
+		ItemPaths.Num(), CropAssets.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	if (UntaggedItemIds.Num() > 0 || UntaggedCropPaths.Num() > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UItemCatalogSubsystem::BuildCatalog: %d items and %d crops have no catalog tags and are loaded in the background to index them; resave them"),
+			UntaggedItemIds.Num(), UntaggedCropPaths.Num());
+		RequestUntaggedAssets();
+	}
+	else
+	{
+		IndexUntaggedAssets();
+	}
+}
+
+void UItemCatalogSubsystem::RequestUntaggedAssets()
+{
+	TArray<FSoftObjectPath> AssetsToLoad;
+	AssetsToLoad.Reserve(UntaggedItemIds.Num() + UntaggedCropPaths.Num());
+	for (const int32 ItemId : UntaggedItemIds)
+	{
+		AssetsToLoad.Add(ItemPaths[ItemId]);
+	}
+	AssetsToLoad.Append(UntaggedCropPaths);
+
+	UntaggedAssetsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		MoveTemp(AssetsToLoad),
+		FStreamableDelegate::CreateUObject(this, &UItemCatalogSubsystem::IndexUntaggedAssets));
+
+	// A request that could not start still indexes whatever is already resident
+	if (!UntaggedAssetsHandle.IsValid())
+	{
+		IndexUntaggedAssets();
+	}
+}
+
+void UItemCatalogSubsystem::CallWhenReverseIndexComplete(FSimpleDelegate Callback)
+{
+	if (bUntaggedAssetsIndexed)
+	{
+		Callback.ExecuteIfBound();
+		return;
+	}
+
+	ReverseIndexCallbacks.Add(MoveTemp(Callback));
+}
+
+void UItemCatalogSubsystem::IndexUntaggedAssets()
+{
+	if (bUntaggedAssetsIndexed)
+	{
+		return;
+	}
+	bUntaggedAssetsIndexed = true;
+
+	FARM_HITCH_SCOPE(RegistryScan, this);
+
+	// The assets were loaded by UntaggedAssetsHandle; nothing here loads
+	for (const int32 ItemId : UntaggedItemIds)
+	{
+		const UItemDataAsset* Item = Cast<UItemDataAsset>(ItemPaths[ItemId].ResolveObject());
+		if (!Item)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("UItemCatalogSubsystem::IndexUntaggedAssets: Failed to load item '%s'"), *ItemPaths[ItemId].ToString());
+			continue;
+		}
+
+		if (Item->bIsPlaceable)
+		{
+			AddReverseEntry(ItemBySoil, FSoftObjectPath(Item->PlaceableSoilDataAsset.Get()), ItemId);
+			AddReverseEntry(ItemByContainer, FSoftObjectPath(Item->PlaceableContainerDataAsset.Get()), ItemId);
+		}
+
+		if (const USeedDataAsset* Seed = Cast<USeedDataAsset>(Item))
+		{
+			AddReverseEntry(SeedByCrop, FSoftObjectPath(Seed->CropToPlant.Get()), ItemId);
+		}
+	}
+
+	for (const FSoftObjectPath& CropPath : UntaggedCropPaths)
+	{
+		const UCropDataAsset* Crop = Cast<UCropDataAsset>(CropPath.ResolveObject());
+		if (!Crop)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("UItemCatalogSubsystem::IndexUntaggedAssets: Failed to load crop '%s'"), *CropPath.ToString());
+			continue;
+		}
+
+		if (const int32* HarvestId = ItemIdsByPath.Find(Crop->HarvestItem.ToSoftObjectPath()))
+		{
+			AddReverseEntry(HarvestItemByCrop, CropPath, *HarvestId);
+		}
+	}
+
+	// Only the references were needed; the assets may unload again
+	if (UntaggedAssetsHandle.IsValid())
+	{
+		UntaggedAssetsHandle->ReleaseHandle();
+		UntaggedAssetsHandle.Reset();
+	}
+
+	TArray<FSimpleDelegate> Callbacks = MoveTemp(ReverseIndexCallbacks);
+	for (FSimpleDelegate& Callback : Callbacks)
+	{
+		Callback.ExecuteIfBound();
+	}
+}
+
+FSoftObjectPath UItemCatalogSubsystem::GetReferenceTag(const FAssetData& AssetData, FName TagName)
+{
+	FString TagValue;
+	if (!AssetData.GetTagValue(TagName, TagValue) || TagValue.IsEmpty() || TagValue == TEXT("None"))
+	{
+		return FSoftObjectPath();
+	}
+
+	// Hard references are exported as Class'/Path/To.Asset', soft references as a bare path
+	return FSoftObjectPath(FPackageName::ExportTextPathToObjectPath(TagValue));
+}
+
+void UItemCatalogSubsystem::AddReverseEntry(TMap<FSoftObjectPath, int32>& Index, const FSoftObjectPath& Key, int32 ItemId)
+{
+	if (Key.IsNull() || Index.Contains(Key))
+	{
+		return;
+	}
+
+	Index.Add(Key, ItemId);
+}
+
+int32 UItemCatalogSubsystem::FindReverseEntry(const TMap<FSoftObjectPath, int32>& Index, const UObject* Key)
+{
+	if (!Key)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32* ItemId = Index.Find(FSoftObjectPath(Key));
+	return ItemId ? *ItemId : INDEX_NONE;
+}
+
+int32 UItemCatalogSubsystem::FindReverseEntryOrWarn(const TMap<FSoftObjectPath, int32>& Index, const UObject* Key, const TCHAR* LookupName) const
+{
+	const int32 ItemId = FindReverseEntry(Index, Key);
+	if (ItemId != INDEX_NONE || !Key)
+	{
+		return ItemId;
+	}
+
+	bool bAlreadyReported = false;
+	ReportedMisses.Add(FSoftObjectPath(Key), &bAlreadyReported);
+
+	if (!bAlreadyReported)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UItemCatalogSubsystem::%s: No item found for %s%s"), LookupName, *Key->GetPathName(),
+			bUntaggedAssetsIndexed ? TEXT("") : TEXT("; assets without catalog tags are still being indexed"));
+	}
+
+	return INDEX_NONE;
+}
+
+int32 UItemCatalogSubsystem::GetItemId(const UItemDataAsset* Item) const
+{
+	return Item ? GetItemIdByPath(FSoftObjectPath(Item)) : INDEX_NONE;
+}
+
+int32 UItemCatalogSubsystem::GetItemIdByPath(const FSoftObjectPath& ItemPath) const
+{
+	const int32* ItemId = ItemIdsByPath.Find(ItemPath);
+	return ItemId ? *ItemId : INDEX_NONE;
+}
+
+const FSoftObjectPath& UItemCatalogSubsystem::GetItemPath(int32 ItemId) const
+{
+	static const FSoftObjectPath EmptyPath;
+	return ItemPaths.IsValidIndex(ItemId) ? ItemPaths[ItemId] : EmptyPath;
+}
+
+UItemDataAsset* UItemCatalogSubsystem::GetLoadedItem(int32 ItemId) const
+{
+	if (!ItemPaths.IsValidIndex(ItemId))
+	{
+		return nullptr;
+	}
+
+	return Cast<UItemDataAsset>(ItemPaths[ItemId].ResolveObject());
+}
+
+int32 UItemCatalogSubsystem::FindPlaceableItemForSoil(const USoilDataAsset* SoilData) const
+{
+	return FindReverseEntryOrWarn(ItemBySoil, SoilData, TEXT("FindPlaceableItemForSoil"));
+}
+
+int32 UItemCatalogSubsystem::FindItemForContainer(const USoilContainerDataAsset* ContainerData) const
+{
+	return FindReverseEntryOrWarn(ItemByContainer, ContainerData, TEXT("FindItemForContainer"));
+}
+
+int32 UItemCatalogSubsystem::FindSeedForCrop(const UCropDataAsset* CropData) const
+{
+	return FindReverseEntryOrWarn(SeedByCrop, CropData, TEXT("FindSeedForCrop"));
+}
+
+int32 UItemCatalogSubsystem::FindHarvestItemForCrop(const UCropDataAsset* CropData) const
+{
+	return FindReverseEntryOrWarn(HarvestItemByCrop, CropData, TEXT("FindHarvestItemForCrop"));
+}
+
+void UItemCatalogSubsystem::LoadItemAsync(int32 ItemId, FOnCatalogItemLoaded OnLoaded)
+{
+	if (!ItemPaths.IsValidIndex(ItemId))
+	{
+		OnLoaded.ExecuteIfBound(nullptr);
+		return;
+	}
+
+	if (UItemDataAsset* LoadedItem = GetLoadedItem(ItemId))
+	{
+		OnLoaded.ExecuteIfBound(LoadedItem);
+		return;
+	}
+
+	const FSoftObjectPath ItemPath = ItemPaths[ItemId];
+	TWeakObjectPtr<UItemCatalogSubsystem> WeakThis(this);
+
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		ItemPath,
+		FStreamableDelegate::CreateLambda([WeakThis, ItemPath, OnLoaded]()
+		{
+			if (UItemCatalogSubsystem* Catalog = WeakThis.Get())
+			{
+				Catalog->PendingLoads.RemoveAll([](const TSharedPtr<FStreamableHandle>& Pending)
+				{
+					return !Pending.IsValid() || Pending->HasLoadCompleted() || Pending->WasCanceled();
+				});
+			}
+
+			UItemDataAsset* Item = Cast<UItemDataAsset>(ItemPath.ResolveObject());
+			if (!Item)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("UItemCatalogSubsystem::LoadItemAsync: Failed to load item '%s'"), *ItemPath.ToString());
+			}
+			OnLoaded.ExecuteIfBound(Item);
+		}),
+		FStreamableManager::AsyncLoadHighPriority
+	);
+
+	if (Handle.IsValid() && !Handle->HasLoadCompleted())
+	{
+		PendingLoads.Add(Handle);
+	}
+}
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "UObject/SoftObjectPath.h"
+#include "UItemCatalogSubsystem.generated.h"
+
+class UItemDataAsset;
+class USoilDataAsset;
+class USoilContainerDataAsset;
+class UCropDataAsset;
+struct FAssetData;
+struct FStreamableHandle;
+
+DECLARE_DELEGATE_OneParam(FOnCatalogItemLoaded, UItemDataAsset* /*Item*/);
+
+/**
+ * Catalog of every item definition in the project, built once from asset registry tags.
+ * Assigns dense numeric item IDs and keeps reverse indexes so lookups never load or scan assets.
+ * Only the asset that a lookup resolves to is loaded, and always asynchronously.
+ * Assets saved before the catalog tags existed have none; they are loaded asynchronously once the catalog is built
+ * to read their references, and reverse lookups for them miss until that finishes. Resave them to avoid the load.
+ */
+UCLASS()
+class FUNGIFIELDS_API UItemCatalogSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/**
+	 * Get the catalog for the game instance that owns the given world context.
+	 * @param WorldContextObject Any object with a valid world
+	 * @return The catalog, or nullptr if there is no game instance
+	 */
+	static UItemCatalogSubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	 * Get the most recently initialized catalog, for code without a world context such as struct serializers.
+	 * Every game instance builds an identical catalog from the same registry, so any live instance is valid.
+	 * @return The active catalog, or nullptr before startup
+	 */
+	static const UItemCatalogSubsystem* GetActive() { return ActiveCatalog; }
+
+	/** Largest item ID that fits the 16-bit packed slot encoding */
+	static constexpr int32 MaxPackedItemId = 0xFFFE;
+
+	/**
+	 * Get the number of items in the catalog. Valid item IDs are [0, GetNumItems()).
+	 * @return Number of catalogued items
+	 */
+	UFUNCTION(BlueprintPure, Category = "Item Catalog")
+	int32 GetNumItems() const { return ItemPaths.Num(); }
+
+	/**
+	 * Get the dense ID of an item. IDs are stable for a given set of cooked content.
+	 * @param Item The item definition
+	 * @return The item ID, or INDEX_NONE if the item is not catalogued
+	 */
+	UFUNCTION(BlueprintPure, Category = "Item Catalog")
+	int32 GetItemId(const UItemDataAsset* Item) const;
+
+	/**
+	 * Get the dense ID of an item by its asset path.
+	 * @param ItemPath Path of the item definition
+	 * @return The item ID, or INDEX_NONE if the item is not catalogued
+	 */
+	int32 GetItemIdByPath(const FSoftObjectPath& ItemPath) const;
+
+	/**
+	 * Get the asset path of an item ID.
+	 * @param ItemId The item ID
+	 * @return The item path, or an empty path if the ID is invalid
+	 */
+	const FSoftObjectPath& GetItemPath(int32 ItemId) const;
+
+	/**
+	 * Get the item for an ID if it is already in memory. Never loads.
+	 * @param ItemId The item ID
+	 * @return The resident item, or nullptr if the ID is invalid or the asset is not loaded
+	 */
+	UFUNCTION(BlueprintPure, Category = "Item Catalog")
+	UItemDataAsset* GetLoadedItem(int32 ItemId) const;
+
+	/**
+	 * Whether the reverse lookups cover every asset, including those indexed by loading because they have no
+	 * catalog tags.
+	 * @return True once untagged assets have been indexed, or immediately if there are none
+	 */
+	bool IsReverseIndexComplete() const { return bUntaggedAssetsIndexed; }
+
+	/**
+	 * Run a callback once the reverse lookups are complete; immediately if they already are.
+	 * @param Callback Callback to run on the game thread
+	 */
+	void CallWhenReverseIndexComplete(FSimpleDelegate Callback);
+
+	/** Find the placeable item that places the given soil type. Returns INDEX_NONE if there is none. */
+	int32 FindPlaceableItemForSoil(const USoilDataAsset* SoilData) const;
+
+	/** Find the placeable item that places the given container. Returns INDEX_NONE if there is none. */
+	int32 FindItemForContainer(const USoilContainerDataAsset* ContainerData) const;
+
+	/** Find the seed item that plants the given crop. Returns INDEX_NONE if there is none. */
+	int32 FindSeedForCrop(const UCropDataAsset* CropData) const;
+
+	/** Find the item granted when harvesting the given crop. Returns INDEX_NONE if there is none. */
+	int32 FindHarvestItemForCrop(const UCropDataAsset* CropData) const;
+
+	/**
+	 * Resolve an item, loading it asynchronously if it is not resident.
+	 * The callback runs immediately when the item is already loaded, otherwise when streaming completes.
+	 * It receives nullptr if the ID is invalid or the load fails.
+	 * @param ItemId The item ID to resolve
+	 * @param OnLoaded Callback receiving the loaded item
+	 */
+	void LoadItemAsync(int32 ItemId, FOnCatalogItemLoaded OnLoaded);
+
+private:
+	/** Rebuild every table from the asset registry. Does not load any assets. */
+	void BuildCatalog();
+
+	/** Called when the asset registry finishes its initial scan (editor only) */
+	void OnAssetRegistryFilesLoaded();
+
+	/** Read an object reference tag from registry data as a path. Returns an empty path for missing or None values. */
+	static FSoftObjectPath GetReferenceTag(const FAssetData& AssetData, FName TagName);
+
+	/** Add a reverse index entry, keeping the first item found for a key */
+	static void AddReverseEntry(TMap<FSoftObjectPath, int32>& Index, const FSoftObjectPath& Key, int32 ItemId);
+
+	/** Look up a reverse index entry by object */
+	static int32 FindReverseEntry(const TMap<FSoftObjectPath, int32>& Index, const UObject* Key);
+
+	/**
+	 * Look up a reverse index entry, warning once per key on a miss.
+	 * @param Index Reverse index to search
+	 * @param Key Object to look up
+	 * @param LookupName Name of the lookup, for the warning
+	 * @return The item ID, or INDEX_NONE if no item references the key
+	 */
+	int32 FindReverseEntryOrWarn(const TMap<FSoftObjectPath, int32>& Index, const UObject* Key, const TCHAR* LookupName) const;
+
+	/** Start loading the items and crops without catalog tags in the background so they can be indexed */
+	void RequestUntaggedAssets();
+
+	/** Add the reverse index entries of the loaded untagged items and crops, then run the waiting callbacks */
+	void IndexUntaggedAssets();
+
+	/** Item paths indexed by item ID, sorted so IDs match between server and clients */
+	TArray<FSoftObjectPath> ItemPaths;
+
+	/** Item path to item ID */
+	TMap<FSoftObjectPath, int32> ItemIdsByPath;
+
+	/** Soil data asset to placeable item ID */
+	TMap<FSoftObjectPath, int32> ItemBySoil;
+
+	/** Container data asset to placeable item ID */
+	TMap<FSoftObjectPath, int32> ItemByContainer;
+
+	/** Crop data asset to seed item ID */
+	TMap<FSoftObjectPath, int32> SeedByCrop;
+
+	/** Crop data asset to harvest item ID */
+	TMap<FSoftObjectPath, int32> HarvestItemByCrop;
+
+	/** Items whose registry data has no catalog tags */
+	TArray<int32> UntaggedItemIds;
+
+	/** Crops whose registry data has no HarvestItem tag */
+	TArray<FSoftObjectPath> UntaggedCropPaths;
+
+	/** Whether the untagged assets have been indexed since the last build */
+	bool bUntaggedAssetsIndexed = false;
+
+	/** Background load of the untagged assets, released once they are indexed */
+	TSharedPtr<FStreamableHandle> UntaggedAssetsHandle;
+
+	/** Callbacks waiting for the reverse lookups to be complete */
+	TArray<FSimpleDelegate> ReverseIndexCallbacks;
+
+	/** Lookup keys a miss has already been reported for */
+	mutable TSet<FSoftObjectPath> ReportedMisses;
+
+	/** In-flight async loads, kept alive until they complete */
+	TArray<TSharedPtr<FStreamableHandle>> PendingLoads;
+
+	/** Registry callback handle while waiting for the initial scan */
+	FDelegateHandle FilesLoadedHandle;
+
+	/** Catalog returned by GetActive */
+	static UItemCatalogSubsystem* ActiveCatalog;
+};
@@ -0,0 +1,46 @@
+#include "../Commandlets/UInventoryBenchmarkCommandlet.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryBenchmarkTest, "FungiFields.Benchmarks.Inventory",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FInventoryBenchmarkTest::RunTest(const FString& Parameters)
+{
+	// Held strongly: the benchmark world collects garbage when it is torn down
+	TStrongObjectPtr<UInventoryBenchmarkCommandlet> Benchmark(NewObject<UInventoryBenchmarkCommandlet>(GetTransientPackage()));
+
+	if (!TestTrue(TEXT("Benchmark world created"), Benchmark->RunCases()))
+	{
+		return false;
+	}
+
+	for (const FInventoryBenchmarkResult& Result : Benchmark->GetResults())
+	{
+		AddInfo(FString::Printf(TEXT("%s: %.1f ns/op, %.3f allocs/op"), *Result.Name, Result.NsPerOp, Result.AllocsPerOp));
+	}
+
+	const FString BaselinePath = Benchmark->GetBaselinePath();
+	const bool bWithinBaseline = Benchmark->CompareWithBaseline(BaselinePath);
+
+	if (!Benchmark->IsBaselineMeasured())
+	{
+		AddWarning(FString::Printf(TEXT("%s is not a measured baseline; only allocations were compared"), *BaselinePath));
+	}
+
+	for (const FInventoryBenchmarkResult& Result : Benchmark->GetResults())
+	{
+		if (Result.bRegressed)
+		{
+			AddError(FString::Printf(TEXT("%s regressed: %.1f ns/op (baseline %.1f), %.3f allocs/op (baseline %.3f)"),
+				*Result.Name, Result.NsPerOp, Result.BaselineNsPerOp, Result.AllocsPerOp, Result.BaselineAllocsPerOp));
+		}
+	}
+
+	return TestTrue(FString::Printf(TEXT("Results within baseline %s"), *BaselinePath), bWithinBaseline);
+}
+
+#endif
@@ -0,0 +1,349 @@
+#include "../Actors/ACropBase.h"
+#include "../Actors/ASoilPlot.h"
+#include "../Commandlets/FBenchmarkWorld.h"
+#include "../Components/InventoryComponent.h"
+#include "../Components/UFarmingComponent.h"
+#include "../Components/UPlacementComponent.h"
+#include "../Components/USoilComponent.h"
+#include "../Data/UCropDataAsset.h"
+#include "../Data/UItemDataAsset.h"
+#include "../Data/USoilDataAsset.h"
+#include "../Data/UToolDataAsset.h"
+#include "../ENUM/EToolType.h"
+#include "../Interfaces/IFarmableInterface.h"
+#include "../Subsystems/FFarmAllocationCounter.h"
+#include "../Subsystems/FFarmSimTimings.h"
+#include "../Subsystems/UCropManagerSubsystem.h"
+#include "Camera/CameraComponent.h"
+#include "Components/BoxComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "InputActionValue.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SteadyStateAllocationTest
+{
+	/** Ticks before counting, so first-use caches and the tooltip are set up */
+	static constexpr int32 WarmupTicks = 8;
+
+	/** Ticks counted */
+	static constexpr int32 MeasuredTicks = 120;
+
+	static constexpr float DeltaTime = 1.0f / 60.0f;
+
+	/**
+	 * Spawn a stand-in for the player: a camera at the origin looking along +X, and an inventory.
+	 * @param World World to spawn in
+	 * @param Pitch Camera pitch in degrees
+	 * @return The camera, or nullptr if the actor could not be spawned
+	 */
+	static UCameraComponent* SpawnPlayer(UWorld* World, float Pitch)
+	{
+		AActor* Player = World->SpawnActor<AActor>();
+		if (!Player)
+		{
+			return nullptr;
+		}
+
+		UCameraComponent* Camera = NewObject<UCameraComponent>(Player);
+		Player->SetRootComponent(Camera);
+		Camera->RegisterComponent();
+		Camera->SetWorldRotation(FRotator(Pitch, 0.0f, 0.0f));
+
+		UInventoryComponent* Inventory = NewObject<UInventoryComponent>(Player);
+		Inventory->SetInitialSlotCount(9);
+		Inventory->RegisterComponent();
+
+		return Camera;
+	}
+
+	/**
+	 * Give an actor a box that blocks traces, since the test has no meshes to trace against.
+	 * @param Actor The actor
+	 * @param Location Centre of the box
+	 * @param Extent Half size of the box
+	 */
+	static void AddBlockingBox(AActor* Actor, const FVector& Location, const FVector& Extent)
+	{
+		UBoxComponent* Box = NewObject<UBoxComponent>(Actor);
+		Box->SetBoxExtent(Extent);
+		Box->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+		Box->SetCollisionResponseToAllChannels(ECR_Block);
+
+		if (USceneComponent* Root = Actor->GetRootComponent())
+		{
+			Box->SetupAttachment(Root);
+		}
+		else
+		{
+			Actor->SetRootComponent(Box);
+		}
+
+		Box->RegisterComponent();
+		Box->SetWorldLocation(Location);
+	}
+
+	/**
+	 * Spawn a tilled plot filled with water.
+	 * @param World World to spawn in
+	 * @return The plot, or nullptr if it could not be spawned
+	 */
+	static ASoilPlot* SpawnWateredPlot(UWorld* World)
+	{
+		ASoilPlot* Plot = World->SpawnActor<ASoilPlot>(FVector::ZeroVector, FRotator::ZeroRotator);
+		if (!Plot)
+		{
+			return nullptr;
+		}
+
+		USoilDataAsset* SoilData = NewObject<USoilDataAsset>(GetTransientPackage());
+		Plot->Initialize(SoilData);
+
+		// Soils with a till threshold need several passes
+		for (int32 Pass = 0; Pass < 16 && IFarmableInterface::Execute_CanInteractWithTool(Plot, EToolType::Hoe, nullptr); ++Pass)
+		{
+			IFarmableInterface::Execute_InteractTool(Plot, EToolType::Hoe, nullptr, 1.0f);
+		}
+
+		Plot->GetSoilComponent()->AddWater(SoilData->MaxWaterLevel);
+		return Plot;
+	}
+
+	/**
+	 * Run a step past its warm-up, then count what its allocation-guarded scopes allocate.
+	 * @param Step One steady-state step
+	 * @return Allocations made inside FARM_ALLOCATION_GUARD scopes over MeasuredTicks steps
+	 */
+	static uint64 CountGuardedAllocations(TFunctionRef<void()> Step)
+	{
+		for (int32 Tick = 0; Tick < WarmupTicks; ++Tick)
+		{
+			Step();
+		}
+
+		const bool bWasEnabled = FScopedFarmAllocationGuard::IsEnabled();
+		FScopedFarmAllocationGuard::SetEnabled(true);
+		FScopedFarmAllocationGuard::ResetAllocationCount();
+
+		for (int32 Tick = 0; Tick < MeasuredTicks; ++Tick)
+		{
+			Step();
+		}
+
+		const uint64 AllocationCount = FScopedFarmAllocationGuard::GetAllocationCount();
+		FScopedFarmAllocationGuard::SetEnabled(bWasEnabled);
+		return AllocationCount;
+	}
+
+	/**
+	 * Tick a component past its warm-up, then count what its allocation-guarded scopes allocate.
+	 * @param Component The component
+	 * @return Allocations made inside FARM_ALLOCATION_GUARD scopes over MeasuredTicks ticks
+	 */
+	static uint64 CountGuardedAllocations(UActorComponent* Component)
+	{
+		return CountGuardedAllocations([Component]()
+		{
+			Component->TickComponent(DeltaTime, LEVELTICK_All, nullptr);
+		});
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTraceForFarmableAllocationTest, "FungiFields.Allocations.TraceForFarmable",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FTraceForFarmableAllocationTest::RunTest(const FString& Parameters)
+{
+	using namespace SteadyStateAllocationTest;
+
+	FBenchmarkWorld BenchmarkWorld(TEXT("TraceForFarmableAllocationTest"));
+	UWorld* World = BenchmarkWorld.Get();
+	if (!TestNotNull(TEXT("World"), World))
+	{
+		return false;
+	}
+
+	UCameraComponent* Camera = SpawnPlayer(World, 0.0f);
+	if (!TestNotNull(TEXT("Player"), Camera))
+	{
+		return false;
+	}
+
+	AActor* Player = Camera->GetOwner();
+	UInventoryComponent* Inventory = Player->FindComponentByClass<UInventoryComponent>();
+
+	UToolDataAsset* Hoe = NewObject<UToolDataAsset>(GetTransientPackage());
+	Hoe->ToolType = EToolType::Hoe;
+	Inventory->TryAddItem(Hoe);
+	Inventory->EquipSlot(FInputActionValue(), 0);
+
+	// An untilled plot in front of the camera, so every trace hits it and shows the till prompt
+	ASoilPlot* Plot = World->SpawnActor<ASoilPlot>(FVector(200.0f, 0.0f, 0.0f), FRotator::ZeroRotator);
+	if (!TestNotNull(TEXT("Plot"), Plot))
+	{
+		return false;
+	}
+	Plot->Initialize(NewObject<USoilDataAsset>(GetTransientPackage()));
+	AddBlockingBox(Plot, Plot->GetActorLocation(), FVector(50.0f));
+
+	// Registered after the tool is equipped, so it picks the tool up when it begins play
+	UFarmingComponent* Farming = NewObject<UFarmingComponent>(Player);
+	Farming->RegisterComponent();
+	Farming->SetCamera(Camera);
+
+	const uint64 AllocationCount = CountGuardedAllocations(Farming);
+	return TestEqual(TEXT("Allocations in TraceForFarmable over a steady trace"), AllocationCount, static_cast<uint64>(0));
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPlacementPreviewAllocationTest, "FungiFields.Allocations.PlacementPreview",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPlacementPreviewAllocationTest::RunTest(const FString& Parameters)
+{
+	using namespace SteadyStateAllocationTest;
+
+	FBenchmarkWorld BenchmarkWorld(TEXT("PlacementPreviewAllocationTest"));
+	UWorld* World = BenchmarkWorld.Get();
+	if (!TestNotNull(TEXT("World"), World))
+	{
+		return false;
+	}
+
+	// Looking down at a floor, so every ground trace hits it
+	UCameraComponent* Camera = SpawnPlayer(World, -45.0f);
+	AActor* Floor = World->SpawnActor<AActor>();
+	if (!TestNotNull(TEXT("Player"), Camera) || !TestNotNull(TEXT("Floor"), Floor))
+	{
+		return false;
+	}
+	AddBlockingBox(Floor, FVector(0.0f, 0.0f, -250.0f), FVector(2000.0f, 2000.0f, 50.0f));
+
+	UItemDataAsset* Placeable = NewObject<UItemDataAsset>(GetTransientPackage());
+	Placeable->bIsPlaceable = true;
+	Placeable->PlaceableActorClass = AActor::StaticClass();
+
+	UPlacementComponent* Placement = NewObject<UPlacementComponent>(Camera->GetOwner());
+	Placement->RegisterComponent();
+	Placement->SetCamera(Camera);
+	Placement->EnterPlacementMode(Placeable);
+
+	const uint64 AllocationCount = CountGuardedAllocations(Placement);
+	return TestEqual(TEXT("Allocations in the placement preview over a steady trace"), AllocationCount, static_cast<uint64>(0));
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStepGrowthAllocationTest, "FungiFields.Allocations.StepGrowth",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FStepGrowthAllocationTest::RunTest(const FString& Parameters)
+{
+	using namespace SteadyStateAllocationTest;
+
+	FBenchmarkWorld BenchmarkWorld(TEXT("StepGrowthAllocationTest"));
+	UWorld* World = BenchmarkWorld.Get();
+	if (!TestNotNull(TEXT("World"), World))
+	{
+		return false;
+	}
+
+	ASoilPlot* Plot = SpawnWateredPlot(World);
+	UCropManagerSubsystem* CropManager = World->GetSubsystem<UCropManagerSubsystem>();
+	if (!TestNotNull(TEXT("Plot"), Plot) || !TestNotNull(TEXT("Crop manager"), CropManager))
+	{
+		return false;
+	}
+
+	// Slow enough that the crop stays in its first stage and keeps drawing water for the whole test
+	UCropDataAsset* CropData = NewObject<UCropDataAsset>(GetTransientPackage());
+	CropData->GrowthTimeSeconds = 1000000.0f;
+
+	// Spawned directly: the native plot has no crop class to spawn
+	ACropBase* Crop = World->SpawnActor<ACropBase>(Plot->GetActorLocation(), FRotator::ZeroRotator);
+	if (!TestNotNull(TEXT("Crop"), Crop))
+	{
+		return false;
+	}
+	Crop->Initialize(CropData, Plot);
+	Plot->GetSoilComponent()->SetCrop(Crop);
+
+	if (!TestEqual(TEXT("Registered crops"), CropManager->GetRegisteredCropCount(), 1))
+	{
+		return false;
+	}
+
+	const uint64 AllocationCount = CountGuardedAllocations([CropManager]()
+	{
+		CropManager->StepGrowth(DeltaTime);
+	});
+	return TestEqual(TEXT("Allocations in StepGrowth over steady growth"), AllocationCount, static_cast<uint64>(0));
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStepEvaporationAllocationTest, "FungiFields.Allocations.StepEvaporation",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FStepEvaporationAllocationTest::RunTest(const FString& Parameters)
+{
+	using namespace SteadyStateAllocationTest;
+
+	FBenchmarkWorld BenchmarkWorld(TEXT("StepEvaporationAllocationTest"));
+	UWorld* World = BenchmarkWorld.Get();
+	if (!TestNotNull(TEXT("World"), World))
+	{
+		return false;
+	}
+
+	ASoilPlot* Plot = SpawnWateredPlot(World);
+	if (!TestNotNull(TEXT("Plot"), Plot))
+	{
+		return false;
+	}
+
+	// Each step loses less than FSoilWaterRules::ChangeThreshold, so no listener is told
+	USoilComponent* Soil = Plot->GetSoilComponent();
+	const uint64 AllocationCount = CountGuardedAllocations([Soil]()
+	{
+		Soil->StepEvaporation(DeltaTime * 0.1f);
+	});
+	return TestEqual(TEXT("Allocations in StepEvaporation"), AllocationCount, static_cast<uint64>(0));
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEventDispatchAllocationTest, "FungiFields.Allocations.EventDispatch",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FEventDispatchAllocationTest::RunTest(const FString& Parameters)
+{
+	using namespace SteadyStateAllocationTest;
+
+	FBenchmarkWorld BenchmarkWorld(TEXT("EventDispatchAllocationTest"));
+	UWorld* World = BenchmarkWorld.Get();
+	if (!TestNotNull(TEXT("World"), World))
+	{
+		return false;
+	}
+
+	ASoilPlot* Plot = SpawnWateredPlot(World);
+	if (!TestNotNull(TEXT("Plot"), Plot))
+	{
+		return false;
+	}
+
+	// Each step loses more than FSoilWaterRules::ChangeThreshold, so OnWaterLevelChanged reaches the plot every step
+	USoilComponent* Soil = Plot->GetSoilComponent();
+	FFarmSimTimings::AddEnableRef();
+	const uint64 EventsBefore = FFarmSimTimings::Get().EventCount;
+
+	const uint64 AllocationCount = CountGuardedAllocations([Soil]()
+	{
+		Soil->StepEvaporation(DeltaTime * 6.0f);
+	});
+
+	const uint64 EventCount = FFarmSimTimings::Get().EventCount - EventsBefore;
+	FFarmSimTimings::ReleaseEnableRef();
+
+	TestEqual(TEXT("Water level events broadcast"), EventCount, static_cast<uint64>(WarmupTicks + MeasuredTicks));
+	return TestEqual(TEXT("Allocations dispatching water level events"), AllocationCount, static_cast<uint64>(0));
+}
+
+#endif
@@ -1,4 +1,5 @@
 #include "InteractionWidget.h"
+#include "../FungiFieldsStats.h"
 #include "Components/TextBlock.h"
 #include "Kismet/KismetTextLibrary.h"
 
@@ -48,6 +49,9 @@ void UInteractionWidget::HidePrompt()
 
 void UInteractionWidget::UpdateFromActor(AActor* Interactable)
 {
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmWidgetRefresh, "UInteractionWidget::UpdateFromActor");
+	FScopedFarmSimTiming WidgetTiming(&FFarmSimTimings::WidgetCycles);
+
 	// Optional: pull text from an interface or actor properties.
 	// Example (if you add GetInteractionText() to your interface):
 	// if (Interactable && Interactable->GetClass()->ImplementsInterface(UInteractableInterface::StaticClass()))
@@ -1,4 +1,5 @@
 #include "InventorySlotsWidget.h"
+#include "../FungiFieldsStats.h"
 #include "../Characters/FungiFieldsCharacter.h"
 #include "../Components/InventoryComponent.h"
 #include "../Inventory/FInventorySlot.h"
@@ -10,6 +11,7 @@
 #include "Components/Overlay.h"
 #include "Components/OverlaySlot.h"
 #include "../Data/UItemDataAsset.h"
+#include "../Subsystems/FFarmAssetLoading.h"
 #include "Engine/Texture2D.h"
 
 constexpr int32 UInventorySlotsWidget::HotbarSize;
@@ -57,6 +59,10 @@ void UInventorySlotsWidget::OnItemEquipped(UItemDataAsset* Item, int32 SlotIndex
 
 void UInventorySlotsWidget::UpdateSlotVisuals()
 {
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmWidgetRefresh, "UInventorySlotsWidget::UpdateSlotVisuals");
+	FScopedFarmSimTiming WidgetTiming(&FFarmSimTimings::WidgetCycles);
+	FARM_HITCH_SCOPE(WidgetRebuild, this);
+
 	if (!CachedInventoryComponent || !SlotsContainer)
 	{
 		return;
@@ -70,6 +76,8 @@ void UInventorySlotsWidget::UpdateSlotVisuals()
 		SlotWidgets.SetNum(HotbarSize);
 	}
 
+	MissingIcons.Reset();
+
 	for (int32 i = 0; i < HotbarSize; ++i)
 	{
 		UWidget* SlotWidget = GetOrCreateSlotWidget(i);
@@ -83,6 +91,17 @@ void UInventorySlotsWidget::UpdateSlotVisuals()
 		const bool bIsEquipped = (i == EquippedSlotIndex);
 		UpdateSlotWidget(SlotWidget, SlotData, i, bIsEquipped);
 	}
+
+	// One request covers every icon the hotbar is missing; the slots refresh again when it completes
+	// Icons that failed to load are not requested again
+	if (MissingIcons.Num() > 0 && MissingIcons != RequestedIcons)
+	{
+		RequestedIcons = MissingIcons;
+		IconLoadHandle = FFarmAssetLoading::Prefetch(MissingIcons, FStreamableDelegate::CreateWeakLambda(this, [this]()
+		{
+			UpdateSlotVisuals();
+		}));
+	}
 }
 
 UWidget* UInventorySlotsWidget::GetOrCreateSlotWidget(int32 SlotIndex)
@@ -154,6 +173,9 @@ UWidget* UInventorySlotsWidget::GetOrCreateSlotWidget(int32 SlotIndex)
 
 void UInventorySlotsWidget::UpdateSlotWidget(UWidget* SlotWidget, const FInventorySlot& SlotData, int32 SlotIndex, bool bIsEquipped)
 {
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmWidgetRefresh, "UInventorySlotsWidget::UpdateSlotWidget");
+	FScopedFarmSimTiming WidgetTiming(&FFarmSimTimings::WidgetCycles);
+
 	if (!SlotWidget)
 	{
 		return;
@@ -228,7 +250,7 @@ void UInventorySlotsWidget::UpdateSlotWidget(UWidget* SlotWidget, const FInvento
 	{
 		if (ItemIcon && SlotData.ItemDefinition)
 		{
-			if (UTexture2D* IconTexture = SlotData.ItemDefinition->ItemIcon)
+			if (UTexture2D* IconTexture = SlotData.ItemDefinition->ItemIcon.Get())
 			{
 				{
 					ItemIcon->SetBrushFromTexture(IconTexture, true);
@@ -246,6 +268,10 @@ void UInventorySlotsWidget::UpdateSlotWidget(UWidget* SlotWidget, const FInvento
 			else
 			{
 				ItemIcon->SetVisibility(ESlateVisibility::Collapsed);
+				if (!SlotData.ItemDefinition->ItemIcon.IsNull())
+				{
+					MissingIcons.AddUnique(SlotData.ItemDefinition->ItemIcon.ToSoftObjectPath());
+				}
 			}
 		}
 
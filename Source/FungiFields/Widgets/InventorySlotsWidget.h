@@ -56,5 +56,12 @@ private:
 	UPROPERTY()
 	TArray<TObjectPtr<UWidget>> SlotWidgets;
 
+	/** Icons of the displayed items that were not loaded yet, gathered while updating slots */
+	TArray<FSoftObjectPath> MissingIcons;
+
+	/** Icons of the last load request, and the handle keeping them loaded */
+	TArray<FSoftObjectPath> RequestedIcons;
+	TSharedPtr<struct FStreamableHandle> IconLoadHandle;
+
 	static constexpr int32 HotbarSize = 9;
 };
\ No newline at end of file
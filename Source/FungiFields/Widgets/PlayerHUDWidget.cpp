@@ -1,18 +1,43 @@
 #include "PlayerHUDWidget.h"
+#include "../FungiFieldsStats.h"
 #include "../Characters/FungiFieldsCharacter.h"
 #include "Components/TextBlock.h"
 #include "AbilitySystemComponent.h"
 #include "../Attributes/EconomyAttributeSet.h"
 #include "../Attributes/LevelAttributeSet.h"
 #include "FungiFields/Components/LevelComponent.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/InvalidationBox.h"
+#include "Components/RetainerBox.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
 
 void UPlayerHUDWidget::NativeOnInitialized()
 {
 	Super::NativeOnInitialized();
 
+	if (bCacheHUDContent && !IsDesignTime())
+	{
+		WrapContentInInvalidationBox();
+	}
+
 	BindToAttributeDelegates();
 }
 
+void UPlayerHUDWidget::WrapContentInInvalidationBox()
+{
+	UWidget* Content = WidgetTree ? WidgetTree->RootWidget.Get() : nullptr;
+	if (!Content || Content->IsA<UInvalidationBox>() || Content->IsA<URetainerBox>())
+	{
+		return;
+	}
+
+	UInvalidationBox* InvalidationBox = WidgetTree->ConstructWidget<UInvalidationBox>(UInvalidationBox::StaticClass(), TEXT("HUDInvalidationBox"));
+	InvalidationBox->SetCanCache(true);
+	InvalidationBox->SetContent(Content);
+	WidgetTree->RootWidget = InvalidationBox;
+}
+
 void UPlayerHUDWidget::BindToAttributeDelegates()
 {
 	AFungiFieldsCharacter* PlayerCharacter = GetPlayerCharacter();
@@ -22,74 +47,83 @@ void UPlayerHUDWidget::BindToAttributeDelegates()
 	}
 
 	UAbilitySystemComponent* ASC = PlayerCharacter->GetAbilitySystemComponent();
-	if (!ASC || !PlayerCharacter->EconomyAttributeSet || !PlayerCharacter->LevelComponent ||
-		!PlayerCharacter->LevelAttributeSet)
+	if (!ASC)
 	{
 		return;
 	}
 
 	CachedAbilitySystemComponent = ASC;
+	CachedLevelComponent = PlayerCharacter->LevelComponent;
 
-	if (const UEconomyAttributeSet* EconomyAttributeSet = PlayerCharacter->EconomyAttributeSet)
+	// Each set is bound once; a missing set leaves its part of the HUD unchanged
+	const UEconomyAttributeSet* EconomyAttributeSet = PlayerCharacter->EconomyAttributeSet;
+	if (EconomyAttributeSet && CachedEconomyAttributeSet != EconomyAttributeSet)
 	{
+		CachedEconomyAttributeSet = EconomyAttributeSet;
+
 		ASC->GetGameplayAttributeValueChangeDelegate(EconomyAttributeSet->GetGoldAttribute())
-			.AddUObject(this, &UPlayerHUDWidget::OnGoldUpdated);
-		
-		const float CurrentGold = EconomyAttributeSet->GetGold();
-		if (GoldText)
-		{
-			GoldText->SetText(FText::AsNumber(FMath::FloorToInt(CurrentGold)));
-		}
+			.AddUObject(this, &UPlayerHUDWidget::OnAttributeChanged, DirtyGold);
 	}
 
-	if (const ULevelAttributeSet* LevelAttributeSet = PlayerCharacter->LevelAttributeSet)
+	const ULevelAttributeSet* LevelAttributeSet = PlayerCharacter->LevelAttributeSet;
+	if (LevelAttributeSet && CachedLevelAttributeSet != LevelAttributeSet)
 	{
+		CachedLevelAttributeSet = LevelAttributeSet;
+
+		// The XP bar's maximum depends on the level
 		ASC->GetGameplayAttributeValueChangeDelegate(LevelAttributeSet->GetLevelAttribute())
-			.AddUObject(this, &UPlayerHUDWidget::OnLevelUpdated);
-		
-		const float CurrentLevel = LevelAttributeSet->GetLevel();
-		if (LevelText)
-		{
-			LevelText->SetText(FText::AsNumber(FMath::FloorToInt(CurrentLevel)));
-		}
+			.AddUObject(this, &UPlayerHUDWidget::OnAttributeChanged, static_cast<uint8>(DirtyLevel | DirtyXP));
 
 		ASC->GetGameplayAttributeValueChangeDelegate(LevelAttributeSet->GetXPAttribute())
-			.AddUObject(this, &UPlayerHUDWidget::OnXPUpdated);
-		if (XPBar)
-		{
-			
-		}
+			.AddUObject(this, &UPlayerHUDWidget::OnAttributeChanged, DirtyXP);
 	}
-}
 
-void UPlayerHUDWidget::OnGoldUpdated(const FOnAttributeChangeData& Data)
-{
-	if (GoldText)
-	{
-		const int32 NewGoldAmount = FMath::FloorToInt(Data.NewValue);
-		GoldText->SetText(FText::AsNumber(NewGoldAmount));
-	}
+	DirtyAttributes = DirtyAll;
+	ApplyDirtyAttributes();
 }
 
-void UPlayerHUDWidget::OnXPUpdated(const FOnAttributeChangeData& Data)
+void UPlayerHUDWidget::OnAttributeChanged(const FOnAttributeChangeData& Data, uint8 DirtyFlags)
 {
-	if (XPBar) {
-		AFungiFieldsCharacter* PlayerCharacter = GetPlayerCharacter();
-		if (PlayerCharacter)
+	DirtyAttributes |= DirtyFlags;
+
+	if (!bApplyScheduled)
+	{
+		if (UWorld* World = GetWorld())
 		{
-			const float MaxXP = PlayerCharacter->LevelComponent->GetMaxXP();
-			const float XPPercent = MaxXP > 0.0f ? (Data.NewValue / MaxXP) : 0.0f;
-			XPBar->SetPercent(XPPercent);
+			World->GetTimerManager().SetTimerForNextTick(this, &UPlayerHUDWidget::ApplyDirtyAttributes);
+			bApplyScheduled = true;
 		}
 	}
 }
 
-void UPlayerHUDWidget::OnLevelUpdated(const FOnAttributeChangeData& Data)
+void UPlayerHUDWidget::ApplyDirtyAttributes()
 {
-	if (LevelText)
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmWidgetRefresh, "UPlayerHUDWidget::ApplyDirtyAttributes");
+	FScopedFarmSimTiming WidgetTiming(&FFarmSimTimings::WidgetCycles);
+
+	bApplyScheduled = false;
+
+	const uint8 Dirty = DirtyAttributes;
+	DirtyAttributes = 0;
+
+	if ((Dirty & DirtyGold) && GoldText && CachedEconomyAttributeSet)
 	{
-		const int32 NewLevel = FMath::FloorToInt(Data.NewValue);
-		LevelText->SetText(FText::AsNumber(NewLevel));
+		GoldText->SetText(FText::AsNumber(FMath::FloorToInt(CachedEconomyAttributeSet->GetGold())));
+	}
+
+	if ((Dirty & DirtyLevel) && LevelText && CachedLevelAttributeSet)
+	{
+		LevelText->SetText(FText::AsNumber(FMath::FloorToInt(CachedLevelAttributeSet->GetLevel())));
+	}
+
+	if ((Dirty & DirtyXP) && XPBar && CachedLevelAttributeSet && CachedLevelComponent)
+	{
+		const float MaxXP = CachedLevelComponent->GetMaxXP();
+		const float XPPercent = MaxXP > 0.0f ? (CachedLevelAttributeSet->GetXP() / MaxXP) : 0.0f;
+		if (XPBar->GetPercent() != XPPercent)
+		{
+			XPBar->SetPercent(XPPercent);
+		}
 	}
 }
 
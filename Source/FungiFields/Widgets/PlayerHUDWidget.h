@@ -14,12 +14,15 @@ class AFungiFieldsCharacter;
 class UAbilitySystemComponent;
 class UEconomyAttributeSet;
 class ULevelAttributeSet;
+class ULevelComponent;
 
 /**
  * Main HUD widget that serves as the composition root.
- * Assembles smaller dedicated widgets and binds to data sources.
+ * Assembles smaller dedicated widgets and binds to data sources. Attribute changes are coalesced into a dirty set
+ * that is applied once on the next tick, and the widget does not tick. The HUD's content is cached under an
+ * invalidation box, so frames where no attribute or slot changed cost no HUD layout or paint.
  */
-UCLASS(Abstract)
+UCLASS(Abstract, meta = (DisableNativeTick))
 class FUNGIFIELDS_API UPlayerHUDWidget : public UUserWidget
 {
 	GENERATED_BODY()
@@ -40,12 +43,31 @@ protected:
 	UPROPERTY(meta = (BindWidget))
 	TObjectPtr<UInventorySlotsWidget> InventoryDisplay;
 
+	/** Cache the HUD under an invalidation box so only the widgets that change are laid out and painted again */
+	UPROPERTY(EditDefaultsOnly, Category = "HUD Settings")
+	bool bCacheHUDContent = true;
+
 	virtual void NativeOnInitialized() override;
 
 private:
-	void OnGoldUpdated(const FOnAttributeChangeData& Data);
-	void OnXPUpdated(const FOnAttributeChangeData& Data);
-	void OnLevelUpdated(const FOnAttributeChangeData& Data);
+	/** Texts and bars waiting to be applied, as a mask of the Dirty flags below */
+	static constexpr uint8 DirtyGold = 1 << 0;
+	static constexpr uint8 DirtyLevel = 1 << 1;
+	static constexpr uint8 DirtyXP = 1 << 2;
+	static constexpr uint8 DirtyAll = DirtyGold | DirtyLevel | DirtyXP;
+
+	/**
+	 * Mark what a changed attribute affects dirty and schedule it to be applied.
+	 * @param Data The change
+	 * @param DirtyFlags What the attribute affects
+	 */
+	void OnAttributeChanged(const FOnAttributeChangeData& Data, uint8 DirtyFlags);
+
+	/** Apply the dirty texts and bars from the current attribute values */
+	void ApplyDirtyAttributes();
+
+	/** Put the root widget under an invalidation box that caches it */
+	void WrapContentInInvalidationBox();
 
 	AFungiFieldsCharacter* GetPlayerCharacter() const;
 
@@ -53,4 +75,16 @@ private:
 
 	UPROPERTY()
 	TObjectPtr<UAbilitySystemComponent> CachedAbilitySystemComponent;
+
+	UPROPERTY()
+	TObjectPtr<const UEconomyAttributeSet> CachedEconomyAttributeSet;
+
+	UPROPERTY()
+	TObjectPtr<const ULevelAttributeSet> CachedLevelAttributeSet;
+
+	UPROPERTY()
+	TObjectPtr<ULevelComponent> CachedLevelComponent;
+
+	uint8 DirtyAttributes = 0;
+	bool bApplyScheduled = false;
 };
\ No newline at end of file
@@ -21,3 +21,8 @@ void UQuestEntryWidget::Setup(UQuest* InQuest)
 		ProgressText->SetText(FText::FromString(ProgressStr));
 	}
 }
+
+void UQuestEntryWidget::ResetForPool()
+{
+	Quest = nullptr;
+}
@@ -2,13 +2,14 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "../Interfaces/PooledWidgetInterface.h"
 #include "QuestEntryWidget.generated.h"
 
 class UTextBlock;
 class UQuest;
 
 UCLASS()
-class FUNGIFIELDS_API UQuestEntryWidget : public UUserWidget
+class FUNGIFIELDS_API UQuestEntryWidget : public UUserWidget, public IPooledWidgetInterface
 {
 	GENERATED_BODY()
 
@@ -16,6 +17,9 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void Setup(UQuest* InQuest);
 
+	// IPooledWidgetInterface
+	virtual void ResetForPool() override;
+
 protected:
 	UPROPERTY(meta = (BindWidget))
 	UTextBlock* QuestNameText;
@@ -1,7 +1,9 @@
 #include "QuestMenu.h"
+#include "../FungiFieldsStats.h"
 #include "Components/VerticalBox.h"
 #include "Components/Button.h"
 #include "QuestEntryWidget.h"
+#include "../Subsystems/UFarmWidgetPoolSubsystem.h"
 #include "FungiFields/Components/QuestComponent.h"
 #include "FungiFields/Data/Quest.h"
 #include "GameFramework/PlayerController.h"
@@ -12,40 +14,59 @@ void UQuestMenu::NativeConstruct()
 
 	if (CloseButton)
 	{
-		CloseButton->OnClicked.AddDynamic(this, &UQuestMenu::CloseMenu);
+		CloseButton->OnClicked.AddUniqueDynamic(this, &UQuestMenu::CloseMenu);
 	}
 }
 
 void UQuestMenu::RefreshQuests()
 {
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmWidgetRefresh, "UQuestMenu::RefreshQuests");
+	FScopedFarmSimTiming WidgetTiming(&FFarmSimTimings::WidgetCycles);
+	FARM_HITCH_SCOPE(WidgetRebuild, this);
+
 	if (!QuestList)
 		return;
 
-	QuestList->ClearChildren();
-
-	APlayerController* PC = GetWorld()->GetFirstPlayerController();
-	if (!PC)
+	UFarmWidgetPoolSubsystem* WidgetPool = UFarmWidgetPoolSubsystem::Get(this);
+	if (!WidgetPool)
 		return;
 
-	APawn* Pawn = PC->GetPawn();
-	if (!Pawn)
-		return;
+	TArray<UQuest*> Quests;
+	if (APlayerController* PC = GetWorld()->GetFirstPlayerController())
+	{
+		if (APawn* Pawn = PC->GetPawn())
+		{
+			if (UQuestComponent* QC = Pawn->FindComponentByClass<UQuestComponent>())
+			{
+				Quests = QC->GetAllQuests();
+			}
+		}
+	}
 
-	UQuestComponent* QC = Pawn->FindComponentByClass<UQuestComponent>();
-	if (!QC)
-		return;
+	// Drop any placeholder children from the designer before the first entry is added
+	if (QuestEntries.Num() == 0)
+	{
+		QuestList->ClearChildren();
+	}
 
-	TArray<UQuest*> Quests = QC->GetAllQuests();
+	while (QuestEntries.Num() > Quests.Num())
+	{
+		WidgetPool->Release(QuestEntries.Pop(false));
+	}
 
-	for (UQuest* Quest : Quests)
+	while (QuestEntries.Num() < Quests.Num())
 	{
-		UQuestEntryWidget* Entry = CreateWidget<UQuestEntryWidget>(GetWorld(), QuestEntryWidgetClass);
+		UQuestEntryWidget* Entry = WidgetPool->Acquire<UQuestEntryWidget>(QuestEntryWidgetClass, GetOwningPlayer());
+		if (!Entry)
+			break;
 
-		if (Entry)
-		{
-			Entry->Setup(Quest);
-			QuestList->AddChild(Entry);
-		}
+		QuestList->AddChild(Entry);
+		QuestEntries.Add(Entry);
+	}
+
+	for (int32 i = 0; i < QuestEntries.Num(); ++i)
+	{
+		QuestEntries[i]->Setup(Quests[i]);
 	}
 }
 
@@ -7,6 +7,7 @@
 class UVerticalBox;
 class UQuestComponent;
 class UButton;
+class UQuestEntryWidget;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnQuestMenuClosed);
 
@@ -36,4 +37,9 @@ protected:
 
 	UPROPERTY(EditDefaultsOnly)
 	TSubclassOf<class UQuestEntryWidget> QuestEntryWidgetClass;
+
+private:
+	/** Entries in QuestList, in quest order; refreshes reuse them and only acquire or release the difference */
+	UPROPERTY()
+	TArray<UQuestEntryWidget*> QuestEntries;
 };
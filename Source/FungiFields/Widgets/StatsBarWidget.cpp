@@ -1,10 +1,13 @@
 #include "StatsBarWidget.h"
+#include "../FungiFieldsStats.h"
 #include "../Characters/FungiFieldsCharacter.h"
 #include "Components/ProgressBar.h"
 #include "AbilitySystemComponent.h"
 #include "../Attributes/CharacterAttributeSet.h"
 #include "Components/Widget.h"
 #include "Components/CanvasPanelSlot.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
 
 void UStatsBarWidget::NativeConstruct()
 {
@@ -49,146 +52,103 @@ void UStatsBarWidget::BindToPlayerComponentDelegates()
 	}
 
 	UAbilitySystemComponent* ASC = PlayerCharacter->GetAbilitySystemComponent();
-	if (!ASC || !PlayerCharacter->CharacterAttributeSet)
+	const UCharacterAttributeSet* CharacterAttributeSet = PlayerCharacter->CharacterAttributeSet;
+	if (!ASC || !CharacterAttributeSet)
 	{
 		return;
 	}
 
-	CachedAbilitySystemComponent = ASC;
-
-	if (const UCharacterAttributeSet* CharacterAttributeSet = PlayerCharacter->CharacterAttributeSet)
+	// Constructing again only refreshes the bars; the delegates are bound once
+	if (CachedAttributeSet != CharacterAttributeSet)
 	{
+		CachedAbilitySystemComponent = ASC;
+		CachedAttributeSet = CharacterAttributeSet;
+
 		ASC->GetGameplayAttributeValueChangeDelegate(CharacterAttributeSet->GetHealthAttribute())
-			.AddUObject(this, &UStatsBarWidget::OnHealthUpdated);
+			.AddUObject(this, &UStatsBarWidget::OnAttributeChanged, DirtyHealth);
 
 		ASC->GetGameplayAttributeValueChangeDelegate(CharacterAttributeSet->GetStaminaAttribute())
-			.AddUObject(this, &UStatsBarWidget::OnStaminaUpdated);
+			.AddUObject(this, &UStatsBarWidget::OnAttributeChanged, DirtyStamina);
 
 		ASC->GetGameplayAttributeValueChangeDelegate(CharacterAttributeSet->GetMagicAttribute())
-			.AddUObject(this, &UStatsBarWidget::OnMagicUpdated);
+			.AddUObject(this, &UStatsBarWidget::OnAttributeChanged, DirtyMagic);
 
 		ASC->GetGameplayAttributeValueChangeDelegate(CharacterAttributeSet->GetMaxHealthAttribute())
-			.AddUObject(this, &UStatsBarWidget::OnMaxHealthUpdated);
+			.AddUObject(this, &UStatsBarWidget::OnAttributeChanged, DirtyMaxHealth);
 
 		ASC->GetGameplayAttributeValueChangeDelegate(CharacterAttributeSet->GetMaxStaminaAttribute())
-			.AddUObject(this, &UStatsBarWidget::OnMaxStaminaUpdated);
+			.AddUObject(this, &UStatsBarWidget::OnAttributeChanged, DirtyMaxStamina);
 
 		ASC->GetGameplayAttributeValueChangeDelegate(CharacterAttributeSet->GetMaxMagicAttribute())
-			.AddUObject(this, &UStatsBarWidget::OnMaxMagicUpdated);
+			.AddUObject(this, &UStatsBarWidget::OnAttributeChanged, DirtyMaxMagic);
+	}
 
-		if (HealthBar)
-		{
-			const float CurrentHealth = CharacterAttributeSet->GetHealth();
-			const float MaxHealth = CharacterAttributeSet->GetMaxHealth();
-			const float HealthPercent = MaxHealth > 0.0f ? (CurrentHealth / MaxHealth) : 0.0f;
-			HealthBar->SetPercent(HealthPercent);
-			UpdateBarWidth(HealthBar, MaxHealth, BaseMaxHealth);
-		}
+	DirtyBars = DirtyAll;
+	ApplyDirtyBars();
+}
 
-		if (StaminaBar)
-		{
-			const float CurrentStamina = CharacterAttributeSet->GetStamina();
-			const float MaxStamina = CharacterAttributeSet->GetMaxStamina();
-			const float StaminaPercent = MaxStamina > 0.0f ? (CurrentStamina / MaxStamina) : 0.0f;
-			StaminaBar->SetPercent(StaminaPercent);
-			UpdateBarWidth(StaminaBar, MaxStamina, BaseMaxStamina);
-		}
+void UStatsBarWidget::OnAttributeChanged(const FOnAttributeChangeData& Data, uint8 DirtyFlags)
+{
+	DirtyBars |= DirtyFlags;
 
-		if (MagicBar)
+	if (!bApplyScheduled)
+	{
+		if (UWorld* World = GetWorld())
 		{
-			const float CurrentMagic = CharacterAttributeSet->GetMagic();
-			const float MaxMagic = CharacterAttributeSet->GetMaxMagic();
-			const float MagicPercent = MaxMagic > 0.0f ? (CurrentMagic / MaxMagic) : 0.0f;
-			MagicBar->SetPercent(MagicPercent);
-			UpdateBarWidth(MagicBar, MaxMagic, BaseMaxMagic);
+			World->GetTimerManager().SetTimerForNextTick(this, &UStatsBarWidget::ApplyDirtyBars);
+			bApplyScheduled = true;
 		}
 	}
 }
 
-void UStatsBarWidget::OnHealthUpdated(const FOnAttributeChangeData& Data)
+void UStatsBarWidget::ApplyDirtyBars()
 {
-	if (HealthBar)
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmWidgetRefresh, "UStatsBarWidget::ApplyDirtyBars");
+	FScopedFarmSimTiming WidgetTiming(&FFarmSimTimings::WidgetCycles);
+
+	bApplyScheduled = false;
+
+	const uint8 Dirty = DirtyBars;
+	DirtyBars = 0;
+
+	const UCharacterAttributeSet* AttributeSet = CachedAttributeSet;
+	if (!AttributeSet)
 	{
-		AFungiFieldsCharacter* PlayerCharacter = GetPlayerCharacter();
-		if (PlayerCharacter && PlayerCharacter->CharacterAttributeSet)
-		{
-			const float MaxHealth = PlayerCharacter->CharacterAttributeSet->GetMaxHealth();
-			const float HealthPercent = MaxHealth > 0.0f ? (Data.NewValue / MaxHealth) : 0.0f;
-			HealthBar->SetPercent(HealthPercent);
-		}
+		return;
 	}
-}
 
-void UStatsBarWidget::OnStaminaUpdated(const FOnAttributeChangeData& Data)
-{
-	if (StaminaBar)
+	if (Dirty & (DirtyHealth | DirtyMaxHealth))
 	{
-		AFungiFieldsCharacter* PlayerCharacter = GetPlayerCharacter();
-		if (PlayerCharacter && PlayerCharacter->CharacterAttributeSet)
-		{
-			const float MaxStamina = PlayerCharacter->CharacterAttributeSet->GetMaxStamina();
-			const float StaminaPercent = MaxStamina > 0.0f ? (Data.NewValue / MaxStamina) : 0.0f;
-			StaminaBar->SetPercent(StaminaPercent);
-		}
+		ApplyBar(HealthBar, AttributeSet->GetHealth(), AttributeSet->GetMaxHealth(), BaseMaxHealth, (Dirty & DirtyMaxHealth) != 0);
 	}
-}
 
-void UStatsBarWidget::OnMagicUpdated(const FOnAttributeChangeData& Data)
-{
-	if (MagicBar)
+	if (Dirty & (DirtyStamina | DirtyMaxStamina))
 	{
-		AFungiFieldsCharacter* PlayerCharacter = GetPlayerCharacter();
-		if (PlayerCharacter && PlayerCharacter->CharacterAttributeSet)
-		{
-			const float MaxMagic = PlayerCharacter->CharacterAttributeSet->GetMaxMagic();
-			const float MagicPercent = MaxMagic > 0.0f ? (Data.NewValue / MaxMagic) : 0.0f;
-			MagicBar->SetPercent(MagicPercent);
-		}
+		ApplyBar(StaminaBar, AttributeSet->GetStamina(), AttributeSet->GetMaxStamina(), BaseMaxStamina, (Dirty & DirtyMaxStamina) != 0);
 	}
-}
 
-void UStatsBarWidget::OnMaxHealthUpdated(const FOnAttributeChangeData& Data)
-{
-	if (HealthBar)
+	if (Dirty & (DirtyMagic | DirtyMaxMagic))
 	{
-		UpdateBarWidth(HealthBar, Data.NewValue, BaseMaxHealth);
-		AFungiFieldsCharacter* PlayerCharacter = GetPlayerCharacter();
-		if (PlayerCharacter && PlayerCharacter->CharacterAttributeSet)
-		{
-			const float CurrentHealth = PlayerCharacter->CharacterAttributeSet->GetHealth();
-			const float HealthPercent = Data.NewValue > 0.0f ? (CurrentHealth / Data.NewValue) : 0.0f;
-			HealthBar->SetPercent(HealthPercent);
-		}
+		ApplyBar(MagicBar, AttributeSet->GetMagic(), AttributeSet->GetMaxMagic(), BaseMaxMagic, (Dirty & DirtyMaxMagic) != 0);
 	}
 }
 
-void UStatsBarWidget::OnMaxStaminaUpdated(const FOnAttributeChangeData& Data)
+void UStatsBarWidget::ApplyBar(UProgressBar* Bar, float Current, float Max, float BaseMax, bool bMaxChanged)
 {
-	if (StaminaBar)
+	if (!Bar)
 	{
-		UpdateBarWidth(StaminaBar, Data.NewValue, BaseMaxStamina);
-		AFungiFieldsCharacter* PlayerCharacter = GetPlayerCharacter();
-		if (PlayerCharacter && PlayerCharacter->CharacterAttributeSet)
-		{
-			const float CurrentStamina = PlayerCharacter->CharacterAttributeSet->GetStamina();
-			const float StaminaPercent = Data.NewValue > 0.0f ? (CurrentStamina / Data.NewValue) : 0.0f;
-			StaminaBar->SetPercent(StaminaPercent);
-		}
+		return;
 	}
-}
 
-void UStatsBarWidget::OnMaxMagicUpdated(const FOnAttributeChangeData& Data)
-{
-	if (MagicBar)
+	const float Percent = Max > 0.0f ? (Current / Max) : 0.0f;
+	if (Bar->GetPercent() != Percent)
 	{
-		UpdateBarWidth(MagicBar, Data.NewValue, BaseMaxMagic);
-		AFungiFieldsCharacter* PlayerCharacter = GetPlayerCharacter();
-		if (PlayerCharacter && PlayerCharacter->CharacterAttributeSet)
-		{
-			const float CurrentMagic = PlayerCharacter->CharacterAttributeSet->GetMagic();
-			const float MagicPercent = Data.NewValue > 0.0f ? (CurrentMagic / Data.NewValue) : 0.0f;
-			MagicBar->SetPercent(MagicPercent);
-		}
+		Bar->SetPercent(Percent);
+	}
+
+	if (bMaxChanged)
+	{
+		UpdateBarWidth(Bar, Max, BaseMax);
 	}
 }
 
@@ -222,12 +182,25 @@ void UStatsBarWidget::UpdateBarWidth(UProgressBar* Bar, float CurrentMax, float
 	ScaleFactor = FMath::Clamp(ScaleFactor, MinScaleFactor, MaxScaleFactor);
 	float NewWidth = BaseWidth * ScaleFactor;
 
+	// Only a real change of width costs a layout pass
 	if (UCanvasPanelSlot* CanvasSlot = Cast<UCanvasPanelSlot>(Bar->Slot))
 	{
-		FVector2D CurrentSize = CanvasSlot->GetSize();
-		CanvasSlot->SetSize(FVector2D(NewWidth, CurrentSize.Y));
-		CanvasSlot->SetAlignment(FVector2D(0.0f, 0.5f));
-		CanvasSlot->SetAnchors(FAnchors(0.0f, 0.5f));
+		const FVector2D CurrentSize = CanvasSlot->GetSize();
+		if (CurrentSize.X != NewWidth)
+		{
+			CanvasSlot->SetSize(FVector2D(NewWidth, CurrentSize.Y));
+		}
+
+		if (CanvasSlot->GetAlignment() != FVector2D(0.0f, 0.5f))
+		{
+			CanvasSlot->SetAlignment(FVector2D(0.0f, 0.5f));
+		}
+
+		const FAnchors BarAnchors(0.0f, 0.5f);
+		if (CanvasSlot->GetAnchors().Minimum != BarAnchors.Minimum || CanvasSlot->GetAnchors().Maximum != BarAnchors.Maximum)
+		{
+			CanvasSlot->SetAnchors(BarAnchors);
+		}
 	}
 }
 
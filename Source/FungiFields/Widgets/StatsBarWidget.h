@@ -13,9 +13,10 @@ class UCharacterAttributeSet;
 
 /**
  * Widget dedicated to displaying Health, Stamina, and Magic progress bars.
- * Binds to CharacterAttributeSet via Gameplay Ability System delegates.
+ * Binds to CharacterAttributeSet via Gameplay Ability System delegates. Attribute changes only mark their bar
+ * dirty; dirty bars are applied once on the next tick, however many changes arrived, and the widget does not tick.
  */
-UCLASS(Abstract)
+UCLASS(Abstract, meta = (DisableNativeTick))
 class FUNGIFIELDS_API UStatsBarWidget : public UUserWidget
 {
 	GENERATED_BODY()
@@ -51,17 +52,34 @@ protected:
 	virtual void NativeConstruct() override;
 
 private:
-	void OnHealthUpdated(const FOnAttributeChangeData& Data);
-
-	void OnStaminaUpdated(const FOnAttributeChangeData& Data);
-
-	void OnMagicUpdated(const FOnAttributeChangeData& Data);
-
-	void OnMaxHealthUpdated(const FOnAttributeChangeData& Data);
-
-	void OnMaxStaminaUpdated(const FOnAttributeChangeData& Data);
-
-	void OnMaxMagicUpdated(const FOnAttributeChangeData& Data);
+	/** Bars waiting to be applied, as a mask of the Dirty flags below */
+	static constexpr uint8 DirtyHealth = 1 << 0;
+	static constexpr uint8 DirtyStamina = 1 << 1;
+	static constexpr uint8 DirtyMagic = 1 << 2;
+	static constexpr uint8 DirtyMaxHealth = 1 << 3;
+	static constexpr uint8 DirtyMaxStamina = 1 << 4;
+	static constexpr uint8 DirtyMaxMagic = 1 << 5;
+	static constexpr uint8 DirtyAll = 0x3F;
+
+	/**
+	 * Mark the bars of a changed attribute dirty and schedule them to be applied.
+	 * @param Data The change
+	 * @param DirtyFlags Bars the attribute affects
+	 */
+	void OnAttributeChanged(const FOnAttributeChangeData& Data, uint8 DirtyFlags);
+
+	/** Apply the dirty bars from the current attribute values */
+	void ApplyDirtyBars();
+
+	/**
+	 * Set a bar's fill and, if its maximum changed, its width.
+	 * @param Bar The bar
+	 * @param Current Current attribute value
+	 * @param Max Maximum attribute value
+	 * @param BaseMax Maximum at which the bar has its base width
+	 * @param bMaxChanged Whether to update the width
+	 */
+	void ApplyBar(UProgressBar* Bar, float Current, float Max, float BaseMax, bool bMaxChanged);
 
 	void UpdateBarWidth(UProgressBar* Bar, float CurrentMax, float BaseMax);
 
@@ -75,4 +93,10 @@ private:
 
 	UPROPERTY()
 	TObjectPtr<UAbilitySystemComponent> CachedAbilitySystemComponent;
+
+	UPROPERTY()
+	TObjectPtr<const UCharacterAttributeSet> CachedAttributeSet;
+
+	uint8 DirtyBars = 0;
+	bool bApplyScheduled = false;
 };
\ No newline at end of file
@@ -1,7 +1,9 @@
 #include "UBackpackWidget.h"
+#include "../FungiFieldsStats.h"
 #include "../Characters/FungiFieldsCharacter.h"
 #include "../Components/InventoryComponent.h"
 #include "../Inventory/FInventorySlot.h"
+#include "../Subsystems/UFarmWidgetPoolSubsystem.h"
 #include "UInventorySlotWidget.h"
 #include "UInventoryDragDropOperation.h"
 #include "Components/UniformGridPanel.h"
@@ -21,12 +23,34 @@ void UBackpackWidget::NativeConstruct()
 
 	if (CloseButton)
 	{
-		CloseButton->OnClicked.AddDynamic(this, &UBackpackWidget::OnCloseButtonClicked);
+		CloseButton->OnClicked.AddUniqueDynamic(this, &UBackpackWidget::OnCloseButtonClicked);
 	}
 
 	BindToInventoryComponent();
 }
 
+void UBackpackWidget::NativeDestruct()
+{
+	if (CachedInventoryComponent)
+	{
+		CachedInventoryComponent->OnInventoryChanged.RemoveDynamic(this, &UBackpackWidget::OnInventoryChanged);
+		CachedInventoryComponent = nullptr;
+	}
+
+	// Slots go back to the pool so chest widgets can share them; the UI manager keeps a hidden backpack
+	// constructed, so this runs when the menu is torn down rather than every time it closes
+	if (UFarmWidgetPoolSubsystem* WidgetPool = UFarmWidgetPoolSubsystem::Get(this))
+	{
+		for (UInventorySlotWidget* SlotWidget : SlotWidgets)
+		{
+			WidgetPool->Release(SlotWidget);
+		}
+	}
+	SlotWidgets.Reset();
+
+	Super::NativeDestruct();
+}
+
 FReply UBackpackWidget::NativeOnKeyDown(const FGeometry& MyGeometry, const FKeyEvent& InKeyEvent)
 {
 	if (InKeyEvent.GetKey() == EKeys::Escape || InKeyEvent.GetKey() == EKeys::Tab)
@@ -51,6 +75,10 @@ void UBackpackWidget::CloseBackpack()
 
 void UBackpackWidget::RefreshInventory()
 {
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmWidgetRefresh, "UBackpackWidget::RefreshInventory");
+	FScopedFarmSimTiming WidgetTiming(&FFarmSimTimings::WidgetCycles);
+	FARM_HITCH_SCOPE(WidgetRebuild, this);
+
 	if (!CachedInventoryComponent)
 	{
 		BindToInventoryComponent();
@@ -77,7 +105,7 @@ void UBackpackWidget::BindToInventoryComponent()
 
 	if (IsInViewport() || GetWorld())
 	{
-		InventoryComp->OnInventoryChanged.AddDynamic(this, &UBackpackWidget::OnInventoryChanged);
+		InventoryComp->OnInventoryChanged.AddUniqueDynamic(this, &UBackpackWidget::OnInventoryChanged);
 	}
 
 	UpdateAllSlots();
@@ -85,11 +113,21 @@ void UBackpackWidget::BindToInventoryComponent()
 
 void UBackpackWidget::OnInventoryChanged()
 {
+	// A closed backpack is out of the viewport and refreshes when it is opened
+	if (!IsInViewport())
+	{
+		return;
+	}
+
 	UpdateAllSlots();
 }
 
 void UBackpackWidget::UpdateAllSlots()
 {
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmWidgetRefresh, "UBackpackWidget::UpdateAllSlots");
+	FScopedFarmSimTiming WidgetTiming(&FFarmSimTimings::WidgetCycles);
+	FARM_HITCH_SCOPE(WidgetRebuild, this);
+
 	if (!CachedInventoryComponent)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("UBackpackWidget: CachedInventoryComponent is null!"));
@@ -152,26 +190,20 @@ UInventorySlotWidget* UBackpackWidget::GetOrCreateSlotWidget(int32 SlotIndex)
 		return nullptr;
 	}
 
-	UInventorySlotWidget* SlotWidget = nullptr;
-	if (SlotWidgetClass)
+	UFarmWidgetPoolSubsystem* WidgetPool = UFarmWidgetPoolSubsystem::Get(this);
+	if (!WidgetPool)
 	{
-		UWorld* World = GetWorld();
-		if (World)
-		{
-			SlotWidget = CreateWidget<UInventorySlotWidget>(World, SlotWidgetClass);
-		}
+		return nullptr;
 	}
-	
-	if (!SlotWidget)
+
+	if (!SlotWidgetClass)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("UBackpackWidget: SlotWidgetClass not set! Creating default slot widget. Please set SlotWidgetClass in Blueprint."));
-		UWorld* World = GetWorld();
-		if (World)
-		{
-			SlotWidget = CreateWidget<UInventorySlotWidget>(World, UInventorySlotWidget::StaticClass());
-		}
+		UE_LOG(LogTemp, Warning, TEXT("UBackpackWidget: SlotWidgetClass not set! Using default slot widget. Please set SlotWidgetClass in Blueprint."));
 	}
 
+	UInventorySlotWidget* SlotWidget = WidgetPool->Acquire<UInventorySlotWidget>(
+		SlotWidgetClass ? SlotWidgetClass : TSubclassOf<UInventorySlotWidget>(UInventorySlotWidget::StaticClass()), GetOwningPlayer());
+
 	if (!SlotWidget)
 	{
 		UE_LOG(LogTemp, Error, TEXT("UBackpackWidget: Failed to create slot widget!"));
@@ -1,6 +1,8 @@
 #include "UChestWidget.h"
+#include "../FungiFieldsStats.h"
 #include "../Components/InventoryComponent.h"
 #include "../Inventory/FInventorySlot.h"
+#include "../Subsystems/UFarmWidgetPoolSubsystem.h"
 #include "UInventorySlotWidget.h"
 #include "UInventoryDragDropOperation.h"
 #include "Components/UniformGridPanel.h"
@@ -21,7 +23,7 @@ void UChestWidget::NativeConstruct()
 
 	if (CloseButton)
 	{
-		CloseButton->OnClicked.AddDynamic(this, &UChestWidget::OnCloseButtonClicked);
+		CloseButton->OnClicked.AddUniqueDynamic(this, &UChestWidget::OnCloseButtonClicked);
 	}
 }
 
@@ -39,7 +41,7 @@ void UChestWidget::SetupInventories(UInventoryComponent* PlayerInventoryComp, UI
 	{
 		if (IsInViewport() || GetWorld())
 		{
-			PlayerInventory->OnInventoryChanged.AddDynamic(this, &UChestWidget::OnPlayerInventoryChanged);
+			PlayerInventory->OnInventoryChanged.AddUniqueDynamic(this, &UChestWidget::OnPlayerInventoryChanged);
 		}
 		UpdatePlayerSlots();
 	}
@@ -48,12 +50,33 @@ void UChestWidget::SetupInventories(UInventoryComponent* PlayerInventoryComp, UI
 	{
 		if (IsInViewport() || GetWorld())
 		{
-			ChestInventory->OnInventoryChanged.AddDynamic(this, &UChestWidget::OnChestInventoryChanged);
+			ChestInventory->OnInventoryChanged.AddUniqueDynamic(this, &UChestWidget::OnChestInventoryChanged);
 		}
 		UpdateChestSlots();
 	}
 }
 
+void UChestWidget::ResetForPool()
+{
+	if (PlayerInventory)
+	{
+		PlayerInventory->OnInventoryChanged.RemoveDynamic(this, &UChestWidget::OnPlayerInventoryChanged);
+	}
+
+	if (ChestInventory)
+	{
+		ChestInventory->OnInventoryChanged.RemoveDynamic(this, &UChestWidget::OnChestInventoryChanged);
+	}
+
+	PlayerInventory = nullptr;
+	ChestInventory = nullptr;
+	OnChestWidgetClosed.Clear();
+
+	// Slots go back to the pool so the backpack and other chest widgets can share them
+	ReleaseSlotWidgets(PlayerSlotWidgets);
+	ReleaseSlotWidgets(ChestSlotWidgets);
+}
+
 void UChestWidget::CloseWidget()
 {
 	RemoveFromParent();
@@ -94,6 +117,10 @@ void UChestWidget::OnChestInventoryChanged()
 
 void UChestWidget::UpdatePlayerSlots()
 {
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmWidgetRefresh, "UChestWidget::UpdatePlayerSlots");
+	FScopedFarmSimTiming WidgetTiming(&FFarmSimTimings::WidgetCycles);
+	FARM_HITCH_SCOPE(WidgetRebuild, this);
+
 	if (!PlayerInventory)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("UChestWidget: PlayerInventory is null!"));
@@ -141,6 +168,10 @@ void UChestWidget::UpdatePlayerSlots()
 
 void UChestWidget::UpdateChestSlots()
 {
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmWidgetRefresh, "UChestWidget::UpdateChestSlots");
+	FScopedFarmSimTiming WidgetTiming(&FFarmSimTimings::WidgetCycles);
+	FARM_HITCH_SCOPE(WidgetRebuild, this);
+
 	if (!ChestInventory)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("UChestWidget: ChestInventory is null!"));
@@ -211,29 +242,9 @@ UInventorySlotWidget* UChestWidget::GetOrCreatePlayerSlotWidget(int32 SlotIndex)
 		return nullptr;
 	}
 
-	UInventorySlotWidget* SlotWidget = nullptr;
-	if (SlotWidgetClass)
-	{
-		UWorld* World = GetWorld();
-		if (World)
-		{
-			SlotWidget = CreateWidget<UInventorySlotWidget>(World, SlotWidgetClass);
-		}
-	}
-	
-	if (!SlotWidget)
-	{
-		UE_LOG(LogTemp, Warning, TEXT("UChestWidget: SlotWidgetClass not set! Creating default slot widget. Please set SlotWidgetClass in Blueprint."));
-		UWorld* World = GetWorld();
-		if (World)
-		{
-			SlotWidget = CreateWidget<UInventorySlotWidget>(World, UInventorySlotWidget::StaticClass());
-		}
-	}
-
+	UInventorySlotWidget* SlotWidget = AcquireSlotWidget();
 	if (!SlotWidget)
 	{
-		UE_LOG(LogTemp, Error, TEXT("UChestWidget: Failed to create slot widget!"));
 		return nullptr;
 	}
 
@@ -289,29 +300,9 @@ UInventorySlotWidget* UChestWidget::GetOrCreateChestSlotWidget(int32 SlotIndex)
 		return nullptr;
 	}
 
-	UInventorySlotWidget* SlotWidget = nullptr;
-	if (SlotWidgetClass)
-	{
-		UWorld* World = GetWorld();
-		if (World)
-		{
-			SlotWidget = CreateWidget<UInventorySlotWidget>(World, SlotWidgetClass);
-		}
-	}
-	
+	UInventorySlotWidget* SlotWidget = AcquireSlotWidget();
 	if (!SlotWidget)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("UChestWidget: SlotWidgetClass not set! Creating default slot widget. Please set SlotWidgetClass in Blueprint."));
-		UWorld* World = GetWorld();
-		if (World)
-		{
-			SlotWidget = CreateWidget<UInventorySlotWidget>(World, UInventorySlotWidget::StaticClass());
-		}
-	}
-
-	if (!SlotWidget)
-	{
-		UE_LOG(LogTemp, Error, TEXT("UChestWidget: Failed to create slot widget!"));
 		return nullptr;
 	}
 
@@ -345,6 +336,44 @@ UInventorySlotWidget* UChestWidget::GetOrCreateChestSlotWidget(int32 SlotIndex)
 	return SlotWidget;
 }
 
+UInventorySlotWidget* UChestWidget::AcquireSlotWidget()
+{
+	UFarmWidgetPoolSubsystem* WidgetPool = UFarmWidgetPoolSubsystem::Get(this);
+	if (!WidgetPool)
+	{
+		return nullptr;
+	}
+
+	if (!SlotWidgetClass)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UChestWidget: SlotWidgetClass not set! Using default slot widget. Please set SlotWidgetClass in Blueprint."));
+	}
+
+	UInventorySlotWidget* SlotWidget = WidgetPool->Acquire<UInventorySlotWidget>(
+		SlotWidgetClass ? SlotWidgetClass : TSubclassOf<UInventorySlotWidget>(UInventorySlotWidget::StaticClass()), GetOwningPlayer());
+
+	if (!SlotWidget)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UChestWidget: Failed to create slot widget!"));
+	}
+
+	return SlotWidget;
+}
+
+void UChestWidget::ReleaseSlotWidgets(TArray<TObjectPtr<UInventorySlotWidget>>& SlotWidgets)
+{
+	UFarmWidgetPoolSubsystem* WidgetPool = UFarmWidgetPoolSubsystem::Get(this);
+	if (WidgetPool)
+	{
+		for (UInventorySlotWidget* SlotWidget : SlotWidgets)
+		{
+			WidgetPool->Release(SlotWidget);
+		}
+	}
+
+	SlotWidgets.Reset();
+}
+
 void UChestWidget::HandlePlayerSlotClicked(int32 SlotIndex, int32 InventorySourceID)
 {
 }
@@ -386,38 +415,14 @@ bool UChestWidget::HandleItemTransfer(int32 SourceSlotIndex, int32 SourceInvento
 	{
 		if (PlayerInventory && ChestInventory)
 		{
-			const TArray<FInventorySlot>& PlayerSlots = PlayerInventory->GetInventorySlots();
-			if (PlayerSlots.IsValidIndex(SourceSlotIndex) && !PlayerSlots[SourceSlotIndex].IsEmpty())
-			{
-				const FInventorySlot& SourceSlot = PlayerSlots[SourceSlotIndex];
-				if (SourceSlot.ItemDefinition)
-				{
-					if (ChestInventory->TryAddItem(const_cast<UItemDataAsset*>(SourceSlot.ItemDefinition.Get()), SourceSlot.Count))
-					{
-						PlayerInventory->ConsumeFromSlot(SourceSlotIndex, SourceSlot.Count);
-						return true;
-					}
-				}
-			}
+			return PlayerInventory->TransferSlotTo(SourceSlotIndex, ChestInventory);
 		}
 	}
 	else if (SourceInventoryID == 1 && TargetInventoryID == 0)
 	{
 		if (PlayerInventory && ChestInventory)
 		{
-			const TArray<FInventorySlot>& ChestSlots = ChestInventory->GetInventorySlots();
-			if (ChestSlots.IsValidIndex(SourceSlotIndex) && !ChestSlots[SourceSlotIndex].IsEmpty())
-			{
-				const FInventorySlot& SourceSlot = ChestSlots[SourceSlotIndex];
-				if (SourceSlot.ItemDefinition)
-				{
-					if (PlayerInventory->TryAddItem(const_cast<UItemDataAsset*>(SourceSlot.ItemDefinition.Get()), SourceSlot.Count))
-					{
-						ChestInventory->RemoveFromSlot(SourceSlotIndex, SourceSlot.Count);
-						return true;
-					}
-				}
-			}
+			return ChestInventory->TransferSlotTo(SourceSlotIndex, PlayerInventory);
 		}
 	}
 
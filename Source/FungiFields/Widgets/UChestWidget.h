@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "../Interfaces/PooledWidgetInterface.h"
 #include "UChestWidget.generated.h"
 
 class UInventoryComponent;
@@ -17,7 +18,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnChestWidgetClosed);
  * Allows drag & drop between the two inventories.
  */
 UCLASS(Abstract)
-class FUNGIFIELDS_API UChestWidget : public UUserWidget
+class FUNGIFIELDS_API UChestWidget : public UUserWidget, public IPooledWidgetInterface
 {
 	GENERATED_BODY()
 
@@ -32,6 +33,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Chest Widget")
 	void CloseWidget();
 
+	// IPooledWidgetInterface
+	virtual void ResetForPool() override;
+
 	/** Delegate broadcast when chest widget is closed */
 	UPROPERTY(BlueprintAssignable, Category = "Chest Widget")
 	FOnChestWidgetClosed OnChestWidgetClosed;
@@ -79,6 +83,12 @@ private:
 	void UpdateChestSlots();
 	UInventorySlotWidget* GetOrCreatePlayerSlotWidget(int32 SlotIndex);
 	UInventorySlotWidget* GetOrCreateChestSlotWidget(int32 SlotIndex);
+
+	/** Take a slot widget of SlotWidgetClass from the widget pool */
+	UInventorySlotWidget* AcquireSlotWidget();
+
+	/** Give slot widgets back to the widget pool and empty the array */
+	void ReleaseSlotWidgets(TArray<TObjectPtr<UInventorySlotWidget>>& SlotWidgets);
 	
 	UFUNCTION()
 	void HandlePlayerSlotClicked(int32 SlotIndex, int32 InventorySourceID);
@@ -0,0 +1,201 @@
+#include "UFarmPerfOverlayWidget.h"
+#include "../Characters/FungiFieldsCharacter.h"
+#include "../Subsystems/UCropManagerSubsystem.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/TextBlock.h"
+#include "Components/VerticalBox.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "TimerManager.h"
+
+namespace
+{
+	enum EFarmPerfRow : int32
+	{
+		Row_Crops,
+		Row_Evaporation,
+		Row_Events,
+		Row_Traces,
+		Row_Actors,
+		Row_Inventory,
+		Row_GrowthMs,
+		Row_EvaporationMs,
+		Row_EventMs,
+		Row_VisualMs,
+		Row_TraceMs,
+		Row_InventoryMs,
+		Row_WidgetMs,
+		Row_Count
+	};
+
+	const TCHAR* RowFormats[Row_Count] =
+	{
+		TEXT("Crops: {0} registered, {1} updates/s"),
+		TEXT("Evaporation: {0} updates/s"),
+		TEXT("Events: {0}/frame"),
+		TEXT("Traces: {0}/frame"),
+		TEXT("Actors: {0} spawned/s, {1} pooled/s"),
+		TEXT("Inventory: {0} ops/s"),
+		TEXT("Growth: {0} ms"),
+		TEXT("Evaporation: {0} ms"),
+		TEXT("Events: {0} ms"),
+		TEXT("Visuals: {0} ms"),
+		TEXT("Traces: {0} ms"),
+		TEXT("Inventory: {0} ms"),
+		TEXT("Widgets: {0} ms")
+	};
+
+	FAutoConsoleCommandWithWorldAndArgs FarmPerfOverlayCommand(
+		TEXT("Farm.PerfOverlay"),
+		TEXT("Toggle the farm performance overlay. Usage: Farm.PerfOverlay [0|1]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+			if (AFungiFieldsCharacter* Character = PC ? Cast<AFungiFieldsCharacter>(PC->GetPawn()) : nullptr)
+			{
+				Character->SetPerfOverlayVisible(Args.Num() > 0 ? FCString::ToBool(*Args[0]) : !Character->IsPerfOverlayVisible());
+			}
+		}));
+}
+
+void UFarmPerfOverlayWidget::NativeOnInitialized()
+{
+	Super::NativeOnInitialized();
+
+	CreateRows();
+}
+
+void UFarmPerfOverlayWidget::NativeConstruct()
+{
+	Super::NativeConstruct();
+
+	FFarmSimTimings::AddEnableRef();
+
+	LastTimings = FFarmSimTimings::Get();
+	LastFrameCounter = GFrameCounter;
+	LastSampleSeconds = FPlatformTime::Seconds();
+
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().SetTimer(SampleTimerHandle, this, &UFarmPerfOverlayWidget::Sample, SampleInterval, true);
+	}
+}
+
+void UFarmPerfOverlayWidget::NativeDestruct()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(SampleTimerHandle);
+	}
+
+	FFarmSimTimings::ReleaseEnableRef();
+
+	Super::NativeDestruct();
+}
+
+void UFarmPerfOverlayWidget::CreateRows()
+{
+	if (!WidgetTree)
+	{
+		return;
+	}
+
+	if (!RowContainer)
+	{
+		RowContainer = WidgetTree->ConstructWidget<UVerticalBox>(UVerticalBox::StaticClass());
+		if (!WidgetTree->RootWidget)
+		{
+			WidgetTree->RootWidget = RowContainer;
+		}
+	}
+
+	Rows.SetNum(Row_Count);
+	RowTexts.Reset(Row_Count);
+
+	for (int32 RowIndex = 0; RowIndex < Row_Count; ++RowIndex)
+	{
+		Rows[RowIndex].Format = FTextFormat::FromString(RowFormats[RowIndex]);
+
+		UTextBlock* Text = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass());
+		Text->SetColorAndOpacity(FSlateColor(NormalColor));
+		RowContainer->AddChildToVerticalBox(Text);
+		RowTexts.Add(Text);
+	}
+}
+
+void UFarmPerfOverlayWidget::Sample()
+{
+	const FFarmSimTimings& Timings = FFarmSimTimings::Get();
+	const double Now = FPlatformTime::Seconds();
+	const double Seconds = FMath::Max(Now - LastSampleSeconds, KINDA_SMALL_NUMBER);
+	const double Frames = FMath::Max<uint64>(GFrameCounter - LastFrameCounter, 1);
+
+	// Counters go backwards if a benchmark reset them; treat that sample as empty
+	auto Delta = [this, &Timings](uint64 FFarmSimTimings::* Member) -> double
+	{
+		return Timings.*Member >= LastTimings.*Member ? static_cast<double>(Timings.*Member - LastTimings.*Member) : 0.0;
+	};
+
+	const UCropManagerSubsystem* CropManager = GetWorld() ? GetWorld()->GetSubsystem<UCropManagerSubsystem>() : nullptr;
+	SetRow(Row_Crops, CropManager ? CropManager->GetRegisteredCropCount() : 0, Delta(&FFarmSimTimings::CropUpdateCount) / Seconds);
+	SetRow(Row_Evaporation, Delta(&FFarmSimTimings::EvaporationCount) / Seconds);
+	SetRow(Row_Events, Delta(&FFarmSimTimings::EventCount) / Frames);
+	SetRow(Row_Traces, Delta(&FFarmSimTimings::TraceCount) / Frames);
+	SetRow(Row_Actors, Delta(&FFarmSimTimings::ActorSpawnCount) / Seconds, Delta(&FFarmSimTimings::PoolReuseCount) / Seconds);
+	SetRow(Row_Inventory, Delta(&FFarmSimTimings::InventoryOpCount) / Seconds);
+
+	const double MsPerFrame = FPlatformTime::GetSecondsPerCycle64() * 1000.0 / Frames;
+	auto MsPerFrameOf = [&Delta, MsPerFrame](uint64 FFarmSimTimings::* Cycles) { return Delta(Cycles) * MsPerFrame; };
+
+	const double GrowthMs = MsPerFrameOf(&FFarmSimTimings::GrowthCycles);
+	SetRow(Row_GrowthMs, GrowthMs, 0.0, GrowthMs > GrowthBudgetMs);
+	const double EvaporationMs = MsPerFrameOf(&FFarmSimTimings::EvaporationCycles);
+	SetRow(Row_EvaporationMs, EvaporationMs, 0.0, EvaporationMs > EvaporationBudgetMs);
+	const double EventMs = MsPerFrameOf(&FFarmSimTimings::EventCycles);
+	SetRow(Row_EventMs, EventMs, 0.0, EventMs > EventBudgetMs);
+	const double VisualMs = MsPerFrameOf(&FFarmSimTimings::VisualCycles);
+	SetRow(Row_VisualMs, VisualMs, 0.0, VisualMs > VisualBudgetMs);
+	const double TraceMs = MsPerFrameOf(&FFarmSimTimings::TraceCycles);
+	SetRow(Row_TraceMs, TraceMs, 0.0, TraceMs > TraceBudgetMs);
+	const double InventoryMs = MsPerFrameOf(&FFarmSimTimings::InventoryCycles);
+	SetRow(Row_InventoryMs, InventoryMs, 0.0, InventoryMs > InventoryBudgetMs);
+	const double WidgetMs = MsPerFrameOf(&FFarmSimTimings::WidgetCycles);
+	SetRow(Row_WidgetMs, WidgetMs, 0.0, WidgetMs > WidgetBudgetMs);
+
+	LastTimings = Timings;
+	LastFrameCounter = GFrameCounter;
+	LastSampleSeconds = Now;
+}
+
+void UFarmPerfOverlayWidget::SetRow(int32 RowIndex, double Value, double SecondValue, bool bOverBudget)
+{
+	if (!Rows.IsValidIndex(RowIndex) || !RowTexts.IsValidIndex(RowIndex) || !RowTexts[RowIndex])
+	{
+		return;
+	}
+
+	// Compare at display precision so jitter in the last digits does not rebuild the text
+	const double RoundedValue = FMath::RoundToDouble(Value * 100.0) / 100.0;
+	const double RoundedSecondValue = FMath::RoundToDouble(SecondValue * 100.0) / 100.0;
+
+	FOverlayRow& Row = Rows[RowIndex];
+	UTextBlock* Text = RowTexts[RowIndex];
+
+	if (Row.Values[0] != RoundedValue || Row.Values[1] != RoundedSecondValue)
+	{
+		Row.Values[0] = RoundedValue;
+		Row.Values[1] = RoundedSecondValue;
+
+		FNumberFormattingOptions NumberFormat;
+		NumberFormat.MinimumFractionalDigits = 0;
+		NumberFormat.MaximumFractionalDigits = 2;
+		Text->SetText(FText::Format(Row.Format, FText::AsNumber(RoundedValue, &NumberFormat), FText::AsNumber(RoundedSecondValue, &NumberFormat)));
+	}
+
+	if (Row.bOverBudget != bOverBudget)
+	{
+		Row.bOverBudget = bOverBudget;
+		Text->SetColorAndOpacity(FSlateColor(bOverBudget ? OverBudgetColor : NormalColor));
+	}
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "../Subsystems/FFarmSimTimings.h"
+#include "UFarmPerfOverlayWidget.generated.h"
+
+class UTextBlock;
+class UVerticalBox;
+
+/**
+ * Debug overlay shown next to the player HUD with rolling farm performance stats: crop and evaporation
+ * update rates, events and traces per frame, spawned versus pooled objects, inventory operations and
+ * per-system milliseconds per frame, highlighted when over budget.
+ * Stats come from FFarmSimTimings, which the overlay enables while it is on screen. The rows are sampled
+ * on a timer rather than ticked, and a row's text is only rebuilt when its displayed value changes.
+ * Toggle with Farm.PerfOverlay. Builds its own rows when no widget tree is provided by a Blueprint subclass.
+ */
+UCLASS()
+class FUNGIFIELDS_API UFarmPerfOverlayWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void NativeOnInitialized() override;
+	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
+
+	/** Optional container for the rows; created when the widget has no tree */
+	UPROPERTY(meta = (BindWidgetOptional))
+	TObjectPtr<UVerticalBox> RowContainer;
+
+	/** Seconds between samples */
+	UPROPERTY(EditDefaultsOnly, Category = "Overlay Settings", meta = (ClampMin = "0.1"))
+	float SampleInterval = 0.5f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Overlay Settings")
+	FLinearColor NormalColor = FLinearColor::White;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Overlay Settings")
+	FLinearColor OverBudgetColor = FLinearColor(1.0f, 0.25f, 0.2f, 1.0f);
+
+	/** Crop growth budget in ms per frame */
+	UPROPERTY(EditDefaultsOnly, Category = "Overlay Settings|Budgets")
+	float GrowthBudgetMs = 0.5f;
+
+	/** Water evaporation budget in ms per frame */
+	UPROPERTY(EditDefaultsOnly, Category = "Overlay Settings|Budgets")
+	float EvaporationBudgetMs = 0.25f;
+
+	/** Farm event broadcast budget in ms per frame */
+	UPROPERTY(EditDefaultsOnly, Category = "Overlay Settings|Budgets")
+	float EventBudgetMs = 0.25f;
+
+	/** Plot and crop visual budget in ms per frame */
+	UPROPERTY(EditDefaultsOnly, Category = "Overlay Settings|Budgets")
+	float VisualBudgetMs = 0.25f;
+
+	/** Trace budget in ms per frame */
+	UPROPERTY(EditDefaultsOnly, Category = "Overlay Settings|Budgets")
+	float TraceBudgetMs = 0.1f;
+
+	/** Inventory mutation budget in ms per frame */
+	UPROPERTY(EditDefaultsOnly, Category = "Overlay Settings|Budgets")
+	float InventoryBudgetMs = 0.1f;
+
+	/** Widget refresh budget in ms per frame */
+	UPROPERTY(EditDefaultsOnly, Category = "Overlay Settings|Budgets")
+	float WidgetBudgetMs = 0.5f;
+
+private:
+	/** One line of the overlay */
+	struct FOverlayRow
+	{
+		FTextFormat Format;
+
+		/** Displayed values; the text is rebuilt only when one of them changes */
+		double Values[2] = { -1.0, -1.0 };
+
+		bool bOverBudget = false;
+	};
+
+	/** Create the row container and its text blocks */
+	void CreateRows();
+
+	/** Read the timings and update the rows */
+	void Sample();
+
+	/**
+	 * Update a row, rebuilding its text only if a value changed.
+	 * @param RowIndex Row to update
+	 * @param Value First displayed value
+	 * @param SecondValue Second displayed value, if the row's format has one
+	 * @param bOverBudget Whether to highlight the row
+	 */
+	void SetRow(int32 RowIndex, double Value, double SecondValue = 0.0, bool bOverBudget = false);
+
+	UPROPERTY()
+	TArray<TObjectPtr<UTextBlock>> RowTexts;
+
+	TArray<FOverlayRow> Rows;
+
+	/** Timings at the previous sample */
+	FFarmSimTimings LastTimings;
+
+	uint64 LastFrameCounter = 0;
+	double LastSampleSeconds = 0.0;
+
+	FTimerHandle SampleTimerHandle;
+};
@@ -1,9 +1,11 @@
 #include "UInventorySlotWidget.h"
+#include "../FungiFieldsStats.h"
 #include "UInventoryDragDropOperation.h"
 #include "Components/Border.h"
 #include "Components/Image.h"
 #include "Components/TextBlock.h"
 #include "../Data/UItemDataAsset.h"
+#include "../Subsystems/FFarmAssetLoading.h"
 #include "Engine/Texture2D.h"
 #include "Blueprint/DragDropOperation.h"
 #include "Slate/SlateBrushAsset.h"
@@ -71,6 +73,27 @@ void UInventorySlotWidget::SetSlotData(const FInventorySlot& SlotData, int32 InS
 	UpdateSlotVisuals();
 }
 
+void UInventorySlotWidget::ResetForPool()
+{
+	OnSlotClicked.Clear();
+	OnDragStarted.Clear();
+	OnSlotDropped.Clear();
+
+	if (IconLoadHandle.IsValid())
+	{
+		IconLoadHandle->ReleaseHandle();
+		IconLoadHandle.Reset();
+	}
+	PendingIconPath.Reset();
+
+	CurrentSlotData = FInventorySlot();
+	SlotIndex = INDEX_NONE;
+	InventorySourceID = 0;
+	bIsEquipped = false;
+	bIsDragTarget = false;
+	UpdateSlotVisuals();
+}
+
 void UInventorySlotWidget::SetEquipped(bool bInIsEquipped)
 {
 	bIsEquipped = bInIsEquipped;
@@ -79,6 +102,8 @@ void UInventorySlotWidget::SetEquipped(bool bInIsEquipped)
 
 void UInventorySlotWidget::CreateWidgetStructure()
 {
+	LLM_SCOPE_BYTAG(Farm_Widgets);
+
 	SlotBorder = NewObject<UBorder>(this);
 	SlotBorder->SetPadding(FMargin(2.0f));
 	
@@ -132,6 +157,9 @@ void UInventorySlotWidget::CreateWidgetStructure()
 
 void UInventorySlotWidget::UpdateSlotVisuals()
 {
+	FARM_SCOPE_CYCLE_COUNTER(STAT_FarmWidgetRefresh, "UInventorySlotWidget::UpdateSlotVisuals");
+	FScopedFarmSimTiming WidgetTiming(&FFarmSimTimings::WidgetCycles);
+
 	if (!SlotBorder)
 	{
 		SlotBorder = Cast<UBorder>(GetRootWidget());
@@ -186,7 +214,8 @@ void UInventorySlotWidget::UpdateSlotVisuals()
 		}
 		else
 		{
-			if (UTexture2D* IconTexture = CurrentSlotData.ItemDefinition->ItemIcon)
+			const TSoftObjectPtr<UTexture2D>& IconReference = CurrentSlotData.ItemDefinition->ItemIcon;
+			if (UTexture2D* IconTexture = IconReference.Get())
 			{
 				ItemIcon->SetBrushFromTexture(IconTexture, true);
 				FSlateBrush Brush = ItemIcon->GetBrush();
@@ -200,6 +229,7 @@ void UInventorySlotWidget::UpdateSlotVisuals()
 			else
 			{
 				ItemIcon->SetVisibility(ESlateVisibility::Collapsed);
+				RequestIcon(IconReference.ToSoftObjectPath());
 			}
 		}
 	}
@@ -219,6 +249,21 @@ void UInventorySlotWidget::UpdateSlotVisuals()
 	}
 }
 
+void UInventorySlotWidget::RequestIcon(const FSoftObjectPath& IconPath)
+{
+	// An icon that failed to load is not requested again
+	if (IconPath.IsNull() || PendingIconPath == IconPath)
+	{
+		return;
+	}
+
+	PendingIconPath = IconPath;
+	IconLoadHandle = FFarmAssetLoading::Prefetch({ IconPath }, FStreamableDelegate::CreateWeakLambda(this, [this]()
+	{
+		UpdateSlotVisuals();
+	}));
+}
+
 FReply UInventorySlotWidget::NativeOnMouseButtonDown(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
 {
 	if (MouseEvent.GetEffectingButton() == EKeys::LeftMouseButton)
@@ -309,9 +354,10 @@ void UInventorySlotWidget::NativeOnDragDetected(const FGeometry& MyGeometry, con
 				// Update the visual appearance
 				CachedDragVisual->SetBrushColor(SlotBorder->GetBrushColor());
 				
-				if (CachedDragIcon && CurrentSlotData.ItemDefinition && CurrentSlotData.ItemDefinition->ItemIcon)
+				UTexture2D* DragTexture = CurrentSlotData.ItemDefinition ? CurrentSlotData.ItemDefinition->ItemIcon.Get() : nullptr;
+				if (CachedDragIcon && DragTexture)
 				{
-					CachedDragIcon->SetBrushFromTexture(CurrentSlotData.ItemDefinition->ItemIcon, true);
+					CachedDragIcon->SetBrushFromTexture(DragTexture, true);
 					CachedDragIcon->SetVisibility(ESlateVisibility::Visible);
 				}
 				else if (CachedDragIcon)
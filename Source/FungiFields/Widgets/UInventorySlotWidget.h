@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
 #include "../Inventory/FInventorySlot.h"
+#include "../Interfaces/PooledWidgetInterface.h"
 #include "UInventorySlotWidget.generated.h"
 
 class UImage;
@@ -16,7 +17,7 @@ class UItemDataAsset;
  * Can be used in hotbar, backpack, and chest inventories.
  */
 UCLASS()
-class FUNGIFIELDS_API UInventorySlotWidget : public UUserWidget
+class FUNGIFIELDS_API UInventorySlotWidget : public UUserWidget, public IPooledWidgetInterface
 {
 	GENERATED_BODY()
 
@@ -47,6 +48,9 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Inventory Slot")
 	int32 GetInventorySource() const { return InventorySourceID; }
 
+	// IPooledWidgetInterface
+	virtual void ResetForPool() override;
+
 	/** Delegate for when slot is clicked */
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnSlotClicked, int32, SlotIndex, int32, InventorySourceID);
 	UPROPERTY(BlueprintAssignable, Category = "Inventory Slot")
@@ -74,6 +78,12 @@ protected:
 	/** Update visual representation of the slot */
 	void UpdateSlotVisuals();
 
+	/**
+	 * Load an item icon that is not resident yet and refresh the slot when it arrives.
+	 * @param IconPath The icon to load
+	 */
+	void RequestIcon(const FSoftObjectPath& IconPath);
+
 	/** Create widget structure programmatically if Blueprint structure is missing */
 	void CreateWidgetStructure();
 
@@ -97,6 +107,10 @@ private:
 	TObjectPtr<UImage> CachedDragIcon;
 	TObjectPtr<class USizeBox> CachedDragSizeBox;
 
+	/** Keeps the icon being shown loaded; requested on first display */
+	TSharedPtr<struct FStreamableHandle> IconLoadHandle;
+	FSoftObjectPath PendingIconPath;
+
 	void EnsureDragVisualCreated();
 };
 
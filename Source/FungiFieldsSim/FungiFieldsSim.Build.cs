@@ -0,0 +1,12 @@
+using UnrealBuildTool;
+
+public class FungiFieldsSim : ModuleRules
+{
+	public FungiFieldsSim(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		// Plain C++ farm rules: no UObjects, no world, nothing beyond Core
+		PublicDependencyModuleNames.AddRange(new string[] { "Core" });
+	}
+}
@@ -0,0 +1,157 @@
+#include "FCropGrowthRules.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FCropGrowthRulesSpec, "FungiFields.Sim.CropGrowthRules",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+	FCropGrowthParams Params;
+	FCropGrowthState State;
+END_DEFINE_SPEC(FCropGrowthRulesSpec)
+
+void FCropGrowthRulesSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Params = FCropGrowthParams();
+		Params.GrowthPerSecond = 0.1f;
+		Params.WaterConsumptionRate = 2.0f;
+		Params.WitherTimeWithoutWater = 5.0f;
+		State = FCropGrowthState();
+	});
+
+	Describe("GetGrowthPerSecond", [this]()
+	{
+		It("should grow in the growth time at fertility 1", [this]()
+		{
+			TestEqual(TEXT("Rate"), FCropGrowthRules::GetGrowthPerSecond(10.0f, 1.0f), 0.1f);
+		});
+
+		It("should scale with fertility", [this]()
+		{
+			TestEqual(TEXT("Rate"), FCropGrowthRules::GetGrowthPerSecond(10.0f, 2.0f), 0.2f);
+		});
+
+		It("should stay finite and positive for a zero growth time", [this]()
+		{
+			const float Rate = FCropGrowthRules::GetGrowthPerSecond(0.0f, 1.0f);
+			TestTrue(TEXT("Finite"), FMath::IsFinite(Rate));
+			TestTrue(TEXT("Positive"), Rate > 0.0f);
+		});
+
+		It("should stay finite and positive for zero or negative fertility", [this]()
+		{
+			for (const float Fertility : { 0.0f, -1.0f })
+			{
+				const float Rate = FCropGrowthRules::GetGrowthPerSecond(10.0f, Fertility);
+				TestTrue(FString::Printf(TEXT("Finite at fertility %.1f"), Fertility), FMath::IsFinite(Rate));
+				TestTrue(FString::Printf(TEXT("Positive at fertility %.1f"), Fertility), Rate > 0.0f);
+			}
+		});
+	});
+
+	Describe("Step", [this]()
+	{
+		It("should grow and draw water while watered", [this]()
+		{
+			const FCropGrowthStepResult Result = FCropGrowthRules::Step(State, Params, true, 2.0f);
+			TestEqual(TEXT("Progress"), State.Progress, 0.2f);
+			TestEqual(TEXT("Water to consume"), Result.WaterToConsume, 4.0f);
+			TestFalse(TEXT("Withered"), Result.bWitheredThisStep);
+		});
+
+		It("should clamp progress at fully grown", [this]()
+		{
+			Params.GrowthPerSecond = FCropGrowthRules::GetGrowthPerSecond(0.0f, 1.0f);
+			FCropGrowthRules::Step(State, Params, true, 1.0f);
+			TestEqual(TEXT("Progress"), State.Progress, 1.0f);
+			TestTrue(TEXT("Fully grown"), FCropGrowthRules::IsFullyGrown(State.Progress));
+		});
+
+		It("should not grow at zero fertility in a normal step", [this]()
+		{
+			Params.GrowthPerSecond = FCropGrowthRules::GetGrowthPerSecond(10.0f, 0.0f);
+			FCropGrowthRules::Step(State, Params, true, 1.0f);
+			TestTrue(TEXT("Barely grown"), State.Progress < 0.001f);
+			TestEqual(TEXT("Stage"), FCropGrowthRules::GetGrowthStage(State.Progress), 0);
+		});
+
+		It("should wither once dry for the wither time, and only report it once", [this]()
+		{
+			FCropGrowthStepResult Result = FCropGrowthRules::Step(State, Params, false, 4.0f);
+			TestFalse(TEXT("Withered before the wither time"), State.bWithered);
+
+			Result = FCropGrowthRules::Step(State, Params, false, 1.0f);
+			TestTrue(TEXT("Withered at the wither time"), State.bWithered);
+			TestTrue(TEXT("Reported"), Result.bWitheredThisStep);
+
+			Result = FCropGrowthRules::Step(State, Params, false, 1.0f);
+			TestFalse(TEXT("Reported again"), Result.bWitheredThisStep);
+		});
+
+		It("should reset the dry time when watered", [this]()
+		{
+			FCropGrowthRules::Step(State, Params, false, 4.0f);
+			FCropGrowthRules::Step(State, Params, true, 0.1f);
+			FCropGrowthRules::Step(State, Params, false, 4.0f);
+			TestFalse(TEXT("Withered"), State.bWithered);
+			TestEqual(TEXT("Time without water"), State.TimeWithoutWater, 4.0f);
+		});
+
+		It("should not change a withered crop", [this]()
+		{
+			State.Progress = 0.3f;
+			State.bWithered = true;
+			const FCropGrowthStepResult Result = FCropGrowthRules::Step(State, Params, true, 10.0f);
+			TestEqual(TEXT("Progress"), State.Progress, 0.3f);
+			TestEqual(TEXT("Water to consume"), Result.WaterToConsume, 0.0f);
+		});
+	});
+
+	Describe("GetGrowthStage", [this]()
+	{
+		It("should map progress to the stage thresholds", [this]()
+		{
+			TestEqual(TEXT("Planted"), FCropGrowthRules::GetGrowthStage(0.0f), 0);
+			TestEqual(TEXT("Just below 25%"), FCropGrowthRules::GetGrowthStage(0.249f), 0);
+			TestEqual(TEXT("25%"), FCropGrowthRules::GetGrowthStage(0.25f), 1);
+			TestEqual(TEXT("50%"), FCropGrowthRules::GetGrowthStage(0.5f), 2);
+			TestEqual(TEXT("Just below grown"), FCropGrowthRules::GetGrowthStage(0.999f), 2);
+			TestEqual(TEXT("Grown"), FCropGrowthRules::GetGrowthStage(1.0f), FCropGrowthRules::NumGrowthStages - 1);
+		});
+
+		It("should never reach a stage when the crop does not grow", [this]()
+		{
+			TestEqual(TEXT("Time to stage"), FCropGrowthRules::GetTimeToStage(0.0f, 1, 0.0f), TNumericLimits<float>::Max());
+			TestEqual(TEXT("Time to a reached stage"), FCropGrowthRules::GetTimeToStage(0.6f, 2, 0.0f), 0.0f);
+		});
+	});
+
+	Describe("GetHarvestQuantity", [this]()
+	{
+		It("should never double at a yield chance of 0", [this]()
+		{
+			TestEqual(TEXT("Lowest roll"), FCropGrowthRules::GetHarvestQuantity(3, 0.0f, 0.0f), 3);
+			TestEqual(TEXT("Highest roll"), FCropGrowthRules::GetHarvestQuantity(3, 0.0f, 0.9999f), 3);
+		});
+
+		It("should always double at a yield chance of 1", [this]()
+		{
+			TestEqual(TEXT("Lowest roll"), FCropGrowthRules::GetHarvestQuantity(3, 1.0f, 0.0f), 6);
+			TestEqual(TEXT("Highest roll"), FCropGrowthRules::GetHarvestQuantity(3, 1.0f, 0.9999f), 6);
+		});
+
+		It("should double only below the yield chance", [this]()
+		{
+			TestEqual(TEXT("Below"), FCropGrowthRules::GetHarvestQuantity(3, 0.5f, 0.49f), 6);
+			TestEqual(TEXT("At"), FCropGrowthRules::GetHarvestQuantity(3, 0.5f, 0.5f), 3);
+		});
+
+		It("should yield nothing from a zero base quantity", [this]()
+		{
+			TestEqual(TEXT("Quantity"), FCropGrowthRules::GetHarvestQuantity(0, 1.0f, 0.0f), 0);
+		});
+	});
+}
+
+#endif
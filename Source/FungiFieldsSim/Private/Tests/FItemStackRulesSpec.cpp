@@ -0,0 +1,85 @@
+#include "FItemStackRules.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FItemStackRulesSpec, "FungiFields.Sim.ItemStackRules",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FItemStackRulesSpec)
+
+void FItemStackRulesSpec::Define()
+{
+	Describe("AddToStack", [this]()
+	{
+		It("should add everything that fits", [this]()
+		{
+			int32 Count = 10;
+			int32 Amount = 5;
+			TestEqual(TEXT("Added"), FItemStackRules::AddToStack(Count, 99, Amount), 5);
+			TestEqual(TEXT("Count"), Count, 15);
+			TestEqual(TEXT("Remaining"), Amount, 0);
+		});
+
+		It("should stop at the stack limit and keep the overflow", [this]()
+		{
+			int32 Count = 95;
+			int32 Amount = 10;
+			TestEqual(TEXT("Added"), FItemStackRules::AddToStack(Count, 99, Amount), 4);
+			TestEqual(TEXT("Count"), Count, 99);
+			TestEqual(TEXT("Remaining"), Amount, 6);
+		});
+
+		It("should add nothing to a stack above its limit", [this]()
+		{
+			int32 Count = 120;
+			int32 Amount = 10;
+			TestEqual(TEXT("Added"), FItemStackRules::AddToStack(Count, 99, Amount), 0);
+			TestEqual(TEXT("Count"), Count, 120);
+			TestEqual(TEXT("Remaining"), Amount, 10);
+		});
+
+		It("should not overflow with the largest amount", [this]()
+		{
+			int32 Count = 1;
+			int32 Amount = MAX_int32;
+			FItemStackRules::AddToStack(Count, 99, Amount);
+			TestEqual(TEXT("Count"), Count, 99);
+			TestEqual(TEXT("Remaining"), Amount, MAX_int32 - 98);
+		});
+
+		It("should not take items for a negative amount", [this]()
+		{
+			int32 Count = 10;
+			int32 Amount = -5;
+			TestEqual(TEXT("Added"), FItemStackRules::AddToStack(Count, 99, Amount), 0);
+			TestEqual(TEXT("Count"), Count, 10);
+			TestEqual(TEXT("Remaining"), Amount, -5);
+		});
+	});
+
+	Describe("GetNewStackCount", [this]()
+	{
+		It("should cap a new stack at the stack limit", [this]()
+		{
+			TestEqual(TEXT("Below the limit"), FItemStackRules::GetNewStackCount(10, 99), 10);
+			TestEqual(TEXT("Above the limit"), FItemStackRules::GetNewStackCount(250, 99), 99);
+		});
+
+		It("should never be negative", [this]()
+		{
+			TestEqual(TEXT("Negative amount"), FItemStackRules::GetNewStackCount(-3, 99), 0);
+			TestEqual(TEXT("Negative limit"), FItemStackRules::GetNewStackCount(3, -1), 0);
+		});
+	});
+
+	Describe("GetSpace", [this]()
+	{
+		It("should be zero for full and overfull stacks", [this]()
+		{
+			TestEqual(TEXT("Full"), FItemStackRules::GetSpace(99, 99), 0);
+			TestEqual(TEXT("Overfull"), FItemStackRules::GetSpace(120, 99), 0);
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,74 @@
+#include "FSoilWaterRules.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FSoilWaterRulesSpec, "FungiFields.Sim.SoilWaterRules",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FSoilWaterRulesSpec)
+
+void FSoilWaterRulesSpec::Define()
+{
+	Describe("AddWater", [this]()
+	{
+		It("should add water below the capacity", [this]()
+		{
+			TestEqual(TEXT("Level"), FSoilWaterRules::AddWater(20.0f, 30.0f, 100.0f), 50.0f);
+		});
+
+		It("should clamp to the capacity", [this]()
+		{
+			TestEqual(TEXT("Level"), FSoilWaterRules::AddWater(80.0f, 30.0f, 100.0f), 100.0f);
+		});
+
+		It("should hold no water in soil without capacity", [this]()
+		{
+			TestEqual(TEXT("Level"), FSoilWaterRules::AddWater(0.0f, 30.0f, 0.0f), 0.0f);
+		});
+	});
+
+	Describe("ConsumeWater", [this]()
+	{
+		It("should never go below zero", [this]()
+		{
+			TestEqual(TEXT("Level"), FSoilWaterRules::ConsumeWater(5.0f, 8.0f), 0.0f);
+			TestEqual(TEXT("Level"), FSoilWaterRules::ConsumeWater(5.0f, 2.0f), 3.0f);
+		});
+	});
+
+	Describe("GetEvaporation", [this]()
+	{
+		It("should slow with retention", [this]()
+		{
+			TestEqual(TEXT("Retention 1"), FSoilWaterRules::GetEvaporation(2.0f, 1.0f, 3.0f), 6.0f);
+			TestEqual(TEXT("Retention 2"), FSoilWaterRules::GetEvaporation(2.0f, 2.0f, 3.0f), 3.0f);
+		});
+
+		It("should stay finite at zero retention", [this]()
+		{
+			TestTrue(TEXT("Finite"), FMath::IsFinite(FSoilWaterRules::GetEvaporation(2.0f, 0.0f, 1.0f)));
+		});
+
+		It("should not evaporate over no time", [this]()
+		{
+			TestEqual(TEXT("Evaporation"), FSoilWaterRules::GetEvaporation(2.0f, 1.0f, 0.0f), 0.0f);
+		});
+	});
+
+	Describe("IsSignificantChange", [this]()
+	{
+		It("should ignore changes within the threshold", [this]()
+		{
+			TestFalse(TEXT("No change"), FSoilWaterRules::IsSignificantChange(10.0f, 10.0f));
+			TestFalse(TEXT("Small change"), FSoilWaterRules::IsSignificantChange(10.0f, 10.0f + FSoilWaterRules::ChangeThreshold * 0.5f));
+		});
+
+		It("should report changes past the threshold in either direction", [this]()
+		{
+			TestTrue(TEXT("Rise"), FSoilWaterRules::IsSignificantChange(10.0f, 10.5f));
+			TestTrue(TEXT("Fall"), FSoilWaterRules::IsSignificantChange(10.0f, 9.5f));
+		});
+	});
+}
+
+#endif
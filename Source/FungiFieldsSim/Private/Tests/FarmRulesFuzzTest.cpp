@@ -0,0 +1,140 @@
+#include "FCropGrowthRules.h"
+#include "FItemStackRules.h"
+#include "FSoilWaterRules.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FarmRulesFuzz
+{
+	static constexpr int32 NumPlots = 4096;
+	static constexpr int32 NumSteps = 240;
+	static constexpr int32 NumStackOperations = 1000000;
+	static constexpr int32 NumHeldItems = 1000;
+	static constexpr int32 Seed = 0x46756E67;
+
+	/** One simulated plot: soil water and the crop growing in it */
+	struct FPlot
+	{
+		FCropGrowthParams Params;
+		FCropGrowthState Crop;
+		float WaterLevel = 0.0f;
+		float MaxWaterLevel = 100.0f;
+		float EvaporationRate = 0.0f;
+		float Retention = 1.0f;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFarmRulesFuzzTest, "FungiFields.Sim.FarmRulesFuzz",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFarmRulesFuzzTest::RunTest(const FString& Parameters)
+{
+	using namespace FarmRulesFuzz;
+
+	FRandomStream Random(Seed);
+
+	// Random tunables, including the edge values data assets can hold
+	TArray<FPlot> Plots;
+	Plots.SetNum(NumPlots);
+	for (FPlot& Plot : Plots)
+	{
+		const float GrowthTime = Random.FRand() < 0.05f ? 0.0f : Random.FRandRange(1.0f, 600.0f);
+		const float Fertility = Random.FRand() < 0.05f ? 0.0f : Random.FRandRange(0.25f, 3.0f);
+		Plot.Params.GrowthPerSecond = FCropGrowthRules::GetGrowthPerSecond(GrowthTime, Fertility);
+		Plot.Params.WaterConsumptionRate = Random.FRandRange(0.0f, 5.0f);
+		Plot.Params.WitherTimeWithoutWater = Random.FRandRange(0.0f, 60.0f);
+		Plot.MaxWaterLevel = Random.FRandRange(0.0f, 100.0f);
+		Plot.EvaporationRate = Random.FRandRange(0.0f, 2.0f);
+		Plot.Retention = Random.FRand() < 0.05f ? 0.0f : Random.FRandRange(0.5f, 2.0f);
+	}
+
+	int32 Failures = 0;
+	double StepSeconds = 0.0;
+
+	for (int32 Step = 0; Step < NumSteps && Failures == 0; ++Step)
+	{
+		const float DeltaTime = Random.FRandRange(0.0f, 1.0f);
+
+		for (FPlot& Plot : Plots)
+		{
+			if (Random.FRand() < 0.02f)
+			{
+				Plot.WaterLevel = FSoilWaterRules::AddWater(Plot.WaterLevel, Random.FRandRange(0.0f, 50.0f), Plot.MaxWaterLevel);
+			}
+		}
+
+		const double StartSeconds = FPlatformTime::Seconds();
+		for (FPlot& Plot : Plots)
+		{
+			const FCropGrowthStepResult Result = FCropGrowthRules::Step(Plot.Crop, Plot.Params, Plot.WaterLevel > 0.0f, DeltaTime);
+			Plot.WaterLevel = FSoilWaterRules::ConsumeWater(Plot.WaterLevel, Result.WaterToConsume);
+			Plot.WaterLevel = FSoilWaterRules::ConsumeWater(Plot.WaterLevel, FSoilWaterRules::GetEvaporation(Plot.EvaporationRate, Plot.Retention, DeltaTime));
+		}
+		StepSeconds += FPlatformTime::Seconds() - StartSeconds;
+
+		for (int32 PlotIndex = 0; PlotIndex < NumPlots; ++PlotIndex)
+		{
+			const FPlot& Plot = Plots[PlotIndex];
+			const bool bValid = Plot.Crop.Progress >= 0.0f && Plot.Crop.Progress <= 1.0f
+				&& FMath::IsFinite(Plot.WaterLevel) && Plot.WaterLevel >= 0.0f && Plot.WaterLevel <= Plot.MaxWaterLevel;
+
+			if (!bValid)
+			{
+				AddError(FString::Printf(TEXT("Plot %d is invalid after step %d: progress %f, water %f of %f"),
+					PlotIndex, Step, Plot.Crop.Progress, Plot.WaterLevel, Plot.MaxWaterLevel));
+				++Failures;
+			}
+		}
+	}
+
+	const double PlotStepsPerSecond = StepSeconds > 0.0 ? static_cast<double>(NumPlots) * NumSteps / StepSeconds : 0.0;
+	AddInfo(FString::Printf(TEXT("Crop and soil rules: %.0f plot steps per second"), PlotStepsPerSecond));
+
+	// Items are only ever moved between the held pile and the stacks, so the total must be kept
+	int32 Counts[8] = {};
+	int32 Held = NumHeldItems;
+	const double StackStartSeconds = FPlatformTime::Seconds();
+
+	for (int32 Operation = 0; Operation < NumStackOperations && Failures == 0; ++Operation)
+	{
+		int32& Count = Counts[Random.RandHelper(UE_ARRAY_COUNT(Counts))];
+		const int32 MaxStackSize = Random.RandRange(1, 99);
+		const int32 Amount = Random.RandRange(-10, 200);
+
+		if (Random.FRand() < 0.5f)
+		{
+			int32 Remaining = FMath::Min(Amount, Held);
+			const int32 Added = FItemStackRules::AddToStack(Count, MaxStackSize, Remaining);
+			Held -= Added;
+		}
+		else
+		{
+			const int32 Taken = FItemStackRules::GetNewStackCount(FMath::Min(Amount, Count), MaxStackSize);
+			Count -= Taken;
+			Held += Taken;
+		}
+
+		int32 Total = Held;
+		for (int32 StackCount : Counts)
+		{
+			Total += StackCount;
+		}
+
+		if (Count < 0 || Held < 0 || Total != NumHeldItems)
+		{
+			AddError(FString::Printf(TEXT("Stack operation %d lost items: stack %d, held %d, total %d"), Operation, Count, Held, Total));
+			++Failures;
+		}
+	}
+
+	const double StackSeconds = FPlatformTime::Seconds() - StackStartSeconds;
+	const double StackOperationsPerSecond = StackSeconds > 0.0 ? NumStackOperations / StackSeconds : 0.0;
+	AddInfo(FString::Printf(TEXT("Item stack rules: %.0f checked operations per second"), StackOperationsPerSecond));
+
+	return Failures == 0;
+}
+
+#endif
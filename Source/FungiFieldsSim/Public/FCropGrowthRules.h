@@ -0,0 +1,166 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Growth tunables of one crop, resolved from its crop data and the soil it was planted in */
+struct FCropGrowthParams
+{
+	/** Progress gained per second while watered; progress runs from 0 to 1 */
+	float GrowthPerSecond = 0.01f;
+
+	/** Water drawn from the soil per second while growing */
+	float WaterConsumptionRate = 0.0f;
+
+	/** Seconds without water before the crop withers */
+	float WitherTimeWithoutWater = 30.0f;
+};
+
+/** Simulated state of one crop */
+struct FCropGrowthState
+{
+	/** Growth progress from 0 to 1 */
+	float Progress = 0.0f;
+
+	/** Seconds since the crop last had water */
+	float TimeWithoutWater = 0.0f;
+
+	bool bWithered = false;
+};
+
+/** What a growth step asks of the world around the crop */
+struct FCropGrowthStepResult
+{
+	/** Water to take from the soil */
+	float WaterToConsume = 0.0f;
+
+	/** Whether the crop withered during this step */
+	bool bWitheredThisStep = false;
+};
+
+/**
+ * Crop growth, withering and harvest yield rules. Plain functions on plain state, so they can be run
+ * and tested without a world; UCropGrowthComponent and ACropBase apply their results.
+ */
+struct FCropGrowthRules
+{
+	/** Number of visual growth stages: planted, 25%, 50% and fully grown */
+	static constexpr int32 NumGrowthStages = 4;
+
+	/** Visual stage index of a withered crop, after the growth stages */
+	static constexpr int32 WitheredStage = NumGrowthStages;
+
+	/**
+	 * Get the growth rate of a crop planted in soil of the given fertility.
+	 * @param GrowthTimeSeconds Seconds the crop takes to grow at fertility 1
+	 * @param Fertility Soil fertility multiplier
+	 * @return Progress per second
+	 */
+	static float GetGrowthPerSecond(float GrowthTimeSeconds, float Fertility)
+	{
+		const float AdjustedGrowthTime = GrowthTimeSeconds / FMath::Max(Fertility, KINDA_SMALL_NUMBER);
+		return 1.0f / FMath::Max(AdjustedGrowthTime, KINDA_SMALL_NUMBER);
+	}
+
+	/**
+	 * Advance a crop by one step. Watered crops grow and draw water; dry crops wither once they have gone
+	 * WitherTimeWithoutWater seconds without it. Withered crops do not change.
+	 * @param State Crop state, updated in place
+	 * @param Params Crop tunables
+	 * @param bHasWater Whether the soil had water at the start of the step
+	 * @param DeltaTime Seconds to advance
+	 * @return Water to consume and whether the crop withered
+	 */
+	static FCropGrowthStepResult Step(FCropGrowthState& State, const FCropGrowthParams& Params, bool bHasWater, float DeltaTime)
+	{
+		FCropGrowthStepResult Result;
+		if (State.bWithered)
+		{
+			return Result;
+		}
+
+		if (bHasWater)
+		{
+			State.TimeWithoutWater = 0.0f;
+			State.Progress = FMath::Clamp(State.Progress + Params.GrowthPerSecond * DeltaTime, 0.0f, 1.0f);
+			Result.WaterToConsume = Params.WaterConsumptionRate * DeltaTime;
+		}
+		else
+		{
+			State.TimeWithoutWater += DeltaTime;
+			if (State.TimeWithoutWater >= Params.WitherTimeWithoutWater)
+			{
+				State.bWithered = true;
+				Result.bWitheredThisStep = true;
+			}
+		}
+
+		return Result;
+	}
+
+	/**
+	 * Check whether a crop has finished growing.
+	 * @param Progress Growth progress
+	 * @return True at full progress
+	 */
+	static bool IsFullyGrown(float Progress)
+	{
+		return Progress >= 1.0f;
+	}
+
+	/**
+	 * Get the visual growth stage for a progress value.
+	 * @param Progress Growth progress
+	 * @return Stage index from 0 (planted) to NumGrowthStages - 1 (fully grown)
+	 */
+	static int32 GetGrowthStage(float Progress)
+	{
+		for (int32 Stage = NumGrowthStages - 1; Stage > 0; --Stage)
+		{
+			if (Progress >= GetStageStartProgress(Stage))
+			{
+				return Stage;
+			}
+		}
+		return 0;
+	}
+
+	/**
+	 * Get the progress at which a growth stage begins.
+	 * @param Stage Stage index, clamped to the growth stages
+	 * @return Progress from 0 to 1
+	 */
+	static float GetStageStartProgress(int32 Stage)
+	{
+		static constexpr float StageStarts[NumGrowthStages] = { 0.0f, 0.25f, 0.5f, 1.0f };
+		return StageStarts[FMath::Clamp(Stage, 0, NumGrowthStages - 1)];
+	}
+
+	/**
+	 * Get the time a watered crop takes to reach a growth stage.
+	 * @param Progress Current growth progress
+	 * @param Stage Stage to reach
+	 * @param GrowthPerSecond Crop's growth rate
+	 * @return Seconds until the stage begins, 0 if it already has, or the largest float if the crop does not grow
+	 */
+	static float GetTimeToStage(float Progress, int32 Stage, float GrowthPerSecond)
+	{
+		const float Remaining = GetStageStartProgress(Stage) - Progress;
+		if (Remaining <= 0.0f)
+		{
+			return 0.0f;
+		}
+		return GrowthPerSecond > 0.0f ? Remaining / GrowthPerSecond : TNumericLimits<float>::Max();
+	}
+
+	/**
+	 * Get the number of items a harvest yields. The soil's yield chance doubles the base quantity.
+	 * @param BaseQuantity Items a normal harvest yields
+	 * @param YieldChance Soil's chance of a double harvest, 0 to 1
+	 * @param Roll Uniform random value in [0, 1); a chance of 0 never doubles and a chance of 1 always does
+	 * @return Items to spawn
+	 */
+	static int32 GetHarvestQuantity(int32 BaseQuantity, float YieldChance, float Roll)
+	{
+		return Roll < YieldChance ? BaseQuantity * 2 : BaseQuantity;
+	}
+};
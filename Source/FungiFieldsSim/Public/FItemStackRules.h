@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Inventory stacking rules on plain slot counts, applied by UInventoryComponent */
+struct FItemStackRules
+{
+	/**
+	 * Get the room left in a stack.
+	 * @param Count Items in the stack
+	 * @param MaxStackSize Item's stack limit
+	 * @return Items that still fit
+	 */
+	static int32 GetSpace(int32 Count, int32 MaxStackSize)
+	{
+		return FMath::Max(0, MaxStackSize - Count);
+	}
+
+	/**
+	 * Move as many items as fit onto a stack.
+	 * @param Count Items in the stack, updated in place
+	 * @param MaxStackSize Item's stack limit
+	 * @param Amount Items to add, reduced by the number added; a negative amount adds nothing
+	 * @return Number of items added
+	 */
+	static int32 AddToStack(int32& Count, int32 MaxStackSize, int32& Amount)
+	{
+		const int32 Added = FMath::Clamp(Amount, 0, GetSpace(Count, MaxStackSize));
+		Count += Added;
+		Amount -= Added;
+		return Added;
+	}
+
+	/**
+	 * Get the size of a new stack started from an amount of items.
+	 * @param Amount Items to place
+	 * @param MaxStackSize Item's stack limit
+	 * @return Items that go into the new stack, never negative
+	 */
+	static int32 GetNewStackCount(int32 Amount, int32 MaxStackSize)
+	{
+		return FMath::Max(0, FMath::Min(Amount, MaxStackSize));
+	}
+};
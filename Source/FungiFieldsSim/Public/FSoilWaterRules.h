@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Soil water rules: watering, evaporation and consumption. Plain functions on the water level,
+ * applied by USoilComponent.
+ */
+struct FSoilWaterRules
+{
+	/** Water level changes smaller than this are not reported to listeners */
+	static constexpr float ChangeThreshold = 0.01f;
+
+	/**
+	 * Get the water level after watering.
+	 * @param WaterLevel Current level
+	 * @param Amount Water added
+	 * @param MaxWaterLevel Soil's capacity
+	 * @return New level, clamped to the capacity
+	 */
+	static float AddWater(float WaterLevel, float Amount, float MaxWaterLevel)
+	{
+		return FMath::Clamp(WaterLevel + Amount, 0.0f, MaxWaterLevel);
+	}
+
+	/**
+	 * Get the water level after water is drawn out.
+	 * @param WaterLevel Current level
+	 * @param Amount Water removed
+	 * @return New level, never below zero
+	 */
+	static float ConsumeWater(float WaterLevel, float Amount)
+	{
+		return FMath::Max(0.0f, WaterLevel - Amount);
+	}
+
+	/**
+	 * Get the water lost to evaporation over a period.
+	 * @param EvaporationRate Water lost per second by soil with retention 1
+	 * @param RetentionMultiplier Soil's water retention; higher keeps water longer
+	 * @param DeltaTime Seconds elapsed
+	 * @return Water to consume
+	 */
+	static float GetEvaporation(float EvaporationRate, float RetentionMultiplier, float DeltaTime)
+	{
+		return EvaporationRate / FMath::Max(RetentionMultiplier, KINDA_SMALL_NUMBER) * DeltaTime;
+	}
+
+	/**
+	 * Check whether a water level change is large enough to report.
+	 * @param OldWaterLevel Level before the change
+	 * @param NewWaterLevel Level after the change
+	 * @return True if listeners should be told
+	 */
+	static bool IsSignificantChange(float OldWaterLevel, float NewWaterLevel)
+	{
+		return FMath::Abs(NewWaterLevel - OldWaterLevel) > ChangeThreshold;
+	}
+};